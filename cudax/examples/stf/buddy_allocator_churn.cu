@@ -0,0 +1,114 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of CUDASTF in CUDA C++ Core Libraries,
+// under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES.
+//
+//===----------------------------------------------------------------------===//
+
+/**
+ * @file
+ *
+ * @brief Host-only microbenchmark of the buddy allocator metadata under allocate/free churn
+ *
+ * The buffer is first fragmented by filling it with small blocks and freeing every other one, which leaves long free
+ * lists in which no block can be coalesced. Batches of random blocks are then freed, each free looking up the buddy of
+ * the block among the free blocks of its level, and as many blocks are allocated again. The average cost of a free
+ * and of an allocation is reported.
+ *
+ * Example:
+ *   buddy_allocator_churn [buffer size in MiB] [number of operations]
+ */
+
+#include <cuda/experimental/stf.cuh>
+
+#include <chrono>
+#include <random>
+
+using namespace cuda::experimental::stf;
+
+int main(int argc, char** argv)
+{
+  const size_t total_size = size_t(argc > 1 ? atoi(argv[1]) : 64) << 20;
+  const size_t num_ops    = argc > 2 ? atol(argv[2]) : 1 << 18;
+
+  constexpr size_t unit       = 256;
+  constexpr size_t batch_size = 1024;
+  const size_t num_units      = total_size / unit;
+
+  event_list prereqs;
+  reserved::buddy_allocator_metadata metadata(total_size, prereqs);
+
+  event_list dummy;
+  auto allocate = [&] {
+    const ::std::ptrdiff_t offset = metadata.allocate(unit, dummy);
+    EXPECT(offset != -1);
+    return offset;
+  };
+
+  using clock = ::std::chrono::steady_clock;
+  auto seconds_since = [](clock::time_point start) {
+    return ::std::chrono::duration<double>(clock::now() - start).count();
+  };
+
+  // Fill the buffer, then free every other block so that no free block can be coalesced
+  auto start = clock::now();
+  for (size_t i = 0; i < num_units; i++)
+  {
+    allocate();
+  }
+  const double fill_time = seconds_since(start);
+
+  ::std::vector<::std::ptrdiff_t> live;
+  for (size_t u = 0; u < num_units; u += 2)
+  {
+    live.push_back(u * unit);
+    metadata.deallocate((u + 1) * unit, unit, dummy);
+  }
+
+  ::std::mt19937_64 rng(42);
+  ::std::vector<size_t> batch(batch_size);
+
+  double free_time     = 0.0;
+  double allocate_time = 0.0;
+  for (size_t op = 0; op < num_ops; op += batch_size)
+  {
+    // Pick distinct blocks by moving them to the end of the live blocks
+    for (size_t b = 0; b < batch_size; b++)
+    {
+      const size_t i = rng() % (live.size() - b);
+      ::std::swap(live[i], live[live.size() - 1 - b]);
+    }
+
+    // Each free coalesces the block with its free buddy
+    start = clock::now();
+    for (size_t b = 0; b < batch_size; b++)
+    {
+      metadata.deallocate(live[live.size() - 1 - b], unit, dummy);
+    }
+    free_time += seconds_since(start);
+
+    // Each allocation splits a coalesced block again
+    start = clock::now();
+    for (size_t b = 0; b < batch_size; b++)
+    {
+      live[live.size() - 1 - b] = allocate();
+    }
+    allocate_time += seconds_since(start);
+  }
+
+  const size_t num_batched = (num_ops + batch_size - 1) / batch_size * batch_size;
+
+  fprintf(stderr, "buddy allocator churn: %zu MiB buffer, %zu B blocks\n", total_size >> 20, unit);
+  fprintf(stderr, "  fill     : %zu allocations, %.1f ns per allocation\n", num_units, 1e9 * fill_time / num_units);
+  fprintf(stderr,
+          "  churn    : %zu free/allocate pairs with %zu live blocks\n"
+          "  free     : %.1f ns per free\n"
+          "  allocate : %.1f ns per allocation\n",
+          num_batched,
+          live.size(),
+          1e9 * free_time / num_batched,
+          1e9 * allocate_time / num_batched);
+}
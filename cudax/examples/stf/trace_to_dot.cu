@@ -0,0 +1,120 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of CUDASTF in CUDA C++ Core Libraries,
+// under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES.
+//
+//===----------------------------------------------------------------------===//
+
+/**
+ * @file
+ *
+ * @brief Offline processing of the trace files generated with CUDASTF_TRACE_FILE
+ *
+ * Extract a range of tasks from a trace, remove redundant edges, and print the
+ * resulting subgraph in the DOT format. The timing records of the trace can
+ * also be converted into a Chrome trace event file.
+ *
+ * Example:
+ *   CUDASTF_TRACE_FILE=app.trace CUDASTF_DOT_TIMING=1 ./app
+ *   trace_to_dot app.trace --first 1000 --last 2000 -o app.dot --chrome app.json
+ */
+
+#include <cuda/experimental/stf.cuh>
+
+#include <cstring>
+
+using namespace cuda::experimental::stf;
+
+static void usage(const char* prog)
+{
+  fprintf(stderr,
+          "Usage: %s <trace file> [-o <dot file>] [--first <id>] [--last <id>] [--no-prereqs] [--keep-redundant] "
+          "[--chrome <json file>]\n",
+          prog);
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 2)
+  {
+    // Not an error, so that this example can be executed without argument by the test suite
+    usage(argv[0]);
+    return EXIT_SUCCESS;
+  }
+
+  const char* trace_filename = argv[1];
+  const char* dot_filename   = nullptr;
+  const char* json_filename  = nullptr;
+  int first_id               = 0;
+  int last_id                = ::std::numeric_limits<int>::max();
+  bool keep_prereqs          = true;
+  bool keep_redundant        = false;
+
+  for (int i = 2; i < argc; i++)
+  {
+    const bool has_value = (i + 1 < argc);
+    if (!strcmp(argv[i], "-o") && has_value)
+    {
+      dot_filename = argv[++i];
+    }
+    else if (!strcmp(argv[i], "--first") && has_value)
+    {
+      first_id = atoi(argv[++i]);
+    }
+    else if (!strcmp(argv[i], "--last") && has_value)
+    {
+      last_id = atoi(argv[++i]);
+    }
+    else if (!strcmp(argv[i], "--chrome") && has_value)
+    {
+      json_filename = argv[++i];
+    }
+    else if (!strcmp(argv[i], "--no-prereqs"))
+    {
+      keep_prereqs = false;
+    }
+    else if (!strcmp(argv[i], "--keep-redundant"))
+    {
+      keep_redundant = true;
+    }
+    else
+    {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (json_filename)
+  {
+    ::std::ofstream json(json_filename);
+    EXPECT(json.is_open(), "Unable to open file ", json_filename);
+    size_t cnt = reserved::trace_to_chrome_json(trace_filename, json);
+    fprintf(stderr, "Wrote %zu timed tasks in %s\n", cnt, json_filename);
+  }
+
+  // Only convert the graph if a DOT file was requested, or if there was nothing else to do
+  if (dot_filename || !json_filename)
+  {
+    reserved::trace_graph g(trace_filename, first_id, last_id, keep_prereqs);
+    if (!keep_redundant)
+    {
+      g.remove_redundant_edges();
+    }
+
+    if (dot_filename)
+    {
+      ::std::ofstream dot(dot_filename);
+      EXPECT(dot.is_open(), "Unable to open file ", dot_filename);
+      g.print_dot(dot);
+    }
+    else
+    {
+      g.print_dot(::std::cout);
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -26,6 +26,7 @@
 
 // Include the other implementation headers:
 #include <cuda/experimental/__async/sender/basic_sender.cuh>
+#include <cuda/experimental/__async/sender/bulk.cuh>
 #include <cuda/experimental/__async/sender/conditional.cuh>
 #include <cuda/experimental/__async/sender/continue_on.cuh>
 #include <cuda/experimental/__async/sender/cpos.cuh>
@@ -36,8 +37,10 @@
 #include <cuda/experimental/__async/sender/read_env.cuh>
 #include <cuda/experimental/__async/sender/run_loop.cuh>
 #include <cuda/experimental/__async/sender/sequence.cuh>
+#include <cuda/experimental/__async/sender/split.cuh>
 #include <cuda/experimental/__async/sender/start_detached.cuh>
 #include <cuda/experimental/__async/sender/start_on.cuh>
+#include <cuda/experimental/__async/sender/static_thread_pool.cuh>
 #include <cuda/experimental/__async/sender/stop_token.cuh>
 #include <cuda/experimental/__async/sender/sync_wait.cuh>
 #include <cuda/experimental/__async/sender/then.cuh>
@@ -0,0 +1,476 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of CUDA Experimental in CUDA C++ Core Libraries,
+// under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef __CUDAX_ASYNC_DETAIL_BULK
+#define __CUDAX_ASYNC_DETAIL_BULK
+
+#include <cuda/std/detail/__config>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <cuda/std/__type_traits/is_integral.h>
+#include <cuda/std/__type_traits/is_same.h>
+#include <cuda/std/__type_traits/is_signed.h>
+#include <cuda/std/atomic>
+
+#include <cuda/experimental/__async/sender/completion_signatures.cuh>
+#include <cuda/experimental/__async/sender/cpos.cuh>
+#include <cuda/experimental/__async/sender/env.cuh>
+#include <cuda/experimental/__async/sender/exception.cuh>
+#include <cuda/experimental/__async/sender/meta.cuh>
+#include <cuda/experimental/__async/sender/queries.cuh>
+#include <cuda/experimental/__async/sender/tuple.cuh>
+#include <cuda/experimental/__async/sender/utility.cuh>
+#include <cuda/experimental/__async/sender/variant.cuh>
+
+#include <cuda/experimental/__async/sender/prologue.cuh>
+
+namespace cuda::experimental::__async
+{
+// Forward-declare the bulk algorithm tag types:
+struct bulk_t;
+struct bulk_chunked_t;
+
+namespace __bulk
+{
+// The interface of the work a scheduler customizing bulk is given. A scheduler customizes bulk by providing a member
+// function bulk_execute(shape, work) which calls work.execute(begin, end) for chunks of indices covering [0, shape),
+// possibly concurrently, and then work.complete() exactly once, after all the chunks have been executed. Both functions
+// are noexcept. bulk uses the completion scheduler of its predecessor if it has one, and otherwise the scheduler of the
+// environment of its receiver.
+template <class _Shape>
+struct __work_archetype
+{
+  void execute(_Shape, _Shape) noexcept;
+  void complete() noexcept;
+};
+
+template <class _Sch, class _Shape>
+using __bulk_execute_t =
+  decltype(__declval<_Sch&>().bulk_execute(__declval<_Shape>(), __declval<__work_archetype<_Shape>&>()));
+
+template <class _Sch, class _Shape>
+inline constexpr bool __has_bulk_execute = __type_valid_v<__bulk_execute_t, _Sch, _Shape>;
+
+template <class _Sndr>
+using __value_scheduler_of_t =
+  __decay_t<decltype(get_completion_scheduler<set_value_t>(__async::get_env(__declval<const _Sndr&>())))>;
+
+template <class _Rcvr>
+using __rcvr_scheduler_of_t = __decay_t<decltype(get_scheduler(__async::get_env(__declval<const _Rcvr&>())))>;
+
+template <class _Shape, class _Sndr>
+_CUDAX_API constexpr bool __sndr_has_bulk_scheduler() noexcept
+{
+  if constexpr (__type_valid_v<__value_scheduler_of_t, _Sndr>)
+  {
+    return __has_bulk_execute<__value_scheduler_of_t<_Sndr>, _Shape>;
+  }
+  else
+  {
+    return false;
+  }
+}
+
+template <class _Shape, class _Rcvr>
+_CUDAX_API constexpr bool __rcvr_has_bulk_scheduler() noexcept
+{
+  if constexpr (__type_valid_v<__rcvr_scheduler_of_t, _Rcvr>)
+  {
+    return __has_bulk_execute<__rcvr_scheduler_of_t<_Rcvr>, _Shape>;
+  }
+  else
+  {
+    return false;
+  }
+}
+
+// Stands for the scheduler of a bulk operation that runs sequentially on the thread its predecessor completes on.
+struct __inline_bulk_scheduler
+{};
+
+template <class _Shape, class _Sndr, class _Rcvr>
+_CUDAX_API auto __get_bulk_scheduler(const _Sndr& __sndr, const _Rcvr& __rcvr) noexcept
+{
+  if constexpr (__sndr_has_bulk_scheduler<_Shape, _Sndr>())
+  {
+    return get_completion_scheduler<set_value_t>(__async::get_env(__sndr));
+  }
+  else if constexpr (__rcvr_has_bulk_scheduler<_Shape, _Rcvr>())
+  {
+    return get_scheduler(__async::get_env(__rcvr));
+  }
+  else
+  {
+    return __inline_bulk_scheduler{};
+  }
+}
+
+template <class _Shape, class _Sndr, class _Rcvr>
+using __bulk_scheduler_t = decltype(__bulk::__get_bulk_scheduler<_Shape>(__declval<_Sndr>(), __declval<_Rcvr>()));
+
+// A negative shape is an empty index space.
+template <class _Shape>
+_CUDAX_TRIVIAL_API constexpr _Shape __clamp_shape(_Shape __shape) noexcept
+{
+  if constexpr (_CUDA_VSTD::is_signed_v<_Shape>)
+  {
+    return __shape < _Shape(0) ? _Shape(0) : __shape;
+  }
+  else
+  {
+    return __shape;
+  }
+}
+
+// Calls the function of bulk for each index of [begin, end), or once for the whole chunk with bulk_chunked.
+template <bool _Chunked, class _Fn, class _Shape, class... _Ts>
+_CUDAX_API void __run_chunk(_Fn& __fn, _Shape __begin, _Shape __end, _Ts&... __ts) //
+  noexcept(_Chunked ? __nothrow_callable<_Fn&, _Shape, _Shape, _Ts&...> : __nothrow_callable<_Fn&, _Shape, _Ts&...>)
+{
+  if constexpr (_Chunked)
+  {
+    __fn(__begin, __end, __ts...);
+  }
+  else
+  {
+    for (; __begin != __end; ++__begin)
+    {
+      __fn(__begin, __ts...);
+    }
+  }
+}
+
+template <bool _Chunked, class _Fn, class _Shape, class... _Ts>
+inline constexpr bool __callable_with =
+  _Chunked ? __callable<_Fn&, _Shape, _Shape, _Ts&...> : __callable<_Fn&, _Shape, _Ts&...>;
+
+template <bool _Chunked, class _Fn, class _Shape, class... _Ts>
+inline constexpr bool __nothrow_callable_with =
+  _Chunked ? __nothrow_callable<_Fn&, _Shape, _Shape, _Ts&...> : __nothrow_callable<_Fn&, _Shape, _Ts&...>;
+} // namespace __bulk
+
+template <bool _Chunked>
+struct __bulk_t
+{
+#if !_CCCL_CUDA_COMPILER(NVCC)
+
+private:
+#endif // !_CCCL_CUDA_COMPILER(NVCC)
+
+  using _BulkTag = _CUDA_VSTD::conditional_t<_Chunked, bulk_chunked_t, bulk_t>;
+
+  template <class _Fn, class... _Ts>
+  using __error_not_callable = //
+    _ERROR< //
+      _WHERE(_IN_ALGORITHM, _BulkTag),
+      _WHAT(_FUNCTION_IS_NOT_CALLABLE),
+      _WITH_FUNCTION(_Fn),
+      _WITH_ARGUMENTS(_Ts...)>;
+
+  // A sequential bulk passes on the values of its predecessor. A parallel one stores them while the chunks run, and
+  // completes with the stored copies.
+  template <class _Shape, class _Fn, bool _Parallel>
+  struct __transform_completion
+  {
+    template <class... _Ts>
+    using __value_completion = completion_signatures<
+      _CUDA_VSTD::conditional_t<_Parallel, set_value_t(__decay_t<_Ts>...), set_value_t(_Ts...)>>;
+
+    template <class... _Ts>
+    using __call = _CUDA_VSTD::conditional_t<
+      __bulk::__callable_with<_Chunked, _Fn, _Shape, _CUDA_VSTD::conditional_t<_Parallel, __decay_t<_Ts>, _Ts>...>,
+      __concat_completion_signatures<
+        __value_completion<_Ts...>,
+        __eptr_completion_unless<
+          __bulk::__nothrow_callable_with<_Chunked,
+                                          _Fn,
+                                          _Shape,
+                                          _CUDA_VSTD::conditional_t<_Parallel, __decay_t<_Ts>, _Ts>...>
+          && (!_Parallel || __nothrow_decay_copyable<_Ts...>)>>,
+      __error_not_callable<_Fn, _Shape, _Ts...>>;
+  };
+
+  template <class _CvSndr, class _Rcvr, class _Shape, class _Fn, bool _Parallel>
+  using __completions =
+    __gather_completion_signatures<completion_signatures_of_t<_CvSndr, _Rcvr>,
+                                   set_value_t,
+                                   __transform_completion<_Shape, _Fn, _Parallel>::template __call,
+                                   __default_completions,
+                                   __type_try_quote<__concat_completion_signatures>::__call>;
+
+  template <class _Rcvr, class _CvSndr, class _Shape, class _Fn>
+  struct _CCCL_TYPE_VISIBILITY_DEFAULT __opstate_t
+  {
+    _CUDAX_API friend env_of_t<_Rcvr> get_env(const __opstate_t* __self) noexcept
+    {
+      return __async::get_env(__self->__rcvr_);
+    }
+
+    using operation_state_concept = operation_state_t;
+    using __sch_t                 = __bulk::__bulk_scheduler_t<_Shape, _CvSndr, _Rcvr>;
+
+    static constexpr bool __parallel = !_CUDA_VSTD::is_same_v<__sch_t, __bulk::__inline_bulk_scheduler>;
+
+    using completion_signatures = __completions<_CvSndr, __opstate_t*, _Shape, _Fn, __parallel>;
+
+    // What a parallel bulk keeps while its chunks run: the values of the predecessor, the functions running the chunks
+    // and completing with the type of these values, and the first exception thrown by the function.
+    struct __parallel_state_t
+    {
+      using __values_t = __value_types<completion_signatures_of_t<_CvSndr, __opstate_t*>, __decayed_tuple, __variant>;
+
+      __values_t __values_{};
+      void (*__execute_fn_)(__opstate_t*, _Shape, _Shape) noexcept = nullptr;
+      void (*__complete_fn_)(__opstate_t*) noexcept               = nullptr;
+      _CUDA_VSTD::atomic<bool> __failed_{false};
+      ::std::exception_ptr __error_{};
+    };
+
+    _Rcvr __rcvr_;
+    _Shape __shape_;
+    _Fn __fn_;
+    _CCCL_NO_UNIQUE_ADDRESS __sch_t __sch_;
+    _CCCL_NO_UNIQUE_ADDRESS _CUDA_VSTD::conditional_t<__parallel, __parallel_state_t, __ignore> __state_{};
+    connect_result_t<_CvSndr, __opstate_t*> __opstate_;
+
+    _CUDAX_API __opstate_t(_CvSndr&& __sndr, _Rcvr __rcvr, _Shape __shape, _Fn __fn)
+        : __rcvr_{static_cast<_Rcvr&&>(__rcvr)}
+        , __shape_{__bulk::__clamp_shape(__shape)}
+        , __fn_{static_cast<_Fn&&>(__fn)}
+        , __sch_{__bulk::__get_bulk_scheduler<_Shape>(__sndr, __rcvr_)}
+        , __opstate_{__async::connect(static_cast<_CvSndr&&>(__sndr), this)}
+    {}
+
+    _CUDAX_IMMOVABLE(__opstate_t);
+
+    _CUDAX_API void start() & noexcept
+    {
+      __async::start(__opstate_);
+    }
+
+    // The work interface given to the scheduler of a parallel bulk.
+    _CUDAX_API void execute(_Shape __begin, _Shape __end) noexcept
+    {
+      (*__state_.__execute_fn_)(this, __begin, __end);
+    }
+
+    _CUDAX_API void complete() noexcept
+    {
+      (*__state_.__complete_fn_)(this);
+    }
+
+    template <class... _Ts>
+    _CUDAX_API void set_value(_Ts&&... __ts) noexcept
+    {
+      if constexpr (__parallel)
+      {
+        __set_value_parallel(static_cast<_Ts&&>(__ts)...);
+      }
+      else if constexpr (__bulk::__nothrow_callable_with<_Chunked, _Fn, _Shape, _Ts...>)
+      {
+        __bulk::__run_chunk<_Chunked>(__fn_, _Shape(0), __shape_, __ts...);
+        __async::set_value(static_cast<_Rcvr&&>(__rcvr_), static_cast<_Ts&&>(__ts)...);
+      }
+      else
+      {
+        bool __ok = false;
+        _CUDAX_TRY( //
+          ({ //
+            __bulk::__run_chunk<_Chunked>(__fn_, _Shape(0), __shape_, __ts...);
+            __ok = true;
+          }), //
+          _CUDAX_CATCH(...)( //
+            { //
+              __async::set_error(static_cast<_Rcvr&&>(__rcvr_), ::std::current_exception());
+            }))
+        if (__ok)
+        {
+          __async::set_value(static_cast<_Rcvr&&>(__rcvr_), static_cast<_Ts&&>(__ts)...);
+        }
+      }
+    }
+
+    template <class _Error>
+    _CUDAX_API void set_error(_Error&& __error) noexcept
+    {
+      __async::set_error(static_cast<_Rcvr&&>(__rcvr_), static_cast<_Error&&>(__error));
+    }
+
+    _CUDAX_API void set_stopped() noexcept
+    {
+      __async::set_stopped(static_cast<_Rcvr&&>(__rcvr_));
+    }
+
+  private:
+    template <class... _Ts>
+    _CUDAX_API void __set_value_parallel(_Ts&&... __ts) noexcept
+    {
+      using __tupl_t = __decayed_tuple<_Ts...>;
+      if constexpr (__nothrow_decay_copyable<_Ts...>)
+      {
+        __state_.__values_.template __emplace<__tupl_t>(static_cast<_Ts&&>(__ts)...);
+      }
+      else
+      {
+        bool __ok = false;
+        _CUDAX_TRY( //
+          ({ //
+            __state_.__values_.template __emplace<__tupl_t>(static_cast<_Ts&&>(__ts)...);
+            __ok = true;
+          }),
+          _CUDAX_CATCH(...)( //
+            { //
+              __async::set_error(static_cast<_Rcvr&&>(__rcvr_), ::std::current_exception());
+            }))
+        if (!__ok)
+        {
+          return;
+        }
+      }
+
+      __state_.__execute_fn_  = &__execute_impl<__tupl_t>;
+      __state_.__complete_fn_ = &__complete_impl<__tupl_t>;
+      __sch_.bulk_execute(__shape_, *this);
+    }
+
+    template <class _Tupl>
+    _CUDAX_API static void __execute_impl(__opstate_t* __self, _Shape __begin, _Shape __end) noexcept
+    {
+      // once a chunk has failed, the others are skipped
+      if (__self->__state_.__failed_.load(_CUDA_VSTD::memory_order_relaxed))
+      {
+        return;
+      }
+
+      auto& __tupl = *static_cast<_Tupl*>(__self->__state_.__values_.__ptr());
+      auto __run   = [&](auto&... __vs) {
+        __bulk::__run_chunk<_Chunked>(__self->__fn_, __begin, __end, __vs...);
+      };
+      _CUDAX_TRY( //
+        ({ //
+          __tupl.__apply(__run, __tupl);
+        }),
+        _CUDAX_CATCH(...)( //
+          { //
+            if (!__self->__state_.__failed_.exchange(true, _CUDA_VSTD::memory_order_relaxed))
+            {
+              __self->__state_.__error_ = ::std::current_exception();
+            }
+          }))
+    }
+
+    template <class _Tupl>
+    _CUDAX_API static void __complete_impl(__opstate_t* __self) noexcept
+    {
+      // the scheduler calls complete after all the chunks have run, so the error of a failed chunk is visible here
+      if (__self->__state_.__failed_.load(_CUDA_VSTD::memory_order_relaxed))
+      {
+        __async::set_error(static_cast<_Rcvr&&>(__self->__rcvr_),
+                           static_cast<::std::exception_ptr&&>(__self->__state_.__error_));
+      }
+      else
+      {
+        auto& __tupl = *static_cast<_Tupl*>(__self->__state_.__values_.__ptr());
+        __tupl.__apply(__async::set_value, static_cast<_Tupl&&>(__tupl), static_cast<_Rcvr&&>(__self->__rcvr_));
+      }
+    }
+  };
+
+  template <class _Shape, class _Fn, class _Sndr>
+  struct _CCCL_TYPE_VISIBILITY_DEFAULT __sndr_t
+  {
+    using sender_concept = sender_t;
+    _CCCL_NO_UNIQUE_ADDRESS _BulkTag __tag_;
+    _Shape __shape_;
+    _Fn __fn_;
+    _Sndr __sndr_;
+
+    template <class _Rcvr>
+    _CUDAX_API auto connect(_Rcvr __rcvr) && //
+      -> __opstate_t<_Rcvr, _Sndr, _Shape, _Fn>
+    {
+      return __opstate_t<_Rcvr, _Sndr, _Shape, _Fn>{
+        static_cast<_Sndr&&>(__sndr_), static_cast<_Rcvr&&>(__rcvr), __shape_, static_cast<_Fn&&>(__fn_)};
+    }
+
+    template <class _Rcvr>
+    _CUDAX_API auto connect(_Rcvr __rcvr) const& //
+      -> __opstate_t<_Rcvr, const _Sndr&, _Shape, _Fn>
+    {
+      return __opstate_t<_Rcvr, const _Sndr&, _Shape, _Fn>{__sndr_, static_cast<_Rcvr&&>(__rcvr), __shape_, __fn_};
+    }
+
+    _CUDAX_API env_of_t<_Sndr> get_env() const noexcept
+    {
+      return __async::get_env(__sndr_);
+    }
+  };
+
+  template <class _Shape, class _Fn>
+  struct __closure_t
+  {
+    _Shape __shape_;
+    _Fn __fn_;
+
+    template <class _Sndr>
+    _CUDAX_TRIVIAL_API auto operator()(_Sndr __sndr) -> __call_result_t<_BulkTag, _Sndr, _Shape, _Fn>
+    {
+      return _BulkTag()(static_cast<_Sndr&&>(__sndr), __shape_, static_cast<_Fn&&>(__fn_));
+    }
+
+    template <class _Sndr>
+    _CUDAX_TRIVIAL_API friend auto operator|(_Sndr __sndr, __closure_t&& __self) //
+      -> __call_result_t<_BulkTag, _Sndr, _Shape, _Fn>
+    {
+      return _BulkTag()(static_cast<_Sndr&&>(__sndr), __self.__shape_, static_cast<_Fn&&>(__self.__fn_));
+    }
+  };
+
+public:
+  template <class _Sndr, class _Shape, class _Fn>
+  _CUDAX_TRIVIAL_API auto operator()(_Sndr __sndr, _Shape __shape, _Fn __fn) const noexcept //
+    -> __sndr_t<_Shape, _Fn, _Sndr>
+  {
+    static_assert(_CUDA_VSTD::is_integral_v<_Shape>, "the shape of bulk must be an integral type");
+    return __sndr_t<_Shape, _Fn, _Sndr>{{}, __shape, static_cast<_Fn&&>(__fn), static_cast<_Sndr&&>(__sndr)};
+  }
+
+  template <class _Shape, class _Fn>
+  _CUDAX_TRIVIAL_API auto operator()(_Shape __shape, _Fn __fn) const noexcept
+  {
+    return __closure_t<_Shape, _Fn>{__shape, static_cast<_Fn&&>(__fn)};
+  }
+};
+
+//! bulk(sndr, shape, fn) calls fn(i, values...) for each i in [0, shape) with the values sndr completes with, then
+//! completes with these values. It runs sequentially on the thread sndr completes on, unless a scheduler customizes it
+//! by providing bulk_execute, in which case the indices may be processed concurrently.
+_CCCL_GLOBAL_CONSTANT struct bulk_t : __bulk_t<false>
+{
+} bulk{};
+
+//! bulk_chunked(sndr, shape, fn) is like bulk, but calls fn(begin, end, values...) for chunks [begin, end) which
+//! partition [0, shape), which lets fn amortize work across the indices of a chunk. Sequentially, the whole index space
+//! is a single chunk.
+_CCCL_GLOBAL_CONSTANT struct bulk_chunked_t : __bulk_t<true>
+{
+} bulk_chunked{};
+} // namespace cuda::experimental::__async
+
+#include <cuda/experimental/__async/sender/epilogue.cuh>
+
+#endif
@@ -45,7 +45,7 @@ struct __rcvr_with_env_t : _Rcvr
 
   _CUDAX_TRIVIAL_API auto get_env() const noexcept -> __env_t
   {
-    return __env_t{*this};
+    return *this;
   }
 
   template <class _Query>
@@ -104,7 +104,7 @@ struct __rcvr_with_env_t<_Rcvr*, _Env>
 
   _CUDAX_TRIVIAL_API auto get_env() const noexcept -> __env_t
   {
-    return __env_t{*this};
+    return *this;
   }
 
   template <class _Query>
@@ -0,0 +1,382 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of CUDA Experimental in CUDA C++ Core Libraries,
+// under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef __CUDAX_ASYNC_DETAIL_SPLIT
+#define __CUDAX_ASYNC_DETAIL_SPLIT
+
+#include <cuda/std/detail/__config>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <cuda/std/atomic>
+
+#include <cuda/experimental/__async/sender/completion_signatures.cuh>
+#include <cuda/experimental/__async/sender/cpos.cuh>
+#include <cuda/experimental/__async/sender/exception.cuh>
+#include <cuda/experimental/__async/sender/meta.cuh>
+#include <cuda/experimental/__async/sender/tuple.cuh>
+#include <cuda/experimental/__async/sender/utility.cuh>
+#include <cuda/experimental/__async/sender/variant.cuh>
+
+#include <cuda/experimental/__async/sender/prologue.cuh>
+
+namespace cuda::experimental::__async
+{
+// Forward-declare the split and ensure_started algorithm tag types:
+struct split_t;
+struct ensure_started_t;
+
+namespace __shared
+{
+// An operation waiting for the result of a shared computation.
+struct __waiter_t
+{
+  __waiter_t* __next_{nullptr};
+  void (*__notify_)(__waiter_t*) noexcept {nullptr};
+};
+
+template <class... _As>
+using __value_sig_t = completion_signatures<set_value_t(const __decay_t<_As>&...)>;
+
+template <class _Error>
+using __error_sig_t = completion_signatures<set_error_t(const __decay_t<_Error>&)>;
+
+template <class... _As>
+using __value_tuple_t = __tuple<set_value_t, __decay_t<_As>...>;
+
+template <class _Error>
+using __error_tuple_t = __tuple<set_error_t, __decay_t<_Error>>;
+
+using __stopped_tuple_t = __tuple<set_stopped_t>;
+
+template <class _Sndr>
+struct __state_t;
+
+template <class _Sndr>
+struct _CCCL_TYPE_VISIBILITY_DEFAULT __rcvr_t
+{
+  using receiver_concept = receiver_t;
+  __state_t<_Sndr>* __state_;
+
+  template <class... _As>
+  _CUDAX_API void set_value(_As&&... __as) && noexcept
+  {
+    __state_->__complete(set_value_t(), static_cast<_As&&>(__as)...);
+  }
+
+  template <class _Error>
+  _CUDAX_API void set_error(_Error&& __error) && noexcept
+  {
+    __state_->__complete(set_error_t(), static_cast<_Error&&>(__error));
+  }
+
+  _CUDAX_API void set_stopped() && noexcept
+  {
+    __state_->__complete(set_stopped_t());
+  }
+};
+
+// The state shared by the copies of a split or ensure_started sender and the operations connected to them. It is
+// reference counted: each sender and operation holds a reference, and so does the shared computation while it runs.
+// Waiters register themselves on a lock-free stack, which the completion of the computation swaps for a sentinel; a
+// waiter that finds the sentinel completes right away with the stored result.
+template <class _Sndr>
+struct __state_t
+{
+  using __upstream_completions_t = completion_signatures_of_t<_Sndr, __rcvr_t<_Sndr>>;
+
+  static constexpr bool __nothrow_store =
+    __partitioned_completions_of<__upstream_completions_t>::__nothrow_decay_copyable::__all::value;
+
+  // The result is sent to every waiter as const lvalues.
+  using __completions_t =
+    transform_completion_signatures<__upstream_completions_t,
+                                    __eptr_completion_unless<__nothrow_store>,
+                                    __value_sig_t,
+                                    __error_sig_t>;
+
+  using __result_t =
+    __transform_completion_signatures<__completions_t, __value_tuple_t, __error_tuple_t, __stopped_tuple_t, __variant>;
+
+  _CUDAX_API explicit __state_t(_Sndr&& __sndr)
+      : __opstate_{__async::connect(static_cast<_Sndr&&>(__sndr), __rcvr_t<_Sndr>{this})}
+  {}
+
+  _CUDAX_IMMOVABLE(__state_t);
+
+  _CUDAX_API void __add_ref() noexcept
+  {
+    __refs_.fetch_add(1, _CUDA_VSTD::memory_order_relaxed);
+  }
+
+  _CUDAX_API void __release() noexcept
+  {
+    if (__refs_.fetch_sub(1, _CUDA_VSTD::memory_order_acq_rel) == 1)
+    {
+      delete this;
+    }
+  }
+
+  // Starts the computation, unless it has already been started.
+  _CUDAX_API void __start() noexcept
+  {
+    if (!__started_.exchange(true, _CUDA_VSTD::memory_order_relaxed))
+    {
+      __add_ref();
+      __async::start(__opstate_);
+    }
+  }
+
+  // Registers a waiter, or notifies it right away if the computation has completed.
+  _CUDAX_API void __wait(__waiter_t* __waiter) noexcept
+  {
+    __waiter_t* __head = __waiters_.load(_CUDA_VSTD::memory_order_acquire);
+    do
+    {
+      if (__head == &__done_)
+      {
+        __waiter->__notify_(__waiter);
+        return;
+      }
+      __waiter->__next_ = __head;
+    } while (!__waiters_.compare_exchange_weak(
+      __head, __waiter, _CUDA_VSTD::memory_order_release, _CUDA_VSTD::memory_order_acquire));
+  }
+
+  template <class _Tag, class... _As>
+  _CUDAX_API void __complete(_Tag, _As&&... __as) noexcept
+  {
+    using __tupl_t = __tuple<_Tag, __decay_t<_As>...>;
+    if constexpr (__nothrow_decay_copyable<_As...>)
+    {
+      __result_.template __emplace<__tupl_t>(_Tag(), static_cast<_As&&>(__as)...);
+    }
+    else
+    {
+      _CUDAX_TRY( //
+        ({ //
+          __result_.template __emplace<__tupl_t>(_Tag(), static_cast<_As&&>(__as)...);
+        }),
+        _CUDAX_CATCH(...)( //
+          { //
+            __result_.template __emplace<__error_tuple_t<::std::exception_ptr>>(
+              set_error_t(), ::std::current_exception());
+          }))
+    }
+
+    // take the waiters, notifying them in the order they registered
+    __waiter_t* __head = __waiters_.exchange(&__done_, _CUDA_VSTD::memory_order_acq_rel);
+    __waiter_t* __fifo = nullptr;
+    while (__head != nullptr)
+    {
+      __waiter_t* __next = __async::__exchange(__head->__next_, __fifo);
+      __fifo             = __head;
+      __head             = __next;
+    }
+    while (__fifo != nullptr)
+    {
+      // a notified waiter may be destroyed right away
+      __waiter_t* __next = __fifo->__next_;
+      __fifo->__notify_(__fifo);
+      __fifo = __next;
+    }
+
+    __release();
+  }
+
+  __result_t __result_{};
+  _CUDA_VSTD::atomic<::std::size_t> __refs_{1};
+  _CUDA_VSTD::atomic<bool> __started_{false};
+  _CUDA_VSTD::atomic<__waiter_t*> __waiters_{nullptr};
+  __waiter_t __done_{};
+  connect_result_t<_Sndr, __rcvr_t<_Sndr>> __opstate_;
+};
+
+template <class _Rcvr>
+struct __complete_fn
+{
+  _Rcvr& __rcvr_;
+
+  template <class _Tag, class... _As>
+  _CUDAX_API void operator()(_Tag, const _As&... __as) const noexcept
+  {
+    _Tag()(static_cast<_Rcvr&&>(__rcvr_), __as...);
+  }
+};
+} // namespace __shared
+
+template <bool _Eager>
+struct __shared_t
+{
+#if !_CCCL_CUDA_COMPILER(NVCC)
+
+private:
+#endif // !_CCCL_CUDA_COMPILER(NVCC)
+
+  using _SharedTag = _CUDA_VSTD::conditional_t<_Eager, ensure_started_t, split_t>;
+
+  template <class _Sndr, class _Rcvr>
+  struct _CCCL_TYPE_VISIBILITY_DEFAULT __opstate_t : __shared::__waiter_t
+  {
+    using operation_state_concept = operation_state_t;
+    using completion_signatures   = typename __shared::__state_t<_Sndr>::__completions_t;
+
+    // takes over a reference on the state
+    _CUDAX_API __opstate_t(__shared::__state_t<_Sndr>* __state, _Rcvr __rcvr) noexcept
+        : __shared::__waiter_t{nullptr, &__notify}
+        , __rcvr_{static_cast<_Rcvr&&>(__rcvr)}
+        , __state_{__state}
+    {}
+
+    _CUDAX_IMMOVABLE(__opstate_t);
+
+    _CUDAX_API ~__opstate_t()
+    {
+      __state_->__release();
+    }
+
+    _CUDAX_API void start() & noexcept
+    {
+      // Once registered, this operation may be notified and destroyed at any time, together with the last reference on
+      // the state, so the computation is started first.
+      if constexpr (!_Eager)
+      {
+        __state_->__start();
+      }
+      __state_->__wait(this);
+    }
+
+    _CUDAX_API static void __notify(__shared::__waiter_t* __waiter) noexcept
+    {
+      auto* __self = static_cast<__opstate_t*>(__waiter);
+      const auto& __result = __self->__state_->__result_;
+      __result.__visit(
+        [__self](const auto& __tupl) noexcept {
+          __tupl.__apply(__shared::__complete_fn<_Rcvr>{__self->__rcvr_}, __tupl);
+        },
+        __result);
+    }
+
+    _Rcvr __rcvr_;
+    __shared::__state_t<_Sndr>* __state_;
+  };
+
+  template <class _Sndr>
+  struct _CCCL_TYPE_VISIBILITY_DEFAULT __sndr_t
+  {
+    using sender_concept = sender_t;
+    _CCCL_NO_UNIQUE_ADDRESS _SharedTag __tag_;
+    __shared::__state_t<_Sndr>* __state_;
+
+    _CUDAX_API explicit __sndr_t(__shared::__state_t<_Sndr>* __state) noexcept
+        : __tag_{}
+        , __state_{__state}
+    {}
+
+    _CUDAX_API __sndr_t(__sndr_t&& __other) noexcept
+        : __tag_{}
+        , __state_{__async::__exchange(__other.__state_, nullptr)}
+    {}
+
+    _CUDAX_API __sndr_t(const __sndr_t& __other) noexcept
+        : __tag_{}
+        , __state_{__other.__state_}
+    {
+      if (__state_ != nullptr)
+      {
+        __state_->__add_ref();
+      }
+    }
+
+    _CUDAX_API __sndr_t& operator=(__sndr_t __other) noexcept
+    {
+      __async::__swap(__state_, __other.__state_);
+      return *this;
+    }
+
+    _CUDAX_API ~__sndr_t()
+    {
+      if (__state_ != nullptr)
+      {
+        __state_->__release();
+      }
+    }
+
+    template <class _Rcvr>
+    _CUDAX_API auto connect(_Rcvr __rcvr) && noexcept -> __opstate_t<_Sndr, _Rcvr>
+    {
+      _CCCL_ASSERT(__state_ != nullptr, "connecting a moved-from split or ensure_started sender");
+      return __opstate_t<_Sndr, _Rcvr>{__async::__exchange(__state_, nullptr), static_cast<_Rcvr&&>(__rcvr)};
+    }
+
+    template <class _Rcvr>
+    _CUDAX_API auto connect(_Rcvr __rcvr) const& noexcept -> __opstate_t<_Sndr, _Rcvr>
+    {
+      _CCCL_ASSERT(__state_ != nullptr, "connecting a moved-from split or ensure_started sender");
+      __state_->__add_ref();
+      return __opstate_t<_Sndr, _Rcvr>{__state_, static_cast<_Rcvr&&>(__rcvr)};
+    }
+  };
+
+  template <class _Sndr>
+  _CUDAX_API static auto __make_sender(_Sndr __sndr) -> __sndr_t<_Sndr>
+  {
+    auto* __state = new __shared::__state_t<_Sndr>{static_cast<_Sndr&&>(__sndr)};
+    if constexpr (_Eager)
+    {
+      __state->__start();
+    }
+    return __sndr_t<_Sndr>{__state};
+  }
+
+  struct __closure_t
+  {
+    template <class _Sndr>
+    _CUDAX_TRIVIAL_API friend auto operator|(_Sndr __sndr, __closure_t) -> __sndr_t<_Sndr>
+    {
+      return __shared_t{}(static_cast<_Sndr&&>(__sndr));
+    }
+  };
+
+public:
+  template <class _Sndr>
+  _CUDAX_TRIVIAL_API auto operator()(_Sndr __sndr) const -> __sndr_t<_Sndr>
+  {
+    return __make_sender(static_cast<_Sndr&&>(__sndr));
+  }
+
+  _CUDAX_TRIVIAL_API auto operator()() const noexcept -> __closure_t
+  {
+    return __closure_t{};
+  }
+};
+
+//! split(sndr) returns a copyable sender whose copies share one computation of sndr. The computation starts when the
+//! first operation connected to a copy is started, and its result is sent to every operation as const lvalues.
+_CCCL_GLOBAL_CONSTANT struct split_t : __shared_t<false>
+{
+} split{};
+
+//! ensure_started(sndr) is like split, but starts the computation of sndr right away. The computation runs to
+//! completion even if the returned sender is discarded.
+_CCCL_GLOBAL_CONSTANT struct ensure_started_t : __shared_t<true>
+{
+} ensure_started{};
+} // namespace cuda::experimental::__async
+
+#include <cuda/experimental/__async/sender/epilogue.cuh>
+
+#endif
@@ -0,0 +1,636 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of CUDA Experimental in CUDA C++ Core Libraries,
+// under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef __CUDAX_ASYNC_DETAIL_STATIC_THREAD_POOL
+#define __CUDAX_ASYNC_DETAIL_STATIC_THREAD_POOL
+
+#include <cuda/std/detail/__config>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <cuda/experimental/__detail/config.cuh>
+
+// libcu++ does not have <cuda/std/thread>
+#if !defined(__CUDA_ARCH__)
+
+#  include <cuda/std/atomic>
+#  include <cuda/std/cstdint>
+
+#  include <cuda/experimental/__async/sender/completion_signatures.cuh>
+#  include <cuda/experimental/__async/sender/env.cuh>
+#  include <cuda/experimental/__async/sender/exception.cuh>
+#  include <cuda/experimental/__async/sender/queries.cuh>
+#  include <cuda/experimental/__async/sender/run_loop.cuh>
+#  include <cuda/experimental/__async/sender/utility.cuh>
+
+#  include <algorithm>
+#  include <memory>
+#  include <thread>
+#  include <vector>
+
+#  include <cuda/experimental/__async/sender/prologue.cuh>
+
+namespace cuda::experimental::__async
+{
+class static_thread_pool;
+
+// A Chase-Lev work-stealing deque of tasks. The owning worker pushes and pops at the bottom, other workers steal from
+// the top. Rings outgrown by the deque are kept alive until it is destroyed, since thieves may still be reading them.
+class __work_stealing_deque
+{
+  struct __ring
+  {
+    _CUDAX_API explicit __ring(_CUDA_VSTD::int64_t __capacity)
+        : __mask_{__capacity - 1}
+        , __slots_{new _CUDA_VSTD::atomic<__task*>[static_cast<size_t>(__capacity)]}
+    {}
+
+    _CUDAX_API auto __get(_CUDA_VSTD::int64_t __i) const noexcept -> __task*
+    {
+      return __slots_[static_cast<size_t>(__i & __mask_)].load(_CUDA_VSTD::memory_order_relaxed);
+    }
+
+    _CUDAX_API void __put(_CUDA_VSTD::int64_t __i, __task* __tsk) noexcept
+    {
+      __slots_[static_cast<size_t>(__i & __mask_)].store(__tsk, _CUDA_VSTD::memory_order_relaxed);
+    }
+
+    const _CUDA_VSTD::int64_t __mask_;
+    ::std::unique_ptr<_CUDA_VSTD::atomic<__task*>[]> __slots_;
+  };
+
+  static constexpr _CUDA_VSTD::int64_t __initial_capacity = 256;
+
+public:
+  __work_stealing_deque()
+  {
+    __rings_.emplace_back(new __ring{__initial_capacity});
+    __ring_.store(__rings_.back().get(), _CUDA_VSTD::memory_order_relaxed);
+  }
+
+  // Called by the owner only. May throw if the deque has to grow.
+  _CUDAX_API void __push(__task* __tsk)
+  {
+    const _CUDA_VSTD::int64_t __bottom = __bottom_.load(_CUDA_VSTD::memory_order_relaxed);
+    const _CUDA_VSTD::int64_t __top    = __top_.load(_CUDA_VSTD::memory_order_acquire);
+    __ring* __rng                      = __ring_.load(_CUDA_VSTD::memory_order_relaxed);
+
+    if (__bottom - __top > __rng->__mask_)
+    {
+      __rng = __grow(__rng, __top, __bottom);
+    }
+
+    __rng->__put(__bottom, __tsk);
+    __bottom_.store(__bottom + 1, _CUDA_VSTD::memory_order_release);
+  }
+
+  // Called by the owner only. Returns the most recently pushed task, or nullptr if the deque is empty.
+  _CUDAX_API auto __pop() noexcept -> __task*
+  {
+    const _CUDA_VSTD::int64_t __bottom = __bottom_.load(_CUDA_VSTD::memory_order_relaxed) - 1;
+    __ring* __rng                      = __ring_.load(_CUDA_VSTD::memory_order_relaxed);
+    __bottom_.store(__bottom, _CUDA_VSTD::memory_order_seq_cst);
+    _CUDA_VSTD::int64_t __top = __top_.load(_CUDA_VSTD::memory_order_seq_cst);
+
+    if (__top > __bottom)
+    {
+      __bottom_.store(__bottom + 1, _CUDA_VSTD::memory_order_relaxed);
+      return nullptr;
+    }
+
+    __task* __tsk = __rng->__get(__bottom);
+    if (__top == __bottom)
+    {
+      // the last task; race the thieves for it
+      if (!__top_.compare_exchange_strong(
+            __top, __top + 1, _CUDA_VSTD::memory_order_seq_cst, _CUDA_VSTD::memory_order_relaxed))
+      {
+        __tsk = nullptr;
+      }
+      __bottom_.store(__bottom + 1, _CUDA_VSTD::memory_order_relaxed);
+    }
+    return __tsk;
+  }
+
+  // Called by any thread. Returns the least recently pushed task, or nullptr if the deque is empty.
+  _CUDAX_API auto __steal() noexcept -> __task*
+  {
+    _CUDA_VSTD::int64_t __top = __top_.load(_CUDA_VSTD::memory_order_seq_cst);
+    for (;;)
+    {
+      const _CUDA_VSTD::int64_t __bottom = __bottom_.load(_CUDA_VSTD::memory_order_seq_cst);
+      if (__top >= __bottom)
+      {
+        return nullptr;
+      }
+
+      __task* __tsk = __ring_.load(_CUDA_VSTD::memory_order_acquire)->__get(__top);
+      if (__top_.compare_exchange_strong(
+            __top, __top + 1, _CUDA_VSTD::memory_order_seq_cst, _CUDA_VSTD::memory_order_seq_cst))
+      {
+        return __tsk;
+      }
+      // another thread took the task at the top; __top has been reloaded, try the next one
+    }
+  }
+
+  _CUDAX_API auto __empty() const noexcept -> bool
+  {
+    return __bottom_.load(_CUDA_VSTD::memory_order_seq_cst) <= __top_.load(_CUDA_VSTD::memory_order_seq_cst);
+  }
+
+private:
+  _CUDAX_API auto __grow(__ring* __old, _CUDA_VSTD::int64_t __top, _CUDA_VSTD::int64_t __bottom) -> __ring*
+  {
+    __rings_.emplace_back(new __ring{2 * (__old->__mask_ + 1)});
+    __ring* __new = __rings_.back().get();
+    for (_CUDA_VSTD::int64_t __i = __top; __i < __bottom; ++__i)
+    {
+      __new->__put(__i, __old->__get(__i));
+    }
+    __ring_.store(__new, _CUDA_VSTD::memory_order_release);
+    return __new;
+  }
+
+  alignas(64) _CUDA_VSTD::atomic<_CUDA_VSTD::int64_t> __top_{0};
+  alignas(64) _CUDA_VSTD::atomic<_CUDA_VSTD::int64_t> __bottom_{0};
+  _CUDA_VSTD::atomic<__ring*> __ring_{nullptr};
+  ::std::vector<::std::unique_ptr<__ring>> __rings_;
+};
+
+template <class _Rcvr>
+struct __pool_operation;
+
+template <class _Shape, class _Work>
+struct __pool_bulk_state;
+
+//! A pool of a fixed number of threads executing the work scheduled on it. Every thread owns a deque of tasks: work
+//! scheduled from one of the threads of the pool goes to the deque of that thread, work scheduled from any other
+//! thread goes to a lock-free submission stack shared by the pool. Threads that run out of work take the submitted
+//! tasks, then steal from the deques of the other threads, and go to sleep when there is nothing to steal.
+class _CCCL_TYPE_VISIBILITY_DEFAULT static_thread_pool
+{
+  template <class>
+  friend struct __pool_operation;
+
+  template <class, class>
+  friend struct __pool_bulk_state;
+
+  struct __worker
+  {
+    static_thread_pool* __pool_;
+    ::std::size_t __index_;
+    __work_stealing_deque __deque_{};
+    ::std::thread __thrd_{};
+  };
+
+public:
+  explicit static_thread_pool(::std::size_t __thread_count = ::std::thread::hardware_concurrency())
+      : __thread_count_{__thread_count == 0 ? 1 : __thread_count}
+      , __workers_{new __worker[__thread_count_]}
+  {
+    for (::std::size_t __i = 0; __i < __thread_count_; ++__i)
+    {
+      __workers_[__i].__pool_  = this;
+      __workers_[__i].__index_ = __i;
+    }
+    for (::std::size_t __i = 0; __i < __thread_count_; ++__i)
+    {
+      __workers_[__i].__thrd_ = ::std::thread{[this, __i] {
+        __run(__i);
+      }};
+    }
+  }
+
+  ~static_thread_pool() noexcept
+  {
+    join();
+  }
+
+  //! Waits for all the scheduled work to complete and stops the threads of the pool.
+  void join() noexcept
+  {
+    __stop_.store(true, _CUDA_VSTD::memory_order_seq_cst);
+    __wake_all();
+    for (::std::size_t __i = 0; __i < __thread_count_; ++__i)
+    {
+      if (__workers_[__i].__thrd_.joinable())
+      {
+        __workers_[__i].__thrd_.join();
+      }
+    }
+  }
+
+  _CUDAX_API auto thread_count() const noexcept -> ::std::size_t
+  {
+    return __thread_count_;
+  }
+
+  class __scheduler
+  {
+    struct __schedule_task
+    {
+      using __t            = __schedule_task;
+      using __id           = __schedule_task;
+      using sender_concept = sender_t;
+
+      template <class _Rcvr>
+      _CUDAX_API auto connect(_Rcvr __rcvr) const noexcept -> __pool_operation<_Rcvr>
+      {
+        return {__pool_, static_cast<_Rcvr&&>(__rcvr)};
+      }
+
+    private:
+      friend __scheduler;
+
+      struct __env
+      {
+        static_thread_pool* __pool_;
+
+        template <class _Tag>
+        _CUDAX_API auto query(get_completion_scheduler_t<_Tag>) const noexcept -> __scheduler
+        {
+          return __pool_->get_scheduler();
+        }
+      };
+
+      _CUDAX_API auto get_env() const noexcept -> __env
+      {
+        return __env{__pool_};
+      }
+
+      _CUDAX_API explicit __schedule_task(static_thread_pool* __pool) noexcept
+          : __pool_(__pool)
+      {}
+
+      static_thread_pool* const __pool_;
+    };
+
+    friend static_thread_pool;
+
+    _CUDAX_API explicit __scheduler(static_thread_pool* __pool) noexcept
+        : __pool_(__pool)
+    {}
+
+    static_thread_pool* __pool_;
+
+  public:
+    using scheduler_concept = scheduler_t;
+
+    [[nodiscard]] _CUDAX_API auto schedule() const noexcept -> __schedule_task
+    {
+      return __schedule_task{__pool_};
+    }
+
+    _CUDAX_API auto query(get_forward_progress_guarantee_t) const noexcept -> forward_progress_guarantee
+    {
+      return forward_progress_guarantee::parallel;
+    }
+
+    //! Customizes bulk and bulk_chunked: the chunks of [0, shape) are run by the threads of the pool together with the
+    //! calling thread, and the last thread to finish one completes the work.
+    template <class _Shape, class _Work>
+    _CUDAX_API void bulk_execute(_Shape __shape, _Work& __work) const noexcept
+    {
+      __pool_->__bulk_execute(__shape, __work);
+    }
+
+    _CUDAX_API friend bool operator==(const __scheduler& __a, const __scheduler& __b) noexcept
+    {
+      return __a.__pool_ == __b.__pool_;
+    }
+
+    _CUDAX_API friend bool operator!=(const __scheduler& __a, const __scheduler& __b) noexcept
+    {
+      return __a.__pool_ != __b.__pool_;
+    }
+  };
+
+  _CUDAX_API auto get_scheduler() noexcept -> __scheduler
+  {
+    return __scheduler{this};
+  }
+
+private:
+  template <class _Shape, class _Work>
+  _CUDAX_API void __bulk_execute(_Shape __shape, _Work& __work) noexcept;
+
+  // the worker running on the calling thread, if any
+  static __worker*& __current_worker() noexcept
+  {
+    static thread_local __worker* __current = nullptr;
+    return __current;
+  }
+
+  _CUDAX_API void __submit(__task* __tsk)
+  {
+    __worker* __current = __current_worker();
+    if (__current != nullptr && __current->__pool_ == this)
+    {
+      __current->__deque_.__push(__tsk);
+    }
+    else
+    {
+      __task* __head = __submitted_.load(_CUDA_VSTD::memory_order_relaxed);
+      do
+      {
+        __tsk->__next_ = __head;
+      } while (!__submitted_.compare_exchange_weak(
+        __head, __tsk, _CUDA_VSTD::memory_order_seq_cst, _CUDA_VSTD::memory_order_relaxed));
+    }
+
+    __wake_one();
+  }
+
+  // Moves the submitted tasks to the deque of the worker, oldest at the bottom so that the worker runs them first.
+  _CUDAX_API auto __take_submitted(__worker& __self) noexcept -> __task*
+  {
+    if (__submitted_.load(_CUDA_VSTD::memory_order_relaxed) == nullptr)
+    {
+      return nullptr;
+    }
+
+    __task* __head = __submitted_.exchange(nullptr, _CUDA_VSTD::memory_order_seq_cst);
+    if (__head == nullptr)
+    {
+      return nullptr;
+    }
+
+    // the submission stack holds the most recent task first; keep the oldest one to run right away
+    for (; __head->__next_ != nullptr; __head = __head->__next_)
+    {
+      __self.__deque_.__push(__head);
+    }
+    return __head;
+  }
+
+  _CUDAX_API auto __find_task(__worker& __self) noexcept -> __task*
+  {
+    if (__task* __tsk = __self.__deque_.__pop())
+    {
+      return __tsk;
+    }
+
+    if (__task* __tsk = __take_submitted(__self))
+    {
+      return __tsk;
+    }
+
+    for (::std::size_t __i = 1; __i < __thread_count_; ++__i)
+    {
+      __worker& __victim = __workers_[(__self.__index_ + __i) % __thread_count_];
+      if (__task* __tsk = __victim.__deque_.__steal())
+      {
+        return __tsk;
+      }
+    }
+
+    return nullptr;
+  }
+
+  _CUDAX_API void __run(::std::size_t __index) noexcept
+  {
+    __worker& __self    = __workers_[__index];
+    __current_worker() = &__self;
+
+    for (;;)
+    {
+      if (__task* __tsk = __find_task(__self))
+      {
+        __tsk->__execute();
+        continue;
+      }
+
+      // Announce the intent to sleep before the last look for work: a submitter either sees the sleeper and bumps the
+      // epoch after publishing its task, or published it before this look.
+      __sleepers_.fetch_add(1, _CUDA_VSTD::memory_order_seq_cst);
+      const _CUDA_VSTD::uint32_t __epoch = __epoch_.load(_CUDA_VSTD::memory_order_seq_cst);
+
+      __task* __tsk = __find_task(__self);
+      if (__tsk == nullptr)
+      {
+        if (__stop_.load(_CUDA_VSTD::memory_order_seq_cst))
+        {
+          __sleepers_.fetch_sub(1, _CUDA_VSTD::memory_order_relaxed);
+          break;
+        }
+        __epoch_.wait(__epoch, _CUDA_VSTD::memory_order_seq_cst);
+      }
+      __sleepers_.fetch_sub(1, _CUDA_VSTD::memory_order_relaxed);
+
+      if (__tsk != nullptr)
+      {
+        __tsk->__execute();
+      }
+    }
+
+    __current_worker() = nullptr;
+  }
+
+  _CUDAX_API void __wake_one() noexcept
+  {
+    __epoch_.fetch_add(1, _CUDA_VSTD::memory_order_seq_cst);
+    if (__sleepers_.load(_CUDA_VSTD::memory_order_seq_cst) != 0)
+    {
+      __epoch_.notify_one();
+    }
+  }
+
+  _CUDAX_API void __wake_all() noexcept
+  {
+    __epoch_.fetch_add(1, _CUDA_VSTD::memory_order_seq_cst);
+    __epoch_.notify_all();
+  }
+
+  const ::std::size_t __thread_count_;
+  ::std::unique_ptr<__worker[]> __workers_;
+  alignas(64) _CUDA_VSTD::atomic<__task*> __submitted_{nullptr};
+  alignas(64) _CUDA_VSTD::atomic<_CUDA_VSTD::uint32_t> __epoch_{0};
+  _CUDA_VSTD::atomic<_CUDA_VSTD::uint32_t> __sleepers_{0};
+  _CUDA_VSTD::atomic<bool> __stop_{false};
+};
+
+template <class _Rcvr>
+struct __pool_operation : __task
+{
+  static_thread_pool* __pool_;
+  _CCCL_NO_UNIQUE_ADDRESS _Rcvr __rcvr_;
+
+  using completion_signatures = //
+    __async::completion_signatures<set_value_t(), set_error_t(::std::exception_ptr), set_stopped_t()>;
+
+  _CUDAX_API static void __execute_impl(__task* __p) noexcept
+  {
+    auto& __rcvr = static_cast<__pool_operation*>(__p)->__rcvr_;
+    _CUDAX_TRY( //
+      ({ //
+        if (get_stop_token(get_env(__rcvr)).stop_requested())
+        {
+          set_stopped(static_cast<_Rcvr&&>(__rcvr));
+        }
+        else
+        {
+          set_value(static_cast<_Rcvr&&>(__rcvr));
+        }
+      }),
+      _CUDAX_CATCH(...)( //
+        { //
+          set_error(static_cast<_Rcvr&&>(__rcvr), ::std::current_exception());
+        }))
+  }
+
+  _CUDAX_API __pool_operation(static_thread_pool* __pool, _Rcvr __rcvr)
+      : __task{nullptr, &__execute_impl}
+      , __pool_{__pool}
+      , __rcvr_{static_cast<_Rcvr&&>(__rcvr)}
+  {}
+
+  _CUDAX_API void start() & noexcept
+  {
+    _CUDAX_TRY( //
+      ({ //
+        __pool_->__submit(this); //
+      }), //
+      _CUDAX_CATCH(...)( //
+        { //
+          set_error(static_cast<_Rcvr&&>(__rcvr_), ::std::current_exception()); //
+        })) //
+  }
+};
+
+// The state of a bulk operation on a static_thread_pool. The index space is cut into a few chunks per thread, which the
+// participating threads claim one at a time so that the threads that run faster take more of them. Every participant
+// holds a reference on the state, and the last one to drop it completes the work.
+template <class _Shape, class _Work>
+struct __pool_bulk_state
+{
+  struct __bulk_task : __task
+  {
+    __pool_bulk_state* __state_;
+  };
+
+  static constexpr ::std::size_t __chunks_per_thread = 4;
+
+  _CUDAX_API __pool_bulk_state(_Shape __shape, _Work& __work, ::std::size_t __thread_count)
+      : __work_{__work}
+      , __shape_{__shape}
+      , __chunk_count_{static_cast<::std::size_t>(__shape) < __thread_count * __chunks_per_thread
+                         ? __shape
+                         : static_cast<_Shape>(__thread_count * __chunks_per_thread)}
+      , __tasks_{new __bulk_task[__thread_count]}
+  {}
+
+  _CUDAX_API auto __chunk_begin(_Shape __chunk) const noexcept -> _Shape
+  {
+    const _Shape __size = __shape_ / __chunk_count_;
+    const _Shape __rest = __shape_ % __chunk_count_;
+    return __chunk * __size + (__chunk < __rest ? __chunk : __rest);
+  }
+
+  _CUDAX_API void __run() noexcept
+  {
+    for (;;)
+    {
+      const _Shape __chunk = __next_chunk_.fetch_add(1, _CUDA_VSTD::memory_order_relaxed);
+      if (__chunk >= __chunk_count_)
+      {
+        break;
+      }
+      __work_.execute(__chunk_begin(__chunk), __chunk_begin(__chunk + 1));
+    }
+
+    if (__refs_.fetch_sub(1, _CUDA_VSTD::memory_order_acq_rel) == 1)
+    {
+      _Work& __work = __work_;
+      delete this;
+      __work.complete();
+    }
+  }
+
+  _CUDAX_API static void __execute_impl(__task* __p) noexcept
+  {
+    static_cast<__bulk_task*>(__p)->__state_->__run();
+  }
+
+  _Work& __work_;
+  const _Shape __shape_;
+  const _Shape __chunk_count_;
+  _CUDA_VSTD::atomic<_Shape> __next_chunk_{0};
+  _CUDA_VSTD::atomic<::std::size_t> __refs_{1};
+  ::std::unique_ptr<__bulk_task[]> __tasks_;
+};
+
+template <class _Shape, class _Work>
+_CUDAX_API void static_thread_pool::__bulk_execute(_Shape __shape, _Work& __work) noexcept
+{
+  using __state_t = __pool_bulk_state<_Shape, _Work>;
+
+  if (__shape <= 1 || __thread_count_ == 1)
+  {
+    if (__shape > 0)
+    {
+      __work.execute(_Shape(0), __shape);
+    }
+    __work.complete();
+    return;
+  }
+
+  // if the state cannot be allocated, the calling thread runs the whole index space
+  __state_t* __state = nullptr;
+  _CUDAX_TRY( //
+    ({ //
+      __state = new __state_t{__shape, __work, __thread_count_};
+    }),
+    _CUDAX_CATCH(...)( //
+      { //
+        __work.execute(_Shape(0), __shape);
+        __work.complete();
+      }))
+  if (__state == nullptr)
+  {
+    return;
+  }
+
+  // the calling thread takes part, and one helper task per other thread is submitted; chunks left over by helpers that
+  // could not be submitted are claimed by the participants
+  const ::std::size_t __participants = (::std::min)(__thread_count_, static_cast<::std::size_t>(__state->__chunk_count_));
+  bool __submitted                   = true;
+  for (::std::size_t __i = 0; __i + 1 < __participants && __submitted; ++__i)
+  {
+    auto& __tsk         = __state->__tasks_[__i];
+    __tsk.__execute_fn_ = &__state_t::__execute_impl;
+    __tsk.__state_      = __state;
+    __state->__refs_.fetch_add(1, _CUDA_VSTD::memory_order_relaxed);
+    _CUDAX_TRY( //
+      ({ //
+        __submit(&__tsk);
+      }),
+      _CUDAX_CATCH(...)( //
+        { //
+          __state->__refs_.fetch_sub(1, _CUDA_VSTD::memory_order_relaxed);
+          __submitted = false;
+        }))
+  }
+
+  __state->__run();
+}
+} // namespace cuda::experimental::__async
+
+#  include <cuda/experimental/__async/sender/epilogue.cuh>
+
+#endif // !defined(__CUDA_ARCH__)
+
+#endif
@@ -102,13 +102,10 @@ public:
   /**
    * @brief Print information about the allocator
    *
-   * This method prints information about the allocator to stderr.
+   * This method prints information about the allocator to stderr. Allocators without any information to report print
+   * nothing.
    */
-  virtual void print_info() const
-  {
-    const auto s = to_string();
-    fprintf(stderr, "No additional info for allocator of kind \"%.*s\".\n", static_cast<int>(s.size()), s.data());
-  }
+  virtual void print_info() const {}
 };
 
 /**
@@ -153,6 +150,11 @@ public:
     return pimpl->to_string();
   }
 
+  void print_info() const
+  {
+    pimpl->print_info();
+  }
+
   explicit operator bool() const
   {
     return pimpl != nullptr;
@@ -42,6 +42,9 @@ namespace reserved
  * It does not manipulate memory at all, but returns offsets within some memory space of size "size"
  *
  * We (currently) assume that the size is a power of 2
+ *
+ * Free blocks are kept in one free list per level, indexed by the offset of the blocks, so that allocating and
+ * freeing (including coalescing with the buddies) take O(log(size)) operations regardless of fragmentation.
  */
 class buddy_allocator_metadata
 {
@@ -61,6 +64,74 @@ private:
     event_list prereqs; // dependencies to use that block
   };
 
+  /**
+   * @brief The free blocks of one level
+   *
+   * Blocks are stored contiguously, and a hash map from the index of a block to its position makes it possible to
+   * find and remove the buddy of a freed block in constant time. Removing a block moves the last block into its slot.
+   */
+  class free_list
+  {
+  public:
+    bool empty() const
+    {
+      return blocks_.empty();
+    }
+
+    void push(size_t index, event_list prereqs)
+    {
+      assert(positions_.count(index) == 0);
+      positions_.emplace(index, blocks_.size());
+      blocks_.emplace_back(index, mv(prereqs));
+    }
+
+    // Removes the most recently pushed block which was not removed since
+    avail_block pop()
+    {
+      assert(!empty());
+      avail_block b = mv(blocks_.back());
+      blocks_.pop_back();
+      positions_.erase(b.index);
+      return b;
+    }
+
+    // Removes the block at this index if it is free, and merges its prerequisites into prereqs
+    bool take(size_t index, event_list& prereqs)
+    {
+      auto it = positions_.find(index);
+      if (it == positions_.end())
+      {
+        return false;
+      }
+
+      const size_t position = it->second;
+      positions_.erase(it);
+
+      prereqs.merge(blocks_[position].prereqs);
+      if (position + 1 != blocks_.size())
+      {
+        blocks_[position]                   = mv(blocks_.back());
+        positions_[blocks_[position].index] = position;
+      }
+      blocks_.pop_back();
+      return true;
+    }
+
+    ::std::vector<avail_block>& blocks()
+    {
+      return blocks_;
+    }
+
+    const ::std::vector<avail_block>& blocks() const
+    {
+      return blocks_;
+    }
+
+  private:
+    ::std::vector<avail_block> blocks_;
+    ::std::unordered_map<size_t, size_t> positions_;
+  };
+
 public:
   buddy_allocator_metadata(size_t size, event_list init_prereqs)
   {
@@ -72,7 +143,7 @@ public:
     free_lists_.resize(max_level_ + 1);
 
     // Initially, the whole memory is free, but depends on init_prereqs
-    free_lists_[max_level_].emplace_back(0, init_prereqs);
+    free_lists_[max_level_].push(0, mv(init_prereqs));
   }
 
   ::std::ptrdiff_t allocate(size_t size, event_list& prereqs)
@@ -108,32 +179,25 @@ public:
     while (level < max_level_)
     {
       size_t buddy_index = get_buddy_index(index, level);
-      auto& buddy_list   = free_lists_[level];
-      auto it = ::std::find_if(buddy_list.begin(), buddy_list.end(), [buddy_index](const avail_block& block) {
-        return block.index == buddy_index;
-      });
-
-      if (it == buddy_list.end())
+      if (!free_lists_[level].take(buddy_index, block_prereqs))
       {
         // No buddy available to merge, stop here
         break;
       }
-      // Merge with buddy
-      block_prereqs.merge(it->prereqs);
 
-      buddy_list.erase(it);
+      // Merged with buddy
       index = ::std::min(index, ::std::ptrdiff_t(buddy_index));
       level++;
     }
 
-    free_lists_[level].emplace_back(index, prereqs);
+    free_lists_[level].push(index, mv(block_prereqs));
   }
 
   void deinit(event_list& prereqs)
   {
     for (auto& level : free_lists_)
     {
-      for (auto& block : level)
+      for (auto& block : level.blocks())
       {
         prereqs.merge(block.prereqs);
         block.prereqs.clear();
@@ -149,7 +213,7 @@ public:
       if (!free_lists_[i].empty())
       {
         fprintf(stderr, "Level %zu : %s bytes : ", i, pretty_print_bytes(power).c_str());
-        for (const auto& b : free_lists_[i])
+        for (const auto& b : free_lists_[i].blocks())
         {
           fprintf(stderr, "[%zu, %zu[ ", b.index, b.index + power);
         }
@@ -193,13 +257,11 @@ private:
       {
         continue;
       }
-      auto& b              = free_lists_[current_level].back();
-      size_t block_index   = b.index;
-      event_list b_prereqs = mv(b.prereqs);
-      free_lists_[current_level].pop_back();
+      avail_block b      = free_lists_[current_level].pop();
+      size_t block_index = b.index;
 
       // Dependencies to reuse that block
-      prereqs.merge(b_prereqs);
+      prereqs.merge(b.prereqs);
 
       // If we are not at the requested level, split blocks
       while (current_level > level)
@@ -207,7 +269,7 @@ private:
         current_level--;
         size_t buddy_index = block_index + (1ull << current_level);
         // split blocks depend on the previous dependencies of the whole unsplit block
-        free_lists_[current_level].emplace_back(buddy_index, b_prereqs);
+        free_lists_[current_level].push(buddy_index, b.prereqs);
       }
       return block_index;
     }
@@ -221,7 +283,7 @@ private:
     return index ^ (1ull << level); // XOR to find the buddy block
   }
 
-  ::std::vector<::std::vector<avail_block>> free_lists_;
+  ::std::vector<free_list> free_lists_;
   size_t total_size_ = 0;
   size_t max_level_  = 0;
 };
@@ -361,6 +423,39 @@ UNITTEST("buddy allocator meta data")
   // allocator.debug_print();
 };
 
+UNITTEST("buddy allocator meta data coalescing")
+{
+  event_list prereqs; // starts empty
+
+  reserved::buddy_allocator_metadata allocator(1024, prereqs);
+
+  event_list dummy;
+
+  // Fragment the whole buffer into blocks of 16 bytes
+  ::std::vector<::std::ptrdiff_t> blocks;
+  for (size_t i = 0; i < 64; i++)
+  {
+    ::std::ptrdiff_t ptr = allocator.allocate(16, dummy);
+    EXPECT(ptr != -1);
+    blocks.push_back(ptr);
+  }
+  EXPECT(allocator.allocate(16, dummy) == -1);
+
+  // Free every other block, which leaves no pair of free buddies
+  for (size_t i = 0; i < blocks.size(); i += 2)
+  {
+    allocator.deallocate(blocks[i], 16, dummy);
+  }
+  EXPECT(allocator.allocate(32, dummy) == -1);
+
+  // Freeing the remaining blocks coalesces everything back into a single block
+  for (size_t i = 1; i < blocks.size(); i += 2)
+  {
+    allocator.deallocate(blocks[i], 16, dummy);
+  }
+  EXPECT(allocator.allocate(1024, dummy) == 0);
+};
+
 #endif // UNITTESTED_FILE
 
 } // end namespace cuda::experimental::stf
@@ -26,8 +26,14 @@
 #endif // no system header
 
 #include <cuda/experimental/__stf/allocators/block_allocator.cuh>
+#include <cuda/experimental/__stf/utility/pretty_print.cuh>
 
+#include <cstdlib>
+#include <limits>
+#include <list>
+#include <map>
 #include <mutex>
+#include <unordered_map>
 
 namespace cuda::experimental::stf
 {
@@ -37,16 +43,44 @@ namespace cuda::experimental::stf
  *
  * This allocator uses an internal cache to reuse previously allocated memory blocks.
  * The aim is to reduce the overhead of memory allocation.
+ *
+ * Requested sizes are rounded up to size classes (four per power of two), and a cached block is reused for any request
+ * whose size class it exceeds by at most a configurable slack, so that buffers whose sizes vary slightly between
+ * iterations still hit the cache. The total size of the cached blocks can be capped: when it is exceeded, the least
+ * recently freed blocks are returned to the root allocator. The cap can also be set in MB with the
+ * CUDASTF_CACHED_ALLOCATOR_SIZE_MB environment variable, and defaults to no limit.
+ *
+ * Cache hits only take the lock of the cache. Calls to the root allocator are made without it, but they are serialized
+ * by a separate lock, so the root allocator does not need to be thread safe.
  */
 class cached_block_allocator : public block_allocator_interface
 {
 public:
+  /**
+   * @brief Counters describing the activity of the cache
+   */
+  struct statistics
+  {
+    size_t hits                    = 0; ///< Allocations served from the cache
+    size_t misses                  = 0; ///< Allocations forwarded to the root allocator
+    size_t evictions               = 0; ///< Cached blocks returned to the root allocator before deinit
+    size_t cached_bytes            = 0; ///< Bytes currently held in the cache
+    size_t cached_bytes_high_water = 0; ///< Highest value of cached_bytes so far
+  };
+
   /**
    * @brief This constructor takes a root allocator which performs
    *        allocations when there is a cache miss
+   *
+   * @param max_cached_bytes_ Maximum total size of the blocks kept in the cache
+   * @param max_slack_ A cached block may serve a request whose size class is smaller by at most this fraction of it
    */
-  cached_block_allocator(block_allocator_untyped root_allocator_)
+  cached_block_allocator(block_allocator_untyped root_allocator_,
+                         size_t max_cached_bytes_ = default_max_cached_bytes(),
+                         double max_slack_        = 0.25)
       : root_allocator(mv(root_allocator_))
+      , max_cached_bytes(max_cached_bytes_)
+      , max_slack(max_slack_)
   {}
 
   /**
@@ -65,28 +99,62 @@ public:
   {
     EXPECT(s > 0);
 
-    ::std::lock_guard<::std::mutex> g(allocator_mutex);
-    if (auto it = free_cache.find(memory_node); it != free_cache.end())
+    const size_t class_size = size_class(s);
+
+    {
+      ::std::lock_guard<::std::mutex> g(allocator_mutex);
+      if (auto it = free_cache.find(memory_node); it != free_cache.end())
+      {
+        // Best fit: the smallest cached block which is large enough, unless it wastes too much memory
+        per_place_map_t& m = it->second;
+        auto it2           = m.lower_bound(class_size);
+        if (it2 != m.end() && it2->first <= class_size + size_t(max_slack * class_size))
+        {
+          alloc_cache_entry& e = *it2->second;
+          prereqs.merge(mv(e.prereq));
+          void* result = e.ptr;
+
+          stats.cached_bytes -= e.size;
+          live_blocks.emplace(result, e.size);
+          lru.erase(it2->second);
+          m.erase(it2);
+
+          stats.hits++;
+          return result;
+        }
+      }
+      stats.misses++;
+    }
+
+    // That is a miss, we need to allocate data using the root allocator (without holding the lock of the cache, as this
+    // may be slow)
+    ::std::lock_guard<::std::mutex> root_guard(root_mutex);
+    ::std::ptrdiff_t root_s = class_size;
+    void* result            = root_allocator.allocate(ctx, memory_node, root_s, prereqs);
+    if (root_s < 0)
     {
-      per_place_map_t& m = it->second;
-      if (auto it2 = m.find(s); it2 != m.end())
+      // Give the memory cached for this place back to the root allocator, and retry
+      release_place(ctx, memory_node, prereqs);
+
+      root_s = class_size;
+      result = root_allocator.allocate(ctx, memory_node, root_s, prereqs);
+      if (root_s < 0)
       {
-        alloc_cache_entry& e = it2->second;
-        prereqs.merge(mv(e.prereq));
-        void* result = e.ptr;
-        m.erase(it2);
+        s = root_s;
         return result;
       }
     }
 
-    // That is a miss, we need to allocate data using the root allocator
-    return root_allocator.allocate(ctx, memory_node, s, prereqs);
+    ::std::lock_guard<::std::mutex> g(allocator_mutex);
+    live_blocks.emplace(result, class_size);
+    return result;
   }
 
   /**
    * @brief Deallocates a memory block.
    *
-   * Puts the deallocated block back into the internal cache for future reuse.
+   * Puts the deallocated block back into the internal cache for future reuse, and returns the least recently freed
+   * blocks to the root allocator if the cache exceeds its capacity.
    *
    * @param ctx The backend context (unused in this implementation).
    * @param memory_node Memory location where the deallocation should happen.
@@ -95,11 +163,55 @@ public:
    * @param sz Size of the memory block.
    */
   void
-  deallocate(backend_ctx_untyped&, const data_place& memory_node, event_list& prereqs, void* ptr, size_t sz) override
+  deallocate(backend_ctx_untyped& ctx, const data_place& memory_node, event_list& prereqs, void* ptr, size_t sz) override
   {
-    ::std::lock_guard<::std::mutex> g(allocator_mutex);
-    // We do not call the deallocate method of the root allocator, we discard buffers instead
-    free_cache[memory_node].emplace(sz, alloc_cache_entry{ptr, prereqs});
+    ::std::list<alloc_cache_entry> victims;
+    {
+      ::std::lock_guard<::std::mutex> g(allocator_mutex);
+
+      // The block may be larger than the size requested for it
+      if (auto it = live_blocks.find(ptr); it != live_blocks.end())
+      {
+        sz = it->second;
+        live_blocks.erase(it);
+      }
+
+      // We do not call the deallocate method of the root allocator, we discard buffers instead
+      lru.push_back(alloc_cache_entry{memory_node, ptr, sz, prereqs});
+      free_cache[memory_node].emplace(sz, ::std::prev(lru.end()));
+      stats.cached_bytes += sz;
+
+      while (stats.cached_bytes > max_cached_bytes)
+      {
+        auto victim = lru.begin();
+        remove_from_place_map(victim);
+        stats.cached_bytes -= victim->size;
+        stats.evictions++;
+        victims.splice(victims.end(), lru, victim);
+      }
+      stats.cached_bytes_high_water = ::std::max(stats.cached_bytes_high_water, stats.cached_bytes);
+    }
+
+    if (victims.empty())
+    {
+      return;
+    }
+
+    // Return cold blocks to the root allocator, without holding the lock of the cache
+    event_list evicted;
+    {
+      ::std::lock_guard<::std::mutex> root_guard(root_mutex);
+      for (auto& victim : victims)
+      {
+        root_allocator.deallocate(ctx, victim.where, victim.prereq, victim.ptr, victim.size);
+        evicted.merge(mv(victim.prereq));
+      }
+    }
+
+    {
+      ::std::lock_guard<::std::mutex> g(allocator_mutex);
+      eviction_prereqs.merge(mv(evicted));
+    }
   }
 
   /**
@@ -108,27 +220,25 @@ public:
    */
   event_list deinit(backend_ctx_untyped& ctx) override
   {
-    ::std::unordered_map<data_place, per_place_map_t, hash<data_place>> free_cache_janitor;
+    ::std::list<alloc_cache_entry> lru_janitor;
+    event_list result;
     {
       ::std::lock_guard<::std::mutex> g(allocator_mutex);
-      free_cache.swap(free_cache_janitor);
+      lru_janitor.swap(lru);
+      free_cache.clear();
+      live_blocks.clear();
+      stats.cached_bytes = 0;
+      result             = mv(eviction_prereqs);
+      eviction_prereqs   = event_list();
     }
 
-    event_list result;
-    for (auto& entry : free_cache_janitor)
+    ::std::lock_guard<::std::mutex> root_guard(root_mutex);
+    for (auto& ace : lru_janitor)
     {
-      auto& where        = entry.first;
-      per_place_map_t& m = entry.second;
-      for (auto& entry2 : m)
-      {
-        size_t sz              = entry2.first;
-        alloc_cache_entry& ace = entry2.second;
-
-        root_allocator.deallocate(ctx, where, ace.prereq, ace.ptr, sz);
+      root_allocator.deallocate(ctx, ace.where, ace.prereq, ace.ptr, ace.size);
 
-        // Move all events
-        result.merge(mv(ace.prereq));
-      }
+      // Move all events
+      result.merge(mv(ace.prereq));
     }
     return result;
   }
@@ -144,22 +254,55 @@ public:
   }
 
   /**
-   * @brief Prints additional information about the allocator.
-   *
-   * This function currently prints no additional information.
+   * @brief Returns the counters describing the activity of the cache so far.
+   */
+  statistics get_statistics() const
+  {
+    ::std::lock_guard<::std::mutex> g(allocator_mutex);
+    return stats;
+  }
+
+  /**
+   * @brief Prints the hit and miss counters of the cache, and its footprint.
    */
   void print_info() const override
   {
-    const auto s = to_string();
-    fprintf(stderr, "No additional info for allocator of kind \"%.*s\".\n", static_cast<int>(s.size()), s.data());
+    const auto st    = get_statistics();
+    const auto total = st.hits + st.misses;
+    fprintf(stderr,
+            "%s: %zu hits, %zu misses (%.1f%% hit rate), %zu evictions, %s cached (high water %s)\n",
+            to_string().c_str(),
+            st.hits,
+            st.misses,
+            total == 0 ? 0.0 : 100.0 * st.hits / total,
+            st.evictions,
+            pretty_print_bytes(st.cached_bytes).c_str(),
+            pretty_print_bytes(st.cached_bytes_high_water).c_str());
   }
 
-protected:
   /**
-   * @brief Underlying root allocator for base buffers
+   * @brief Rounds a size up to its size class.
+   *
+   * Sizes up to 1 KiB are rounded to a multiple of 256 bytes, larger sizes to a multiple of a quarter of their
+   * highest power of two, which wastes at most 25% of the block.
    */
-  block_allocator_untyped root_allocator;
+  static size_t size_class(size_t s)
+  {
+    if (s <= 1024)
+    {
+      return (s + 255) / 256 * 256;
+    }
 
+    size_t power = 1024;
+    while (power <= s / 2)
+    {
+      power *= 2;
+    }
+    const size_t step = power / 4;
+    return (s + step - 1) / step * step;
+  }
+
+protected:
   /**
    * @brief Struct representing an entry in the cache.
    *
@@ -167,17 +310,117 @@ protected:
    */
   struct alloc_cache_entry
   {
+    data_place where; ///< Place of the memory block.
     void* ptr; ///< Pointer to the allocated memory block.
+    size_t size; ///< Size of the memory block, as allocated from the root allocator.
     event_list prereq; ///< Prerequisites for reusing this block.
   };
 
+  /// Cached blocks, from the least to the most recently freed.
+  using lru_t = ::std::list<alloc_cache_entry>;
+
   /// Maps sizes to cache entries for a given data_place.
-  using per_place_map_t = ::std::unordered_multimap<size_t, alloc_cache_entry>;
+  using per_place_map_t = ::std::multimap<size_t, typename lru_t::iterator>;
+
+  static size_t default_max_cached_bytes()
+  {
+    const char* str = getenv("CUDASTF_CACHED_ALLOCATOR_SIZE_MB");
+    return str ? size_t(atol(str)) * 1024 * 1024 : ::std::numeric_limits<size_t>::max();
+  }
+
+  /// Removes a cached block from the size index of its place (the lock must be held).
+  void remove_from_place_map(typename lru_t::iterator entry)
+  {
+    per_place_map_t& m = free_cache[entry->where];
+    auto range         = m.equal_range(entry->size);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+      if (it->second == entry)
+      {
+        m.erase(it);
+        return;
+      }
+    }
+    _CCCL_ASSERT(false, "cached block missing from the size index");
+  }
+
+  /// Returns all the blocks cached for a place to the root allocator (root_mutex must be held).
+  void release_place(backend_ctx_untyped& ctx, const data_place& memory_node, event_list& prereqs)
+  {
+    lru_t released;
+    {
+      ::std::lock_guard<::std::mutex> g(allocator_mutex);
+      auto it = free_cache.find(memory_node);
+      if (it == free_cache.end())
+      {
+        return;
+      }
+      for (auto& entry : it->second)
+      {
+        stats.cached_bytes -= entry.second->size;
+        released.splice(released.end(), lru, entry.second);
+      }
+      free_cache.erase(it);
+    }
+
+    for (auto& ace : released)
+    {
+      root_allocator.deallocate(ctx, ace.where, ace.prereq, ace.ptr, ace.size);
+      prereqs.merge(mv(ace.prereq));
+    }
+  }
+
+  /**
+   * @brief Underlying root allocator for base buffers
+   */
+  block_allocator_untyped root_allocator;
+
+  /// Maximum total size of the cached blocks.
+  size_t max_cached_bytes;
+
+  /// Maximum fraction of a size class by which a reused block may exceed it.
+  double max_slack;
+
+  /// Cached blocks, in the order they were freed.
+  lru_t lru;
 
   /// Top-level cache map mapping data_place to per_place_map_t.
   ::std::unordered_map<data_place, per_place_map_t, hash<data_place>> free_cache;
 
-  ::std::mutex allocator_mutex;
+  /// Sizes of the blocks currently handed out, which may exceed the sizes requested for them.
+  ::std::unordered_map<void*, size_t> live_blocks;
+
+  /// Events of the deallocations of evicted blocks, returned by deinit.
+  event_list eviction_prereqs;
+
+  statistics stats;
+
+  mutable ::std::mutex allocator_mutex;
+
+  /// Serializes the calls to the root allocator. It may be held while taking allocator_mutex, never the other way.
+  ::std::mutex root_mutex;
+};
+
+#ifdef UNITTESTED_FILE
+
+UNITTEST("cached_block_allocator size classes")
+{
+  EXPECT(cached_block_allocator::size_class(1) == 256);
+  EXPECT(cached_block_allocator::size_class(1000) == 1024);
+  EXPECT(cached_block_allocator::size_class(1025) == 1280);
+  EXPECT(cached_block_allocator::size_class(3000) == 3072);
+  EXPECT(cached_block_allocator::size_class(1 << 20) == 1 << 20);
+  EXPECT(cached_block_allocator::size_class((1 << 20) + 1) == (1 << 20) + (1 << 18));
+
+  // Rounding never wastes more than a quarter of the requested size beyond the smallest class
+  for (size_t s = 1024; s < (1 << 24); s += 4099)
+  {
+    const size_t c = cached_block_allocator::size_class(s);
+    EXPECT(c >= s);
+    EXPECT(c - s < s / 4);
+  }
 };
 
+#endif // UNITTESTED_FILE
+
 } // end namespace cuda::experimental::stf
@@ -231,10 +231,11 @@ class graph_ctx : public backend_ctx<graph_ctx>
       return false;
     }
 
-    /* Store a vector of previously instantiated graphs, with the number of
-     * nodes, number of edges, the executable graph, and the corresponding epoch.
+    /* Store a vector of previously instantiated graphs, with the fingerprint
+     * of the graph, the executable graph, and the corresponding epoch.
      * */
-    ::std::vector<::std::tuple<size_t, size_t, ::std::shared_ptr<cudaGraphExec_t>, size_t>> previous_exec_graphs;
+    ::std::vector<::std::tuple<reserved::graph_fingerprint, ::std::shared_ptr<cudaGraphExec_t>, size_t>>
+      previous_exec_graphs;
     cudaStream_t submitted_stream                 = nullptr; // stream used in submit
     ::std::shared_ptr<cudaGraphExec_t> exec_graph = nullptr;
     ::std::shared_ptr<cudaGraph_t> _graph         = nullptr;
@@ -437,11 +438,8 @@ public:
   {
     ::std::shared_ptr<cudaGraph_t> g = finalize_as_graph();
 
-    size_t nedges;
-    size_t nnodes;
-
-    cuda_safe_call(cudaGraphGetNodes(*g, nullptr, &nnodes));
-    cuda_safe_call(cudaGraphGetEdges(*g, nullptr, nullptr, &nedges));
+    // Summarize the structure of the graph to only try to update executable graphs that may match
+    const auto fingerprint = reserved::compute_graph_fingerprint(*g);
 
     auto& state = this->state();
 
@@ -451,8 +449,9 @@ public:
       print_to_dot("instantiated_graph" + ::std::to_string(instantiated_graph++) + ".dot");
     }
 
-    bool use_cache = true;
-    bool hit       = false;
+    bool use_cache        = true;
+    bool hit              = false;
+    size_t failed_updates = 0;
 
     // If there is a policy, check whether it enables or disables the use of
     // the cache
@@ -466,7 +465,7 @@ public:
     {
       /* This will lookup in the cache (if any) and update an existing entry, or
        * instantiate a graph if none is found. */
-      auto query_result = async_resources().cached_graphs_query(nnodes, nedges, g);
+      auto query_result = async_resources().cached_graphs_query(fingerprint, g, &failed_updates);
       state.exec_graph  = query_result.first;
 
       hit = query_result.second; // indicate if this was a hit or miss in the cache
@@ -487,8 +486,9 @@ public:
       stats->instantiate_cnt++;
     }
 
-    stats->nnodes += nnodes;
-    stats->nedges += nedges;
+    stats->failed_update_cnt += failed_updates;
+    stats->nnodes += fingerprint.nnodes;
+    stats->nedges += fingerprint.nedges;
 
     return state.exec_graph;
   }
@@ -613,11 +613,7 @@ private:
     }
     //        cuda_safe_call(cudaStreamSynchronize(state.submitted_stream));
 
-    size_t nedges;
-    size_t nnodes;
-
-    cuda_safe_call(cudaGraphGetNodes(g, nullptr, &nnodes));
-    cuda_safe_call(cudaGraphGetEdges(g, nullptr, nullptr, &nedges));
+    const auto fingerprint = reserved::compute_graph_fingerprint(g);
 
     cudaGraphExec_t local_exec_graph = nullptr;
 
@@ -632,10 +628,10 @@ private:
     bool found = false;
 
     // Try to reuse previous instantiated graphs
-    for (auto& [prev_nnodes, prev_nedges, prev_e_ptr, last_epoch] : state.previous_exec_graphs)
+    for (auto& [prev_fingerprint, prev_e_ptr, last_epoch] : state.previous_exec_graphs)
     {
       // Early exit if the topology cannot match
-      if (prev_nnodes != nnodes || prev_nedges != nedges)
+      if (prev_fingerprint != fingerprint)
       {
         continue;
       }
@@ -658,7 +654,7 @@ private:
       auto e_graph_ptr = graph_instantiate(g);
 
       // Save for future use
-      state.previous_exec_graphs.push_back(::std::make_tuple(nnodes, nedges, e_graph_ptr, epoch));
+      state.previous_exec_graphs.push_back(::std::make_tuple(fingerprint, e_graph_ptr, epoch));
 
       local_exec_graph = *e_graph_ptr;
     }
@@ -221,6 +221,7 @@ public:
       }
       dep.set_symbol(dep.get_data().get_symbol());
       dep.set_data_footprint(dep.get_data().get_data_interface().data_footprint());
+      dep.set_data_id(dep.get_data().get_unique_id());
       index++;
     }
   }
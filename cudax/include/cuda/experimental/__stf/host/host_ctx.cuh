@@ -0,0 +1,357 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of CUDASTF in CUDA C++ Core Libraries,
+// under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES.
+//
+//===----------------------------------------------------------------------===//
+
+/**
+ * @file
+ *
+ * @brief Implements the host_ctx backend, which executes tasks on a pool of CPU threads
+ *
+ * @see host_ctx
+ */
+
+#pragma once
+
+#include <cuda/__cccl_config>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <cuda/experimental/__stf/host/host_task.cuh>
+#include <cuda/experimental/__stf/host/interfaces/slice.cuh>
+#include <cuda/experimental/__stf/host/interfaces/void_interface.cuh>
+#include <cuda/experimental/__stf/host/internal/event_types.cuh>
+#include <cuda/experimental/__stf/host/internal/thread_pool.cuh>
+#include <cuda/experimental/__stf/internal/acquire_release.cuh>
+#include <cuda/experimental/__stf/internal/backend_allocator_setup.cuh>
+#include <cuda/experimental/__stf/internal/backend_ctx.cuh>
+#include <cuda/experimental/__stf/internal/host_launch_scope.cuh>
+#include <cuda/experimental/__stf/internal/parallel_for_scope.cuh>
+
+#include <cstdlib>
+
+namespace cuda::experimental::stf
+{
+
+template <typename T>
+struct hosted_interface_of;
+
+/**
+ * @brief Uncached allocator of the host backend (used as a basis for other allocators)
+ *
+ * Allocations are done with `malloc`, and deallocations are deferred to the thread pool until their prerequisites
+ * are fulfilled.
+ */
+class uncached_host_allocator : public block_allocator_interface
+{
+public:
+  uncached_host_allocator() = default;
+
+  void* allocate(backend_ctx_untyped&, const data_place& memory_node, ::std::ptrdiff_t& s, event_list&) override
+  {
+    EXPECT(memory_node.is_host(), "The host backend only supports data on the host.");
+
+    void* result = ::std::malloc(s);
+    if (!result)
+    {
+      // Notify the caller that the allocation failed
+      s = -s;
+    }
+    return result;
+  }
+
+  void deallocate(
+    backend_ctx_untyped& ctx, const data_place& memory_node, event_list& prereqs, void* ptr, size_t /* sz */) override
+  {
+    EXPECT(memory_node.is_host(), "The host backend only supports data on the host.");
+    reserved::host_async_op(
+      ctx,
+      prereqs,
+      [ptr] {
+        ::std::free(ptr);
+      },
+      "free");
+  }
+
+  // Nothing is done as all deallocation are done immediately
+  event_list deinit(backend_ctx_untyped& /* ctx */) override
+  {
+    return event_list();
+  }
+
+  ::std::string to_string() const override
+  {
+    return "uncached host allocator";
+  }
+};
+
+/**
+ * @brief This class describes a CUDASTF execution context where tasks are executed by a pool of CPU threads, and
+ * where events are host-side latches.
+ *
+ * All tasks run on `exec_place::host()` and all data live on `data_place::host()`. The context neither initializes
+ * CUDA nor uses any CUDA stream, so that it can be used on machines without GPU. Tasks are submitted to the thread pool
+ * as soon as their dependencies are fulfilled, and `task_fence()` or `finalize()` block the calling thread until all
+ * submitted work is completed.
+ *
+ * This class is copyable, movable, and can be passed by value
+ */
+class host_ctx : public backend_ctx<host_ctx>
+{
+  using base = backend_ctx<host_ctx>;
+
+public:
+  using task_type = host_task<>;
+
+  /**
+   * @brief Definition for the underlying implementation of `data_interface<T>`
+   *
+   * @tparam T
+   */
+  template <typename T>
+  using data_interface = typename hosted_interface_of<T>::type;
+
+  /// @brief This type is copyable, assignable, and movable. However, copies have reference semantics.
+  ///@{
+  /**
+   * @brief Create a context with a pool of `nthreads` threads
+   *
+   * By default, the number of threads is given by the `CUDASTF_HOST_THREADS` environment variable, or by the number of
+   * hardware threads.
+   */
+  explicit host_ctx(size_t nthreads = reserved::host_thread_pool::default_thread_count())
+      : backend_ctx<host_ctx>(::std::make_shared<impl>(nthreads))
+  {}
+  ///@}
+
+  /// All tasks of a host_ctx are executed on the host
+  exec_place default_exec_place() const
+  {
+    return exec_place::host();
+  }
+
+  using backend_ctx<host_ctx>::task;
+
+  /**
+   * @brief Creates a task on the specified execution place, which must be the host
+   */
+  template <typename... Deps>
+  host_task<Deps...> task(exec_place e_place, task_dep<Deps>... deps)
+  {
+    EXPECT(e_place == exec_place::host(), "Tasks of a host_ctx can only be executed on the host.");
+    return host_task<Deps...>(*this, mv(e_place), mv(deps)...);
+  }
+
+  /// Block the calling thread until all the work submitted so far is completed
+  void task_fence()
+  {
+    auto prereqs = get_state().insert_task_fence(*get_dot());
+    reserved::host_events_wait(prereqs);
+  }
+
+  void submit()
+  {
+    auto& state = this->state();
+    _CCCL_ASSERT(!state.submitted, "");
+    _CCCL_ASSERT(get_phase() < backend_ctx_untyped::phase::submitted, "");
+
+    // Write-back data and erase automatically created data instances
+    state.erase_all_logical_data();
+    state.detach_allocators(*this);
+
+    state.submitted_events = state.insert_task_fence(*get_dot());
+    state.submitted        = true;
+
+    set_phase(backend_ctx_untyped::phase::submitted);
+  }
+
+  void finalize()
+  {
+    _CCCL_ASSERT(get_phase() < backend_ctx_untyped::phase::finalized, "");
+    auto& state = this->state();
+    if (!state.submitted)
+    {
+      // Wasn't submitted yet
+      submit();
+    }
+
+    reserved::host_events_wait(state.submitted_events);
+    state.submitted_events.clear();
+
+    state.cleanup();
+    set_phase(backend_ctx_untyped::phase::finalized);
+  }
+
+  // no-op : so that we can use the same code with stream_ctx and graph_ctx
+  void change_epoch()
+  {
+    auto& dot = *get_dot();
+    if (dot.is_tracing())
+    {
+      dot.change_epoch();
+    }
+  }
+
+  template <typename T>
+  auto wait(cuda::experimental::stf::logical_data<T>& ldata)
+  {
+    typename owning_container_of<T>::type out;
+
+    auto t = task(exec_place::host(), ldata.read());
+    t.set_symbol("wait");
+    t->*[&](auto data) {
+      out = owning_container_of<T>::get_value(data);
+    };
+
+    // The body of the task is executed asynchronously by the thread pool
+    t.wait();
+
+    return out;
+  }
+
+  /// Number of threads executing the tasks of this context
+  size_t thread_count() const
+  {
+    return state().pool.size();
+  }
+
+private:
+  /* This class contains all the state associated to a host_ctx, and all states associated to every contexts (in
+   * `impl`) */
+  class impl : public base::impl
+  {
+  public:
+    impl(size_t nthreads)
+        : base::impl(async_resources_handle(nullptr), false)
+        , pool(nthreads)
+    {
+      reserved::backend_ctx_setup_allocators<impl, uncached_host_allocator>(*this);
+    }
+
+    void cleanup()
+    {
+      submitted = false;
+      base::impl::cleanup();
+    }
+
+    // Due to circular dependencies, we need to define it here, and not in backend_ctx_untyped
+    void update_uncached_allocator(block_allocator_untyped custom) override
+    {
+      reserved::backend_ctx_update_uncached_allocator(*this, mv(custom));
+    }
+
+    reserved::host_thread_pool* host_pool() override
+    {
+      return &pool;
+    }
+
+    ::std::string to_string() const override
+    {
+      return "host backend context";
+    }
+
+    // Dangling events (e.g. deferred deallocations) must be waited for by the fence of the context
+    bool track_dangling_events() const override
+    {
+      return true;
+    }
+
+    reserved::host_thread_pool pool;
+
+    bool submitted = false;
+    // Events waited for by finalize()
+    event_list submitted_events;
+  };
+
+  impl& state()
+  {
+    return dynamic_cast<impl&>(get_state());
+  }
+  const impl& state() const
+  {
+    return dynamic_cast<const impl&>(get_state());
+  }
+};
+
+#ifdef UNITTESTED_FILE
+UNITTEST("host_ctx dependencies")
+{
+  host_ctx ctx(4);
+
+  int array[128];
+  for (size_t i = 0; i < 128; i++)
+  {
+    array[i] = int(i);
+  }
+
+  auto lA = ctx.logical_data(array);
+  auto lB = ctx.logical_data<int>(128);
+
+  ctx.task(lA.rw())->*[](auto a) {
+    for (size_t i = 0; i < a.size(); i++)
+    {
+      a(i) *= 2;
+    }
+  };
+
+  ctx.task(lA.read(), lB.write())->*[](auto a, auto b) {
+    for (size_t i = 0; i < a.size(); i++)
+    {
+      b(i) = a(i) + 1;
+    }
+  };
+
+  ctx.task(lB.read(), lA.write())->*[](auto b, auto a) {
+    for (size_t i = 0; i < a.size(); i++)
+    {
+      a(i) = b(i);
+    }
+  };
+
+  ctx.finalize();
+
+  for (size_t i = 0; i < 128; i++)
+  {
+    EXPECT(array[i] == 2 * int(i) + 1);
+  }
+};
+
+UNITTEST("host_ctx token and untyped task")
+{
+  host_ctx ctx(2);
+
+  int value  = 0;
+  auto token = ctx.logical_token();
+
+  for (int k = 0; k < 10; k++)
+  {
+    ctx.task(token.rw())->*[&value]() {
+      value++;
+    };
+  }
+
+  auto t = ctx.task();
+  t.add_deps(token.read());
+  t.start();
+  t.enqueue([&value] {
+    EXPECT(value == 10);
+  });
+  t.end();
+
+  ctx.finalize();
+  EXPECT(value == 10);
+};
+#endif // UNITTESTED_FILE
+
+} // namespace cuda::experimental::stf
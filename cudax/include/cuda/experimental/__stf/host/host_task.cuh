@@ -0,0 +1,413 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of CUDASTF in CUDA C++ Core Libraries,
+// under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES.
+//
+//===----------------------------------------------------------------------===//
+
+/**
+ * @file
+ * @brief Implement tasks in the host backend (host_ctx)
+ *
+ * @see host_ctx
+ */
+
+#pragma once
+
+#include <cuda/__cccl_config>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <cuda/experimental/__stf/host/internal/event_types.cuh>
+#include <cuda/experimental/__stf/internal/logical_data.cuh>
+#include <cuda/experimental/__stf/internal/task_statistics.cuh>
+#include <cuda/experimental/__stf/internal/void_interface.cuh>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace cuda::experimental::stf
+{
+
+template <typename... Data>
+class host_task;
+
+/**
+ * @brief Task with dynamic dependencies executed by the thread pool of a `host_ctx`.
+ *
+ * Between `start()` and `end()`, the work of the task is described by calling `enqueue()` (or `parallel_enqueue()` to
+ * split a loop among the threads of the pool). This work is not executed immediately: it is submitted to the pool when
+ * `end()` is called, and starts once the dependencies of the task are fulfilled. The task is completed when all its
+ * jobs are completed.
+ *
+ * Jobs are executed by the threads of the pool, like CUDA host callbacks they must not throw exceptions, nor wait for
+ * other tasks of the context.
+ */
+template <>
+class host_task<> : public task
+{
+public:
+  host_task(backend_ctx_untyped ctx_, exec_place e_place = exec_place::host())
+      : task(mv(e_place))
+      , ctx(mv(ctx_))
+  {
+    ctx.increment_task_count();
+  }
+
+  host_task(const host_task<>&)              = default;
+  host_task<>& operator=(const host_task<>&) = default;
+  ~host_task()                               = default;
+
+  host_task<>& start()
+  {
+    EXPECT(get_exec_place() == exec_place::host(), "Tasks of a host_ctx can only be executed on the host.");
+
+    ready_prereqs = acquire(ctx);
+    return *this;
+  }
+
+  /// Add a job to the task, it will be executed once the dependencies are fulfilled
+  void enqueue(::std::function<void()> job)
+  {
+    assert(get_task_phase() == task::phase::running);
+    jobs.push_back(mv(job));
+  }
+
+  /// Add a job to the task, using a C-style callback similar to `cudaLaunchHostFunc`
+  void enqueue(void (*fn)(void*), void* user_data)
+  {
+    enqueue([fn, user_data] {
+      fn(user_data);
+    });
+  }
+
+  /**
+   * @brief Split the iteration space [0, n) into chunks executed concurrently by the threads of the pool
+   *
+   * @param n Number of iterations
+   * @param f Function called as `f(begin, end)` for each chunk
+   */
+  template <typename Fun>
+  void parallel_enqueue(size_t n, Fun&& f)
+  {
+    if (n == 0)
+    {
+      return;
+    }
+
+    // A few chunks per thread so that work stealing can balance irregular loops
+    const size_t nchunks = ::std::min(n, 4 * pool().size());
+    const size_t chunk   = (n + nchunks - 1) / nchunks;
+
+    auto shared_f = ::std::make_shared<::std::decay_t<Fun>>(::std::forward<Fun>(f));
+    for (size_t begin = 0; begin < n; begin += chunk)
+    {
+      const size_t end = ::std::min(begin + chunk, n);
+      enqueue([shared_f, begin, end] {
+        (*shared_f)(begin, end);
+      });
+    }
+  }
+
+  /* End the task, but do not clear its data structures yet */
+  host_task<>& end_uncleared()
+  {
+    assert(get_task_phase() == task::phase::running);
+
+    auto st  = ::std::make_shared<run_state>();
+    st->jobs = mv(jobs);
+    jobs.clear();
+    st->remaining = st->jobs.size();
+    if (ctx.generate_event_symbols())
+    {
+      st->done->set_symbol(ctx, "done " + get_symbol());
+    }
+
+    auto& dot = *ctx.get_dot();
+    if (dot.is_tracing_prereqs())
+    {
+      ready_prereqs.dot_declare_prereqs(dot, st->done->unique_prereq_id, 1);
+    }
+
+    done_event = st->done;
+
+    auto* p = &pool();
+    reserved::host_events_then(ready_prereqs, [p, st] {
+      st->start = ::std::chrono::steady_clock::now();
+      if (st->jobs.empty())
+      {
+        st->finish();
+        return;
+      }
+
+      for (size_t i = 0; i < st->jobs.size(); i++)
+      {
+        p->submit([st, i] {
+          st->jobs[i]();
+          if (st->remaining.fetch_sub(1) == 1)
+          {
+            st->finish();
+          }
+        });
+      }
+    });
+    ready_prereqs.clear();
+
+    event_list end_list(st->done);
+    release(ctx, end_list);
+
+    return *this;
+  }
+
+  host_task<>& end()
+  {
+    end_uncleared();
+    clear();
+    return *this;
+  }
+
+  /// Block the calling thread until the work of the task (submitted by `end()`) is completed
+  void wait() const
+  {
+    _CCCL_ASSERT(done_event.has_value(), "wait() must be called after end()");
+    done_event.value()->wait();
+  }
+
+  /// Time spent between the moment the task was ready and its completion, only valid after `wait()`
+  float elapsed_ms() const
+  {
+    _CCCL_ASSERT(done_event.has_value(), "elapsed_ms() must be called after end()");
+    return done_event.value()->elapsed_ms;
+  }
+
+  /**
+   * @brief Run a function submitting the work of the task
+   *
+   * @tparam Fun Type of lambda
+   * @param fun Lambda function taking a `host_task<>&` as its only argument, which can call `enqueue()`
+   */
+  template <typename Fun>
+  void operator->*(Fun&& fun)
+  {
+    nvtx_range nr(get_symbol().c_str());
+    start();
+
+    auto& dot = ctx.get_dot();
+
+    SCOPE(exit)
+    {
+      end();
+    };
+
+    if (dot->is_tracing())
+    {
+      dot->template add_vertex<task, logical_data_untyped>(*this);
+    }
+
+    ::std::forward<Fun>(fun)(*this);
+  }
+
+  void populate_deps_scheduling_info() const
+  {
+    // Error checking copied from acquire() in acquire_release()
+
+    int index        = 0;
+    const auto& deps = get_task_deps();
+    for (const auto& dep : deps)
+    {
+      if (!dep.get_data().is_initialized())
+      {
+        fprintf(stderr, "Error: dependency number %d is an uninitialized logical data.\n", index);
+        abort();
+      }
+      dep.set_symbol(dep.get_data().get_symbol());
+      dep.set_data_footprint(dep.get_data().get_data_interface().data_footprint());
+      dep.set_data_id(dep.get_data().get_unique_id());
+      index++;
+    }
+  }
+
+  /**
+   * @brief There is a single execution place in a host_ctx, so this only checks whether the task's time needs to be
+   * recorded
+   */
+  bool schedule_task()
+  {
+    reserved::dot& dot = reserved::dot::instance();
+    auto& statistics   = reserved::task_statistics::instance();
+
+    if (statistics.is_calibrating())
+    {
+      populate_deps_scheduling_info();
+    }
+
+    return dot.is_timing() || statistics.is_calibrating();
+  }
+
+private:
+  class done_event_impl;
+  using done_event_t = reserved::handle<done_event_impl, reserved::handle_flags::non_null>;
+
+  // The event marking the completion of a task also records how long its jobs took
+  class done_event_impl : public reserved::host_event_impl
+  {
+  protected:
+    done_event_impl() = default;
+
+  public:
+    float elapsed_ms = 0.0f;
+  };
+
+  struct run_state
+  {
+    void finish()
+    {
+      done->elapsed_ms =
+        ::std::chrono::duration<float, ::std::milli>(::std::chrono::steady_clock::now() - start).count();
+      done->set_done();
+    }
+
+    ::std::vector<::std::function<void()>> jobs;
+    ::std::atomic<size_t> remaining = 0;
+    ::std::chrono::steady_clock::time_point start;
+    done_event_t done;
+  };
+
+  reserved::host_thread_pool& pool()
+  {
+    auto* p = ctx.host_pool();
+    _CCCL_ASSERT(p, "host_task requires a host_ctx");
+    return *p;
+  }
+
+  event_list ready_prereqs;
+  ::std::vector<::std::function<void()>> jobs;
+  ::std::optional<done_event_t> done_event;
+
+protected:
+  backend_ctx_untyped ctx;
+};
+
+/**
+ * @brief Host task with fixed, typed dependencies.
+ *
+ * @tparam Data A list of data that this task depends on
+ *
+ * The body passed to `->*` receives the data instances (e.g. `slice` objects) of the dependencies. It is executed
+ * asynchronously by a thread of the pool once the dependencies are fulfilled, so it is captured by value and its
+ * result is discarded.
+ */
+template <typename... Data>
+class host_task : public host_task<>
+{
+public:
+  host_task(backend_ctx_untyped ctx, exec_place e_place, task_dep<Data>... deps)
+      : host_task<>(mv(ctx), mv(e_place))
+  {
+    static_assert(sizeof(*this) == sizeof(host_task<>), "Cannot add state - it would be lost by slicing.");
+    add_deps(mv(deps)...);
+  }
+
+  host_task& set_symbol(::std::string s) &
+  {
+    host_task<>::set_symbol(mv(s));
+    return *this;
+  }
+
+  host_task&& set_symbol(::std::string s) &&
+  {
+    host_task<>::set_symbol(mv(s));
+    return mv(*this);
+  }
+
+  template <typename Fun>
+  void operator->*(Fun&& fun)
+  {
+    auto& dot        = ctx.get_dot();
+    auto& statistics = reserved::task_statistics::instance();
+
+    bool record_time = schedule_task();
+
+    if (statistics.is_calibrating_to_file())
+    {
+      record_time = true;
+    }
+
+    nvtx_range nr(get_symbol().c_str());
+    start();
+
+    SCOPE(exit)
+    {
+      end_uncleared();
+
+      if (record_time)
+      {
+        wait();
+        const float milliseconds = elapsed_ms();
+
+        if (dot->is_tracing())
+        {
+          dot->template add_vertex_timing<task>(*this, milliseconds);
+        }
+
+        if (statistics.is_calibrating())
+        {
+          statistics.log_task_time(*this, milliseconds);
+        }
+      }
+
+      clear();
+    };
+
+    if (dot->is_tracing())
+    {
+      dot->template add_vertex<task, logical_data_untyped>(*this);
+    }
+
+    constexpr bool fun_invocable_task_deps          = ::std::is_invocable_v<Fun, Data...>;
+    constexpr bool fun_invocable_task_non_void_deps = reserved::is_invocable_with_filtered<Fun, Data...>::value;
+
+    static_assert(fun_invocable_task_deps || fun_invocable_task_non_void_deps, "Incorrect lambda function signature.");
+
+    // The job may be executed after this task object is destroyed, so it owns the function and the data instances
+    if constexpr (fun_invocable_task_deps)
+    {
+      auto w = ::std::make_shared<::std::pair<::std::decay_t<Fun>, decltype(typed_deps())>>(
+        ::std::forward<Fun>(fun), typed_deps());
+      enqueue([w] {
+        ::std::apply(w->first, w->second);
+      });
+    }
+    else
+    {
+      auto args = reserved::remove_void_interface_types(typed_deps());
+      auto w    = ::std::make_shared<::std::pair<::std::decay_t<Fun>, decltype(args)>>(::std::forward<Fun>(fun), mv(args));
+      enqueue([w] {
+        ::std::apply(w->first, w->second);
+      });
+    }
+  }
+
+private:
+  auto typed_deps()
+  {
+    return make_tuple_indexwise<sizeof...(Data)>([&](auto i) {
+      return this->get<::std::tuple_element_t<i, ::std::tuple<Data...>>>(i);
+    });
+  }
+};
+
+} // namespace cuda::experimental::stf
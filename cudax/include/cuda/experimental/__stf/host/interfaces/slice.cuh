@@ -0,0 +1,161 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of CUDASTF in CUDA C++ Core Libraries,
+// under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES.
+//
+//===----------------------------------------------------------------------===//
+
+/**
+ * @file
+ *
+ * @brief Implementation of the slice data interface in the host backend (host_ctx)
+ */
+
+#pragma once
+
+#include <cuda/__cccl_config>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <cuda/experimental/__stf/host/internal/event_types.cuh>
+#include <cuda/experimental/__stf/internal/data_interface.cuh>
+#include <cuda/experimental/__stf/internal/slice.cuh>
+
+#include <cstring>
+
+namespace cuda::experimental::stf
+{
+
+template <typename T>
+struct hosted_interface_of;
+
+/** @brief Contiguous memory interface for the host backend. All instances are in host memory, and copies between
+ * instances are done with `memcpy` by the thread pool of the context.
+ */
+template <typename T, size_t dimensions = 1>
+class slice_host_interface : public data_impl_base<slice<T, dimensions>>
+{
+public:
+  using base = data_impl_base<slice<T, dimensions>>;
+  using typename base::element_type;
+  using typename base::shape_t;
+
+  using mutable_value_type = typename ::std::remove_const<T>::type;
+
+  slice_host_interface(T* p)
+      : base(slice<T, dimensions>(p))
+  {
+    static_assert(dimensions == 0, "This constructor is reserved for 0-dimensional data.");
+  }
+
+  slice_host_interface(slice<T, dimensions> s)
+      : base(mv(s))
+  {}
+
+  slice_host_interface(shape_t s)
+      : base(mv(s))
+  {}
+
+  void data_allocate(
+    backend_ctx_untyped& bctx,
+    block_allocator_untyped& custom_allocator,
+    const data_place& memory_node,
+    instance_id_t instance_id,
+    ::std::ptrdiff_t& s,
+    void**,
+    event_list& prereqs) override
+  {
+    EXPECT(memory_node.is_host(), "The host backend only supports data on the host.");
+
+    s                = this->shape.size() * sizeof(T);
+    auto& local_desc = this->instance(instance_id);
+
+    T* base_ptr = static_cast<T*>(custom_allocator.allocate(bctx, memory_node, s, prereqs));
+    local_desc  = this->shape.create(base_ptr);
+  }
+
+  void data_deallocate(
+    backend_ctx_untyped& bctx,
+    block_allocator_untyped& custom_allocator,
+    const data_place& memory_node,
+    instance_id_t instance_id,
+    void*,
+    event_list& prereqs) override
+  {
+    const size_t sz  = this->shape.size() * sizeof(T);
+    auto& local_desc = this->instance(instance_id);
+    // We can deallocate a copy of a logical data even if it was only accessible in read only mode
+    auto ptr = const_cast<mutable_value_type*>(local_desc.data_handle());
+
+    custom_allocator.deallocate(bctx, memory_node, prereqs, ptr, sz);
+  }
+
+  void data_copy(backend_ctx_untyped& bctx,
+                 const data_place& dst_memory_node,
+                 instance_id_t dst_instance_id,
+                 const data_place& src_memory_node,
+                 instance_id_t src_instance_id,
+                 event_list& prereqs) override
+  {
+    assert(src_memory_node != dst_memory_node);
+
+    // The copy may happen after the logical data was destroyed, so we only
+    // capture the descriptions of the instances
+    const auto& b = this->shape;
+    auto src      = this->instance(src_instance_id);
+    auto dst      = this->instance(dst_instance_id);
+
+    reserved::host_async_op(
+      bctx,
+      prereqs,
+      [b, src, dst] {
+        /* We are copying so the destination will be changed, but from this
+         * might be a constant variable (when using a read-only access). */
+        auto dst_ptr = const_cast<mutable_value_type*>(dst.data_handle());
+        auto src_ptr = src.data_handle();
+        assert(src_ptr);
+        assert(dst_ptr);
+
+        if constexpr (dimensions == 0)
+        {
+          ::std::memcpy(dst_ptr, src_ptr, sizeof(T));
+        }
+        else if constexpr (dimensions == 1)
+        {
+          ::std::memcpy(dst_ptr, src_ptr, b.extent(0) * sizeof(T));
+        }
+        else if constexpr (dimensions == 2)
+        {
+          for (size_t j = 0; j < b.extent(1); j++)
+          {
+            ::std::memcpy(dst_ptr + j * dst.stride(1), src_ptr + j * src.stride(1), b.extent(0) * sizeof(T));
+          }
+        }
+        else
+        {
+          // We only support higher dimensions if they are contiguous !
+          _CCCL_ASSERT(contiguous_dims(src) == dimensions && contiguous_dims(dst) == dimensions,
+                       "Higher dimensions not supported.");
+          ::std::memcpy(dst_ptr, src_ptr, b.size() * sizeof(T));
+        }
+      },
+      "slice copy " + src_memory_node.to_string() + "->" + dst_memory_node.to_string());
+  }
+};
+
+template <typename T, typename... P>
+struct hosted_interface_of<mdspan<T, P...>>
+{
+  using type = slice_host_interface<T, mdspan<T, P...>::rank()>;
+};
+
+} // namespace cuda::experimental::stf
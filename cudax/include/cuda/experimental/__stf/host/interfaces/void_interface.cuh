@@ -0,0 +1,91 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of CUDASTF in CUDA C++ Core Libraries,
+// under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES.
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cuda/__cccl_config>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <cuda/experimental/__stf/internal/data_interface.cuh>
+#include <cuda/experimental/__stf/internal/void_interface.cuh>
+
+namespace cuda::experimental::stf
+{
+
+template <typename T>
+struct hosted_interface_of;
+
+/**
+ * @brief Data interface to manipulate the void interface in the host backend
+ */
+class void_host_interface : public data_impl_base<void_interface>
+{
+public:
+  using base = data_impl_base<void_interface>;
+  using base::shape_t;
+
+  void_host_interface(void_interface m)
+      : base(::std::move(m))
+  {}
+  void_host_interface(typename base::shape_t s)
+      : base(s)
+  {}
+
+  /// Pretend we allocate an instance on a specific data place : we do not do any allocation here
+  void data_allocate(
+    backend_ctx_untyped&,
+    block_allocator_untyped&,
+    const data_place&,
+    instance_id_t,
+    ::std::ptrdiff_t& s,
+    void**,
+    event_list&) override
+  {
+    // By filling a non negative number, we notify that the allocation was successful
+    s = 0;
+  }
+
+  /// Pretend we deallocate an instance (no-op)
+  void data_deallocate(
+    backend_ctx_untyped&, block_allocator_untyped&, const data_place&, instance_id_t, void*, event_list&) override
+  {}
+
+  /// Copy the content of an instance to another instance : this is a no-op
+  void data_copy(
+    backend_ctx_untyped&, const data_place&, instance_id_t, const data_place&, instance_id_t, event_list&) override
+  {}
+
+  /* This helps detecting when we are manipulating a void data interface, so
+   * that we can optimize useless stages such as allocations or copies */
+  bool is_void_interface() const override final
+  {
+    return true;
+  }
+};
+
+/**
+ * @brief Define how the host backend must manipulate this void interface
+ *
+ * @extends hosted_interface_of
+ */
+template <>
+struct hosted_interface_of<void_interface>
+{
+  using type = void_host_interface;
+};
+
+} // end namespace cuda::experimental::stf
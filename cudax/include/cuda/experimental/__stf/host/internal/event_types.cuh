@@ -0,0 +1,213 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of CUDASTF in CUDA C++ Core Libraries,
+// under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES.
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cuda/__cccl_config>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <cuda/experimental/__stf/host/internal/thread_pool.cuh>
+#include <cuda/experimental/__stf/internal/async_prereq.cuh>
+#include <cuda/experimental/__stf/internal/backend_ctx.cuh>
+#include <cuda/experimental/__stf/utility/unstable_unique.cuh>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace cuda::experimental::stf::reserved
+{
+
+class host_event_impl;
+
+using host_event = reserved::handle<host_event_impl, reserved::handle_flags::non_null>;
+
+/**
+ * @brief Event of the host backend (host_ctx), which is a one-shot latch set by the thread of the pool that executed
+ * the corresponding operation.
+ *
+ * Rather than blocking a thread until the event is set, operations depending on it register a continuation with
+ * `then()`, which is executed by the thread setting the event (or immediately if it was set already).
+ */
+class host_event_impl : public event_impl
+{
+protected:
+  host_event_impl()                       = default;
+  host_event_impl(const host_event_impl&) = delete;
+
+public:
+  /// Mark the event as completed and execute the continuations registered so far
+  void set_done()
+  {
+    ::std::vector<::std::function<void()>> todo;
+    {
+      ::std::lock_guard<::std::mutex> lock(mutex);
+      _CCCL_ASSERT(!done, "host event completed twice");
+      done = true;
+      todo.swap(continuations);
+    }
+    cv.notify_all();
+
+    for (auto& f : todo)
+    {
+      f();
+    }
+  }
+
+  /// Execute `f` once the event is completed
+  void then(::std::function<void()> f)
+  {
+    {
+      ::std::lock_guard<::std::mutex> lock(mutex);
+      if (!done)
+      {
+        continuations.push_back(mv(f));
+        return;
+      }
+    }
+
+    f();
+  }
+
+  bool is_done() const
+  {
+    ::std::lock_guard<::std::mutex> lock(mutex);
+    return done;
+  }
+
+  /// Block the calling thread until the event is completed
+  void wait() const
+  {
+    ::std::unique_lock<::std::mutex> lock(mutex);
+    cv.wait(lock, [this] {
+      return done;
+    });
+  }
+
+  bool factorize(backend_ctx_untyped&, reserved::event_vector& events) override
+  {
+    _CCCL_ASSERT(events.size() >= 2, "invalid value");
+
+    // Completed events do not constrain anything, so we drop them to prevent the growth of event lists
+    events.erase(::std::remove_if(events.begin(),
+                                  events.end(),
+                                  [](const event& e) {
+                                    _CCCL_ASSERT(dynamic_cast<const host_event_impl*>(e.operator->()),
+                                                 "invalid event type");
+                                    return static_cast<const host_event_impl*>(e.operator->())->is_done();
+                                  }),
+                 events.end());
+
+    ::std::sort(events.begin(), events.end(), [](auto& a, auto& b) {
+      return *a < *b;
+    });
+    events.erase(unstable_unique(events.begin(),
+                                 events.end(),
+                                 [](auto& a, auto& b) {
+                                   return *a == *b;
+                                 }),
+                 events.end());
+
+    return true;
+  }
+
+private:
+  mutable ::std::mutex mutex;
+  mutable ::std::condition_variable cv;
+  bool done = false;
+  ::std::vector<::std::function<void()>> continuations;
+};
+
+/**
+ * @brief Execute `f` once all the events of `prereqs` are completed.
+ *
+ * `f` is executed by the thread completing the last event, or by the calling thread if they are all completed, so it
+ * is expected to be cheap (typically, submitting a job to the thread pool).
+ */
+template <typename Fun>
+void host_events_then(const event_list& prereqs, Fun&& f)
+{
+  // One count per event, plus one released once all continuations are registered
+  auto count = ::std::make_shared<::std::atomic<size_t>>(prereqs.size() + 1);
+  auto fun   = ::std::make_shared<::std::decay_t<Fun>>(::std::forward<Fun>(f));
+
+  auto release = [count, fun] {
+    if (count->fetch_sub(1) == 1)
+    {
+      (*fun)();
+    }
+  };
+
+  for (const auto& e : prereqs)
+  {
+    reserved::host_event(e, reserved::use_dynamic_cast)->then(release);
+  }
+
+  release();
+}
+
+/**
+ * @brief Asynchronously execute `job` on the thread pool of the context once `prereqs` are completed.
+ *
+ * Upon return, `prereqs` contains a single event which is completed after `job` was executed.
+ */
+template <typename Job>
+void host_async_op(backend_ctx_untyped& bctx, event_list& prereqs, Job&& job, ::std::string symbol = "")
+{
+  auto* pool = bctx.host_pool();
+  _CCCL_ASSERT(pool, "host operations require a host_ctx");
+
+  auto e = reserved::host_event();
+  if (!symbol.empty() && bctx.generate_event_symbols())
+  {
+    e->set_symbol(bctx, mv(symbol));
+  }
+
+  auto& dot = *bctx.get_dot();
+  if (dot.is_tracing_prereqs())
+  {
+    prereqs.dot_declare_prereqs(dot, e->unique_prereq_id, 1);
+  }
+
+  if (prereqs.size() > 0)
+  {
+    prereqs.optimize(bctx);
+  }
+  host_events_then(prereqs, [pool, e, job = ::std::forward<Job>(job)]() mutable {
+    pool->submit([e, job = mv(job)]() mutable {
+      job();
+      e->set_done();
+    });
+  });
+
+  prereqs = event_list(mv(e));
+}
+
+/// Block the calling thread until all the events of the list are completed
+inline void host_events_wait(const event_list& prereqs)
+{
+  for (const auto& e : prereqs)
+  {
+    reserved::host_event(e, reserved::use_dynamic_cast)->wait();
+  }
+}
+
+} // namespace cuda::experimental::stf::reserved
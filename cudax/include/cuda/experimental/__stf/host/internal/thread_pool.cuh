@@ -0,0 +1,286 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of CUDASTF in CUDA C++ Core Libraries,
+// under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES.
+//
+//===----------------------------------------------------------------------===//
+
+/**
+ * @file
+ * @brief Work-stealing pool of CPU threads used by the host_ctx backend
+ */
+
+#pragma once
+
+#include <cuda/__cccl_config>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <cuda/experimental/__stf/utility/unittest.cuh>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace cuda::experimental::stf::reserved
+{
+
+/**
+ * @brief A pool of CPU threads executing jobs, with one queue per thread.
+ *
+ * A job submitted by a worker (for example the successor of a task that just completed) is pushed on the queue of
+ * that worker, which pops its own queue in LIFO order to benefit from cache locality. Jobs submitted from other
+ * threads are distributed over the queues in a round-robin fashion. A worker whose queue is empty steals the oldest
+ * job of another queue, and sleeps when no job is pending. Submitting and running jobs only lock the queues involved,
+ * the lock shared by the workers is only taken to put a worker to sleep or to wake one up.
+ *
+ * The number of threads is given to the constructor, or taken from the `CUDASTF_HOST_THREADS` environment variable,
+ * or from `std::thread::hardware_concurrency()`. Destroying the pool waits for all the submitted jobs.
+ */
+class host_thread_pool
+{
+public:
+  using job_t = ::std::function<void()>;
+
+  explicit host_thread_pool(size_t nthreads = default_thread_count())
+  {
+    nthreads = ::std::max<size_t>(nthreads, 1);
+    queues.reserve(nthreads);
+    for (size_t i = 0; i < nthreads; i++)
+    {
+      queues.push_back(::std::make_unique<queue_t>());
+    }
+
+    workers.reserve(nthreads);
+    for (size_t i = 0; i < nthreads; i++)
+    {
+      workers.emplace_back([this, i] {
+        worker_loop(i);
+      });
+    }
+  }
+
+  host_thread_pool(const host_thread_pool&)            = delete;
+  host_thread_pool& operator=(const host_thread_pool&) = delete;
+
+  ~host_thread_pool()
+  {
+    {
+      ::std::lock_guard<::std::mutex> lock(sleep_mutex);
+      stopping = true;
+    }
+    sleep_cv.notify_all();
+
+    for (auto& w : workers)
+    {
+      w.join();
+    }
+  }
+
+  /// Number of threads of the pool
+  size_t size() const
+  {
+    return workers.size();
+  }
+
+  /// Enqueue a job, which will be executed by one of the threads of the pool
+  void submit(job_t job)
+  {
+    size_t index = (current_pool == this) ? current_worker : next_queue++ % queues.size();
+
+    // The count of pending jobs is incremented before the job is visible, so that it never underflows
+    pending.fetch_add(1);
+
+    {
+      auto& q = *queues[index];
+      ::std::lock_guard<::std::mutex> lock(q.mutex);
+      q.jobs.push_back(::std::move(job));
+    }
+
+    // Either we see the worker that is about to sleep, or it sees the job (both counters are sequentially consistent).
+    // Notifying under the lock makes sure that a worker which has checked the count is waiting when it is notified.
+    if (sleepers.load() > 0)
+    {
+      ::std::lock_guard<::std::mutex> lock(sleep_mutex);
+      sleep_cv.notify_one();
+    }
+  }
+
+  /// Returns true if the calling thread is one of the threads of this pool
+  bool is_worker_thread() const
+  {
+    return current_pool == this;
+  }
+
+  static size_t default_thread_count()
+  {
+    if (const char* env = ::std::getenv("CUDASTF_HOST_THREADS"))
+    {
+      const int n = ::std::atoi(env);
+      if (n > 0)
+      {
+        return size_t(n);
+      }
+    }
+
+    return ::std::max(::std::thread::hardware_concurrency(), 1U);
+  }
+
+private:
+  struct queue_t
+  {
+    ::std::mutex mutex;
+    ::std::deque<job_t> jobs;
+  };
+
+  // Pop a job from the queue of the worker, or steal one from another queue
+  bool try_pop(size_t index, job_t& job)
+  {
+    {
+      auto& q = *queues[index];
+      ::std::lock_guard<::std::mutex> lock(q.mutex);
+      if (!q.jobs.empty())
+      {
+        job = ::std::move(q.jobs.back());
+        q.jobs.pop_back();
+        return true;
+      }
+    }
+
+    for (size_t k = 1; k < queues.size(); k++)
+    {
+      auto& q = *queues[(index + k) % queues.size()];
+      ::std::lock_guard<::std::mutex> lock(q.mutex);
+      if (!q.jobs.empty())
+      {
+        job = ::std::move(q.jobs.front());
+        q.jobs.pop_front();
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  void worker_loop(size_t index)
+  {
+    current_pool   = this;
+    current_worker = index;
+
+    job_t job;
+    for (;;)
+    {
+      if (try_pop(index, job))
+      {
+        pending.fetch_sub(1);
+        job();
+        job = nullptr;
+        continue;
+      }
+
+      ::std::unique_lock<::std::mutex> lock(sleep_mutex);
+      sleepers.fetch_add(1);
+      // A job may have been submitted after our last attempt, in which case the count is not zero
+      sleep_cv.wait(lock, [this] {
+        return pending.load() > 0 || stopping;
+      });
+      sleepers.fetch_sub(1);
+      if (pending.load() == 0 && stopping)
+      {
+        return;
+      }
+    }
+  }
+
+  ::std::vector<::std::unique_ptr<queue_t>> queues;
+  ::std::vector<::std::thread> workers;
+  ::std::atomic<size_t> next_queue = 0;
+
+  // Number of jobs which were submitted but not popped yet, and number of workers going to sleep or sleeping
+  ::std::atomic<size_t> pending  = 0;
+  ::std::atomic<size_t> sleepers = 0;
+  bool stopping                  = false;
+  ::std::mutex sleep_mutex;
+  ::std::condition_variable sleep_cv;
+
+  static inline thread_local const host_thread_pool* current_pool = nullptr;
+  static inline thread_local size_t current_worker                = 0;
+};
+
+#ifdef UNITTESTED_FILE
+UNITTEST("host_thread_pool nested submissions")
+{
+  constexpr size_t num_roots = 64;
+  constexpr size_t depth     = 256;
+
+  ::std::atomic<size_t> executed = 0;
+  // Declared before the pool, which may still run jobs calling it until it is destroyed
+  ::std::function<void(size_t)> chain;
+  {
+    host_thread_pool pool(4);
+
+    // Each root job submits a chain of jobs from the workers, which may be stolen by other workers
+    chain = [&](size_t remaining) {
+      executed++;
+      if (remaining > 0)
+      {
+        pool.submit([&chain, remaining] {
+          chain(remaining - 1);
+        });
+      }
+    };
+
+    for (size_t i = 0; i < num_roots; i++)
+    {
+      pool.submit([&pool, &chain] {
+        EXPECT(pool.is_worker_thread());
+        chain(depth - 1);
+      });
+    }
+    // Destroying the pool waits for all the jobs, including the ones submitted by jobs
+  }
+
+  EXPECT(executed.load() == num_roots * depth);
+};
+
+UNITTEST("host_thread_pool wakes up sleeping workers")
+{
+  host_thread_pool pool(4);
+  EXPECT(!pool.is_worker_thread());
+
+  // Give the workers time to go to sleep before each job, a lost wake up would never complete
+  for (size_t i = 0; i < 100; i++)
+  {
+    ::std::this_thread::sleep_for(::std::chrono::microseconds(100));
+
+    ::std::atomic<bool> done = false;
+    pool.submit([&pool, &done] {
+      EXPECT(pool.is_worker_thread());
+      done = true;
+    });
+    while (!done)
+    {
+      ::std::this_thread::yield();
+    }
+  }
+};
+#endif // UNITTESTED_FILE
+
+} // namespace cuda::experimental::stf::reserved
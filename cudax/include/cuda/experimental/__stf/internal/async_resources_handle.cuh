@@ -386,7 +386,7 @@ private:
     // stores a pool of streams on this device
     ::std::vector<::std::pair<stream_pool, stream_pool>> pool;
 
-    /* Store previously instantiated graphs, indexed by the number of edges and nodes */
+    /* Store previously instantiated graphs, indexed by their structural fingerprint */
     executable_graph_cache cached_graphs;
 
     ::std::vector<::std::shared_ptr<green_context_helper>> per_device_gc_helper;
@@ -433,10 +433,19 @@ public:
   }
 
   _CUDA_VSTD::pair<::std::shared_ptr<cudaGraphExec_t>, bool>
-  cached_graphs_query(size_t nnodes, size_t nedges, ::std::shared_ptr<cudaGraph_t> g)
+  cached_graphs_query(const reserved::graph_fingerprint& fingerprint,
+                      ::std::shared_ptr<cudaGraph_t> g,
+                      size_t* failed_updates = nullptr)
   {
     assert(pimpl);
-    return pimpl->cached_graphs.query(nnodes, nedges, mv(g));
+    return pimpl->cached_graphs.query(fingerprint, mv(g), failed_updates);
+  }
+
+  // Hits, misses, failed updates and evictions of the executable graph cache, for all devices
+  const executable_graph_cache::statistics& graph_cache_statistics() const
+  {
+    assert(pimpl);
+    return pimpl->cached_graphs.get_statistics();
   }
 
   // Get the green context helper cached for this device (or let the user initialize it)
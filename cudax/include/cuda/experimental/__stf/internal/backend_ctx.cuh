@@ -81,6 +81,8 @@ class host_launch_scope;
 template <typename Ctx, bool chained, typename... Deps>
 class cuda_kernel_scope;
 
+class host_thread_pool;
+
 // We need to have a map of logical data stored in the ctx.
 class logical_data_untyped_impl;
 
@@ -118,20 +120,25 @@ protected:
   public:
     friend class backend_ctx_untyped;
 
-    impl(async_resources_handle async_resources = async_resources_handle())
+    // Backends which do not use CUDA (host_ctx) set `uses_cuda` to false, so
+    // that neither CUDA nor the asynchronous resources are initialized
+    impl(async_resources_handle async_resources = async_resources_handle(), bool uses_cuda = true)
         : auto_scheduler(reserved::scheduler::make(getenv("CUDASTF_SCHEDULE")))
         , auto_reorderer(reserved::reorderer::make(getenv("CUDASTF_TASK_ORDER")))
-        , async_resources(async_resources ? mv(async_resources) : async_resources_handle())
+        , async_resources((async_resources || !uses_cuda) ? mv(async_resources) : async_resources_handle())
     {
-      // Forces init
-      cudaError_t ret = cudaFree(0);
+      if (uses_cuda)
+      {
+        // Forces init
+        cudaError_t ret = cudaFree(0);
 
-      // If we are running the task in the context of a CUDA callback, we are
-      // not allowed to issue any CUDA API call.
-      EXPECT((ret == cudaSuccess || ret == cudaErrorNotPermitted));
+        // If we are running the task in the context of a CUDA callback, we are
+        // not allowed to issue any CUDA API call.
+        EXPECT((ret == cudaSuccess || ret == cudaErrorNotPermitted));
 
-      // Enable peer memory accesses (if not done already)
-      reserved::machine::instance().enable_peer_accesses();
+        // Enable peer memory accesses (if not done already)
+        reserved::machine::instance().enable_peer_accesses();
+      }
 
       // If CUDASTF_DISPLAY_STATS is set to a non 0 value, record stats
       const char* record_stats_env = getenv("CUDASTF_DISPLAY_STATS");
@@ -145,6 +152,7 @@ protected:
         reserved::dot::instance().is_tracing(),
         reserved::dot::instance().is_tracing_prereqs(),
         reserved::dot::instance().is_timing());
+      dot->set_trace(reserved::dot::instance().get_trace(), reserved::dot::instance().is_generating_dot());
 
       // We generate symbols if we may use them
       generate_event_symbols = dot->is_tracing_prereqs();
@@ -219,6 +227,12 @@ protected:
       return size_t(-1);
     }
 
+    // Pool of CPU threads executing the tasks, only defined in the host backend
+    virtual reserved::host_thread_pool* host_pool()
+    {
+      return nullptr;
+    }
+
     virtual ::std::string to_string() const = 0;
 
     /**
@@ -266,6 +280,11 @@ protected:
       // Deinitialize all attached allocators in reversed order
       for (auto it : each(attached_allocators.rbegin(), attached_allocators.rend()))
       {
+        if (is_recording_stats)
+        {
+          it->print_info();
+        }
+
         auto deinit_res = it->deinit(bctx);
         if (track_dangling)
         {
@@ -755,6 +774,11 @@ public:
     return pimpl->epoch();
   }
 
+  reserved::host_thread_pool* host_pool() const
+  {
+    return pimpl->host_pool();
+  }
+
   ::std::string to_string() const
   {
     return pimpl->to_string();
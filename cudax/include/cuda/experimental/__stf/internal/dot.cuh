@@ -19,6 +19,9 @@
  * CUDASTF_DOT_REMOVE_DATA_DEPS
  * CUDASTF_DOT_TIMING
  * CUDASTF_DOT_MAX_DEPTH
+ * CUDASTF_TRACE_FILE
+ *
+ * @see trace_file.cuh for a streaming alternative which does not keep the graph in memory
  */
 
 #pragma once
@@ -34,6 +37,7 @@
 #endif // no system header
 
 #include <cuda/experimental/__stf/internal/constants.cuh>
+#include <cuda/experimental/__stf/internal/trace_file.cuh>
 #include <cuda/experimental/__stf/utility/cuda_safe_call.cuh>
 #include <cuda/experimental/__stf/utility/hash.cuh>
 #include <cuda/experimental/__stf/utility/nvtx.cuh>
@@ -101,6 +105,16 @@ public:
       return;
     }
 
+    if (trace)
+    {
+      trace->add_fence(unique_id, id);
+    }
+
+    if (!keep_in_memory)
+    {
+      return;
+    }
+
     ::std::lock_guard<::std::mutex> guard(mtx);
 
     vertices.push_back(unique_id);
@@ -116,6 +130,16 @@ public:
       return;
     }
 
+    if (trace)
+    {
+      trace->add_prereq(prereq_unique_id, id, symbol);
+    }
+
+    if (!keep_in_memory)
+    {
+      return;
+    }
+
     ::std::lock_guard<::std::mutex> guard(mtx);
 
     vertices.push_back(prereq_unique_id);
@@ -153,6 +177,16 @@ public:
       return;
     }
 
+    if (trace)
+    {
+      trace->add_edge(id_from, id_to, style);
+    }
+
+    if (!keep_in_memory)
+    {
+      return;
+    }
+
     auto p = ::std::pair(id_from, id_to);
 
     // Note that since this is a set, there is no need to check if that
@@ -177,16 +211,6 @@ public:
       return;
     }
 
-    set_current_color_by_device(guard);
-
-    vertices.push_back(t.get_unique_id());
-
-    auto& task_metadata = metadata[t.get_unique_id()];
-
-    task_metadata.color = get_current_color();
-
-    task_metadata.dot_section_id = get_current_section_id();
-
     // We here create the label of the task, which we may augment later with
     // timing information for example
     ::std::ostringstream task_oss;
@@ -205,7 +229,25 @@ public:
       }
     }
 
-    task_metadata.label = task_oss.str();
+    if (trace)
+    {
+      trace->add_vertex(t.get_unique_id(), id, get_current_section_id(), task_oss.str());
+    }
+
+    if (!keep_in_memory)
+    {
+      return;
+    }
+
+    set_current_color_by_device(guard);
+
+    vertices.push_back(t.get_unique_id());
+
+    auto& task_metadata = metadata[t.get_unique_id()];
+
+    task_metadata.color          = get_current_color();
+    task_metadata.dot_section_id = get_current_section_id();
+    task_metadata.label          = task_oss.str();
   }
 
   template <typename task_type>
@@ -218,6 +260,16 @@ public:
       return;
     }
 
+    if (trace)
+    {
+      trace->add_timing(t.get_unique_id(), time_ms, device, t.get_symbol());
+    }
+
+    if (!keep_in_memory)
+    {
+      return;
+    }
+
     oss << "// " << t.get_unique_id() << " : mapping_id=" << t.get_mapping_id() << " time=" << time_ms
         << " device=" << device << "\n";
 
@@ -278,6 +330,18 @@ public:
     return discarded_tasks.find(id) != discarded_tasks.end();
   }
 
+  /**
+   * @brief Stream the activity of this context to a trace file
+   *
+   * @param t The trace writer, or nullptr to disable streaming
+   * @param in_memory Whether the graph must also be kept in memory to generate a DOT file at the end of the execution
+   */
+  void set_trace(::std::shared_ptr<trace_writer> t, bool in_memory)
+  {
+    trace          = mv(t);
+    keep_in_memory = in_memory;
+  }
+
   static void set_parent_ctx(::std::shared_ptr<per_ctx_dot> parent_dot, ::std::shared_ptr<per_ctx_dot> child_dot)
   {
     parent_dot->children.push_back(child_dot);
@@ -316,6 +380,12 @@ public:
   // We may temporarily discard some tasks
   bool tracing_enabled = true;
 
+  // Records are streamed to this file if set
+  ::std::shared_ptr<trace_writer> trace;
+
+  // Disabled when only streaming to a trace file, to avoid accumulating the whole graph
+  bool keep_in_memory = true;
+
   // A palette of colors
   const char* const colors[8] = {"#ff5500", "#66ccff", "#9933cc", "#00cc66", "#ffcc00", "#00b3e6", "#cc0066", "#009933"};
 
@@ -432,6 +502,11 @@ public:
       // Save the section in the map
       dot::instance().map[id] = sec;
 
+      if (auto& trace = dot::instance().trace)
+      {
+        trace->add_section(id, parent_id, sec->get_symbol());
+      }
+
       // Add the section to the children of its parent if that was not the root
       if (parent_id > 0)
       {
@@ -494,13 +569,22 @@ protected:
   {
     ::std::lock_guard<::std::mutex> lock(mtx);
 
+    // Records are streamed to this file as they are produced, independently of the DOT file
+    if (const char* trace_filename = getenv("CUDASTF_TRACE_FILE"))
+    {
+      trace = ::std::make_shared<trace_writer>(trace_filename);
+    }
+
     const char* filename = getenv("CUDASTF_DOT_FILE");
-    if (!filename)
+    if (!filename && !trace)
     {
       return;
     }
 
-    dot_filename = filename;
+    if (filename)
+    {
+      dot_filename = filename;
+    }
     //::std::cout << "Creating a DOT file in " << filename << ::std::endl;
 
     const char* ignore_prereqs_str = getenv("CUDASTF_DOT_IGNORE_PREREQS");
@@ -517,10 +601,21 @@ protected:
 
 public:
   bool is_tracing() const
+  {
+    return !dot_filename.empty() || trace;
+  }
+
+  // Is the whole graph kept in memory to generate a DOT file when the application ends ?
+  bool is_generating_dot() const
   {
     return !dot_filename.empty();
   }
 
+  const ::std::shared_ptr<trace_writer>& get_trace() const
+  {
+    return trace;
+  }
+
   bool is_tracing_prereqs()
   {
     return tracing_prereqs;
@@ -544,6 +639,13 @@ public:
   {
     single_threaded_section guard(mtx);
 
+    if (trace)
+    {
+      // Contexts may still hold the writer, but records added afterwards are ignored
+      trace->close();
+      trace.reset();
+    }
+
     if (dot_filename.empty())
     {
       return;
@@ -1157,6 +1259,9 @@ private:
 
   ::std::string dot_filename;
 
+  // Streaming trace, if CUDASTF_TRACE_FILE is set
+  ::std::shared_ptr<trace_writer> trace;
+
   // Map to get dot sections from their ID
   ::std::unordered_map<int, ::std::shared_ptr<section>> map;
 
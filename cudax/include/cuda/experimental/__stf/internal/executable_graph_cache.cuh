@@ -26,12 +26,14 @@
 #endif // no system header
 
 #include <cuda/experimental/__stf/utility/cuda_safe_call.cuh>
-#include <cuda/experimental/__stf/utility/hash.cuh> // for ::std::hash<::std::pair<::std::ptrdiff_t, ::std::ptrdiff_t>>
+#include <cuda/experimental/__stf/utility/hash.cuh> // for hash_combine
 #include <cuda/experimental/__stf/utility/pretty_print.cuh>
 #include <cuda/experimental/__stf/utility/source_location.cuh>
 
+#include <algorithm>
 #include <queue> // for ::std::priority_queue
 #include <unordered_map>
+#include <vector>
 
 namespace cuda::experimental::stf
 {
@@ -72,6 +74,171 @@ inline ::std::shared_ptr<cudaGraphExec_t> graph_instantiate(cudaGraph_t g)
   return res;
 }
 
+/**
+ * @brief Summary of the structure of a CUDA graph, used to find executable graphs which may be updated with it
+ *
+ * Two graphs with different fingerprints cannot be used to update each other, so that the cache only attempts to
+ * update executable graphs instantiated from a graph with the same fingerprint.
+ */
+struct graph_fingerprint
+{
+  // Hash of the topology of the graph, and of the type and fixed parameters of its nodes (child graphs are hashed
+  // recursively)
+  size_t hash   = 0;
+  size_t nnodes = 0;
+  size_t nedges = 0;
+  // Estimated size of the executable graph, in bytes
+  size_t footprint = 0;
+
+  bool operator==(const graph_fingerprint& other) const
+  {
+    return hash == other.hash && nnodes == other.nnodes && nedges == other.nedges;
+  }
+
+  bool operator!=(const graph_fingerprint& other) const
+  {
+    return !(*this == other);
+  }
+};
+
+/**
+ * @brief Rough estimate of the memory used by a node once the graph is instantiated
+ *
+ * Kernel nodes keep a copy of their parameters and launch configuration, copies and host callbacks are lighter, and
+ * nodes which do not perform any work are almost free.
+ */
+inline size_t graph_node_footprint(cudaGraphNodeType type)
+{
+  switch (type)
+  {
+    case cudaGraphNodeTypeKernel:
+      return 10240;
+    case cudaGraphNodeTypeMemcpy:
+    case cudaGraphNodeTypeMemset:
+    case cudaGraphNodeTypeHost:
+    case cudaGraphNodeTypeMemAlloc:
+    case cudaGraphNodeTypeMemFree:
+      return 4096;
+    default:
+      return 1024;
+  }
+}
+
+/**
+ * @brief Hash the parameters of a node which cannot be changed by `cudaGraphExecUpdate`
+ *
+ * An executable graph can only be updated with a copy or memset node if its memory operands are of the same kind
+ * (pointer or array) and type, and belong to the same device, so these are part of the fingerprint. Graphs which only
+ * differ by such parameters are not tried against each other's executable graphs.
+ */
+inline void hash_graph_node_params(size_t& hash, cudaGraphNode_t node, cudaGraphNodeType type)
+{
+  auto hash_pointer = [&](const void* ptr) {
+    cudaPointerAttributes attr{};
+    cuda_safe_call(cudaPointerGetAttributes(&attr, ptr));
+    hash_combine(hash, int(attr.type));
+    hash_combine(hash, attr.device);
+  };
+
+  switch (type)
+  {
+    case cudaGraphNodeTypeMemcpy: {
+      cudaMemcpy3DParms p{};
+      cuda_safe_call(cudaGraphMemcpyNodeGetParams(node, &p));
+      hash_combine(hash, int(p.kind));
+      hash_combine(hash, p.srcArray != nullptr);
+      hash_combine(hash, p.dstArray != nullptr);
+      if (p.srcArray == nullptr)
+      {
+        hash_pointer(p.srcPtr.ptr);
+      }
+      if (p.dstArray == nullptr)
+      {
+        hash_pointer(p.dstPtr.ptr);
+      }
+      break;
+    }
+    case cudaGraphNodeTypeMemset: {
+      cudaMemsetParams p{};
+      cuda_safe_call(cudaGraphMemsetNodeGetParams(node, &p));
+      hash_combine(hash, p.elementSize);
+      hash_pointer(p.dst);
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+/**
+ * @brief Compute the fingerprint of a CUDA graph from the type of its nodes, in creation order, from the parameters of
+ * its nodes which cannot be updated, and from its edges
+ */
+inline graph_fingerprint compute_graph_fingerprint(cudaGraph_t g)
+{
+  graph_fingerprint result;
+
+  cuda_safe_call(cudaGraphGetNodes(g, nullptr, &result.nnodes));
+  ::std::vector<cudaGraphNode_t> nodes(result.nnodes);
+  if (result.nnodes > 0)
+  {
+    cuda_safe_call(cudaGraphGetNodes(g, nodes.data(), &result.nnodes));
+  }
+
+  // Nodes are identified by their index so that the fingerprint does not depend on the addresses of the nodes
+  ::std::unordered_map<cudaGraphNode_t, size_t> node_index;
+  node_index.reserve(result.nnodes);
+
+  hash_combine(result.hash, result.nnodes);
+  for (size_t i = 0; i < nodes.size(); i++)
+  {
+    node_index[nodes[i]] = i;
+
+    cudaGraphNodeType type;
+    cuda_safe_call(cudaGraphNodeGetType(nodes[i], &type));
+    hash_combine(result.hash, int(type));
+    hash_graph_node_params(result.hash, nodes[i], type);
+
+    if (type == cudaGraphNodeTypeGraph)
+    {
+      // The topology of a child graph must also match to update the node
+      cudaGraph_t child;
+      cuda_safe_call(cudaGraphChildGraphNodeGetGraph(nodes[i], &child));
+      auto child_fingerprint = compute_graph_fingerprint(child);
+      hash_combine(result.hash, child_fingerprint.hash);
+      result.footprint += child_fingerprint.footprint;
+    }
+    else
+    {
+      result.footprint += graph_node_footprint(type);
+    }
+  }
+
+  cuda_safe_call(cudaGraphGetEdges(g, nullptr, nullptr, &result.nedges));
+  if (result.nedges > 0)
+  {
+    ::std::vector<cudaGraphNode_t> from(result.nedges), to(result.nedges);
+    cuda_safe_call(cudaGraphGetEdges(g, from.data(), to.data(), &result.nedges));
+
+    // Sort edges so that the fingerprint does not depend on the order in which dependencies were added
+    ::std::vector<::std::pair<size_t, size_t>> edges(result.nedges);
+    for (size_t i = 0; i < result.nedges; i++)
+    {
+      edges[i] = {node_index[from[i]], node_index[to[i]]};
+    }
+    ::std::sort(edges.begin(), edges.end());
+
+    hash_combine(result.hash, result.nedges);
+    for (const auto& e : edges)
+    {
+      hash_combine(result.hash, e.first);
+      hash_combine(result.hash, e.second);
+    }
+  }
+
+  return result;
+}
+
 } // end namespace reserved
 
 // To get information about how it was used
@@ -82,6 +249,8 @@ public:
   size_t update_cnt      = 0;
   size_t nnodes          = 0;
   size_t nedges          = 0;
+  // Number of executable graphs with a matching fingerprint which could not be updated
+  size_t failed_update_cnt = 0;
 };
 
 class executable_graph_cache
@@ -108,6 +277,57 @@ public:
 
     // Initialize the footprint per device too
     total_cache_footprint.resize(ndevices, 0);
+
+    const char* display_stats_env = getenv("CUDASTF_DISPLAY_STATS");
+    display_stats                 = display_stats_env && atoi(display_stats_env) != 0;
+  }
+
+  ~executable_graph_cache()
+  {
+    if (display_stats)
+    {
+      print_info();
+    }
+  }
+
+  executable_graph_cache(const executable_graph_cache&)            = delete;
+  executable_graph_cache& operator=(const executable_graph_cache&) = delete;
+
+  // Statistics of the cache, for all devices
+  struct statistics
+  {
+    size_t hits           = 0;
+    size_t misses         = 0;
+    size_t failed_updates = 0;
+    size_t evictions      = 0;
+  };
+
+  const statistics& get_statistics() const
+  {
+    return stats;
+  }
+
+  /**
+   * @brief Prints the hit and miss counters of the cache, and the number of update attempts which failed
+   */
+  void print_info() const
+  {
+    const size_t total = stats.hits + stats.misses;
+    size_t footprint   = 0;
+    for (auto f : total_cache_footprint)
+    {
+      footprint += f;
+    }
+
+    fprintf(stderr,
+            "executable graph cache: %zu hits, %zu misses (%.1f%% hit rate), %zu failed updates, %zu evictions, %s "
+            "cached (estimated)\n",
+            stats.hits,
+            stats.misses,
+            total == 0 ? 0.0 : 100.0 * stats.hits / total,
+            stats.failed_updates,
+            stats.evictions,
+            pretty_print_bytes(footprint).c_str());
   }
 
   // One entry of the cache
@@ -133,48 +353,56 @@ public:
     size_t footprint;
   };
 
-  // TODO we should not have to redefine this one again
-  struct hash_pair
-  {
-    size_t operator()(const std::pair<size_t, size_t>& p) const
-    {
-      auto h1 = ::std::hash<size_t>{}(p.first); // Hash the first element
-      auto h2 = ::std::hash<size_t>{}(p.second); // Hash the second element
-      return h1 ^ (h2 << 1); // Combine the two hash values
-    }
-  };
-
-  // On each device, we have a map indexed by pairs of edge/vertex count
-  using per_device_map_t = ::std::unordered_multimap<::std::pair<size_t, size_t>, entry, hash_pair>;
+  // On each device, we have a map indexed by the hash of the fingerprint of the graphs
+  using per_device_map_t = ::std::unordered_multimap<size_t, ::std::pair<reserved::graph_fingerprint, entry>>;
 
   // Check if there is a matching entry (and update it if necessary)
   // the returned bool indicate is this is a cache hit (true = cache hit, false = cache miss)
+  //
+  // If `failed_updates` is not null, it is incremented for every executable graph that could not be updated
   _CUDA_VSTD::pair<::std::shared_ptr<cudaGraphExec_t>, bool>
-  query(size_t nnodes, size_t nedges, ::std::shared_ptr<cudaGraph_t> g)
+  query(const reserved::graph_fingerprint& fingerprint,
+        ::std::shared_ptr<cudaGraph_t> g,
+        size_t* failed_updates = nullptr)
   {
     int dev_id = cuda_try<cudaGetDevice>();
     _CCCL_ASSERT(dev_id < int(cached_graphs.size()), "invalid device id value");
 
-    auto range = cached_graphs[dev_id].equal_range({nnodes, nedges});
+    auto range = cached_graphs[dev_id].equal_range(fingerprint.hash);
     for (auto it = range.first; it != range.second; ++it)
     {
-      auto& e = it->second;
+      // Skip hash collisions
+      if (it->second.first != fingerprint)
+      {
+        continue;
+      }
+
+      auto& e = it->second.second;
       if (reserved::try_updating_executable_graph(*e.exec_g, *g))
       {
         // update the last use index for the LRU algorithm
         e.lru_refresh();
 
         // We have successfully updated the graph, this is a cache hit
+        stats.hits++;
         return _CUDA_VSTD::make_pair(e.exec_g, true);
       }
+
+      // Same structure, but some node could not be updated (e.g. a memory allocation node)
+      stats.failed_updates++;
+      if (failed_updates)
+      {
+        (*failed_updates)++;
+      }
     }
 
+    stats.misses++;
+
     // There was no match, so we ensure we have enough memory (or reclaim
     // some), and then instantiate a new graph and put it in the cache.
 
-    // Rough footprint estimate of the graph based on the number of nodes (this
-    // is really an approximation)
-    size_t footprint = nnodes * 10240;
+    // The footprint is estimated from the type of the nodes (this is really an approximation)
+    const size_t footprint = fingerprint.footprint;
     if (total_cache_footprint[dev_id] + footprint > cache_size_limit)
     {
       reclaim(dev_id, total_cache_footprint[dev_id] + footprint - cache_size_limit);
@@ -185,7 +413,7 @@ public:
     // If we maintain a cache, store the executable graph
     if (cache_size_limit != 0)
     {
-      cached_graphs[dev_id].insert({::std::make_pair(nnodes, nedges), entry(this, exec_g, footprint)});
+      cached_graphs[dev_id].insert({fingerprint.hash, {fingerprint, entry(this, exec_g, footprint)}});
       total_cache_footprint[dev_id] += footprint;
     }
 
@@ -200,7 +428,7 @@ private:
     // Use a priority queue (min-heap) to track least recently used entries
     using entry_iter = per_device_map_t::iterator;
     auto cmp         = [](const entry_iter& a, const entry_iter& b) {
-      return a->second.last_use > b->second.last_use;
+      return a->second.second.last_use > b->second.second.last_use;
     };
     ::std::priority_queue<entry_iter, ::std::vector<entry_iter>, decltype(cmp)> lru_queue(cmp);
 
@@ -216,9 +444,10 @@ private:
       auto lru_it = lru_queue.top();
       lru_queue.pop();
 
-      reclaimed += lru_it->second.footprint;
-      total_cache_footprint[dev_id] -= lru_it->second.footprint;
+      reclaimed += lru_it->second.second.footprint;
+      total_cache_footprint[dev_id] -= lru_it->second.second.footprint;
       cached_graphs[dev_id].erase(lru_it);
+      stats.evictions++;
     }
 
 #if 0
@@ -230,7 +459,7 @@ private:
 #endif
   }
 
-  // cached graphs index per device, then index per pair of edge/vertex count within each device
+  // cached graphs index per device, then index per fingerprint within each device
   ::std::vector<per_device_map_t> cached_graphs;
 
   // To keep track of the last recently used entries, we have an entry of
@@ -240,6 +469,11 @@ private:
   ::std::vector<size_t> total_cache_footprint;
 
   size_t cache_size_limit;
+
+  statistics stats;
+
+  // Set if CUDASTF_DISPLAY_STATS is set to a non 0 value
+  bool display_stats = false;
 };
 
 } // namespace cuda::experimental::stf
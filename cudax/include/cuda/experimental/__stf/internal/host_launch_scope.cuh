@@ -37,6 +37,7 @@ namespace cuda::experimental::stf
 {
 
 class graph_ctx;
+class host_ctx;
 class stream_ctx;
 
 namespace reserved
@@ -115,15 +116,22 @@ public:
     SCOPE(exit)
     {
       t.end_uncleared();
-      if constexpr (::std::is_same_v<Ctx, stream_ctx>)
+      if constexpr (::std::is_same_v<Ctx, stream_ctx> || ::std::is_same_v<Ctx, host_ctx>)
       {
         if (record_time)
         {
-          cuda_safe_call(cudaEventRecord(end_event, t.get_stream()));
-          cuda_safe_call(cudaEventSynchronize(end_event));
-
           float milliseconds = 0;
-          cuda_safe_call(cudaEventElapsedTime(&milliseconds, start_event, end_event));
+          if constexpr (::std::is_same_v<Ctx, host_ctx>)
+          {
+            t.wait();
+            milliseconds = t.elapsed_ms();
+          }
+          else
+          {
+            cuda_safe_call(cudaEventRecord(end_event, t.get_stream()));
+            cuda_safe_call(cudaEventSynchronize(end_event));
+            cuda_safe_call(cudaEventElapsedTime(&milliseconds, start_event, end_event));
+          }
 
           if (dot.is_tracing())
           {
@@ -188,6 +196,11 @@ public:
       auto lock = t.lock_ctx_graph();
       cuda_safe_call(cudaGraphAddHostNode(&t.get_node(), t.get_ctx_graph(), nullptr, 0, &params));
     }
+    else if constexpr (::std::is_same_v<Ctx, host_ctx>)
+    {
+      // Executed by the thread pool once the dependencies of the task are fulfilled
+      t.enqueue(callback, wrapper);
+    }
     else
     {
       cuda_safe_call(cudaLaunchHostFunc(t.get_stream(), callback, wrapper));
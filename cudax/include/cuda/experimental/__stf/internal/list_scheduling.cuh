@@ -0,0 +1,851 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of CUDASTF in CUDA C++ Core Libraries,
+// under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES.
+//
+//===----------------------------------------------------------------------===//
+
+/**
+ * @file
+ *
+ * @brief Host-only list scheduling of task graphs on multiple devices
+ *
+ * This implements a windowed look-ahead variant of HEFT, which orders tasks by upward rank and places them with an
+ * insertion-based policy, as well as the simpler policies used by the schedulers of CUDASTF. All policies share the
+ * same cost model, so that the makespans of their schedules can be compared by `simulate_makespan`, without any
+ * device, on task graphs recorded with CUDASTF_TASK_GRAPH_FILE.
+ */
+
+#pragma once
+
+#include <cuda/__cccl_config>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <cuda/experimental/__stf/internal/constants.cuh>
+#include <cuda/experimental/__stf/utility/core.cuh>
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cuda::experimental::stf::reserved
+{
+
+/**
+ * @brief Access of a task to a piece of data
+ *
+ * Data are identified by the unique id of their logical data, the symbol is only displayed, and several logical data
+ * may have the same symbol.
+ */
+struct list_sched_access
+{
+  int data_id = -1;
+  ::std::string symbol;
+  size_t footprint = 0;
+  access_mode mode = access_mode::none;
+  // Copies of the data which are valid before the tasks are scheduled : the devices holding one, and whether another
+  // place (such as the host) does. Data without any valid copy need no transfer.
+  ::std::vector<int> valid_devices;
+  bool valid_on_host = true;
+
+  bool reads() const
+  {
+    return mode == access_mode::read || mode == access_mode::rw || mode == access_mode::reduce_no_init;
+  }
+
+  bool writes() const
+  {
+    return mode != access_mode::read && mode != access_mode::none;
+  }
+};
+
+/**
+ * @brief Task of a graph handled by the list schedulers
+ */
+struct list_sched_task
+{
+  int id = -1;
+  ::std::string symbol;
+  // Estimated duration of the task (in ms)
+  double cost = 0.0;
+  // Device on which the task must run, or -1 if the scheduler may select any device
+  int device = -1;
+  ::std::vector<int> predecessors;
+  ::std::vector<int> successors;
+  ::std::vector<list_sched_access> accesses;
+};
+
+/**
+ * @brief A task graph. Tasks are stored in submission order, which must be a valid topological order.
+ *
+ * Graphs can be saved and loaded as CSV files with one task per line : `id,symbol,cost,predecessors,accesses,device`,
+ * where predecessors are separated by `;`, accesses are `data_id:symbol:mode:bytes:copies` items separated by `;`,
+ * and the device is -1 for tasks which may run on any device. The initially valid copies of the data are `|`
+ * separated device ordinals, and `h` for the host. Files without the device column, with accesses without copies
+ * (the data is then in host memory), or with `symbol:mode:bytes` accesses identifying data by their symbol, are also
+ * read.
+ */
+class list_sched_graph
+{
+public:
+  list_sched_task& add_task(int id, ::std::string symbol, double cost)
+  {
+    _CCCL_ASSERT(index.count(id) == 0, "duplicate task id");
+    index[id] = tasks.size();
+
+    list_sched_task t;
+    t.id     = id;
+    t.symbol = mv(symbol);
+    t.cost   = cost;
+    tasks.push_back(mv(t));
+    return tasks.back();
+  }
+
+  /// Add a dependency between two tasks which were already added
+  void add_dependency(int pred, int succ)
+  {
+    _CCCL_ASSERT(index.at(pred) < index.at(succ), "dependencies must follow the submission order");
+    at(pred).successors.push_back(succ);
+    at(succ).predecessors.push_back(pred);
+  }
+
+  const ::std::vector<list_sched_task>& get_tasks() const
+  {
+    return tasks;
+  }
+
+  size_t size() const
+  {
+    return tasks.size();
+  }
+
+  list_sched_task& at(int id)
+  {
+    return tasks[index.at(id)];
+  }
+
+  const list_sched_task& at(int id) const
+  {
+    return tasks[index.at(id)];
+  }
+
+  /// Position of a task in the submission order
+  size_t position(int id) const
+  {
+    return index.at(id);
+  }
+
+  void write(::std::ostream& os) const
+  {
+    os << "id,symbol,cost,predecessors,accesses,device\n";
+    for (const auto& t : tasks)
+    {
+      os << t.id << ',' << sanitize(t.symbol) << ',' << t.cost << ',';
+      for (size_t i = 0; i < t.predecessors.size(); i++)
+      {
+        os << (i > 0 ? ";" : "") << t.predecessors[i];
+      }
+      os << ',';
+      for (size_t i = 0; i < t.accesses.size(); i++)
+      {
+        const auto& a = t.accesses[i];
+        os << (i > 0 ? ";" : "") << a.data_id << ':' << sanitize(a.symbol) << ':' << access_mode_name(a.mode) << ':'
+           << a.footprint << ':' << (a.valid_on_host ? "h" : "");
+        for (size_t j = 0; j < a.valid_devices.size(); j++)
+        {
+          os << (j > 0 || a.valid_on_host ? "|" : "") << a.valid_devices[j];
+        }
+      }
+      os << ',' << t.device << '\n';
+    }
+  }
+
+  void write(const ::std::string& filename) const
+  {
+    ::std::ofstream file(filename);
+    EXPECT(file, "Failed to write task graph file '", filename, "'.");
+    write(file);
+  }
+
+  static list_sched_graph read(::std::istream& is)
+  {
+    list_sched_graph g;
+
+    // Ids of the data identified by their symbol
+    ::std::unordered_map<::std::string, int> symbol_ids;
+
+    int current_line = 0;
+    for (::std::string line; ::std::getline(is, line); ++current_line)
+    {
+      // Skip the csv header
+      if (current_line == 0 || line.empty())
+      {
+        continue;
+      }
+
+      ::std::vector<::std::string> cells = split(line, ',');
+      EXPECT((cells.size() == 5 || cells.size() == 6), "Invalid task graph line ", current_line, ": '", line, "'.");
+
+      auto& t = g.add_task(::std::stoi(cells[0]), cells[1], ::std::stod(cells[2]));
+      if (cells.size() == 6)
+      {
+        t.device = ::std::stoi(cells[5]);
+      }
+      const int id = t.id;
+
+      for (const auto& s : split(cells[4], ';'))
+      {
+        if (s.empty())
+        {
+          continue;
+        }
+        auto fields = split(s, ':');
+        EXPECT((fields.size() >= 3 && fields.size() <= 5), "Invalid access '", s, "' on line ", current_line, ".");
+        if (fields.size() == 3)
+        {
+          const int data_id = symbol_ids.try_emplace(fields[0], int(symbol_ids.size())).first->second;
+          fields.insert(fields.begin(), ::std::to_string(data_id));
+        }
+        list_sched_access a{
+          ::std::stoi(fields[0]), fields[1], ::std::stoul(fields[3]), access_mode_from_name(fields[2])};
+        if (fields.size() == 5)
+        {
+          a.valid_on_host = false;
+          for (const auto& copy : split(fields[4], '|'))
+          {
+            if (copy == "h")
+            {
+              a.valid_on_host = true;
+            }
+            else if (!copy.empty())
+            {
+              a.valid_devices.push_back(::std::stoi(copy));
+            }
+          }
+        }
+        g.at(id).accesses.push_back(mv(a));
+      }
+
+      for (const auto& p : split(cells[3], ';'))
+      {
+        if (p.empty())
+        {
+          continue;
+        }
+        g.add_dependency(::std::stoi(p), id);
+      }
+    }
+
+    return g;
+  }
+
+  static list_sched_graph read(const ::std::string& filename)
+  {
+    ::std::ifstream file(filename);
+    EXPECT(file, "Failed to read task graph file '", filename, "'.");
+    return read(file);
+  }
+
+private:
+  static ::std::string sanitize(::std::string s)
+  {
+    for (auto& c : s)
+    {
+      if (c == ',' || c == ';' || c == ':' || c == '\n')
+      {
+        c = '_';
+      }
+    }
+    return s;
+  }
+
+  // Split a string, empty items are kept so that the number of columns is preserved
+  static ::std::vector<::std::string> split(const ::std::string& s, char sep)
+  {
+    ::std::vector<::std::string> res(1);
+    for (char c : s)
+    {
+      if (c == sep)
+      {
+        res.emplace_back();
+      }
+      else
+      {
+        res.back().push_back(c);
+      }
+    }
+    return res;
+  }
+
+  static const char* access_mode_name(access_mode m)
+  {
+    switch (m)
+    {
+      case access_mode::read:
+        return "read";
+      case access_mode::write:
+      case access_mode::reduce:
+        return "write";
+      case access_mode::none:
+        return "none";
+      default:
+        return "rw";
+    }
+  }
+
+  static access_mode access_mode_from_name(const ::std::string& s)
+  {
+    if (s == "read")
+    {
+      return access_mode::read;
+    }
+    if (s == "write")
+    {
+      return access_mode::write;
+    }
+    if (s == "none")
+    {
+      return access_mode::none;
+    }
+    EXPECT(s == "rw", "Invalid access mode '", s, "'.");
+    return access_mode::rw;
+  }
+
+  ::std::vector<list_sched_task> tasks;
+  ::std::unordered_map<int, size_t> index;
+};
+
+/**
+ * @brief Estimated time of data transfers
+ */
+struct transfer_cost_model
+{
+  // Bytes per ms, the default value was obtained with the p2pBandwidthLatencyTest CUDA sample
+  double bandwidth = 250 * 1e5;
+  // Fixed cost of a transfer (in ms)
+  double latency = 0.01;
+
+  double transfer_time(size_t bytes) const
+  {
+    return bytes == 0 ? 0.0 : latency + double(bytes) / bandwidth;
+  }
+};
+
+/**
+ * @brief Tracks which devices have a valid copy of each piece of data, and when it becomes available, following a MSI
+ * protocol. Before the first access to a piece of data, its valid copies are the ones described by that access.
+ */
+class data_location_tracker
+{
+public:
+  data_location_tracker(int ndevices, transfer_cost_model model)
+      : ndevices(ndevices)
+      , model(mv(model))
+  {}
+
+  /// Time at which the data accessed by `a` may be used on `device`, including a transfer if needed
+  double when_available(const list_sched_access& a, int device) const
+  {
+    const double transfer = model.transfer_time(a.footprint);
+
+    auto it = copies.find(a.data_id);
+    if (it == copies.end())
+    {
+      if (::std::find(a.valid_devices.begin(), a.valid_devices.end(), device) != a.valid_devices.end())
+      {
+        return 0.0;
+      }
+      return (a.valid_on_host || !a.valid_devices.empty()) ? transfer : 0.0;
+    }
+
+    const auto& c = it->second;
+    if (c[device].valid)
+    {
+      return c[device].time;
+    }
+
+    double earliest = ::std::numeric_limits<double>::max();
+    for (const auto& copy : c)
+    {
+      if (copy.valid)
+      {
+        earliest = ::std::min(earliest, copy.time + transfer);
+      }
+    }
+    return earliest == ::std::numeric_limits<double>::max() ? transfer : earliest;
+  }
+
+  /// Time at which all the data read by `t` may be used on `device`
+  double when_data_ready(const list_sched_task& t, int device) const
+  {
+    double ready = 0.0;
+    for (const auto& a : t.accesses)
+    {
+      if (a.reads())
+      {
+        ready = ::std::max(ready, when_available(a, device));
+      }
+    }
+    return ready;
+  }
+
+  /// Record the accesses of a task executed on `device`, and completed at time `end`
+  void record(const list_sched_task& t, int device, double end)
+  {
+    for (const auto& a : t.accesses)
+    {
+      if (a.mode == access_mode::none)
+      {
+        continue;
+      }
+
+      const double available  = a.reads() ? when_available(a, device) : end;
+      auto [it, first_access] = copies.try_emplace(a.data_id, ndevices);
+      auto& c                 = it->second;
+      if (first_access)
+      {
+        for (int d : a.valid_devices)
+        {
+          if (d >= 0 && d < ndevices)
+          {
+            c[d] = {true, 0.0};
+          }
+        }
+      }
+      if (a.writes())
+      {
+        // Other copies are invalidated
+        for (auto& copy : c)
+        {
+          copy.valid = false;
+        }
+        c[device] = {true, end};
+      }
+      else if (!c[device].valid)
+      {
+        c[device] = {true, available};
+      }
+    }
+  }
+
+  const transfer_cost_model& get_model() const
+  {
+    return model;
+  }
+
+private:
+  struct copy_state
+  {
+    bool valid  = false;
+    double time = 0.0;
+  };
+
+  int ndevices;
+  transfer_cost_model model;
+  // Copies of each piece of data, indexed by the id of the data
+  ::std::unordered_map<int, ::std::vector<copy_state>> copies;
+};
+
+/**
+ * @brief Busy intervals of a device, so that a task may be inserted in an idle gap between tasks scheduled earlier
+ */
+class device_timeline
+{
+public:
+  /// Earliest start time, not before `ready`, of a task of the given duration
+  double earliest_start(double ready, double duration) const
+  {
+    double candidate = ready;
+    // Skip intervals which end before the task may start
+    auto it = ::std::lower_bound(busy.begin(), busy.end(), ready, [](const auto& interval, double t) {
+      return interval.second <= t;
+    });
+    for (; it != busy.end(); ++it)
+    {
+      if (candidate + duration <= it->first)
+      {
+        break;
+      }
+      candidate = ::std::max(candidate, it->second);
+    }
+    return candidate;
+  }
+
+  void reserve(double start, double duration)
+  {
+    auto interval = ::std::make_pair(start, start + duration);
+    busy.insert(::std::upper_bound(busy.begin(), busy.end(), interval), interval);
+  }
+
+private:
+  // Sorted, non overlapping, intervals
+  ::std::vector<::std::pair<double, double>> busy;
+};
+
+/**
+ * @brief Result of a scheduling policy : the order in which tasks are submitted, and their device
+ */
+struct list_schedule
+{
+  ::std::vector<int> order;
+  ::std::unordered_map<int, int> device;
+};
+
+/**
+ * @brief Compute the upward rank of every task, which is the length of the critical path from the task to the end of
+ * the graph. Communication costs are averaged over all pairs of devices, unless both tasks must run on given devices.
+ */
+inline ::std::unordered_map<int, double>
+compute_upward_ranks(const list_sched_graph& g, int ndevices, const transfer_cost_model& model)
+{
+  ::std::unordered_map<int, double> ranks;
+  const double remote_ratio = ndevices > 1 ? double(ndevices - 1) / ndevices : 0.0;
+
+  const auto& tasks = g.get_tasks();
+  for (auto it = tasks.rbegin(); it != tasks.rend(); ++it)
+  {
+    const auto& t = *it;
+
+    double max_succ = 0.0;
+    for (int s : t.successors)
+    {
+      const auto& succ = g.at(s);
+
+      // Data produced by the task and used by its successor
+      double comm = 0.0;
+      for (const auto& a : t.accesses)
+      {
+        if (!a.writes())
+        {
+          continue;
+        }
+        for (const auto& b : succ.accesses)
+        {
+          if (b.reads() && b.data_id == a.data_id)
+          {
+            comm += model.transfer_time(b.footprint);
+          }
+        }
+      }
+
+      const bool pinned  = t.device != -1 && succ.device != -1;
+      const double ratio = pinned ? (t.device == succ.device ? 0.0 : 1.0) : remote_ratio;
+      max_succ           = ::std::max(max_succ, ratio * comm + ranks.at(s));
+    }
+
+    ranks[t.id] = t.cost + max_succ;
+  }
+
+  return ranks;
+}
+
+/**
+ * @brief Order tasks by decreasing upward rank, among the tasks whose predecessors were already ordered
+ */
+inline ::std::vector<int> rank_order(const list_sched_graph& g, const ::std::unordered_map<int, double>& ranks)
+{
+  // Highest rank first, then submission order
+  using entry = ::std::pair<double, size_t>;
+  auto cmp    = [](const entry& a, const entry& b) {
+    return a.first < b.first || (a.first == b.first && a.second > b.second);
+  };
+  ::std::priority_queue<entry, ::std::vector<entry>, decltype(cmp)> ready(cmp);
+
+  const auto& tasks = g.get_tasks();
+  ::std::vector<size_t> missing(tasks.size());
+  for (size_t i = 0; i < tasks.size(); i++)
+  {
+    missing[i] = tasks[i].predecessors.size();
+    if (missing[i] == 0)
+    {
+      ready.emplace(ranks.at(tasks[i].id), i);
+    }
+  }
+
+  ::std::vector<int> order;
+  order.reserve(tasks.size());
+  while (!ready.empty())
+  {
+    const auto& t = tasks[ready.top().second];
+    ready.pop();
+    order.push_back(t.id);
+
+    for (int s : t.successors)
+    {
+      const size_t pos = g.position(s);
+      if (--missing[pos] == 0)
+      {
+        ready.emplace(ranks.at(s), pos);
+      }
+    }
+  }
+
+  _CCCL_ASSERT(order.size() == tasks.size(), "cyclic task graph");
+  return order;
+}
+
+/**
+ * @brief Windowed look-ahead list scheduling
+ *
+ * Tasks are considered by decreasing upward rank, and each task is placed on the device which minimizes the finish
+ * time of its successors among the next `window` tasks of that order (or its own finish time if there are none).
+ * Tasks may be inserted in idle gaps of the devices. The returned order follows the estimated start times. Tasks with
+ * a device are kept on it.
+ *
+ * With a window of 0, this is the insertion-based HEFT algorithm.
+ */
+inline list_schedule
+lookahead_list_schedule(const list_sched_graph& g, int ndevices, const transfer_cost_model& model, size_t window)
+{
+  _CCCL_ASSERT(ndevices > 0, "invalid number of devices");
+
+  const auto ranks = compute_upward_ranks(g, ndevices, model);
+  const auto order = rank_order(g, ranks);
+
+  ::std::unordered_map<int, size_t> order_pos;
+  for (size_t i = 0; i < order.size(); i++)
+  {
+    order_pos[order[i]] = i;
+  }
+
+  data_location_tracker locations(ndevices, model);
+  ::std::vector<device_timeline> timelines(ndevices);
+  ::std::unordered_map<int, double> start_time, finish_time;
+
+  list_schedule result;
+
+  // Devices which may be selected for a task
+  auto first_device = [](const list_sched_task& t) {
+    return t.device == -1 ? 0 : t.device;
+  };
+  auto last_device = [ndevices](const list_sched_task& t) {
+    return t.device == -1 ? ndevices - 1 : t.device;
+  };
+
+  // Time at which all the predecessors of a task which were already placed are completed
+  auto preds_done = [&](const list_sched_task& t) {
+    double res = 0.0;
+    for (int p : t.predecessors)
+    {
+      if (auto it = finish_time.find(p); it != finish_time.end())
+      {
+        res = ::std::max(res, it->second);
+      }
+    }
+    return res;
+  };
+
+  for (size_t i = 0; i < order.size(); i++)
+  {
+    const auto& t = g.at(order[i]);
+
+    // Successors in the window, the predecessors which were not placed yet are ignored when estimating their
+    // finish time
+    ::std::vector<const list_sched_task*> lookahead;
+    for (int s : t.successors)
+    {
+      if (order_pos.at(s) <= i + window)
+      {
+        lookahead.push_back(&g.at(s));
+      }
+    }
+
+    int best_device   = 0;
+    double best_score = ::std::numeric_limits<double>::max();
+    double best_start = 0.0;
+    double best_end   = ::std::numeric_limits<double>::max();
+
+    for (int d = first_device(t); d <= last_device(t); d++)
+    {
+      const double ready = ::std::max(preds_done(t), locations.when_data_ready(t, d));
+      const double start = timelines[d].earliest_start(ready, t.cost);
+      const double end   = start + t.cost;
+
+      double score = end;
+      for (const auto* succ : lookahead)
+      {
+        // Best finish time of the successor if this task is executed on d
+        double succ_end = ::std::numeric_limits<double>::max();
+        for (int d2 = first_device(*succ); d2 <= last_device(*succ); d2++)
+        {
+          double succ_ready = ::std::max(end, preds_done(*succ));
+          for (const auto& a : succ->accesses)
+          {
+            if (!a.reads())
+            {
+              continue;
+            }
+            const bool produced = ::std::any_of(t.accesses.begin(), t.accesses.end(), [&](const auto& b) {
+              return b.writes() && b.data_id == a.data_id;
+            });
+            const double available = produced ? end + (d2 == d ? 0.0 : model.transfer_time(a.footprint))
+                                              : locations.when_available(a, d2);
+            succ_ready = ::std::max(succ_ready, available);
+          }
+          succ_end = ::std::min(succ_end, timelines[d2].earliest_start(succ_ready, succ->cost) + succ->cost);
+        }
+        score = ::std::max(score, succ_end);
+      }
+
+      if (score < best_score || (score == best_score && end < best_end))
+      {
+        best_device = d;
+        best_score  = score;
+        best_start  = start;
+        best_end    = end;
+      }
+    }
+
+    timelines[best_device].reserve(best_start, t.cost);
+    locations.record(t, best_device, best_end);
+    start_time[t.id]    = best_start;
+    finish_time[t.id]   = best_end;
+    result.device[t.id] = best_device;
+  }
+
+  // Submit tasks in the order of their estimated start time, a task never starts before its predecessors
+  result.order = order;
+  ::std::stable_sort(result.order.begin(), result.order.end(), [&](int a, int b) {
+    return start_time.at(a) < start_time.at(b);
+  });
+
+  return result;
+}
+
+/**
+ * @brief Tasks in submission order, on random devices (as the `random` scheduler), tasks with a device are kept on it
+ */
+inline list_schedule random_list_schedule(const list_sched_graph& g, int ndevices, unsigned seed = 0)
+{
+  ::std::mt19937 gen(seed);
+  ::std::uniform_int_distribution<> dist(0, ndevices - 1);
+
+  list_schedule result;
+  for (const auto& t : g.get_tasks())
+  {
+    result.order.push_back(t.id);
+    result.device[t.id] = t.device == -1 ? dist(gen) : t.device;
+  }
+  return result;
+}
+
+/**
+ * @brief Tasks in submission order, on devices selected in a round robin fashion (as the `round_robin` scheduler),
+ * tasks with a device are kept on it
+ */
+inline list_schedule round_robin_list_schedule(const list_sched_graph& g, int ndevices)
+{
+  list_schedule result;
+  int current_device = 0;
+  for (const auto& t : g.get_tasks())
+  {
+    result.order.push_back(t.id);
+    result.device[t.id] = t.device == -1 ? current_device++ % ndevices : t.device;
+  }
+  return result;
+}
+
+/**
+ * @brief Tasks in submission order, each task is placed on the device where it would finish first, without
+ * insertion (as the `heft` scheduler), tasks with a device are kept on it
+ */
+inline list_schedule
+greedy_heft_list_schedule(const list_sched_graph& g, int ndevices, const transfer_cost_model& model)
+{
+  data_location_tracker locations(ndevices, model);
+  ::std::vector<double> device_available(ndevices, 0.0);
+  ::std::unordered_map<int, double> finish_time;
+
+  list_schedule result;
+  for (const auto& t : g.get_tasks())
+  {
+    double preds_done = 0.0;
+    for (int p : t.predecessors)
+    {
+      preds_done = ::std::max(preds_done, finish_time.at(p));
+    }
+
+    int best_device = 0;
+    double best_end = ::std::numeric_limits<double>::max();
+    for (int d = 0; d < ndevices; d++)
+    {
+      if (t.device != -1 && d != t.device)
+      {
+        continue;
+      }
+      const double start = ::std::max({device_available[d], preds_done, locations.when_data_ready(t, d)});
+      if (start + t.cost < best_end)
+      {
+        best_device = d;
+        best_end    = start + t.cost;
+      }
+    }
+
+    device_available[best_device] = best_end;
+    finish_time[t.id]             = best_end;
+    locations.record(t, best_device, best_end);
+
+    result.order.push_back(t.id);
+    result.device[t.id] = best_device;
+  }
+  return result;
+}
+
+/**
+ * @brief Estimate the makespan of a schedule
+ *
+ * Tasks are executed one at a time on each device, in the order of the schedule, once their predecessors are
+ * completed and the data they read were transferred to the device.
+ */
+inline double simulate_makespan(
+  const list_sched_graph& g, const list_schedule& schedule, int ndevices, const transfer_cost_model& model)
+{
+  _CCCL_ASSERT(schedule.order.size() == g.size(), "incomplete schedule");
+
+  data_location_tracker locations(ndevices, model);
+  ::std::vector<double> device_available(ndevices, 0.0);
+  ::std::unordered_map<int, double> finish_time;
+
+  double makespan = 0.0;
+  for (int id : schedule.order)
+  {
+    const auto& t = g.at(id);
+    const int d   = schedule.device.at(id);
+    _CCCL_ASSERT(d >= 0 && d < ndevices, "invalid device");
+
+    double start = ::std::max(device_available[d], locations.when_data_ready(t, d));
+    for (int p : t.predecessors)
+    {
+      auto it = finish_time.find(p);
+      EXPECT(it != finish_time.end(), "Task ", id, " is scheduled before its predecessor ", p, ".");
+      start = ::std::max(start, it->second);
+    }
+
+    const double end    = start + t.cost;
+    device_available[d] = end;
+    finish_time[id]     = end;
+    locations.record(t, d, end);
+
+    makespan = ::std::max(makespan, end);
+  }
+
+  return makespan;
+}
+
+} // end namespace cuda::experimental::stf::reserved
@@ -33,6 +33,7 @@ namespace cuda::experimental::stf
 
 class stream_ctx;
 class graph_ctx;
+class host_ctx;
 
 template <typename T>
 struct owning_container_of;
@@ -520,15 +521,22 @@ public:
     SCOPE(exit)
     {
       t.end_uncleared();
-      if constexpr (::std::is_same_v<context, stream_ctx>)
+      if constexpr (::std::is_same_v<context, stream_ctx> || ::std::is_same_v<context, host_ctx>)
       {
         if (record_time)
         {
-          cuda_safe_call(cudaEventRecord(end_event, t.get_stream()));
-          cuda_safe_call(cudaEventSynchronize(end_event));
-
           float milliseconds = 0;
-          cuda_safe_call(cudaEventElapsedTime(&milliseconds, start_event, end_event));
+          if constexpr (::std::is_same_v<context, host_ctx>)
+          {
+            t.wait();
+            milliseconds = t.elapsed_ms();
+          }
+          else
+          {
+            cuda_safe_call(cudaEventRecord(end_event, t.get_stream()));
+            cuda_safe_call(cudaEventSynchronize(end_event));
+            cuda_safe_call(cudaEventElapsedTime(&milliseconds, start_event, end_event));
+          }
 
           if (dot.is_tracing())
           {
@@ -576,7 +584,13 @@ public:
 #  endif
 
     // TODO redo cascade of tests
-    if constexpr (need_reduction)
+    if constexpr (::std::is_same_v<context, host_ctx>)
+    {
+      // All tasks of a host_ctx run on the thread pool, whatever the type of lambda
+      static_assert(!need_reduction, "Reduce access mode currently unimplemented with host_ctx.");
+      return do_parallel_for_host(::std::forward<Fun>(f), shape, t);
+    }
+    else if constexpr (need_reduction)
     {
       _CCCL_ASSERT(e_place != exec_place::host(), "Reduce access mode currently unimplemented on host.");
       _CCCL_ASSERT(!e_place.is_grid(), "Reduce access mode currently unimplemented on grid of places.");
@@ -606,7 +620,8 @@ public:
     }
 
     // Device land. Must use the supplemental if constexpr below to avoid compilation errors.
-    if constexpr (is_extended_host_device_lambda_closure_type || is_extended_device_lambda_closure_type)
+    if constexpr (!::std::is_same_v<context, host_ctx>
+                  && (is_extended_host_device_lambda_closure_type || is_extended_device_lambda_closure_type))
     {
       if (!e_place.is_grid())
       {
@@ -963,7 +978,30 @@ public:
       }
     };
 
-    if constexpr (::std::is_same_v<context, stream_ctx>)
+    if constexpr (::std::is_same_v<context, host_ctx>)
+    {
+      // Split the loop among the threads of the pool, the arguments are
+      // released after the last chunk was executed
+      ::std::shared_ptr<args_t> shared_args(args);
+      t.parallel_enqueue(n, [shared_args](size_t begin, size_t end) {
+        auto& data               = ::std::get<0>(*shared_args);
+        Fun& f                   = ::std::get<2>(*shared_args);
+        const sub_shape_t& shape = ::std::get<3>(*shared_args);
+
+        auto explode_coords = [&](size_t i, typename deps_ops_t::dep_type... data) {
+          auto h = [&](auto... coords) {
+            f(coords..., data...);
+          };
+          ::std::apply(h, shape.index_to_coords(i));
+        };
+
+        for (size_t i = begin; i < end; ++i)
+        {
+          ::std::apply(explode_coords, ::std::tuple_cat(::std::make_tuple(i), data));
+        }
+      });
+    }
+    else if constexpr (::std::is_same_v<context, stream_ctx>)
     {
       cuda_safe_call(cudaLaunchHostFunc(t.get_stream(), host_func, args));
     }
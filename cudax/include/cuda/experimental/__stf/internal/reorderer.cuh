@@ -26,12 +26,15 @@
 #  pragma system_header
 #endif // no system header
 
+#include <cuda/experimental/__stf/internal/list_scheduling.cuh> // lookahead_reorderer
 #include <cuda/experimental/__stf/internal/task_dep.cuh> // reorderer_payload uses task_dep_vector_untyped
 #include <cuda/experimental/__stf/internal/task_statistics.cuh> // heft_scheduler uses statistics_t
+#include <cuda/experimental/__stf/utility/traits.cuh> // peer_bandwidth is a meyers_singleton
 
 #include <algorithm> // ::std::shuffle
 #include <functional> // ::std::function
 #include <memory> // ::std::unique_ptr
+#include <optional>
 #include <queue>
 #include <random>
 #include <string>
@@ -47,13 +50,18 @@ namespace cuda::experimental::stf::reserved
  */
 struct reorderer_payload
 {
-  reorderer_payload(
-    ::std::string s, int id, ::std::unordered_set<int> succ, ::std::unordered_set<int> pred, task_dep_vector_untyped d)
+  reorderer_payload(::std::string s,
+                    int id,
+                    ::std::unordered_set<int> succ,
+                    ::std::unordered_set<int> pred,
+                    task_dep_vector_untyped d,
+                    int pinned = -1)
       : symbol(mv(s))
       , mapping_id(id)
       , successors(mv(succ))
       , predecessors(mv(pred))
       , deps(mv(d))
+      , pinned_device(pinned)
   {}
 
   reorderer_payload() = delete;
@@ -89,6 +97,8 @@ struct reorderer_payload
   ::std::unordered_set<int> successors;
   ::std::unordered_set<int> predecessors;
   task_dep_vector_untyped deps;
+  // Device on which the task must run, or -1 if the reorderer may select the device
+  int pinned_device;
 };
 
 /**
@@ -299,6 +309,174 @@ private:
   task_statistics& statistics = task_statistics::instance();
 };
 
+/**
+ * @brief Bandwidth between devices, in bytes per millisecond, measured by timing a copy from device 0 to device 1 the
+ * first time it is needed in the process. There is no measurement with fewer than two devices.
+ */
+class peer_bandwidth : public meyers_singleton<peer_bandwidth>
+{
+protected:
+  peer_bandwidth()
+  {
+    const int num_devices = cuda_try<cudaGetDeviceCount>();
+    if (num_devices < 2)
+    {
+      // There is no transfer between devices
+      return;
+    }
+
+    const size_t bytes = 64 * 1024 * 1024;
+    const int prev_dev = cuda_try<cudaGetDevice>();
+
+    void* src;
+    void* dst;
+    cuda_safe_call(cudaSetDevice(1));
+    cuda_safe_call(cudaMalloc(&dst, bytes));
+    cuda_safe_call(cudaSetDevice(0));
+    cuda_safe_call(cudaMalloc(&src, bytes));
+
+    cudaEvent_t start, stop;
+    cuda_safe_call(cudaEventCreate(&start));
+    cuda_safe_call(cudaEventCreate(&stop));
+
+    // The first copy is not timed, to exclude initialization costs
+    cuda_safe_call(cudaMemcpyPeer(dst, 1, src, 0, bytes));
+    cuda_safe_call(cudaEventRecord(start));
+    cuda_safe_call(cudaMemcpyPeerAsync(dst, 1, src, 0, bytes));
+    cuda_safe_call(cudaEventRecord(stop));
+    cuda_safe_call(cudaEventSynchronize(stop));
+
+    float ms = 0.0f;
+    cuda_safe_call(cudaEventElapsedTime(&ms, start, stop));
+
+    cuda_safe_call(cudaEventDestroy(start));
+    cuda_safe_call(cudaEventDestroy(stop));
+    cuda_safe_call(cudaFree(src));
+    cuda_safe_call(cudaSetDevice(1));
+    cuda_safe_call(cudaFree(dst));
+    cuda_safe_call(cudaSetDevice(prev_dev));
+
+    if (ms > 0.0f)
+    {
+      bandwidth = double(bytes) / ms;
+    }
+  }
+
+  ~peer_bandwidth() = default;
+
+public:
+  /// The measured bandwidth, if any
+  const ::std::optional<double>& get() const
+  {
+    return bandwidth;
+  }
+
+private:
+  ::std::optional<double> bandwidth;
+};
+
+/**
+ * @brief Orders tasks by upward rank and assigns them to devices, with windowed look-ahead list scheduling (see
+ * `lookahead_list_schedule`).
+ *
+ * Transfer costs are derived from the data footprints of the tasks and from a measurement of the bandwidth between
+ * devices, measured once per process. CUDASTF_LOOKAHEAD_WINDOW sets the number of tasks considered by the look-ahead, and if
+ * CUDASTF_TASK_GRAPH_FILE is set, the task graph is saved so that it can be replayed by a simulator.
+ */
+class lookahead_reorderer : public reorderer
+{
+public:
+  lookahead_reorderer()
+      : reorderer()
+  {
+    const char* filename = getenv("CUDASTF_TASK_STATISTICS");
+
+    if (filename)
+    {
+      statistics.read_statistics_file(filename);
+    }
+    else
+    {
+      statistics.enable_calibration();
+    }
+
+    const char* window_env = getenv("CUDASTF_LOOKAHEAD_WINDOW");
+    if (window_env)
+    {
+      window = ::std::stoul(window_env);
+    }
+
+    if (auto bandwidth = peer_bandwidth::instance().get())
+    {
+      model.bandwidth = *bandwidth;
+    }
+  }
+
+  void reorder_tasks(::std::vector<int>& tasks, ::std::unordered_map<int, reorderer_payload>& task_map) override
+  {
+    list_sched_graph g;
+    for (int id : tasks)
+    {
+      const auto& payload = task_map.at(id);
+
+      auto& t  = g.add_task(id, payload.get_symbol(), task_cost(payload));
+      t.device = payload.pinned_device;
+      for (const auto& dep : payload.get_task_deps())
+      {
+        t.accesses.push_back({dep.get_data_id(),
+                              dep.get_symbol(),
+                              dep.get_data_footprint(),
+                              dep.get_access_mode(),
+                              dep.get_valid_devices(),
+                              dep.is_valid_on_host()});
+      }
+
+      // Tasks are sorted in submission order, so predecessors were already added
+      for (int pred : payload.predecessors)
+      {
+        g.add_dependency(pred, id);
+      }
+    }
+
+    const char* graph_file = getenv("CUDASTF_TASK_GRAPH_FILE");
+    if (graph_file)
+    {
+      g.write(::std::string(graph_file));
+    }
+
+    auto schedule = lookahead_list_schedule(g, num_devices, model, window);
+    for (auto& [id, device] : schedule.device)
+    {
+      task_map.at(id).device = device;
+    }
+    tasks = mv(schedule.order);
+  }
+
+private:
+  double task_cost(const reorderer_payload& payload)
+  {
+    // Tasks without a symbol have no statistics
+    if (payload.get_symbol().rfind("task ", 0) == 0)
+    {
+      return 0.0;
+    }
+
+    auto [cost, num_calls] = statistics.get_task_stats(payload);
+    if (num_calls == 0 && !statistics.has_model(payload.get_symbol()))
+    {
+      cost = default_cost;
+    }
+    return cost;
+  }
+
+  // Measure the bandwidth of a copy between the first two devices, in bytes per ms
+
+  task_statistics& statistics = task_statistics::instance();
+  transfer_cost_model model;
+  size_t window             = 8;
+  const double default_cost = 0.5;
+};
+
 class post_mortem_reorderer : public reorderer
 {
 public:
@@ -364,6 +542,11 @@ inline ::std::unique_ptr<reorderer> reorderer::make(const char* reorderer_type)
     return ::std::make_unique<heft_reorderer>();
   }
 
+  if (reorderer_type_s == "lookahead")
+  {
+    return ::std::make_unique<lookahead_reorderer>();
+  }
+
   if (reorderer_type_s == "post_mortem")
   {
     const char* order_file = getenv("CUDASTF_ORDER_FILE");
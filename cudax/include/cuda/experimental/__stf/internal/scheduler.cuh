@@ -177,9 +177,10 @@ public:
 
   ::std::pair<exec_place, bool> schedule_task(const task& t) override
   {
+    // For footprints which were not measured yet, the cost is predicted from other footprints of the same symbol
     auto [task_cost, num_calls] = statistics.get_task_stats(t);
 
-    if (num_calls == 0)
+    if (num_calls == 0 && !statistics.has_model(t.get_symbol()))
     {
       task_cost = default_cost;
     }
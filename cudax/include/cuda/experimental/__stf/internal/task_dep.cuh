@@ -153,6 +153,32 @@ public:
     return data_footprint;
   }
 
+  void set_data_id(int id) const
+  {
+    data_id = id;
+  }
+
+  int get_data_id() const
+  {
+    return data_id;
+  }
+
+  void set_valid_copies(::std::vector<int> devices, bool on_host) const
+  {
+    valid_devices = mv(devices);
+    valid_on_host = on_host;
+  }
+
+  const ::std::vector<int>& get_valid_devices() const
+  {
+    return valid_devices;
+  }
+
+  bool is_valid_on_host() const
+  {
+    return valid_on_host;
+  }
+
   void reset_logical_data()
   {
     data = nullptr;
@@ -169,6 +195,10 @@ private:
   // as const ref)
   mutable ::std::string symbol;
   mutable size_t data_footprint = 0;
+  mutable int data_id           = -1;
+  // Devices with a valid copy of the data, and whether another place has one
+  mutable ::std::vector<int> valid_devices;
+  mutable bool valid_on_host = true;
 
   mutable data_place dplace;
   ::std::shared_ptr<reduction_operator_base> redux_op;
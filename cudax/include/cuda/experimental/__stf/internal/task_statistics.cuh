@@ -16,6 +16,9 @@
  * by setting the CUDASTF_CALIBRATION_FILE environment variable to point to the file which
  * will store the results.
  *
+ * For every symbol, a cost model fitted on the recorded samples predicts the duration of tasks
+ * whose data footprint was never measured.
+ *
  *
  * CUDASTF_CALIBRATION_FILE
  */
@@ -36,16 +39,133 @@
 #include <cuda/experimental/__stf/utility/traits.cuh>
 #include <cuda/experimental/__stf/utility/unittest.cuh>
 
+#include <algorithm>
 #include <cmath>
+#include <cstdio>
 #include <cstdlib>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <optional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace cuda::experimental::stf::reserved
 {
 
+/**
+ * @brief Model of the duration of the tasks with the same symbol, as a function of their data footprint
+ *
+ * The model is fitted online. The mean duration measured for each footprint is kept, and predictions
+ * interpolate linearly between the closest measured footprints. Outside the range of measured footprints, the
+ * prediction follows the slope of a least-squares linear regression over all samples, from the closest measured
+ * point. The quality of that regression is exposed with `fit()` for diagnostics.
+ */
+class footprint_cost_model
+{
+public:
+  /// Summary of the linear regression `time = intercept + slope * footprint` over all samples
+  struct fit_info
+  {
+    double intercept = 0.0;
+    double slope     = 0.0;
+    // Coefficient of determination of the regression, in [0, 1]
+    double r_squared      = 0.0;
+    double num_samples    = 0.0;
+    size_t num_footprints = 0;
+  };
+
+  /**
+   * @brief Record `count` samples of mean duration `mean` and standard deviation `stddev` for a given footprint
+   *
+   * @param footprint data footprint of the task (in bytes)
+   * @param mean mean duration of the new samples
+   * @param point_mean mean duration of all the samples recorded for this footprint so far, including the new ones
+   * @param count number of new samples
+   * @param stddev standard deviation of the new samples
+   */
+  void add_samples(size_t footprint, double mean, double point_mean, int count = 1, double stddev = 0.0)
+  {
+    _CCCL_ASSERT(count > 0, "invalid sample count");
+
+    points[footprint] = point_mean;
+
+    // Weighted version of Welford's method to update the means and co-moments
+    const double w = count;
+    const double x = double(footprint);
+    n += w;
+    const double dx = x - mean_x;
+    const double dy = mean - mean_y;
+    mean_x += w * dx / n;
+    mean_y += w * dy / n;
+    m2_x += w * dx * (x - mean_x);
+    m2_y += w * dy * (mean - mean_y) + (count - 1) * stddev * stddev;
+    c_xy += w * dx * (mean - mean_y);
+  }
+
+  bool empty() const
+  {
+    return points.empty();
+  }
+
+  fit_info fit() const
+  {
+    fit_info res;
+    res.num_samples    = n;
+    res.num_footprints = points.size();
+    if (m2_x > 0.0)
+    {
+      res.slope = c_xy / m2_x;
+      if (m2_y > 0.0)
+      {
+        res.r_squared = ::std::min(1.0, c_xy * c_xy / (m2_x * m2_y));
+      }
+    }
+    res.intercept = mean_y - res.slope * mean_x;
+    return res;
+  }
+
+  /// Predict the duration of a task with the given footprint, the model must not be empty
+  double predict(size_t footprint) const
+  {
+    _CCCL_ASSERT(!empty(), "cannot predict with an empty model");
+
+    auto hi = points.lower_bound(footprint);
+    if (hi != points.end() && hi->first == footprint)
+    {
+      return hi->second;
+    }
+
+    if (hi != points.end() && hi != points.begin())
+    {
+      // Interpolate between the two closest measured footprints
+      auto lo        = ::std::prev(hi);
+      const double t = double(footprint - lo->first) / double(hi->first - lo->first);
+      return lo->second + t * (hi->second - lo->second);
+    }
+
+    // Extrapolate from the closest measured footprint. A task never becomes faster with more data.
+    const auto& closest = (hi == points.end()) ? *points.rbegin() : *hi;
+    const double slope  = ::std::max(0.0, fit().slope);
+    const double res    = closest.second + slope * (double(footprint) - double(closest.first));
+    return ::std::max(0.0, res);
+  }
+
+private:
+  // Mean duration for each measured footprint
+  ::std::map<size_t, double> points;
+
+  // Running sums for the linear regression
+  double n      = 0.0;
+  double mean_x = 0.0;
+  double mean_y = 0.0;
+  double m2_x   = 0.0;
+  double m2_y   = 0.0;
+  double c_xy   = 0.0;
+};
+
 /**
  * @brief This class stores statistics about task execution time
  */
@@ -72,6 +192,12 @@ protected:
     {
       write_stats();
     }
+
+    const char* display_stats_env = ::std::getenv("CUDASTF_DISPLAY_STATS");
+    if (display_stats_env && ::std::atoi(display_stats_env) != 0)
+    {
+      print_models();
+    }
   }
 
 public:
@@ -101,12 +227,14 @@ public:
     auto it = statistics.find(key);
     if (it == statistics.end())
     {
-      statistics.emplace(key, statistic(time));
+      it = statistics.emplace(key, statistic(time)).first;
     }
     else
     {
       it->second.update(time);
     }
+
+    models[key.first].add_samples(key.second, time, it->second.get_mean());
   }
 
   class statistic
@@ -222,12 +350,21 @@ public:
 
       ::std::pair<::std::string, size_t> key(task_name, size);
       statistics.emplace(key, statistic(num_calls, time, stddev));
+
+      // The cost model is rebuilt from the samples summarized in the file
+      if (num_calls > 0)
+      {
+        models[task_name].add_samples(size, time, time, num_calls, stddev);
+      }
     }
   }
 
   /**
    * @brief Get statistics associated with a specific task
    *
+   * If this footprint was never measured for the symbol of the task, the time is predicted by the cost model of
+   * the symbol, and the number of calls is 0.
+   *
    * @tparam Type of task
    * @param The specified task
    * @return A pair of the task time and the number of calls so far
@@ -246,13 +383,59 @@ public:
       return {s.get_mean(), s.get_num_calls()};
     }
 
+    if (auto m = models.find(task_name); m != models.end() && !m->second.empty())
+    {
+      return {m->second.predict(data_footprint), 0};
+    }
+
     // If we do not have the task in the map, this means we have to be calibrating online.
     // A missing task implies an incomplete stats file was provided
-    EXPECT(is_calibrating(), "Task '", task_name, "' with size ", data_footprint, " not provided in stats file.");
+    EXPECT(is_calibrating(), "Task '", task_name, "' not provided in stats file.");
 
     return {0.0, 0};
   }
 
+  /**
+   * @brief Indicates whether the duration of tasks with this symbol can be predicted
+   */
+  bool has_model(const ::std::string& symbol) const
+  {
+    auto m = models.find(symbol);
+    return m != models.end() && !m->second.empty();
+  }
+
+  /**
+   * @brief Get the quality of the cost model of a symbol, if any sample was recorded for this symbol
+   */
+  ::std::optional<footprint_cost_model::fit_info> get_model_fit(const ::std::string& symbol) const
+  {
+    auto m = models.find(symbol);
+    if (m == models.end() || m->second.empty())
+    {
+      return ::std::nullopt;
+    }
+    return m->second.fit();
+  }
+
+  /**
+   * @brief Print the cost model of every symbol, and the quality of its fit
+   */
+  void print_models() const
+  {
+    for (const auto& [symbol, model] : models)
+    {
+      const auto f = model.fit();
+      fprintf(stderr,
+              "cost model '%s': %zu footprints, %.0f samples, time = %g + %g * bytes (r^2 = %.3f)\n",
+              symbol.c_str(),
+              f.num_footprints,
+              f.num_samples,
+              f.intercept,
+              f.slope,
+              f.r_squared);
+    }
+  }
+
 private:
   ::std::string calibration_file;
   bool calibrating = false;
@@ -298,6 +481,131 @@ private:
   }
 
   statistics_map_t statistics;
+
+  // Cost model of each symbol
+  ::std::unordered_map<::std::string, footprint_cost_model> models;
+};
+
+#ifdef UNITTESTED_FILE
+UNITTEST("footprint_cost_model")
+{
+  footprint_cost_model m;
+  EXPECT(m.empty());
+
+  // time = 1 + 2 * (bytes / 1000)
+  for (size_t kb : {1, 2, 4, 8})
+  {
+    const double t = 1.0 + 2.0 * kb;
+    m.add_samples(kb * 1000, t, t);
+  }
+
+  const auto f = m.fit();
+  EXPECT(f.num_footprints == 4);
+  EXPECT(::std::abs(f.slope - 0.002) < 1e-9);
+  EXPECT(::std::abs(f.intercept - 1.0) < 1e-6);
+  EXPECT(f.r_squared > 0.999);
+
+  // Measured, interpolated and extrapolated footprints
+  EXPECT(::std::abs(m.predict(2000) - 5.0) < 1e-9);
+  EXPECT(::std::abs(m.predict(3000) - 7.0) < 1e-9);
+  EXPECT(::std::abs(m.predict(16000) - 33.0) < 1e-6);
+  EXPECT(::std::abs(m.predict(500) - 2.0) < 1e-6);
+};
+
+namespace task_statistics_unittest
+{
+// Only what task_statistics needs from a task: a symbol, and dependencies with a data footprint
+struct fake_dep
+{
+  size_t footprint;
+  size_t get_data_footprint() const
+  {
+    return footprint;
+  }
+};
+
+struct fake_task
+{
+  ::std::string symbol;
+  ::std::vector<fake_dep> deps;
+  const ::std::string& get_symbol() const
+  {
+    return symbol;
+  }
+  const ::std::vector<fake_dep>& get_task_deps() const
+  {
+    return deps;
+  }
+};
+
+// A task_statistics object of its own, rather than the singleton shared with the rest of the program
+struct fresh_task_statistics : task_statistics
+{};
+} // namespace task_statistics_unittest
+
+UNITTEST("task_statistics get_task_stats and has_model")
+{
+  using namespace task_statistics_unittest;
+  fresh_task_statistics stats;
+  stats.enable_calibration();
+
+  const fake_task small{"axpy", {{400}, {600}}};
+  const fake_task large{"axpy", {{4000}}};
+  stats.log_task_time(small, 3.0);
+  stats.log_task_time(small, 5.0);
+  stats.log_task_time(large, 10.0);
+
+  EXPECT(stats.has_model("axpy"));
+  EXPECT(!stats.has_model("gemm"));
+
+  // The footprint of a task sums those of its dependencies
+  const auto measured = stats.get_task_stats(fake_task{"axpy", {{1000}}});
+  EXPECT(::std::abs(measured.first - 4.0) < 1e-9);
+  EXPECT(measured.second == 2);
+
+  // An unseen footprint is predicted by the model, and was never called
+  const auto predicted = stats.get_task_stats(fake_task{"axpy", {{2000}}});
+  EXPECT(::std::abs(predicted.first - 6.0) < 1e-9);
+  EXPECT(predicted.second == 0);
+
+  // Nothing is known about another symbol while calibrating
+  const auto unknown = stats.get_task_stats(fake_task{"gemm", {{2000}}});
+  EXPECT(unknown.first == 0.0);
+  EXPECT(unknown.second == 0);
+};
+
+UNITTEST("task_statistics calibration file reload")
+{
+  using namespace task_statistics_unittest;
+
+  const auto path = ::std::filesystem::temp_directory_path() / "cudastf_task_statistics_unittest.csv";
+  {
+    ::std::ofstream file(path);
+    file << "task,size,num_calls,mean,stddev\n";
+    file << "axpy,1000,2,4,1\n";
+    file << "axpy,4000,1,10,0\n";
+  }
+
+  fresh_task_statistics stats;
+  stats.read_statistics_file(path.string().c_str());
+  ::std::filesystem::remove(path);
+
+  EXPECT(stats.has_model("axpy"));
+
+  const auto measured = stats.get_task_stats(fake_task{"axpy", {{1000}}});
+  EXPECT(::std::abs(measured.first - 4.0) < 1e-9);
+  EXPECT(measured.second == 2);
+
+  // The model rebuilt from the file predicts the footprint which was not calibrated
+  const auto predicted = stats.get_task_stats(fake_task{"axpy", {{2000}}});
+  EXPECT(::std::abs(predicted.first - 6.0) < 1e-9);
+  EXPECT(predicted.second == 0);
+
+  const auto fit = stats.get_model_fit("axpy");
+  EXPECT(fit.has_value());
+  EXPECT(fit->num_footprints == 2);
+  EXPECT(fit->num_samples == 3.0);
 };
+#endif // UNITTESTED_FILE
 
 } // namespace cuda::experimental::stf::reserved
@@ -0,0 +1,909 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of CUDASTF in CUDA C++ Core Libraries,
+// under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES.
+//
+//===----------------------------------------------------------------------===//
+
+/**
+ * @file
+ *
+ * @brief Streaming trace of the task graph, written incrementally in a compact binary format
+ *
+ * Unlike the DOT output, which keeps the whole graph in memory until the end of the application, the trace writer
+ * appends every vertex, edge and timing record to a file as soon as it is known, with a bounded memory footprint.
+ * Trace files are processed offline: `trace_graph` loads a range of tasks, removes redundant edges and prints the
+ * resulting subgraph in the DOT format, and `trace_to_chrome_json` converts timing records into a timeline that can be
+ * visualized with Chrome trace viewers (e.g. Perfetto).
+ *
+ * CUDASTF_TRACE_FILE
+ */
+
+#pragma once
+
+#include <cuda/__cccl_config>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <cuda/experimental/__stf/utility/core.cuh>
+#include <cuda/experimental/__stf/utility/hash.cuh>
+#include <cuda/experimental/__stf/utility/unittest.cuh>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace cuda::experimental::stf::reserved
+{
+
+/**
+ * @brief Kinds of records found in a trace file
+ *
+ * A trace file starts with the 8 bytes of `trace_file_magic` followed by the version of the format as a 32-bit
+ * integer. It is then a sequence of records, each made of a one byte kind followed by its fields. Integers are stored
+ * in little endian, floating point values with their IEEE 754 representation, and strings are prefixed with their
+ * length as a 32-bit integer.
+ */
+enum class trace_record_kind : uint8_t
+{
+  vertex  = 1, // id, ctx_id, section_id, label
+  prereq  = 2, // id, ctx_id, label
+  fence   = 3, // id, ctx_id
+  edge    = 4, // from, to, style (uint8)
+  timing  = 5, // id, ms (float), device, end_ns (uint64), label
+  section = 6, // id, parent_id, label
+};
+
+inline constexpr char trace_file_magic[8]    = {'S', 'T', 'F', 'T', 'R', 'A', 'C', 'E'};
+inline constexpr uint32_t trace_file_version = 1;
+
+/**
+ * @brief Appends records to a trace file as they are produced
+ *
+ * Records are accumulated in a buffer of fixed size which is written to the file whenever it is full, so that the
+ * memory used by the writer does not depend on the number of tasks. All methods are thread safe.
+ */
+class trace_writer
+{
+public:
+  static constexpr size_t default_buffer_size = 1024 * 1024;
+
+  trace_writer(const ::std::string& filename, size_t buffer_size = default_buffer_size)
+      : out(filename, ::std::ios::binary | ::std::ios::trunc)
+      , capacity(buffer_size)
+      , origin(::std::chrono::steady_clock::now())
+  {
+    if (!out.is_open())
+    {
+      ::std::cerr << "Unable to open file: " << filename << ::std::endl;
+      return;
+    }
+
+    buffer.reserve(capacity);
+    buffer.insert(buffer.end(), trace_file_magic, trace_file_magic + sizeof(trace_file_magic));
+    put_u32(trace_file_version);
+  }
+
+  trace_writer(const trace_writer&)            = delete;
+  trace_writer& operator=(const trace_writer&) = delete;
+
+  ~trace_writer()
+  {
+    close();
+  }
+
+  void add_vertex(int id, int ctx_id, int section_id, const ::std::string& label)
+  {
+    ::std::lock_guard<::std::mutex> guard(mtx);
+    begin_record(trace_record_kind::vertex);
+    put_i32(id);
+    put_i32(ctx_id);
+    put_i32(section_id);
+    put_string(label);
+    end_record();
+  }
+
+  void add_prereq(int id, int ctx_id, const ::std::string& label)
+  {
+    ::std::lock_guard<::std::mutex> guard(mtx);
+    begin_record(trace_record_kind::prereq);
+    put_i32(id);
+    put_i32(ctx_id);
+    put_string(label);
+    end_record();
+  }
+
+  void add_fence(int id, int ctx_id)
+  {
+    ::std::lock_guard<::std::mutex> guard(mtx);
+    begin_record(trace_record_kind::fence);
+    put_i32(id);
+    put_i32(ctx_id);
+    end_record();
+  }
+
+  // Edges are not deduplicated here, this is left to the offline tools
+  void add_edge(int id_from, int id_to, int style)
+  {
+    ::std::lock_guard<::std::mutex> guard(mtx);
+    begin_record(trace_record_kind::edge);
+    put_i32(id_from);
+    put_i32(id_to);
+    buffer.push_back(static_cast<char>(style));
+    end_record();
+  }
+
+  /**
+   * @brief Record the duration of a task
+   *
+   * The time at which this record is written is used as the end of the task in the timeline, as timing is collected
+   * once the task is completed.
+   */
+  void add_timing(int id, float time_ms, int device, const ::std::string& label)
+  {
+    const auto elapsed    = ::std::chrono::steady_clock::now() - origin;
+    const uint64_t end_ns = ::std::chrono::duration_cast<::std::chrono::nanoseconds>(elapsed).count();
+
+    ::std::lock_guard<::std::mutex> guard(mtx);
+    begin_record(trace_record_kind::timing);
+    put_i32(id);
+    put_f32(time_ms);
+    put_i32(device);
+    put_u64(end_ns);
+    put_string(label);
+    end_record();
+  }
+
+  void add_section(int id, int parent_id, const ::std::string& label)
+  {
+    ::std::lock_guard<::std::mutex> guard(mtx);
+    begin_record(trace_record_kind::section);
+    put_i32(id);
+    put_i32(parent_id);
+    put_string(label);
+    end_record();
+  }
+
+  /// Write buffered records to the file
+  void flush()
+  {
+    ::std::lock_guard<::std::mutex> guard(mtx);
+    flush(guard);
+  }
+
+  /// Flush and close the file, records added afterwards are ignored
+  void close()
+  {
+    ::std::lock_guard<::std::mutex> guard(mtx);
+    if (out.is_open())
+    {
+      flush(guard);
+      out.close();
+    }
+  }
+
+  /// Number of records written so far
+  size_t record_count() const
+  {
+    ::std::lock_guard<::std::mutex> guard(mtx);
+    return records;
+  }
+
+private:
+  void begin_record(trace_record_kind kind)
+  {
+    record_start = buffer.size();
+    buffer.push_back(static_cast<char>(kind));
+  }
+
+  void end_record()
+  {
+    if (!out.is_open())
+    {
+      buffer.resize(record_start);
+      return;
+    }
+
+    records++;
+    if (buffer.size() >= capacity)
+    {
+      out.write(buffer.data(), buffer.size());
+      buffer.clear();
+    }
+  }
+
+  void flush(::std::lock_guard<::std::mutex>&)
+  {
+    if (out.is_open() && !buffer.empty())
+    {
+      out.write(buffer.data(), buffer.size());
+      out.flush();
+    }
+    buffer.clear();
+  }
+
+  void put_u32(uint32_t v)
+  {
+    for (int i = 0; i < 4; i++)
+    {
+      buffer.push_back(static_cast<char>((v >> (8 * i)) & 0xff));
+    }
+  }
+
+  void put_u64(uint64_t v)
+  {
+    for (int i = 0; i < 8; i++)
+    {
+      buffer.push_back(static_cast<char>((v >> (8 * i)) & 0xff));
+    }
+  }
+
+  void put_i32(int v)
+  {
+    put_u32(static_cast<uint32_t>(v));
+  }
+
+  void put_f32(float v)
+  {
+    static_assert(sizeof(float) == sizeof(uint32_t));
+    uint32_t bits;
+    ::std::memcpy(&bits, &v, sizeof(bits));
+    put_u32(bits);
+  }
+
+  void put_string(const ::std::string& s)
+  {
+    put_u32(static_cast<uint32_t>(s.size()));
+    buffer.insert(buffer.end(), s.begin(), s.end());
+  }
+
+  ::std::ofstream out;
+  ::std::vector<char> buffer;
+  size_t capacity;
+  size_t record_start = 0;
+  size_t records      = 0;
+  ::std::chrono::steady_clock::time_point origin;
+  mutable ::std::mutex mtx;
+};
+
+/**
+ * @brief A record read from a trace file, fields which do not apply to the kind of the record are left to their
+ * default value
+ */
+struct trace_event
+{
+  trace_record_kind kind;
+  int id          = -1;
+  int other_id    = -1; // ctx_id, parent section id, or destination of an edge
+  int section_id  = 0;
+  int style       = 0;
+  int device      = -1;
+  float time_ms   = 0.0f;
+  uint64_t end_ns = 0;
+  ::std::string label;
+};
+
+/**
+ * @brief Sequentially reads the records of a trace file
+ *
+ * Records are decoded one at a time, so that arbitrarily large traces can be scanned with a constant memory footprint.
+ */
+class trace_reader
+{
+public:
+  explicit trace_reader(const ::std::string& filename)
+      : in(filename, ::std::ios::binary)
+  {
+    EXPECT(in.is_open(), "Unable to open trace file ", filename);
+
+    char magic[sizeof(trace_file_magic)];
+    in.read(magic, sizeof(magic));
+    EXPECT((in && ::std::equal(magic, magic + sizeof(magic), trace_file_magic)), "Invalid trace file ", filename);
+
+    const uint32_t version = get_u32();
+    EXPECT(version == trace_file_version, "Unsupported trace file version ", version);
+  }
+
+  /// Read the next record, returns false at the end of the file
+  bool next(trace_event& e)
+  {
+    const int kind = in.get();
+    if (kind == ::std::char_traits<char>::eof())
+    {
+      return false;
+    }
+
+    e      = trace_event{};
+    e.kind = static_cast<trace_record_kind>(kind);
+    switch (e.kind)
+    {
+      case trace_record_kind::vertex:
+        e.id         = get_i32();
+        e.other_id   = get_i32();
+        e.section_id = get_i32();
+        e.label      = get_string();
+        break;
+      case trace_record_kind::prereq:
+        e.id       = get_i32();
+        e.other_id = get_i32();
+        e.label    = get_string();
+        break;
+      case trace_record_kind::fence:
+        e.id       = get_i32();
+        e.other_id = get_i32();
+        break;
+      case trace_record_kind::edge:
+        e.id       = get_i32();
+        e.other_id = get_i32();
+        e.style    = in.get();
+        break;
+      case trace_record_kind::timing:
+        e.id      = get_i32();
+        e.time_ms = get_f32();
+        e.device  = get_i32();
+        e.end_ns  = get_u64();
+        e.label   = get_string();
+        break;
+      case trace_record_kind::section:
+        e.id       = get_i32();
+        e.other_id = get_i32();
+        e.label    = get_string();
+        break;
+      default:
+        EXPECT(false, "Invalid record kind ", kind, " in trace file.");
+    }
+
+    EXPECT(!in.fail(), "Truncated trace file.");
+    return true;
+  }
+
+  /// Call `f(const trace_event&)` for every remaining record of the file
+  template <typename Fun>
+  void for_each(Fun&& f)
+  {
+    trace_event e;
+    while (next(e))
+    {
+      f(const_cast<const trace_event&>(e));
+    }
+  }
+
+private:
+  uint32_t get_u32()
+  {
+    unsigned char b[4] = {};
+    in.read(reinterpret_cast<char*>(b), sizeof(b));
+    return uint32_t(b[0]) | (uint32_t(b[1]) << 8) | (uint32_t(b[2]) << 16) | (uint32_t(b[3]) << 24);
+  }
+
+  uint64_t get_u64()
+  {
+    const uint64_t lo = get_u32();
+    const uint64_t hi = get_u32();
+    return lo | (hi << 32);
+  }
+
+  int get_i32()
+  {
+    return static_cast<int>(get_u32());
+  }
+
+  float get_f32()
+  {
+    const uint32_t bits = get_u32();
+    float v;
+    ::std::memcpy(&v, &bits, sizeof(v));
+    return v;
+  }
+
+  ::std::string get_string()
+  {
+    const uint32_t len = get_u32();
+    ::std::string s(len, '\0');
+    in.read(s.data(), len);
+    return s;
+  }
+
+  ::std::ifstream in;
+};
+
+/**
+ * @brief The subgraph of a trace made of the vertices whose ids are in [first_id, last_id]
+ *
+ * Tasks and asynchronous operations share the same sequence of identifiers, which follows the order of submission.
+ * Selecting a range of identifiers therefore gives a self-contained portion of the execution, and the memory needed to
+ * process it only depends on its size, not on the size of the trace.
+ *
+ * Prereqs (asynchronous operations) may be left out of the subgraph, in which case the paths going through them are
+ * replaced by edges between the remaining vertices.
+ */
+class trace_graph
+{
+public:
+  struct vertex
+  {
+    ::std::string label;
+    ::std::string style;
+    int ctx_id     = -1;
+    int section_id = 0;
+    ::std::optional<float> timing;
+  };
+
+  struct section
+  {
+    int parent_id = 0;
+    ::std::string label;
+  };
+
+  trace_graph(const ::std::string& filename,
+              int first_id      = 0,
+              int last_id       = ::std::numeric_limits<int>::max(),
+              bool keep_prereqs = true)
+  {
+    auto in_range = [&](int id) {
+      return id >= first_id && id <= last_id;
+    };
+
+    // Prereqs are loaded even if they are not kept, to preserve the paths going through them
+    ::std::vector<int> dropped;
+    // Timing records may refer to vertices which are not part of the trace, they are only kept for recorded vertices
+    ::std::unordered_map<int, float> timings;
+
+    // Sections may be referenced by vertices of the range even if they were created earlier, so they are all loaded
+    trace_reader(filename).for_each([&](const trace_event& e) {
+      switch (e.kind)
+      {
+        case trace_record_kind::vertex:
+          if (in_range(e.id))
+          {
+            auto& v      = vertices[e.id];
+            v.label      = e.label;
+            v.style      = "style=\"filled\" fillcolor=\"white\"";
+            v.ctx_id     = e.other_id;
+            v.section_id = e.section_id;
+          }
+          break;
+        case trace_record_kind::prereq:
+          if (in_range(e.id))
+          {
+            if (!keep_prereqs)
+            {
+              dropped.push_back(e.id);
+            }
+            auto& v  = vertices[e.id];
+            v.label  = e.label;
+            v.style  = "style=dashed";
+            v.ctx_id = e.other_id;
+          }
+          break;
+        case trace_record_kind::fence:
+          if (in_range(e.id))
+          {
+            auto& v  = vertices[e.id];
+            v.label  = "task fence";
+            v.style  = "style=\"filled\" fillcolor=\"red\"";
+            v.ctx_id = e.other_id;
+          }
+          break;
+        case trace_record_kind::edge:
+          if (in_range(e.id) && in_range(e.other_id) && e.id != e.other_id)
+          {
+            edges.insert(::std::pair(e.id, e.other_id));
+          }
+          break;
+        case trace_record_kind::timing:
+          if (in_range(e.id))
+          {
+            timings[e.id] += e.time_ms;
+          }
+          break;
+        case trace_record_kind::section:
+          sections[e.id] = section{e.other_id, e.label};
+          break;
+      }
+    });
+
+    for (const auto& [id, ms] : timings)
+    {
+      if (auto it = vertices.find(id); it != vertices.end())
+      {
+        it->second.timing = ms;
+      }
+    }
+
+    // Edges to vertices that were not recorded (e.g. discarded tasks, or vertices outside the range) are dropped
+    for (auto it = edges.begin(); it != edges.end();)
+    {
+      if (vertices.count(it->first) == 0 || vertices.count(it->second) == 0)
+      {
+        it = edges.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+
+    contract_vertices(dropped);
+  }
+
+  /// Largest number of vertices for which `remove_redundant_edges` may be called
+  static constexpr size_t max_reduced_vertices = 64 * 1024;
+
+  /**
+   * @brief Remove the edges implied by other paths of the graph (transitive reduction)
+   *
+   * Vertices are visited in reverse topological order, and the set of vertices reachable from each vertex is stored
+   * as a bitset. The successors of a vertex are considered in topological order, so that an edge is redundant if and
+   * only if its destination is reachable through one of the successors that were kept before it.
+   *
+   * The bitsets take n * n / 8 bytes for n vertices, so that graphs of more than `max_reduced_vertices` vertices are
+   * refused (this would take more than 512 MB) : a smaller range of ids must be selected instead.
+   */
+  void remove_redundant_edges()
+  {
+    EXPECT(vertices.size() <= max_reduced_vertices,
+           "Cannot remove redundant edges of ",
+           vertices.size(),
+           " vertices, select a range of at most ",
+           max_reduced_vertices,
+           " ids.");
+
+    ::std::unordered_map<int, ::std::vector<int>> successors;
+    ::std::unordered_map<int, size_t> indegree;
+    for (const auto& p : vertices)
+    {
+      indegree[p.first] = 0;
+    }
+    for (const auto& [from, to] : edges)
+    {
+      successors[from].push_back(to);
+      indegree[to]++;
+    }
+
+    // Topological sort with Kahn's algorithm, using ids to break ties for a deterministic output
+    ::std::priority_queue<int, ::std::vector<int>, ::std::greater<int>> q;
+    for (const auto& [id, d] : indegree)
+    {
+      if (d == 0)
+      {
+        q.push(id);
+      }
+    }
+
+    ::std::vector<int> order;
+    order.reserve(vertices.size());
+    while (!q.empty())
+    {
+      int u = q.top();
+      q.pop();
+      order.push_back(u);
+      for (int v : successors[u])
+      {
+        if (--indegree[v] == 0)
+        {
+          q.push(v);
+        }
+      }
+    }
+    EXPECT(order.size() == vertices.size(), "The trace contains a cycle.");
+
+    ::std::unordered_map<int, size_t> position;
+    for (size_t i = 0; i < order.size(); i++)
+    {
+      position[order[i]] = i;
+    }
+
+    const size_t words = (order.size() + 63) / 64;
+    ::std::vector<::std::vector<uint64_t>> reach(order.size());
+
+    edge_set kept;
+    for (size_t i = order.size(); i-- > 0;)
+    {
+      auto& r = reach[i];
+      r.assign(words, 0);
+
+      auto& succ = successors[order[i]];
+      ::std::sort(succ.begin(), succ.end(), [&](int a, int b) {
+        return position[a] < position[b];
+      });
+
+      for (int s : succ)
+      {
+        const size_t j = position[s];
+        if (r[j / 64] & (uint64_t(1) << (j % 64)))
+        {
+          // Already reachable through another successor
+          continue;
+        }
+
+        kept.insert(::std::pair(order[i], s));
+        r[j / 64] |= uint64_t(1) << (j % 64);
+        for (size_t w = 0; w < words; w++)
+        {
+          r[w] |= reach[j][w];
+        }
+      }
+    }
+
+    edges = mv(kept);
+  }
+
+  /// Print the subgraph in the DOT format, with vertices grouped in the sections they were created in
+  void print_dot(::std::ostream& out) const
+  {
+    out << "digraph {\n";
+
+    // Sort vertices by id so that the output does not depend on the order of the hash tables
+    ::std::map<int, const vertex*> sorted_vertices;
+    for (const auto& [id, v] : vertices)
+    {
+      sorted_vertices[id] = &v;
+    }
+
+    ::std::map<int, ::std::vector<int>> section_nodes;
+    ::std::map<int, ::std::vector<int>> section_children;
+    for (const auto& [id, v] : sorted_vertices)
+    {
+      if (v->section_id > 0 && sections.count(v->section_id) > 0)
+      {
+        section_nodes[v->section_id].push_back(id);
+      }
+    }
+
+    // Only display the sections containing vertices of the subgraph, and their ancestors
+    ::std::unordered_set<int> used;
+    for (const auto& p : section_nodes)
+    {
+      for (int s = p.first; s > 0 && used.insert(s).second;)
+      {
+        auto it = sections.find(s);
+        s       = (it == sections.end()) ? 0 : it->second.parent_id;
+      }
+    }
+    for (int s : used)
+    {
+      section_children[sections.at(s).parent_id].push_back(s);
+    }
+    for (auto& p : section_children)
+    {
+      ::std::sort(p.second.begin(), p.second.end());
+    }
+    for (int s : section_children[0])
+    {
+      print_section(out, s, section_nodes, section_children);
+    }
+
+    ::std::vector<::std::pair<int, int>> sorted_edges(edges.begin(), edges.end());
+    ::std::sort(sorted_edges.begin(), sorted_edges.end());
+    for (const auto& [from, to] : sorted_edges)
+    {
+      out << "\"NODE_" << from << "\" -> \"NODE_" << to << "\"\n";
+    }
+
+    for (const auto& [id, v] : sorted_vertices)
+    {
+      out << "\"NODE_" << id << "\" [" << v->style << " label=\"" << v->label;
+      if (v->timing.has_value())
+      {
+        out << "\\ntiming: " << v->timing.value() << " ms";
+      }
+      out << "\"]\n";
+    }
+
+    out << "// Edge   count : " << edges.size() << "\n";
+    out << "// Vertex count : " << vertices.size() << "\n";
+    out << "}\n";
+  }
+
+  using edge_set = ::std::unordered_set<::std::pair<int, int>, cuda::experimental::stf::hash<::std::pair<int, int>>>;
+
+  ::std::unordered_map<int, vertex> vertices;
+  edge_set edges;
+  ::std::unordered_map<int, section> sections;
+
+private:
+  // Remove vertices from the graph, each path going through them is replaced by an edge between its remaining ends
+  void contract_vertices(const ::std::vector<int>& ids)
+  {
+    if (ids.empty())
+    {
+      return;
+    }
+
+    ::std::unordered_map<int, ::std::unordered_set<int>> preds, succs;
+    for (const auto& [from, to] : edges)
+    {
+      succs[from].insert(to);
+      preds[to].insert(from);
+    }
+
+    for (int id : ids)
+    {
+      const auto p = mv(preds[id]);
+      const auto s = mv(succs[id]);
+      for (int u : p)
+      {
+        succs[u].erase(id);
+        edges.erase(::std::pair(u, id));
+      }
+      for (int w : s)
+      {
+        preds[w].erase(id);
+        edges.erase(::std::pair(id, w));
+      }
+      for (int u : p)
+      {
+        for (int w : s)
+        {
+          if (u != w)
+          {
+            edges.insert(::std::pair(u, w));
+            succs[u].insert(w);
+            preds[w].insert(u);
+          }
+        }
+      }
+      preds.erase(id);
+      succs.erase(id);
+      vertices.erase(id);
+    }
+  }
+
+  void print_section(::std::ostream& out,
+                     int id,
+                     const ::std::map<int, ::std::vector<int>>& section_nodes,
+                     const ::std::map<int, ::std::vector<int>>& section_children) const
+  {
+    out << "subgraph cluster_section_" << id << " {\n";
+    out << "    color=black;\n";
+    out << "    style=dashed\n";
+    out << "    label=\"" << sections.at(id).label << "\"\n";
+
+    if (auto it = section_children.find(id); it != section_children.end())
+    {
+      for (int child : it->second)
+      {
+        print_section(out, child, section_nodes, section_children);
+      }
+    }
+
+    if (auto it = section_nodes.find(id); it != section_nodes.end())
+    {
+      for (int n : it->second)
+      {
+        out << "    \"NODE_" << n << "\"\n";
+      }
+    }
+
+    out << "} // end subgraph cluster_section_" << id << "\n";
+  }
+};
+
+/**
+ * @brief Convert the timing records of a trace into the Chrome trace event format (JSON)
+ *
+ * Each timed task becomes a complete event ("ph":"X") on the row of the device it was executed on. The file is
+ * converted in a single pass, without loading the trace in memory.
+ *
+ * @return the number of events written
+ */
+inline size_t trace_to_chrome_json(const ::std::string& filename, ::std::ostream& out)
+{
+  auto escape = [](const ::std::string& s) {
+    ::std::string r;
+    r.reserve(s.size());
+    for (char c : s)
+    {
+      if (c == '"' || c == '\\')
+      {
+        r += '\\';
+        r += c;
+      }
+      else if (c == '\n')
+      {
+        r += "\\n";
+      }
+      else if (static_cast<unsigned char>(c) >= 0x20)
+      {
+        r += c;
+      }
+    }
+    return r;
+  };
+
+  size_t cnt = 0;
+  out << "{\"traceEvents\":[\n";
+  trace_reader(filename).for_each([&](const trace_event& e) {
+    if (e.kind != trace_record_kind::timing)
+    {
+      return;
+    }
+
+    // Timestamps and durations are expressed in microseconds
+    const double dur = double(e.time_ms) * 1000.0;
+    const double ts  = ::std::max(0.0, double(e.end_ns) / 1000.0 - dur);
+    out << (cnt++ > 0 ? ",\n" : "") << "{\"name\":\"" << escape(e.label) << "\",\"ph\":\"X\",\"pid\":0,\"tid\":"
+        << e.device << ",\"ts\":" << ts << ",\"dur\":" << dur << ",\"args\":{\"id\":" << e.id << "}}";
+  });
+  out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+  return cnt;
+}
+
+#ifdef UNITTESTED_FILE
+UNITTEST("trace_graph prereqs and timings")
+{
+  const auto path = ::std::filesystem::temp_directory_path() / "cudastf_trace_file_unittest.trace";
+  {
+    trace_writer w(path.string());
+    // The timing of a task may be recorded before the task itself
+    w.add_timing(3, 2.0f, 0, "B");
+    w.add_vertex(0, 0, 0, "A");
+    w.add_prereq(1, 0, "copy");
+    w.add_prereq(2, 0, "copy");
+    w.add_vertex(3, 0, 0, "B");
+    w.add_vertex(4, 0, 0, "C");
+    // 0 -> 1 -> 2 -> 3, 0 -> 4 -> 3
+    w.add_edge(0, 1, 0);
+    w.add_edge(1, 2, 0);
+    w.add_edge(2, 3, 0);
+    w.add_edge(0, 4, 0);
+    w.add_edge(4, 3, 0);
+    w.add_timing(0, 1.0f, 0, "A");
+    w.add_timing(0, 1.0f, 0, "A");
+    w.add_timing(1, 0.5f, 0, "copy");
+    // No vertex was recorded for this id
+    w.add_timing(99, 1.0f, 0, "discarded");
+  }
+
+  trace_graph all(path.string());
+  EXPECT(all.vertices.size() == 5);
+  EXPECT(all.edges.size() == 5);
+  EXPECT(all.vertices.at(1).timing == 0.5f);
+  EXPECT(all.vertices.count(99) == 0);
+
+  // Paths through the prereqs are preserved
+  trace_graph g(path.string(), 0, ::std::numeric_limits<int>::max(), false);
+  ::std::filesystem::remove(path);
+
+  EXPECT(g.vertices.size() == 3);
+  EXPECT(g.vertices.count(99) == 0);
+  EXPECT(g.vertices.at(0).timing == 2.0f);
+  EXPECT(g.vertices.at(3).timing == 2.0f);
+  EXPECT(!g.vertices.at(4).timing.has_value());
+  EXPECT(g.edges.size() == 3);
+  EXPECT(g.edges.count(::std::pair(0, 3)) == 1);
+
+  // The edge 0 -> 3 is implied by 0 -> 4 -> 3
+  g.remove_redundant_edges();
+  EXPECT(g.edges.size() == 2);
+  EXPECT(g.edges.count(::std::pair(0, 3)) == 0);
+  EXPECT(g.edges.count(::std::pair(0, 4)) == 1);
+  EXPECT(g.edges.count(::std::pair(4, 3)) == 1);
+};
+#endif // UNITTESTED_FILE
+
+} // namespace cuda::experimental::stf::reserved
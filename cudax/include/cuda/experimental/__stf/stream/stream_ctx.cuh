@@ -549,7 +549,8 @@ public:
 
       for (auto& [id, payload] : payloads)
       {
-        if (payload.device != -1)
+        // Only tasks without an explicit execution place may be moved to the device selected by the reorderer
+        if (payload.device != -1 && state.task_map.at(id).has_auto_exec_place())
         {
           state.task_map.at(id).set_exec_place(exec_place::device(payload.device));
         }
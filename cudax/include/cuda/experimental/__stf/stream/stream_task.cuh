@@ -339,6 +339,29 @@ public:
       }
       dep.set_symbol(dep.get_data().get_symbol());
       dep.set_data_footprint(dep.get_data().get_data_interface().data_footprint());
+      dep.set_data_id(dep.get_data().get_unique_id());
+
+      // Valid copies of the data before this task, from which the reorderer estimates the cost of transfers
+      const auto d = dep.get_data();
+      ::std::vector<int> valid_devices;
+      bool valid_on_host = false;
+      for (auto i : each(instance_id_t(d.get_data_instance_count())))
+      {
+        const auto& inst = d.get_data_instance(i);
+        if (!inst.get_used() || inst.get_msir() == reserved::msir_state_id::invalid)
+        {
+          continue;
+        }
+        if (inst.get_dplace().is_device())
+        {
+          valid_devices.push_back(device_ordinal(inst.get_dplace()));
+        }
+        else
+        {
+          valid_on_host = true;
+        }
+      }
+      dep.set_valid_copies(mv(valid_devices), valid_on_host);
       index++;
     }
   }
@@ -678,6 +701,18 @@ protected:
       return cost;
     }
 
+    // Indicates whether the execution place is selected automatically, so that a reorderer may assign a device
+    virtual bool has_auto_exec_place() const
+    {
+      return false;
+    }
+
+    // Device on which the task must run, or -1 if it has an automatic execution place
+    virtual int get_pinned_device() const
+    {
+      return cuda_try<cudaGetDevice>();
+    }
+
   private:
     // Sets of mapping ids
     ::std::unordered_set<int> predecessors;
@@ -766,7 +801,8 @@ public:
       payload->get_mapping_id(),
       payload->get_successors(),
       payload->get_predecessors(),
-      payload->get_task_deps());
+      payload->get_task_deps(),
+      payload->get_pinned_device());
   }
 
   void set_exec_place(exec_place e_place)
@@ -774,6 +810,12 @@ public:
     assert(payload);
     payload->set_exec_place(e_place);
   }
+
+  bool has_auto_exec_place() const
+  {
+    assert(payload);
+    return payload->has_auto_exec_place();
+  }
 };
 
 /**
@@ -834,6 +876,22 @@ class deferred_stream_task : public deferred_stream_task<>
     {
       task.set_exec_place(e_place);
     }
+
+    bool has_auto_exec_place() const override
+    {
+      return task.get_exec_place().affine_data_place().is_device_auto();
+    }
+
+    int get_pinned_device() const override
+    {
+      const auto& place = task.get_exec_place().affine_data_place();
+      if (place.is_device_auto())
+      {
+        return -1;
+      }
+      // Tasks which do not run on a single device are kept on the current device
+      return place.is_device() ? device_ordinal(place) : cuda_try<cudaGetDevice>();
+    }
   };
 
   payload_t& my_payload() const
@@ -0,0 +1,240 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of CUDA Experimental in CUDA C++ Core Libraries,
+// under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES.
+//
+//===----------------------------------------------------------------------===//
+
+// Include this first
+#include <cuda/experimental/__async/sender.cuh>
+
+// Then include the test helpers
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "common/checked_receiver.cuh"
+#include "common/utility.cuh"
+#include "testing.cuh"
+
+namespace
+{
+#if !defined(__CUDA_ARCH__)
+
+TEST_CASE("bulk calls the function for each index and passes the values on", "[adaptors][bulk]")
+{
+  std::vector<int> seen(10, 0);
+  auto sndr = cudax_async::just(3) //
+            | cudax_async::bulk(10, [&](int i, int& val) {
+                seen[i] += val;
+              });
+
+  check_value_types<types<int>>(sndr);
+  check_sends_stopped<false>(sndr);
+  check_error_types<std::exception_ptr>(sndr);
+
+  auto op = cudax_async::connect(std::move(sndr), checked_value_receiver{3});
+  cudax_async::start(op);
+
+  CUDAX_CHECK(seen == std::vector<int>(10, 3));
+}
+
+TEST_CASE("bulk with a noexcept function does not send an error", "[adaptors][bulk]")
+{
+  int sum   = 0;
+  auto sndr = cudax_async::bulk(cudax_async::just(), 4, [&](int i) noexcept {
+    sum += i;
+  });
+
+  check_value_types<types<>>(sndr);
+  check_error_types<>(sndr);
+
+  auto op = cudax_async::connect(std::move(sndr), checked_value_receiver<>{});
+  cudax_async::start(op);
+
+  CUDAX_CHECK(sum == 6);
+}
+
+TEST_CASE("bulk_chunked runs the whole index space as one chunk by default", "[adaptors][bulk]")
+{
+  std::vector<std::pair<int, int>> chunks;
+  auto sndr = cudax_async::just(42) //
+            | cudax_async::bulk_chunked(100, [&](int begin, int end, int) {
+                chunks.emplace_back(begin, end);
+              });
+
+  auto op = cudax_async::connect(std::move(sndr), checked_value_receiver{42});
+  cudax_async::start(op);
+
+  CUDAX_REQUIRE(chunks.size() == 1);
+  CUDAX_CHECK(chunks[0] == std::make_pair(0, 100));
+}
+
+TEST_CASE("bulk sends the exception thrown by its function", "[adaptors][bulk]")
+{
+  int calls = 0;
+  auto sndr = cudax_async::just() //
+            | cudax_async::bulk(10, [&](int i) {
+                ++calls;
+                if (i == 4)
+                {
+                  throw std::runtime_error("bulk");
+                }
+              });
+
+  bool caught = false;
+  try
+  {
+    cudax_async::sync_wait(std::move(sndr));
+  }
+  catch (const std::runtime_error&)
+  {
+    caught = true;
+  }
+  CUDAX_CHECK(caught);
+  CUDAX_CHECK(calls == 5);
+}
+
+TEST_CASE("bulk passes errors and stopped of its predecessor through", "[adaptors][bulk]")
+{
+  bool called = false;
+  auto fn     = [&](int) noexcept {
+    called = true;
+  };
+
+  auto op1 = cudax_async::connect(cudax_async::just_error(13) | cudax_async::bulk(5, fn), checked_error_receiver{13});
+  cudax_async::start(op1);
+
+  auto op2 = cudax_async::connect(cudax_async::just_stopped() | cudax_async::bulk(5, fn), checked_stopped_receiver{});
+  cudax_async::start(op2);
+
+  CUDAX_CHECK_FALSE(called);
+}
+
+TEST_CASE("bulk with a negative shape has an empty index space", "[adaptors][bulk]")
+{
+  bool called = false;
+  auto fn     = [&](int, int) noexcept {
+    called = true;
+  };
+
+  auto op1 = cudax_async::connect(cudax_async::just(7) | cudax_async::bulk(-5, fn), checked_value_receiver{7});
+  cudax_async::start(op1);
+  CUDAX_CHECK_FALSE(called);
+
+  std::vector<std::pair<int, int>> chunks;
+  auto chunk_fn = [&](int begin, int end) {
+    chunks.emplace_back(begin, end);
+  };
+
+  auto op2 =
+    cudax_async::connect(cudax_async::just() | cudax_async::bulk_chunked(-3, chunk_fn), checked_value_receiver<>{});
+  cudax_async::start(op2);
+  CUDAX_REQUIRE(chunks.size() == 1);
+  CUDAX_CHECK(chunks[0] == std::make_pair(0, 0));
+}
+
+TEST_CASE("bulk is split across the threads of a static_thread_pool", "[adaptors][bulk][static_thread_pool]")
+{
+  cudax_async::static_thread_pool pool{4};
+  constexpr int count = 10000;
+
+  std::vector<std::atomic<int>> hits(count);
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+
+  // the values of the predecessor are decay-copied and sent on after all the indices ran
+  auto sndr = cudax_async::continue_on(cudax_async::just(1), pool.get_scheduler()) //
+            | cudax_async::bulk(count, [&](int i, int& val) {
+                hits[i].fetch_add(val);
+                if (i % 100 == 0)
+                {
+                  std::lock_guard<std::mutex> lock{mutex};
+                  threads.insert(std::this_thread::get_id());
+                }
+              });
+
+  auto [val] = cudax_async::sync_wait(std::move(sndr)).value();
+  CUDAX_CHECK(val == 1);
+
+  for (auto& hit : hits)
+  {
+    CUDAX_CHECK(hit.load() == 1);
+  }
+  CUDAX_CHECK(threads.count(std::this_thread::get_id()) == 0);
+}
+
+TEST_CASE("bulk_chunked partitions the index space on a static_thread_pool", "[adaptors][bulk][static_thread_pool]")
+{
+  cudax_async::static_thread_pool pool{3};
+  constexpr long count = 1001;
+
+  std::mutex mutex;
+  std::vector<std::pair<long, long>> chunks;
+
+  // bulk running on a pool uses the scheduler of the environment when its predecessor has no completion scheduler
+  auto sndr = cudax_async::start_on(pool.get_scheduler(),
+                                    cudax_async::just() | cudax_async::bulk_chunked(count, [&](long begin, long end) {
+                                      std::lock_guard<std::mutex> lock{mutex};
+                                      chunks.emplace_back(begin, end);
+                                    }));
+  cudax_async::sync_wait(std::move(sndr));
+
+  std::sort(chunks.begin(), chunks.end());
+  CUDAX_REQUIRE(chunks.size() > 1);
+  CUDAX_CHECK(chunks.front().first == 0);
+  CUDAX_CHECK(chunks.back().second == count);
+  for (size_t i = 1; i < chunks.size(); ++i)
+  {
+    CUDAX_CHECK(chunks[i - 1].second == chunks[i].first);
+  }
+}
+
+TEST_CASE("bulk with a negative shape runs no index on a static_thread_pool", "[adaptors][bulk][static_thread_pool]")
+{
+  cudax_async::static_thread_pool pool{4};
+  std::atomic<int> calls{0};
+
+  auto sndr = cudax_async::continue_on(cudax_async::just(2), pool.get_scheduler()) //
+            | cudax_async::bulk(-1000, [&](int, int) {
+                calls.fetch_add(1);
+              });
+
+  auto [val] = cudax_async::sync_wait(std::move(sndr)).value();
+  CUDAX_CHECK(val == 2);
+  CUDAX_CHECK(calls.load() == 0);
+}
+
+TEST_CASE("bulk on a static_thread_pool sends the exception of a failed index", "[adaptors][bulk][static_thread_pool]")
+{
+  cudax_async::static_thread_pool pool{4};
+
+  auto sndr = cudax_async::continue_on(cudax_async::just(), pool.get_scheduler()) //
+            | cudax_async::bulk(1000, [](int i) {
+                if (i == 500)
+                {
+                  throw std::runtime_error("bulk");
+                }
+              });
+
+  bool caught = false;
+  try
+  {
+    cudax_async::sync_wait(std::move(sndr));
+  }
+  catch (const std::runtime_error&)
+  {
+    caught = true;
+  }
+  CUDAX_CHECK(caught);
+}
+
+#endif // !defined(__CUDA_ARCH__)
+} // namespace
@@ -0,0 +1,215 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of CUDA Experimental in CUDA C++ Core Libraries,
+// under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES.
+//
+//===----------------------------------------------------------------------===//
+
+// Include this first
+#include <cuda/experimental/__async/sender.cuh>
+
+// Then include the test helpers
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "common/checked_receiver.cuh"
+#include "common/utility.cuh"
+#include "testing.cuh"
+
+namespace
+{
+#if !defined(__CUDA_ARCH__)
+
+TEST_CASE("split sends the values of its predecessor to every receiver", "[adaptors][split]")
+{
+  int calls = 0;
+  auto sndr = cudax_async::just(21) //
+            | cudax_async::then([&](int i) {
+                ++calls;
+                return i * 2;
+              })
+            | cudax_async::split();
+
+  check_value_types<types<const int&>>(sndr);
+  check_error_types<const std::exception_ptr&>(sndr);
+  check_sends_stopped<false>(sndr);
+
+  auto op1 = cudax_async::connect(sndr, checked_value_receiver{42});
+  auto op2 = cudax_async::connect(sndr, checked_value_receiver{42});
+  auto op3 = cudax_async::connect(std::move(sndr), checked_value_receiver{42});
+
+  // split is lazy
+  CUDAX_CHECK(calls == 0);
+
+  cudax_async::start(op1);
+  CUDAX_CHECK(calls == 1);
+
+  cudax_async::start(op2);
+  cudax_async::start(op3);
+  CUDAX_CHECK(calls == 1);
+}
+
+TEST_CASE("ensure_started starts its predecessor eagerly", "[adaptors][ensure_started]")
+{
+  int calls = 0;
+  auto sndr = cudax_async::ensure_started(cudax_async::just() | cudax_async::then([&]() noexcept {
+                                            return ++calls;
+                                          }));
+  CUDAX_CHECK(calls == 1);
+
+  check_error_types<>(sndr);
+
+  auto op1 = cudax_async::connect(sndr, checked_value_receiver{1});
+  auto op2 = cudax_async::connect(std::move(sndr), checked_value_receiver{1});
+  cudax_async::start(op1);
+  cudax_async::start(op2);
+  CUDAX_CHECK(calls == 1);
+}
+
+TEST_CASE("ensure_started runs to completion when its sender is discarded", "[adaptors][ensure_started]")
+{
+  std::vector<int> values{1, 2, 3};
+  int calls = 0;
+  {
+    auto sndr = cudax_async::just(values) | cudax_async::then([&](std::vector<int> v) {
+                  ++calls;
+                  return v;
+                })
+              | cudax_async::ensure_started();
+  }
+  CUDAX_CHECK(calls == 1);
+}
+
+TEST_CASE("split sends errors and stopped to every receiver", "[adaptors][split]")
+{
+  auto sndr1 = cudax_async::split(cudax_async::just_error(13));
+  check_error_types<const int&>(sndr1);
+
+  auto op1 = cudax_async::connect(sndr1, checked_error_receiver{13});
+  auto op2 = cudax_async::connect(sndr1, checked_error_receiver{13});
+  cudax_async::start(op1);
+  cudax_async::start(op2);
+
+  auto sndr2 = cudax_async::split(cudax_async::just_stopped());
+  check_sends_stopped<true>(sndr2);
+
+  auto op3 = cudax_async::connect(sndr2, checked_stopped_receiver{});
+  auto op4 = cudax_async::connect(sndr2, checked_stopped_receiver{});
+  cudax_async::start(op3);
+  cudax_async::start(op4);
+}
+
+TEST_CASE("split sends the exception thrown by its predecessor", "[adaptors][split]")
+{
+  auto sndr = cudax_async::just() //
+            | cudax_async::then([]() -> int {
+                throw std::runtime_error("split");
+              })
+            | cudax_async::split();
+
+  for (int i = 0; i < 2; ++i)
+  {
+    bool caught = false;
+    try
+    {
+      cudax_async::sync_wait(sndr);
+    }
+    catch (const std::runtime_error&)
+    {
+      caught = true;
+    }
+    CUDAX_CHECK(caught);
+  }
+}
+
+TEST_CASE("split shares one computation among the children of when_all", "[adaptors][split]")
+{
+  int calls = 0;
+  auto sndr = cudax_async::just(std::vector<int>{1, 2, 3}) //
+            | cudax_async::then([&](std::vector<int> v) {
+                ++calls;
+                return v;
+              })
+            | cudax_async::split();
+
+  auto size = [](const std::vector<int>& v) noexcept {
+    return v.size();
+  };
+  auto [a, b] = cudax_async::sync_wait(cudax_async::when_all(sndr | cudax_async::then(size), //
+                                                             sndr | cudax_async::then(size)))
+                  .value();
+  CUDAX_CHECK(a == 3);
+  CUDAX_CHECK(b == 3);
+  CUDAX_CHECK(calls == 1);
+}
+
+TEST_CASE("ensure_started on a static_thread_pool completes every waiter once", "[adaptors][ensure_started]")
+{
+  cudax_async::static_thread_pool pool{4};
+  std::atomic<int> calls{0};
+
+  for (int iter = 0; iter < 100; ++iter)
+  {
+    calls     = 0;
+    auto sndr = cudax_async::continue_on(cudax_async::just(iter), pool.get_scheduler()) //
+              | cudax_async::then([&](int i) noexcept {
+                  calls.fetch_add(1);
+                  return i;
+                })
+              | cudax_async::ensure_started();
+
+    // the waiters race with the completion of the shared computation
+    std::vector<int> results(4, -1);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+      threads.emplace_back([&results, t, sndr] {
+        auto [i]   = cudax_async::sync_wait(sndr).value();
+        results[t] = i;
+      });
+    }
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+
+    CUDAX_CHECK(results == std::vector<int>(4, iter));
+    CUDAX_CHECK(calls.load() == 1);
+  }
+}
+
+TEST_CASE("split with detached consumers on a static_thread_pool", "[adaptors][split]")
+{
+  cudax_async::static_thread_pool pool{4};
+  std::atomic<int> done{0};
+  std::atomic<long> sum{0};
+
+  constexpr int iterations = 1000;
+  for (int iter = 0; iter < iterations; ++iter)
+  {
+    auto sndr    = cudax_async::split(cudax_async::start_on(pool.get_scheduler(), cudax_async::just(iter)));
+    auto consume = [&](const int& i) noexcept {
+      sum.fetch_add(i);
+      done.fetch_add(1);
+    };
+
+    // the consumers own the only references on the shared state, and each one is destroyed as soon as it is notified,
+    // possibly before its start has returned
+    cudax_async::start_detached(sndr | cudax_async::then(consume));
+    cudax_async::start_detached(std::move(sndr) | cudax_async::then(consume));
+  }
+
+  while (done.load() < 2 * iterations)
+  {
+    std::this_thread::yield();
+  }
+  CUDAX_CHECK(sum.load() == long(iterations) * (iterations - 1));
+}
+
+#endif // !defined(__CUDA_ARCH__)
+} // namespace
@@ -0,0 +1,124 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of CUDA Experimental in CUDA C++ Core Libraries,
+// under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES.
+//
+//===----------------------------------------------------------------------===//
+
+#include <cuda/experimental/__async/sender.cuh>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include "common/checked_receiver.cuh"
+#include "common/utility.cuh"
+#include "testing.cuh"
+
+namespace
+{
+#if !defined(__CUDA_ARCH__)
+
+TEST_CASE("static_thread_pool scheduler is a parallel scheduler", "[context][static_thread_pool]")
+{
+  cudax_async::static_thread_pool pool{2};
+  auto sch = pool.get_scheduler();
+
+  CUDAX_CHECK(pool.thread_count() == 2);
+  CUDAX_CHECK(cudax_async::get_forward_progress_guarantee(sch) == cudax_async::forward_progress_guarantee::parallel);
+  CUDAX_CHECK(sch == pool.get_scheduler());
+
+  cudax_async::static_thread_pool other{1};
+  CUDAX_CHECK(sch != other.get_scheduler());
+}
+
+TEST_CASE("static_thread_pool runs work started on it", "[context][static_thread_pool]")
+{
+  cudax_async::static_thread_pool pool{4};
+
+  std::thread::id id{};
+  auto snd = cudax_async::start_on(pool.get_scheduler(), cudax_async::just(13)) //
+           | cudax_async::then([&](int val) {
+               id = std::this_thread::get_id();
+               return val;
+             });
+  check_values(std::move(snd), 13);
+  CUDAX_CHECK(id != std::thread::id{});
+  CUDAX_CHECK(id != std::this_thread::get_id());
+}
+
+TEST_CASE("static_thread_pool can be continued on", "[context][static_thread_pool]")
+{
+  cudax_async::static_thread_pool pool{2};
+
+  auto snd = cudax_async::continue_on(cudax_async::just(2, 3), pool.get_scheduler()) //
+           | cudax_async::then([](int a, int b) {
+               return a * b;
+             });
+  check_values(std::move(snd), 6);
+}
+
+TEST_CASE("static_thread_pool runs when_all branches in parallel", "[context][static_thread_pool]")
+{
+  cudax_async::static_thread_pool pool{2};
+  auto sch = pool.get_scheduler();
+
+  // each branch waits for the other one to start, which deadlocks unless they run on different threads
+  std::atomic<int> started{0};
+  auto branch = [&](int val) {
+    return cudax_async::start_on(sch, cudax_async::just(val)) //
+         | cudax_async::then([&](int v) {
+             started.fetch_add(1);
+             while (started.load() < 2)
+             {
+               std::this_thread::yield();
+             }
+             return v;
+           });
+  };
+
+  auto [a, b] = cudax_async::sync_wait(cudax_async::when_all(branch(1), branch(2))).value();
+  CUDAX_CHECK(a == 1);
+  CUDAX_CHECK(b == 2);
+}
+
+TEST_CASE("static_thread_pool runs work scheduled from its own threads", "[context][static_thread_pool]")
+{
+  cudax_async::static_thread_pool pool{4};
+  auto sch = pool.get_scheduler();
+
+  constexpr int count = 1000;
+  std::atomic<int> done{0};
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+
+  // every task scheduled from outside the pool schedules nested tasks from inside it
+  for (int i = 0; i < count; ++i)
+  {
+    cudax_async::start_detached(cudax_async::start_on(sch, cudax_async::just()) | cudax_async::then([&] {
+                                  for (int j = 0; j < 10; ++j)
+                                  {
+                                    cudax_async::start_detached(
+                                      cudax_async::start_on(sch, cudax_async::just()) | cudax_async::then([&] {
+                                        {
+                                          std::lock_guard<std::mutex> lock{mutex};
+                                          threads.insert(std::this_thread::get_id());
+                                        }
+                                        done.fetch_add(1);
+                                      }));
+                                  }
+                                }));
+  }
+
+  pool.join();
+
+  CUDAX_CHECK(done.load() == count * 10);
+  CUDAX_CHECK(threads.count(std::this_thread::get_id()) == 0);
+}
+
+#endif // !defined(__CUDA_ARCH__)
+} // namespace
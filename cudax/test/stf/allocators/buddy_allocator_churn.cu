@@ -0,0 +1,102 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of CUDASTF in CUDA C++ Core Libraries,
+// under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES.
+//
+//===----------------------------------------------------------------------===//
+
+#include <cuda/experimental/stf.cuh>
+
+#include <algorithm>
+#include <random>
+
+/**
+ * @brief Checks the buddy allocator metadata under allocate/free churn
+ *
+ * The buffer is first fragmented by filling it with small blocks and freeing every other one, which leaves long free
+ * lists in which no block can be coalesced. Blocks are then freed in random order and reallocated, each free looking
+ * up the buddy of the block among the free blocks of its level. The test checks that allocated blocks never overlap,
+ * that two free buddies are coalesced and no other blocks are, and that freeing every block coalesces the buffer back
+ * into a single block.
+ */
+
+using namespace cuda::experimental::stf;
+
+int main(int, char**)
+{
+  constexpr size_t total_size = 1 << 20;
+  constexpr size_t unit       = 256;
+  constexpr size_t num_units  = total_size / unit;
+  constexpr size_t num_ops    = 1 << 14;
+
+  event_list prereqs;
+  reserved::buddy_allocator_metadata metadata(total_size, prereqs);
+
+  // Which units of the buffer are currently allocated
+  ::std::vector<bool> used(num_units, false);
+
+  event_list dummy;
+  auto allocate = [&] {
+    const ::std::ptrdiff_t offset = metadata.allocate(unit, dummy);
+    EXPECT(offset != -1);
+    EXPECT(offset % unit == 0);
+    EXPECT(!used[offset / unit], "block allocated twice");
+    used[offset / unit] = true;
+    return offset;
+  };
+
+  auto deallocate = [&](::std::ptrdiff_t offset) {
+    EXPECT(used[offset / unit], "block freed twice");
+    used[offset / unit] = false;
+    metadata.deallocate(offset, unit, dummy);
+  };
+
+  // Fill the buffer, then free every other block
+  for (size_t i = 0; i < num_units; i++)
+  {
+    allocate();
+  }
+  EXPECT(metadata.allocate(unit, dummy) == -1, "the buffer is full");
+
+  ::std::vector<::std::ptrdiff_t> live;
+  for (size_t u = 0; u < num_units; u += 2)
+  {
+    live.push_back(u * unit);
+    deallocate((u + 1) * unit);
+  }
+
+  // No two free blocks are buddies, so none may have been coalesced
+  EXPECT(metadata.allocate(2 * unit, dummy) == -1);
+
+  // Freeing the buddy of a free block coalesces them, and the pair is the only block of that size
+  deallocate(live[0]);
+  EXPECT(metadata.allocate(2 * unit, dummy) == 0);
+  metadata.deallocate(0, 2 * unit, dummy);
+  live[0] = allocate();
+
+  ::std::mt19937_64 rng(42);
+
+  for (size_t op = 0; op < num_ops; op++)
+  {
+    // Free a random block, which coalesces with its free buddy, and allocate a block again
+    const size_t i = rng() % live.size();
+    deallocate(live[i]);
+    live[i] = allocate();
+  }
+
+  // Every live block is tracked once, half of the units stay allocated
+  EXPECT(size_t(::std::count(used.begin(), used.end(), true)) == num_units / 2);
+
+  // Free the blocks in random order
+  ::std::shuffle(live.begin(), live.end(), rng);
+  for (::std::ptrdiff_t offset : live)
+  {
+    deallocate(offset);
+  }
+
+  // Everything was coalesced back into the initial block
+  EXPECT(metadata.allocate(total_size, dummy) == 0);
+}
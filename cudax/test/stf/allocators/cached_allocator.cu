@@ -0,0 +1,225 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of CUDASTF in CUDA C++ Core Libraries,
+// under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES.
+//
+//===----------------------------------------------------------------------===//
+
+/**
+ * @file
+ * @brief Checks the reuse, eviction and accounting policies of the cached block allocator
+ */
+
+#include <cuda/experimental/stf.cuh>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace cuda::experimental::stf;
+
+// Root allocator which hands out distinct fake addresses that are never dereferenced, and records the calls made to it
+//
+// At most `capacity` blocks may be allocated at the same time, further allocations fail until a block is returned.
+class counting_allocator : public block_allocator_interface
+{
+public:
+  explicit counting_allocator(size_t capacity_ = ::std::numeric_limits<size_t>::max())
+      : capacity(capacity_)
+  {}
+
+  void* allocate(backend_ctx_untyped&, const data_place&, ::std::ptrdiff_t& s, event_list&) override
+  {
+    if (live == capacity)
+    {
+      s = -s;
+      return nullptr;
+    }
+
+    allocations++;
+    live++;
+    void* result = reinterpret_cast<void*>(next);
+    next += s;
+    return result;
+  }
+
+  void deallocate(backend_ctx_untyped&, const data_place&, event_list&, void* ptr, size_t sz) override
+  {
+    EXPECT(live > 0);
+    live--;
+    freed.emplace_back(ptr, sz);
+  }
+
+  event_list deinit(backend_ctx_untyped&) override
+  {
+    return event_list();
+  }
+
+  ::std::string to_string() const override
+  {
+    return "counting";
+  }
+
+  size_t capacity;
+  size_t allocations = 0;
+  size_t live        = 0;
+  ::std::vector<::std::pair<void*, size_t>> freed;
+
+private:
+  ::std::uintptr_t next = 0x10000;
+};
+
+// Allocates a block of s bytes, which must succeed
+void* allocate(cached_block_allocator& cache, backend_ctx_untyped& ctx, size_t s)
+{
+  event_list prereqs;
+  ::std::ptrdiff_t sz = s;
+  void* result        = cache.allocate(ctx, data_place::host(), sz, prereqs);
+  EXPECT(sz > 0);
+  EXPECT(result != nullptr);
+  return result;
+}
+
+void deallocate(cached_block_allocator& cache, backend_ctx_untyped& ctx, void* ptr, size_t s)
+{
+  event_list prereqs;
+  cache.deallocate(ctx, data_place::host(), prereqs, ptr, s);
+}
+
+// A freed block serves the next request of the same size class, and is accounted with the size of its class
+void test_hit_miss(backend_ctx_untyped& ctx)
+{
+  auto root = ::std::make_shared<counting_allocator>();
+  cached_block_allocator cache(block_allocator_untyped(root));
+
+  void* a = allocate(cache, ctx, 1000);
+  EXPECT(root->allocations == 1);
+
+  // Deallocated with the requested size, but the block is as large as its class
+  deallocate(cache, ctx, a, 1000);
+  EXPECT(cache.get_statistics().cached_bytes == 1024);
+
+  EXPECT(allocate(cache, ctx, 900) == a);
+  EXPECT(root->allocations == 1);
+
+  // A different place does not share the cache
+  event_list prereqs;
+  ::std::ptrdiff_t sz = 900;
+  EXPECT(cache.allocate(ctx, data_place::managed(), sz, prereqs) != a);
+  EXPECT(root->allocations == 2);
+
+  const auto st = cache.get_statistics();
+  EXPECT(st.hits == 1);
+  EXPECT(st.misses == 2);
+  EXPECT(st.cached_bytes == 0);
+  EXPECT(st.cached_bytes_high_water == 1024);
+}
+
+// The smallest large enough block is reused, unless it exceeds the size class by more than the slack
+void test_best_fit(backend_ctx_untyped& ctx)
+{
+  auto root = ::std::make_shared<counting_allocator>();
+  cached_block_allocator cache(block_allocator_untyped(root));
+
+  void* small = allocate(cache, ctx, 4096);
+  void* large = allocate(cache, ctx, 8192);
+  deallocate(cache, ctx, large, 8192);
+  deallocate(cache, ctx, small, 4096);
+
+  // 3500 bytes round up to 3584, which the 4096 block exceeds by less than a quarter
+  EXPECT(allocate(cache, ctx, 3500) == small);
+
+  // 6000 bytes round up to 6144, which the 8192 block exceeds by a third
+  void* other = allocate(cache, ctx, 6000);
+  EXPECT(other != large);
+  EXPECT(root->allocations == 3);
+
+  // The reused block is cached again with its own size, not the requested one
+  deallocate(cache, ctx, small, 3500);
+  EXPECT(cache.get_statistics().cached_bytes == 8192 + 4096);
+  EXPECT(allocate(cache, ctx, 4000) == small);
+}
+
+// Above the byte cap, the least recently freed blocks are returned to the root allocator
+void test_lru_eviction(backend_ctx_untyped& ctx)
+{
+  auto root = ::std::make_shared<counting_allocator>();
+  cached_block_allocator cache(block_allocator_untyped(root), 3 * 1024);
+
+  void* blocks[4];
+  for (auto& b : blocks)
+  {
+    b = allocate(cache, ctx, 1024);
+  }
+
+  for (auto& b : blocks)
+  {
+    deallocate(cache, ctx, b, 1024);
+  }
+
+  auto st = cache.get_statistics();
+  EXPECT(st.evictions == 1);
+  EXPECT(st.cached_bytes == 3 * 1024);
+  EXPECT(root->freed.size() == 1);
+  EXPECT(root->freed[0].first == blocks[0]);
+  EXPECT(root->freed[0].second == 1024);
+
+  // The three most recently freed blocks are still cached, the fourth request is a miss
+  ::std::vector<void*> reused;
+  for (int i = 0; i < 3; i++)
+  {
+    reused.push_back(allocate(cache, ctx, 1024));
+  }
+  ::std::sort(reused.begin(), reused.end());
+  ::std::vector<void*> expected(blocks + 1, blocks + 4);
+  ::std::sort(expected.begin(), expected.end());
+  EXPECT(reused == expected);
+
+  allocate(cache, ctx, 1024);
+  st = cache.get_statistics();
+  EXPECT(st.hits == 3);
+  EXPECT(st.misses == 5);
+  // The cap is enforced before the high water mark is recorded
+  EXPECT(st.cached_bytes_high_water == 3 * 1024);
+}
+
+// When the root allocator is out of memory, the blocks cached for the place are released and the allocation retried
+void test_release_and_retry(backend_ctx_untyped& ctx)
+{
+  auto root = ::std::make_shared<counting_allocator>(2);
+  cached_block_allocator cache(block_allocator_untyped(root));
+
+  void* a = allocate(cache, ctx, 1024);
+  void* b = allocate(cache, ctx, 1024);
+  deallocate(cache, ctx, a, 1024);
+  deallocate(cache, ctx, b, 1024);
+
+  // Too large for the cached blocks, and the root allocator is full until they are released
+  allocate(cache, ctx, 1 << 20);
+  EXPECT(root->freed.size() == 2);
+  EXPECT(root->live == 1);
+  EXPECT(cache.get_statistics().cached_bytes == 0);
+
+  // Nothing is left to release, so the failure is reported
+  allocate(cache, ctx, 1024);
+  event_list prereqs;
+  ::std::ptrdiff_t sz = 1024;
+  cache.allocate(ctx, data_place::host(), sz, prereqs);
+  EXPECT(sz < 0);
+}
+
+int main()
+{
+  stream_ctx ctx;
+
+  test_hit_miss(ctx);
+  test_best_fit(ctx);
+  test_lru_eviction(ctx);
+  test_release_and_retry(ctx);
+
+  ctx.finalize();
+}
@@ -0,0 +1,95 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of CUDASTF in CUDA C++ Core Libraries,
+// under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES.
+//
+//===----------------------------------------------------------------------===//
+
+/**
+ * @file
+ * @brief This test makes sure we can stream the task graph to a trace file, and process it offline
+ */
+
+#include <cuda/experimental/stf.cuh>
+
+using namespace cuda::experimental::stf;
+
+int main()
+{
+// TODO (miscco): Make it work for windows
+#if !_CCCL_COMPILER(MSVC)
+  // Generate a random filename
+  int r = rand();
+
+  char filename[64];
+  snprintf(filename, 64, "output_%d.trace", r);
+  setenv("CUDASTF_TRACE_FILE", filename, 1);
+  setenv("CUDASTF_DOT_TIMING", "1", 1);
+
+  stream_ctx ctx;
+
+  auto lA = ctx.logical_data(shape_of<slice<char>>(64));
+  auto lB = ctx.logical_data(shape_of<slice<char>>(64));
+
+  // The last task depends on the first one directly and through the second one
+  ctx.task(lA.write()).set_symbol("initA")->*[](cudaStream_t, auto) {};
+  ctx.task(lA.read(), lB.write()).set_symbol("AtoB")->*[](cudaStream_t, auto, auto) {};
+  ctx.task(lA.rw(), lB.read()).set_symbol("BtoA")->*[](cudaStream_t, auto, auto) {};
+  ctx.finalize();
+
+  // Only streaming was requested, so that the graph is not kept in memory
+  EXPECT(reserved::dot::instance().is_tracing());
+  EXPECT(!reserved::dot::instance().is_generating_dot());
+
+  // Call this explicitly for the purpose of the test
+  reserved::dot::instance().finish();
+
+  // Select the three tasks, ignoring asynchronous operations
+  reserved::trace_graph g(filename, 0, ::std::numeric_limits<int>::max(), false);
+  size_t ntasks = 0;
+  for (const auto& [id, v] : g.vertices)
+  {
+    if (v.timing.has_value())
+    {
+      ntasks++;
+    }
+  }
+  EXPECT(ntasks == 3);
+
+  // Labels start with the symbol of the task
+  auto find_task = [&](const char* symbol) {
+    for (const auto& [id, v] : g.vertices)
+    {
+      if (v.label.rfind(symbol, 0) == 0)
+      {
+        return id;
+      }
+    }
+    return -1;
+  };
+  const int initA = find_task("initA");
+  const int AtoB  = find_task("AtoB");
+  const int BtoA  = find_task("BtoA");
+  EXPECT(initA != -1);
+  EXPECT(AtoB != -1);
+  EXPECT(BtoA != -1);
+
+  // The edge from initA to BtoA is implied by the path through AtoB
+  g.remove_redundant_edges();
+  EXPECT(g.edges.count(::std::pair(initA, BtoA)) == 0);
+  EXPECT(g.edges.count(::std::pair(initA, AtoB)) == 1);
+  EXPECT(g.edges.count(::std::pair(AtoB, BtoA)) == 1);
+
+  ::std::ostringstream dot_oss;
+  g.print_dot(dot_oss);
+  EXPECT(dot_oss.str().find("AtoB") != ::std::string::npos);
+
+  ::std::ostringstream json_oss;
+  EXPECT(reserved::trace_to_chrome_json(filename, json_oss) == 3);
+
+  EXPECT(unlink(filename) == 0);
+#endif // !_CCCL_COMPILER(MSVC)
+}
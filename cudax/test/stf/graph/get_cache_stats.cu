@@ -10,15 +10,113 @@
 
 /**
  * @file
- * @brief An example to query statistics about graph instantiation
+ * @brief An example to query statistics about graph instantiation, and a check of the executable graph cache
  */
 
 #include <cuda/experimental/stf.cuh>
 
 using namespace cuda::experimental::stf;
 
+::std::shared_ptr<cudaGraph_t> new_graph()
+{
+  ::std::shared_ptr<cudaGraph_t> g(new cudaGraph_t, [](cudaGraph_t* p) {
+    cudaGraphDestroy(*p);
+    delete p;
+  });
+  cuda_safe_call(cudaGraphCreate(g.get(), 0));
+  return g;
+}
+
+// Three empty nodes and two edges, either as a chain a -> b -> c or as a fork a -> b, a -> c
+::std::shared_ptr<cudaGraph_t> three_node_graph(bool chain)
+{
+  auto g = new_graph();
+  cudaGraphNode_t a, b, c;
+  cuda_safe_call(cudaGraphAddEmptyNode(&a, *g, nullptr, 0));
+  cuda_safe_call(cudaGraphAddEmptyNode(&b, *g, &a, 1));
+  cuda_safe_call(cudaGraphAddEmptyNode(&c, *g, chain ? &b : &a, 1));
+  return g;
+}
+
+// A single copy node
+::std::shared_ptr<cudaGraph_t> copy_graph(void* dst, const void* src, size_t size)
+{
+  auto g = new_graph();
+  cudaGraphNode_t n;
+  cuda_safe_call(cudaGraphAddMemcpyNode1D(&n, *g, nullptr, 0, dst, src, size, cudaMemcpyDefault));
+  return g;
+}
+
+// Graphs with as many nodes and edges but a different topology are told apart by their fingerprint, and only graphs
+// with the same fingerprint are used to update each other
+void test_fingerprint_topology()
+{
+  async_resources_handle handle;
+  const auto& st = handle.graph_cache_statistics();
+
+  auto chain = three_node_graph(true);
+  auto fork  = three_node_graph(false);
+
+  const auto chain_fp = reserved::compute_graph_fingerprint(*chain);
+  const auto fork_fp  = reserved::compute_graph_fingerprint(*fork);
+  EXPECT((chain_fp.nnodes == 3 && fork_fp.nnodes == 3));
+  EXPECT((chain_fp.nedges == 2 && fork_fp.nedges == 2));
+  EXPECT(chain_fp != fork_fp);
+  EXPECT(chain_fp.hash != fork_fp.hash);
+  EXPECT(reserved::compute_graph_fingerprint(*three_node_graph(true)) == chain_fp);
+
+  // The fork is not tried against the executable graph of the chain
+  size_t failed = 0;
+  EXPECT(!handle.cached_graphs_query(chain_fp, chain, &failed).second);
+  EXPECT(!handle.cached_graphs_query(fork_fp, fork, &failed).second);
+  EXPECT(failed == 0);
+
+  // New graphs of the same topologies update the executable graphs
+  EXPECT(handle.cached_graphs_query(chain_fp, three_node_graph(true), &failed).second);
+  EXPECT(handle.cached_graphs_query(fork_fp, three_node_graph(false), &failed).second);
+  EXPECT(failed == 0);
+
+  EXPECT(st.hits == 2);
+  EXPECT(st.misses == 2);
+  EXPECT(st.failed_updates == 0);
+
+  // Changing the type of the source memory of a copy node is not supported by cudaGraphExecUpdate, so copies from
+  // device and from host memory have different fingerprints
+  const size_t size = 1024;
+  void *d_src, *d_dst, *h_src;
+  cuda_safe_call(cudaMalloc(&d_src, size));
+  cuda_safe_call(cudaMalloc(&d_dst, size));
+  cuda_safe_call(cudaMallocHost(&h_src, size));
+
+  auto d2d = copy_graph(d_dst, d_src, size);
+  auto h2d = copy_graph(d_dst, h_src, size);
+  const auto d2d_fp = reserved::compute_graph_fingerprint(*d2d);
+  const auto h2d_fp = reserved::compute_graph_fingerprint(*h2d);
+  EXPECT(d2d_fp != h2d_fp);
+
+  EXPECT(!handle.cached_graphs_query(d2d_fp, d2d, &failed).second);
+  EXPECT(!handle.cached_graphs_query(h2d_fp, h2d, &failed).second);
+  EXPECT(failed == 0);
+
+  // A copy between other device buffers updates the executable graph of the first copy
+  auto d2d_reversed = copy_graph(d_src, d_dst, size);
+  EXPECT(reserved::compute_graph_fingerprint(*d2d_reversed) == d2d_fp);
+  EXPECT(handle.cached_graphs_query(d2d_fp, d2d_reversed, &failed).second);
+  EXPECT(failed == 0);
+
+  EXPECT(st.hits == 3);
+  EXPECT(st.misses == 4);
+  EXPECT(st.failed_updates == 0);
+
+  cuda_safe_call(cudaFree(d_src));
+  cuda_safe_call(cudaFree(d_dst));
+  cuda_safe_call(cudaFreeHost(h_src));
+}
+
 int main()
 {
+  test_fingerprint_topology();
+
   async_resources_handle handle;
   for (size_t i = 0; i < 10; i++)
   {
@@ -46,6 +144,9 @@ int main()
       EXPECT(st->update_cnt == 1);
     }
 
+    // Graphs with the same structure are found directly, without trying to update other graphs
+    EXPECT(st->failed_update_cnt == 0);
+
     // fprintf(stderr, "nnodes %ld nedges %ld\n", st->nnodes, st->nedges);
   }
 }
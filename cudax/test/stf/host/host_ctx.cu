@@ -0,0 +1,106 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of CUDASTF in CUDA C++ Core Libraries,
+// under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES.
+//
+//===----------------------------------------------------------------------===//
+
+/**
+ * @file
+ *
+ * @brief Ensure tasks, parallel_for and host_launch constructs are executed by the thread pool of a host_ctx
+ */
+
+#include <cuda/experimental/stf.cuh>
+
+#include <atomic>
+
+using namespace cuda::experimental::stf;
+
+int main()
+{
+  host_ctx ctx(4);
+
+  const size_t N = 1000;
+
+  double X[N], Y[N];
+  for (size_t i = 0; i < N; i++)
+  {
+    X[i] = double(i);
+    Y[i] = 1.0;
+  }
+
+  auto lX = ctx.logical_data(X);
+  auto lY = ctx.logical_data(Y);
+  auto lZ = ctx.logical_data(lX.shape());
+
+  // Y = 2*X + Y
+  ctx.parallel_for(lY.shape(), lX.read(), lY.rw())->*[](size_t i, auto x, auto y) {
+    y(i) += 2.0 * x(i);
+  };
+
+  // Z = Y - 1
+  ctx.task(lY.read(), lZ.write())->*[](auto y, auto z) {
+    for (size_t i = 0; i < y.size(); i++)
+    {
+      z(i) = y(i) - 1.0;
+    }
+  };
+
+  // Check Z on the host with host_launch
+  ctx.host_launch(lZ.read())->*[](auto z) {
+    for (size_t i = 0; i < z.size(); i++)
+    {
+      EXPECT(z(i) == 2.0 * double(i));
+    }
+  };
+
+  // Tokens serialize tasks that do not access any data
+  int counter = 0;
+  auto token  = ctx.logical_token();
+  for (int k = 0; k < 16; k++)
+  {
+    ctx.task(token.rw())->*[&counter]() {
+      counter++;
+    };
+  }
+
+  // Concurrent accesses in read mode may execute on different threads
+  ::std::atomic<int> readers = 0;
+  for (int k = 0; k < 8; k++)
+  {
+    ctx.task(token.read())->*[&readers, &counter]() {
+      EXPECT(counter == 16);
+      readers++;
+    };
+  }
+
+  ctx.task_fence();
+  EXPECT(readers == 8);
+
+  // Multidimensional loops
+  auto lM = ctx.logical_data(shape_of<slice<int, 2>>(16, 8));
+  ctx.parallel_for(lM.shape(), lM.write())->*[](size_t i, size_t j, auto m) {
+    m(i, j) = int(i + 16 * j);
+  };
+
+  ctx.host_launch(lM.read())->*[](auto m) {
+    for (size_t j = 0; j < m.extent(1); j++)
+    {
+      for (size_t i = 0; i < m.extent(0); i++)
+      {
+        EXPECT(m(i, j) == int(i + 16 * j));
+      }
+    }
+  };
+
+  ctx.finalize();
+
+  for (size_t i = 0; i < N; i++)
+  {
+    EXPECT(Y[i] == 2.0 * double(i) + 1.0);
+  }
+}
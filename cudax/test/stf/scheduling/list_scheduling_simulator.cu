@@ -0,0 +1,194 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of CUDASTF in CUDA C++ Core Libraries,
+// under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES.
+//
+//===----------------------------------------------------------------------===//
+
+/**
+ * @file
+ *
+ * @brief Compare the makespans of the scheduling policies on a task graph, without using any device
+ *
+ * By default, the task graph of a tiled Cholesky factorization is used. A task graph recorded by setting
+ * CUDASTF_TASK_ORDER=lookahead and CUDASTF_TASK_GRAPH_FILE may be replayed by passing the file as an argument,
+ * optionally followed by the number of devices.
+ */
+
+#include <cuda/experimental/__stf/internal/list_scheduling.cuh>
+
+#include <cstdio>
+#include <sstream>
+
+using namespace cuda::experimental::stf;
+using namespace cuda::experimental::stf::reserved;
+
+// Task graph of a tiled Cholesky factorization of nt x nt tiles of the given size, the potrf tasks are kept on the
+// given device unless it is -1
+list_sched_graph cholesky_graph(int nt, size_t tile_bytes, int potrf_device = -1)
+{
+  list_sched_graph g;
+
+  // Last task which modified each tile
+  ::std::vector<int> last_writer(nt * nt, -1);
+  int next_id = 0;
+
+  auto tile = [&](int i, int j) {
+    return "A_" + ::std::to_string(i) + "_" + ::std::to_string(j);
+  };
+
+  auto add = [&](const char* symbol,
+                 double cost,
+                 ::std::vector<::std::pair<int, int>> reads,
+                 ::std::pair<int, int> written) {
+    const int id = next_id++;
+    auto& t      = g.add_task(id, symbol, cost);
+
+    for (auto [i, j] : reads)
+    {
+      t.accesses.push_back({i * nt + j, tile(i, j), tile_bytes, access_mode::read});
+    }
+    t.accesses.push_back(
+      {written.first * nt + written.second, tile(written.first, written.second), tile_bytes, access_mode::rw});
+
+    ::std::vector<int> preds;
+    reads.push_back(written);
+    for (auto [i, j] : reads)
+    {
+      const int w = last_writer[i * nt + j];
+      if (w != -1 && ::std::find(preds.begin(), preds.end(), w) == preds.end())
+      {
+        preds.push_back(w);
+      }
+    }
+    for (int p : preds)
+    {
+      g.add_dependency(p, id);
+    }
+
+    last_writer[written.first * nt + written.second] = id;
+  };
+
+  for (int k = 0; k < nt; k++)
+  {
+    add("potrf", 1.0, {}, {k, k});
+    g.at(next_id - 1).device = potrf_device;
+    for (int i = k + 1; i < nt; i++)
+    {
+      add("trsm", 2.0, {{k, k}}, {i, k});
+    }
+    for (int i = k + 1; i < nt; i++)
+    {
+      add("syrk", 2.0, {{i, k}}, {i, i});
+      for (int j = k + 1; j < i; j++)
+      {
+        add("gemm", 4.0, {{i, k}, {j, k}}, {i, j});
+      }
+    }
+  }
+
+  return g;
+}
+
+int main(int argc, char** argv)
+{
+  int ndevices = 4;
+  list_sched_graph g;
+
+  if (argc > 1)
+  {
+    g = list_sched_graph::read(::std::string(argv[1]));
+    if (argc > 2)
+    {
+      ndevices = ::std::stoi(argv[2]);
+    }
+  }
+  else
+  {
+    g = cholesky_graph(8, 8 * 1024 * 1024);
+  }
+
+  transfer_cost_model model;
+
+  const double random      = simulate_makespan(g, random_list_schedule(g, ndevices), ndevices, model);
+  const double round_robin = simulate_makespan(g, round_robin_list_schedule(g, ndevices), ndevices, model);
+  const double heft        = simulate_makespan(g, greedy_heft_list_schedule(g, ndevices, model), ndevices, model);
+  const double lookahead   = simulate_makespan(g, lookahead_list_schedule(g, ndevices, model, 16), ndevices, model);
+
+  fprintf(stderr, "%zu tasks on %d devices\n", g.size(), ndevices);
+  fprintf(stderr, "random      : %.3f ms\n", random);
+  fprintf(stderr, "round robin : %.3f ms\n", round_robin);
+  fprintf(stderr, "heft        : %.3f ms\n", heft);
+  fprintf(stderr, "lookahead   : %.3f ms\n", lookahead);
+
+  if (argc > 1)
+  {
+    return 0;
+  }
+
+  // Ranks and look-ahead must improve over the policies which ignore the structure of the graph, and over a greedy
+  // placement in submission order
+  EXPECT(lookahead <= random);
+  EXPECT(lookahead <= round_robin);
+  EXPECT(lookahead <= heft);
+
+  // The makespan cannot be shorter than the critical path
+  const auto ranks = compute_upward_ranks(g, 1, model);
+  EXPECT(lookahead >= ranks.at(0));
+
+  // A saved graph is scheduled identically once read back
+  ::std::stringstream ss;
+  g.write(ss);
+  auto g2 = list_sched_graph::read(ss);
+  EXPECT(g2.size() == g.size());
+  EXPECT(simulate_makespan(g2, lookahead_list_schedule(g2, ndevices, model, 16), ndevices, model) == lookahead);
+
+  // Distinct data with the same symbol are not mistaken for one another : the second task does not read what the
+  // first one wrote, so there is no transfer between them
+  list_sched_graph same_symbol;
+  same_symbol.add_task(0, "producer", 1.0).accesses.push_back({0, "A", 1024 * 1024 * 1024, access_mode::write});
+  same_symbol.add_task(1, "consumer", 1.0).accesses.push_back({1, "A", 1024 * 1024 * 1024, access_mode::read});
+  same_symbol.add_dependency(0, 1);
+  EXPECT(compute_upward_ranks(same_symbol, ndevices, model).at(0) == 2.0);
+
+  // Tasks with a device are kept on it by all policies, and their device is saved
+  auto pinned = cholesky_graph(8, 8 * 1024 * 1024, 1);
+  for (const auto& schedule : {random_list_schedule(pinned, ndevices),
+                               round_robin_list_schedule(pinned, ndevices),
+                               greedy_heft_list_schedule(pinned, ndevices, model),
+                               lookahead_list_schedule(pinned, ndevices, model, 16)})
+  {
+    for (const auto& t : pinned.get_tasks())
+    {
+      EXPECT((t.device == -1 || schedule.device.at(t.id) == t.device));
+    }
+  }
+
+  ::std::stringstream pinned_ss;
+  pinned.write(pinned_ss);
+  auto pinned2 = list_sched_graph::read(pinned_ss);
+  EXPECT(pinned2.at(0).device == 1);
+  EXPECT(pinned2.at(1).device == -1);
+  EXPECT(pinned2.at(0).accesses.at(0).data_id == 0);
+
+  // Data which is already valid on a device is read there without any transfer, and data without any valid copy needs
+  // no transfer at all
+  list_sched_graph resident;
+  resident.add_task(0, "reader", 1.0).accesses.push_back({0, "A", 1024 * 1024 * 1024, access_mode::read, {2}, false});
+  resident.add_task(1, "writer", 1.0).accesses.push_back({1, "B", 1024 * 1024 * 1024, access_mode::rw, {}, false});
+  const auto resident_schedule = lookahead_list_schedule(resident, ndevices, model, 16);
+  EXPECT(resident_schedule.device.at(0) == 2);
+  EXPECT(simulate_makespan(resident, resident_schedule, ndevices, model) == 1.0);
+
+  ::std::stringstream resident_ss;
+  resident.write(resident_ss);
+  auto resident2 = list_sched_graph::read(resident_ss);
+  EXPECT(resident2.at(0).accesses.at(0).valid_devices == ::std::vector<int>{2});
+  EXPECT(!resident2.at(0).accesses.at(0).valid_on_host);
+  EXPECT(resident2.at(1).accesses.at(0).valid_devices.empty());
+  EXPECT(!resident2.at(1).accesses.at(0).valid_on_host);
+  EXPECT(g2.at(0).accesses.at(0).valid_on_host);
+}
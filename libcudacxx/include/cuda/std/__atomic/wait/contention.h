@@ -0,0 +1,147 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of libcu++, the C++ Standard Library for your entire system,
+// under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCUDACXX___ATOMIC_WAIT_CONTENTION_H
+#define _LIBCUDACXX___ATOMIC_WAIT_CONTENTION_H
+
+#include <cuda/std/detail/__config>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <cuda/std/__atomic/functions.h>
+#include <cuda/std/__atomic/order.h>
+#include <cuda/std/__atomic/scopes.h>
+#include <cuda/std/__atomic/types/common.h>
+#include <cuda/std/__atomic/wait/polling.h>
+#include <cuda/std/__thread/threading_support.h>
+#include <cuda/std/cstddef>
+#include <cuda/std/cstdint>
+
+// Host waiters block on a futex instead of polling with backoff. Waiters on atomics of any size park on one of the
+// 32-bit futex words of a table indexed by a hash of the waited-on address, and notifiers wake the waiters parked on
+// the same entry. The table is per process: waiters on atomics shared with other processes are not notified and
+// only wake up once the futex wait times out.
+#if !defined(_LIBCUDACXX_HAS_NO_THREADS) && defined(_LIBCUDACXX_HAS_THREAD_API_PTHREAD) && defined(__linux__) \
+  && !_CCCL_COMPILER(NVRTC)
+#  define _LIBCUDACXX_HAS_ATOMIC_CONTENTION_TABLE
+#endif
+
+_LIBCUDACXX_BEGIN_NAMESPACE_STD
+
+// The address notifiers and waiters agree on: the one of the value, which is shared by every atomic_ref to it
+template <typename _Sto, __atomic_storage_is_base<_Sto> = 0>
+_CCCL_HOST_DEVICE void const volatile* __atomic_contention_address(_Sto const volatile* __a)
+{
+  return __a->get();
+}
+
+template <typename _Sto, __atomic_storage_is_small<_Sto> = 0>
+_CCCL_HOST_DEVICE void const volatile* __atomic_contention_address(_Sto const volatile* __a)
+{
+  return __atomic_contention_address(&__a->__a_value);
+}
+
+template <typename _Sto, __atomic_storage_is_locked<_Sto> = 0>
+_CCCL_HOST_DEVICE void const volatile* __atomic_contention_address(_Sto const volatile* __a)
+{
+  return &__a->__a_value;
+}
+
+#if defined(_LIBCUDACXX_HAS_ATOMIC_CONTENTION_TABLE)
+
+struct _CCCL_ALIGNAS(64) __cccl_contention_entry
+{
+  // number of threads parked on this entry, lets notifiers skip the system call when there are none
+  int32_t __waiters;
+  // bumped by every notification, waiters park on it
+  uint32_t __version;
+};
+
+#  define _LIBCUDACXX_CONTENTION_TABLE_SIZE 256
+
+// matches the longest sleep of __cccl_thread_poll_with_backoff
+#  define _LIBCUDACXX_CONTENTION_WAIT_TIMEOUT _CUDA_VSTD::chrono::milliseconds(1)
+
+// The table must be unique in the process for notifiers to see the waiters of other shared objects, hence the
+// default visibility.
+_CCCL_VISIBILITY_DEFAULT inline __cccl_contention_entry*
+__cccl_contention_table_entry(void const volatile* __addr) noexcept
+{
+  static __cccl_contention_entry __table[_LIBCUDACXX_CONTENTION_TABLE_SIZE];
+
+  // neighboring atomics fall on different entries
+  uintptr_t __hash = reinterpret_cast<uintptr_t>(__addr) >> 2;
+  __hash ^= __hash >> 16;
+  __hash *= 0x45d9f3bu;
+  __hash ^= __hash >> 16;
+
+  return &__table[__hash % _LIBCUDACXX_CONTENTION_TABLE_SIZE];
+}
+
+template <typename _Tp, typename _Sco>
+void __atomic_try_wait_slow_host(
+  _Tp const volatile* __a, __atomic_underlying_remove_cv_t<_Tp> __val, memory_order __order, _Sco)
+{
+  __cccl_contention_entry* __entry = __cccl_contention_table_entry(__atomic_contention_address(__a));
+
+  __atomic_fetch_add_host(&__entry->__waiters, 1, memory_order_seq_cst);
+
+  // A notification that bumps the version after this load sees the waiter above and wakes up the futex. One that
+  // bumped it before published the new value, which the comparison below observes.
+  const uint32_t __version = __atomic_load_host(&__entry->__version, memory_order_seq_cst);
+
+  const auto __current = __atomic_load_dispatch(__a, __order, _Sco{});
+
+  if (_CUDA_VSTD::__atomic_memcmp(&__current, &__val, sizeof(__val)) == 0)
+  {
+    __cccl_futex_wait(&__entry->__version, __version, _LIBCUDACXX_CONTENTION_WAIT_TIMEOUT);
+  }
+
+  __atomic_fetch_sub_host(&__entry->__waiters, 1, memory_order_release);
+}
+
+// Waiters on other atomics may share the entry, so even notify_one wakes every thread parked on it
+template <typename _Tp>
+void __atomic_notify_host(_Tp const volatile* __a)
+{
+  __cccl_contention_entry* __entry = __cccl_contention_table_entry(__atomic_contention_address(__a));
+
+  __atomic_fetch_add_host(&__entry->__version, 1u, memory_order_seq_cst);
+
+  if (__atomic_load_host(&__entry->__waiters, memory_order_seq_cst) != 0)
+  {
+    __cccl_futex_wake_all(&__entry->__version);
+  }
+}
+
+#else // ^^^ _LIBCUDACXX_HAS_ATOMIC_CONTENTION_TABLE ^^^ / vvv !_LIBCUDACXX_HAS_ATOMIC_CONTENTION_TABLE vvv
+
+template <typename _Tp, typename _Sco>
+_CCCL_HOST_DEVICE void __atomic_try_wait_slow_host(
+  _Tp const volatile* __a, __atomic_underlying_remove_cv_t<_Tp> __val, memory_order __order, _Sco)
+{
+  __atomic_try_wait_slow_fallback(__a, __val, __order, _Sco{});
+}
+
+template <typename _Tp>
+_CCCL_HOST_DEVICE void __atomic_notify_host(_Tp const volatile*)
+{}
+
+#endif // !_LIBCUDACXX_HAS_ATOMIC_CONTENTION_TABLE
+
+_LIBCUDACXX_END_NAMESPACE_STD
+
+#endif // _LIBCUDACXX___ATOMIC_WAIT_CONTENTION_H
@@ -24,6 +24,7 @@
 
 #  include <cuda/std/chrono>
 #  include <cuda/std/climits>
+#  include <cuda/std/cstdint>
 
 #  include <errno.h>
 #  include <pthread.h>
@@ -175,6 +176,24 @@ _LIBCUDACXX_HIDE_FROM_ABI void __cccl_thread_sleep_for(_CUDA_VSTD::chrono::nanos
     ;
 }
 
+// Futex
+#  if defined(__linux__)
+
+// Blocks while *__addr == __expected, returns on a wake up, a signal, a spurious wake up or after __ns
+_LIBCUDACXX_HIDE_FROM_ABI void
+__cccl_futex_wait(uint32_t const volatile* __addr, uint32_t __expected, _CUDA_VSTD::chrono::nanoseconds __ns)
+{
+  __cccl_timespec_t __ts = __cccl_to_timespec(__ns);
+  ::syscall(SYS_futex, __addr, FUTEX_WAIT_PRIVATE, __expected, &__ts, nullptr, 0);
+}
+
+_LIBCUDACXX_HIDE_FROM_ABI void __cccl_futex_wake_all(uint32_t const volatile* __addr)
+{
+  ::syscall(SYS_futex, __addr, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+}
+
+#  endif // __linux__
+
 _LIBCUDACXX_END_NAMESPACE_STD
 
 _CCCL_POP_MACROS
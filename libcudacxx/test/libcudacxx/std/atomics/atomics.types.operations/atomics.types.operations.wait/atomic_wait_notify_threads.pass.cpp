@@ -0,0 +1,170 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of libcu++, the C++ Standard Library for your entire system,
+// under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES.
+//
+//===----------------------------------------------------------------------===//
+//
+// UNSUPPORTED: libcpp-has-no-threads
+// UNSUPPORTED: pre-sm-70
+
+// <cuda/std/atomic>
+
+// Host threads blocked in wait are woken by notify_one and notify_all, including when several atomics share a waiter
+// entry and when waiters and notifiers go through different atomic_ref instances.
+
+#include <cuda/std/atomic>
+#include <cuda/std/cassert>
+
+#include "test_macros.h"
+
+#ifndef __CUDA_ARCH__
+#  include <thread>
+#  include <vector>
+#endif
+
+#ifndef __CUDA_ARCH__
+
+constexpr int num_threads = 8;
+constexpr int num_rounds  = 1000;
+
+// every waiter is released by a single notify_all
+template <class T>
+void test_notify_all()
+{
+  cuda::std::atomic<T> flag(T(0));
+  cuda::std::atomic<int> woken(0);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_threads; ++i)
+  {
+    threads.emplace_back([&] {
+      flag.wait(T(0));
+      assert(flag.load() == T(1));
+      woken.fetch_add(1);
+    });
+  }
+
+  flag.store(T(1));
+  flag.notify_all();
+
+  for (auto& t : threads)
+  {
+    t.join();
+  }
+  assert(woken.load() == num_threads);
+}
+
+// two threads take turns, every turn is handed over with notify_one
+template <class T>
+void test_notify_one_ping_pong()
+{
+  cuda::std::atomic<T> turn(T(0));
+
+  std::thread other([&] {
+    for (int i = 0; i < num_rounds; ++i)
+    {
+      turn.wait(T(0));
+      turn.store(T(0));
+      turn.notify_one();
+    }
+  });
+
+  for (int i = 0; i < num_rounds; ++i)
+  {
+    turn.store(T(1));
+    turn.notify_one();
+    turn.wait(T(1));
+  }
+
+  other.join();
+  assert(turn.load() == T(0));
+}
+
+// Every thread waits on its own atomic of an array, with more atomics than waiter entries, so that some of them share
+// an entry. Each is released by a notify_one that other waiters on the entry may observe too.
+void test_shared_entries()
+{
+  constexpr int num_flags = 1024;
+
+  std::vector<cuda::std::atomic<char>> flags(num_flags);
+  for (auto& f : flags)
+  {
+    f.store(0);
+  }
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_threads; ++i)
+  {
+    threads.emplace_back([&, i] {
+      for (int j = i; j < num_flags; j += num_threads)
+      {
+        flags[j].wait(0);
+        assert(flags[j].load() == 1);
+      }
+    });
+  }
+
+  for (int j = 0; j < num_flags; ++j)
+  {
+    flags[j].store(1);
+    flags[j].notify_one();
+  }
+
+  for (auto& t : threads)
+  {
+    t.join();
+  }
+}
+
+// waiters and notifiers use distinct atomic_ref instances of one object
+void test_atomic_ref()
+{
+  int value = 0;
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_threads; ++i)
+  {
+    threads.emplace_back([&] {
+      cuda::std::atomic_ref<int> ref(value);
+      ref.wait(0);
+      assert(ref.load() == 1);
+    });
+  }
+
+  cuda::std::atomic_ref<int> ref(value);
+  ref.store(1);
+  ref.notify_all();
+
+  for (auto& t : threads)
+  {
+    t.join();
+  }
+}
+
+void test()
+{
+  test_notify_all<char>();
+  test_notify_all<int>();
+  test_notify_all<long long>();
+
+  test_notify_one_ping_pong<short>();
+  test_notify_one_ping_pong<int>();
+  test_notify_one_ping_pong<unsigned long long>();
+
+  test_shared_entries();
+
+  test_atomic_ref();
+}
+
+#endif // __CUDA_ARCH__
+
+int main(int, char**)
+{
+  NV_IF_TARGET(NV_IS_HOST, (test();))
+
+  return 0;
+}
@@ -42,6 +42,10 @@ static void basic(nvbench::state& state, nvbench::type_list<T>)
   thrust::device_vector<T> data = generate(elements + needles);
   thrust::device_vector<T> result(needles);
   thrust::sort(data.begin(), data.begin() + elements);
+  if (state.get_string("Needles") == "sorted")
+  {
+    thrust::sort(data.begin() + elements, data.end());
+  }
 
   state.add_element_count(needles);
 
@@ -58,4 +62,5 @@ NVBENCH_BENCH_TYPES(basic, NVBENCH_TYPE_AXES(types))
   .set_name("base")
   .set_type_axes_names({"T{ct}"})
   .add_int64_power_of_two_axis("Elements", nvbench::range(16, 28, 4))
-  .add_int64_axis("NeedlesRatio", {1, 25, 50});
+  .add_int64_axis("NeedlesRatio", {1, 25, 50})
+  .add_string_axis("Needles", {"random", "sorted"});
@@ -0,0 +1,164 @@
+#include <thrust/detail/config.h>
+
+#include <thrust/mr/concurrent_pool.h>
+#include <thrust/mr/new.h>
+
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <unittest/unittest.h>
+
+void TestConcurrentPoolReuse()
+{
+  using Pool = thrust::mr::concurrent_pool_resource<thrust::mr::new_delete_resource>;
+
+  thrust::mr::new_delete_resource upstream;
+  Pool pool(&upstream);
+
+  void* a = pool.do_allocate(12, 4);
+  void* b = pool.do_allocate(16, 8);
+  ASSERT_EQUAL(a != b, true);
+  ASSERT_EQUAL(reinterpret_cast<std::size_t>(a) % 4, 0u);
+  ASSERT_EQUAL(reinterpret_cast<std::size_t>(b) % 8, 0u);
+
+  // a freed block is handed out again by the next allocation of the same size class
+  pool.do_deallocate(a, 12, 4);
+  void* c = pool.do_allocate(10, 4);
+  ASSERT_EQUAL(c, a);
+
+  pool.do_deallocate(b, 16, 8);
+  pool.do_deallocate(c, 10, 4);
+
+  // more blocks than fit in the magazines of a thread go through the depot
+  std::vector<void*> blocks;
+  for (std::size_t i = 0; i < 1000; ++i)
+  {
+    blocks.push_back(pool.do_allocate(64));
+  }
+  ASSERT_EQUAL(std::set<void*>(blocks.begin(), blocks.end()).size(), blocks.size());
+
+  for (std::size_t i = 0; i < blocks.size(); ++i)
+  {
+    pool.do_deallocate(blocks[i], 64);
+  }
+
+  std::vector<void*> reused;
+  for (std::size_t i = 0; i < blocks.size(); ++i)
+  {
+    reused.push_back(pool.do_allocate(64));
+  }
+  ASSERT_EQUAL(std::set<void*>(reused.begin(), reused.end()) == std::set<void*>(blocks.begin(), blocks.end()), true);
+
+  for (std::size_t i = 0; i < reused.size(); ++i)
+  {
+    pool.do_deallocate(reused[i], 64);
+  }
+
+  pool.release();
+
+  void* d = pool.do_allocate(64);
+  pool.do_deallocate(d, 64);
+}
+DECLARE_UNITTEST(TestConcurrentPoolReuse);
+
+void TestConcurrentPoolCrossThread()
+{
+  using Pool = thrust::mr::concurrent_pool_resource<thrust::mr::new_delete_resource>;
+
+  thrust::mr::new_delete_resource upstream;
+  Pool pool(&upstream);
+
+  const std::size_t num_threads = 4;
+  const std::size_t num_blocks  = 2000;
+
+  // every thread allocates blocks, which the next thread deallocates
+  std::vector<std::vector<void*>> blocks(num_threads);
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < num_threads; ++t)
+  {
+    threads.emplace_back([&, t] {
+      for (std::size_t i = 0; i < num_blocks; ++i)
+      {
+        std::size_t size = 8 << (i % 6);
+        void* ptr        = pool.do_allocate(size);
+        *static_cast<std::size_t*>(ptr) = t;
+        blocks[t].push_back(ptr);
+      }
+    });
+  }
+  for (std::size_t t = 0; t < num_threads; ++t)
+  {
+    threads[t].join();
+  }
+  threads.clear();
+
+  std::set<void*> unique;
+  for (std::size_t t = 0; t < num_threads; ++t)
+  {
+    for (std::size_t i = 0; i < num_blocks; ++i)
+    {
+      ASSERT_EQUAL(*static_cast<std::size_t*>(blocks[t][i]), t);
+      unique.insert(blocks[t][i]);
+    }
+  }
+  ASSERT_EQUAL(unique.size(), num_threads * num_blocks);
+
+  for (std::size_t t = 0; t < num_threads; ++t)
+  {
+    threads.emplace_back([&, t] {
+      std::vector<void*>& mine = blocks[(t + 1) % num_threads];
+      for (std::size_t i = 0; i < num_blocks; ++i)
+      {
+        pool.do_deallocate(mine[i], 8 << (i % 6));
+      }
+    });
+  }
+  for (std::size_t t = 0; t < num_threads; ++t)
+  {
+    threads[t].join();
+  }
+
+  // the blocks freed by threads that have exited are available to this one
+  std::set<void*> reused;
+  for (std::size_t i = 0; i < num_threads * num_blocks / 6; ++i)
+  {
+    reused.insert(pool.do_allocate(8));
+  }
+  for (void* ptr : reused)
+  {
+    ASSERT_EQUAL(unique.count(ptr), 1u);
+  }
+  for (void* ptr : reused)
+  {
+    pool.do_deallocate(ptr, 8);
+  }
+}
+DECLARE_UNITTEST(TestConcurrentPoolCrossThread);
+
+void TestConcurrentPoolOversized()
+{
+  using Pool = thrust::mr::concurrent_pool_resource<thrust::mr::new_delete_resource>;
+
+  thrust::mr::pool_options options = Pool::get_default_options();
+  options.largest_block_size       = 1024;
+
+  thrust::mr::new_delete_resource upstream;
+  Pool pool(&upstream, options);
+
+  void* a = pool.do_allocate(4096);
+  void* b = pool.do_allocate(64, 1024);
+  ASSERT_EQUAL(reinterpret_cast<std::size_t>(b) % 1024, 0u);
+
+  pool.do_deallocate(a, 4096);
+  pool.do_deallocate(b, 64, 1024);
+}
+DECLARE_UNITTEST(TestConcurrentPoolOversized);
+
+void TestConcurrentGlobalPool()
+{
+  using Pool = thrust::mr::concurrent_pool_resource<thrust::mr::new_delete_resource>;
+
+  ASSERT_EQUAL(thrust::mr::get_global_resource<Pool>() != nullptr, true);
+}
+DECLARE_UNITTEST(TestConcurrentGlobalPool);
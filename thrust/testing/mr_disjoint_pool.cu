@@ -4,6 +4,8 @@
 #include <thrust/mr/disjoint_sync_pool.h>
 #include <thrust/mr/new.h>
 
+#include <sstream>
+
 #include <unittest/unittest.h>
 
 struct alloc_id
@@ -263,6 +265,53 @@ void TestDisjointSynchronizedPoolCachingOversized()
 }
 DECLARE_UNITTEST(TestDisjointSynchronizedPoolCachingOversized);
 
+template <template <typename, typename> class PoolTemplate>
+void TestDisjointPoolCachedOversizedLimit()
+{
+  dummy_resource upstream;
+  thrust::mr::new_delete_resource bookkeeper;
+
+  using Pool = PoolTemplate<dummy_resource, thrust::mr::new_delete_resource>;
+
+  thrust::mr::pool_options opts   = Pool::get_default_options();
+  opts.cache_oversized            = true;
+  opts.largest_block_size         = 1024;
+  opts.max_cached_oversized_bytes = 4096;
+
+  Pool pool(&upstream, &bookkeeper, opts);
+
+  upstream.id_to_allocate = 1;
+  alloc_id a1             = pool.do_allocate(2048, 32);
+  upstream.id_to_allocate = 2;
+  alloc_id a2             = pool.do_allocate(2048, 32);
+  upstream.id_to_allocate = 3;
+  alloc_id a3             = pool.do_allocate(2048, 32);
+
+  pool.do_deallocate(a1, 2048, 32);
+  pool.do_deallocate(a2, 2048, 32);
+
+  // make sure that a block which doesn't fit in the cache is returned to upstream
+  upstream.id_to_deallocate = 3;
+  pool.do_deallocate(a3, 2048, 32);
+  ASSERT_EQUAL(upstream.id_to_deallocate, 0u);
+
+  // while the cached ones are still used
+  alloc_id a4 = pool.do_allocate(2048, 32);
+  ASSERT_EQUAL(a4.id == 1u || a4.id == 2u, true);
+}
+
+void TestDisjointUnsynchronizedPoolCachedOversizedLimit()
+{
+  TestDisjointPoolCachedOversizedLimit<thrust::mr::disjoint_unsynchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestDisjointUnsynchronizedPoolCachedOversizedLimit);
+
+void TestDisjointSynchronizedPoolCachedOversizedLimit()
+{
+  TestDisjointPoolCachedOversizedLimit<thrust::mr::disjoint_synchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestDisjointSynchronizedPoolCachedOversizedLimit);
+
 template <template <typename, typename> class PoolTemplate>
 void TestDisjointGlobalPool()
 {
@@ -282,3 +331,74 @@ void TestSynchronizedDisjointGlobalPool()
   TestDisjointGlobalPool<thrust::mr::disjoint_synchronized_pool_resource>();
 }
 DECLARE_UNITTEST(TestSynchronizedDisjointGlobalPool);
+
+void TestDisjointPoolStatistics()
+{
+  using Pool = thrust::mr::disjoint_unsynchronized_pool_resource<thrust::mr::new_delete_resource,
+                                                                 thrust::mr::new_delete_resource,
+                                                                 thrust::mr::pool_statistics>;
+
+  thrust::mr::pool_options options = Pool::get_default_options();
+  options.smallest_block_size      = 16;
+  options.largest_block_size       = 1024;
+
+  thrust::mr::new_delete_resource upstream;
+  thrust::mr::new_delete_resource bookkeeper;
+  Pool pool(&upstream, &bookkeeper, options);
+
+  thrust::mr::pool_statistics_snapshot stats = pool.statistics();
+  ASSERT_EQUAL(stats.size_classes.size(), 7u);
+  ASSERT_EQUAL(stats.size_classes[2].block_size, 64u);
+
+  // the buckets are allocated from the bookkeeper on construction, and not counted as upstream traffic
+  const std::size_t bookkeeping_allocations = stats.bookkeeping_allocations;
+  ASSERT_EQUAL(bookkeeping_allocations > 0, true);
+  ASSERT_EQUAL(stats.bookkeeping_bytes > 0, true);
+  ASSERT_EQUAL(stats.upstream_allocations, 0u);
+
+  void* a = pool.do_allocate(64);
+  void* b = pool.do_allocate(64);
+  void* c = pool.do_allocate(2048);
+
+  stats = pool.statistics();
+  ASSERT_EQUAL(stats.size_classes[2].misses, 1u);
+  ASSERT_EQUAL(stats.size_classes[2].hits, 1u);
+  ASSERT_EQUAL(stats.oversized_misses, 1u);
+  ASSERT_EQUAL(stats.upstream_allocations, 2u);
+  ASSERT_EQUAL(stats.bytes_in_use, 64u + 64u + 2048u);
+  ASSERT_EQUAL(stats.upstream_bytes_allocated, 1024u + 2048u);
+  ASSERT_EQUAL(stats.bytes_cached, 1024u - 128u);
+
+  // the descriptors of the chunk and of the oversized block grow the bookkeeping
+  ASSERT_EQUAL(stats.bookkeeping_allocations > bookkeeping_allocations, true);
+  ASSERT_EQUAL(stats.bookkeeping_bytes_high_water >= stats.bookkeeping_bytes, true);
+
+  pool.do_deallocate(c, 2048);
+  pool.do_deallocate(b, 64);
+
+  // a cached block counts with its whole size when reused for a smaller request
+  void* d = pool.do_allocate(2000);
+
+  stats = pool.statistics();
+  ASSERT_EQUAL(stats.oversized_hits, 1u);
+  ASSERT_EQUAL(stats.bytes_in_use, 64u + 2048u);
+
+  pool.do_deallocate(d, 2000);
+  pool.do_deallocate(a, 64);
+  pool.release();
+
+  stats = pool.statistics();
+  ASSERT_EQUAL(stats.upstream_deallocations, 2u);
+  ASSERT_EQUAL(stats.upstream_bytes_deallocated, 1024u + 2048u);
+  ASSERT_EQUAL(stats.bytes_held_high_water, 1024u + 2048u);
+  ASSERT_EQUAL(stats.bytes_in_use_high_water, 64u + 64u + 2048u);
+  ASSERT_EQUAL(stats.bytes_in_use, 0u);
+
+  std::ostringstream json;
+  stats.print_json(json);
+  ASSERT_EQUAL(json.str().find("\"upstream\":{\"allocations\":2,\"deallocations\":2,\"bytes_allocated\":3072,"
+                               "\"bytes_deallocated\":3072}")
+                 != std::string::npos,
+               true);
+}
+DECLARE_UNITTEST(TestDisjointPoolStatistics);
@@ -0,0 +1,124 @@
+#include <thrust/mr/mmap.h>
+#include <thrust/mr/pool.h>
+
+#include <cstdint>
+#include <cstring>
+
+#include <unittest/unittest.h>
+
+#if !_CCCL_OS(WINDOWS)
+
+void TestMmapResourceAllocation()
+{
+  thrust::mr::mmap_memory_resource resource;
+  const std::size_t page = thrust::mr::mmap_memory_resource::page_size();
+
+  const std::size_t sizes[]      = {1, 100, 4096, 12345, 1 << 20};
+  const std::size_t alignments[] = {16, 256, 4096, 1 << 16};
+  for (std::size_t bytes : sizes)
+  {
+    for (std::size_t alignment : alignments)
+    {
+      char* p = static_cast<char*>(resource.allocate(bytes, alignment));
+
+      ASSERT_EQUAL(reinterpret_cast<std::uintptr_t>(p) % alignment, 0u);
+      ASSERT_EQUAL(resource.mapped_bytes(), (bytes + page - 1) / page * page);
+      ASSERT_EQUAL(p[0], 0);
+      ASSERT_EQUAL(p[bytes - 1], 0);
+
+      std::memset(p, 1, bytes);
+      resource.deallocate(p, bytes, alignment);
+
+      ASSERT_EQUAL(resource.mapped_bytes(), 0u);
+    }
+  }
+}
+DECLARE_UNITTEST(TestMmapResourceAllocation);
+
+void TestMmapResourceFootprint()
+{
+  thrust::mr::mmap_memory_resource resource;
+  const std::size_t page  = thrust::mr::mmap_memory_resource::page_size();
+  const std::size_t bytes = 64 * page;
+
+  char* p = static_cast<char*>(resource.allocate(bytes));
+
+  // the pages are only resident once they are touched
+  ASSERT_EQUAL(resource.resident_bytes(), 0u);
+  std::memset(p, 1, bytes);
+  ASSERT_EQUAL(resource.resident_bytes(), bytes);
+
+  // purging returns the pages within the range, which read as zeros afterwards
+  resource.purge(p + page / 2, 32 * page);
+  ASSERT_EQUAL(resource.resident_bytes(), bytes - 31 * page);
+  ASSERT_EQUAL(p[0], 1);
+  ASSERT_EQUAL(p[page], 0);
+  ASSERT_EQUAL(p[32 * page - 1], 0);
+  ASSERT_EQUAL(p[32 * page], 1);
+  ASSERT_EQUAL(resource.mapped_bytes(), bytes);
+
+  resource.deallocate(p, bytes);
+  ASSERT_EQUAL(resource.resident_bytes(), 0u);
+}
+DECLARE_UNITTEST(TestMmapResourceFootprint);
+
+void TestMmapResourceHugePages()
+{
+  const thrust::mr::huge_page_mode modes[] = {
+    thrust::mr::huge_page_mode::none, thrust::mr::huge_page_mode::transparent, thrust::mr::huge_page_mode::explicit_};
+  for (thrust::mr::huge_page_mode mode : modes)
+  {
+    thrust::mr::mmap_memory_resource resource(mode);
+    const std::size_t huge_page = thrust::mr::mmap_memory_resource::huge_page_size;
+    const std::size_t bytes     = 3 * huge_page + 1;
+
+    char* p = static_cast<char*>(resource.allocate(bytes));
+    std::memset(p, 1, bytes);
+
+    if (mode == thrust::mr::huge_page_mode::none)
+    {
+      ASSERT_EQUAL(resource.uses_huge_pages(bytes), false);
+    }
+    else
+    {
+      // the allocation is rounded up to whole huge pages, and aligned for them
+      ASSERT_EQUAL(resource.uses_huge_pages(bytes), true);
+      ASSERT_EQUAL(resource.mapped_bytes(), 4 * huge_page);
+      ASSERT_EQUAL(reinterpret_cast<std::uintptr_t>(p) % huge_page, 0u);
+    }
+
+    resource.deallocate(p, bytes);
+    ASSERT_EQUAL(resource.mapped_bytes(), 0u);
+  }
+}
+DECLARE_UNITTEST(TestMmapResourceHugePages);
+
+void TestMmapResourceAsPoolUpstream()
+{
+  thrust::mr::mmap_memory_resource upstream(thrust::mr::huge_page_mode::transparent);
+
+  thrust::mr::pool_options options = thrust::mr::unsynchronized_pool_resource<
+    thrust::mr::mmap_memory_resource>::get_default_options();
+  options.min_bytes_per_chunk = thrust::mr::mmap_memory_resource::huge_page_size;
+
+  {
+    thrust::mr::unsynchronized_pool_resource<thrust::mr::mmap_memory_resource> pool(&upstream, options);
+
+    void* small = pool.allocate(256);
+    void* large = pool.allocate(1 << 24);
+
+    ASSERT_GEQUAL(upstream.mapped_bytes(), (std::size_t(1) << 24) + options.min_bytes_per_chunk);
+
+    pool.deallocate(small, 256);
+    pool.deallocate(large, 1 << 24);
+
+    // releasing the pool unmaps its chunks, and destroying it unmaps its bookkeeping
+    pool.release();
+    ASSERT_LESS(upstream.mapped_bytes(), options.min_bytes_per_chunk);
+  }
+
+  ASSERT_EQUAL(upstream.mapped_bytes(), 0u);
+}
+DECLARE_UNITTEST(TestMmapResourceAsPoolUpstream);
+
+#endif // !_CCCL_OS(WINDOWS)
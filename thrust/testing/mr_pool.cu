@@ -4,6 +4,8 @@
 #include <thrust/mr/pool.h>
 #include <thrust/mr/sync_pool.h>
 
+#include <sstream>
+
 #include <unittest/unittest.h>
 
 template <typename T>
@@ -353,6 +355,96 @@ void TestSynchronizedPoolCachingOversized()
 }
 DECLARE_UNITTEST(TestSynchronizedPoolCachingOversized);
 
+template <template <typename> class PoolTemplate>
+void TestPoolCachedOversizedLimit()
+{
+  tracked_resource upstream;
+
+  upstream.id_to_allocate = -1u;
+
+  using Pool = PoolTemplate<tracked_resource>;
+
+  thrust::mr::pool_options opts   = Pool::get_default_options();
+  opts.cache_oversized            = true;
+  opts.largest_block_size         = 1024;
+  opts.max_cached_oversized_bytes = 4096;
+
+  Pool pool(&upstream, opts);
+
+  upstream.id_to_allocate  = 1;
+  tracked_pointer<void> a1 = pool.do_allocate(2048, THRUST_MR_DEFAULT_ALIGNMENT);
+  upstream.id_to_allocate  = 2;
+  tracked_pointer<void> a2 = pool.do_allocate(2048, THRUST_MR_DEFAULT_ALIGNMENT);
+  upstream.id_to_allocate  = 3;
+  tracked_pointer<void> a3 = pool.do_allocate(2048, THRUST_MR_DEFAULT_ALIGNMENT);
+
+  pool.do_deallocate(a1, 2048, THRUST_MR_DEFAULT_ALIGNMENT);
+  pool.do_deallocate(a2, 2048, THRUST_MR_DEFAULT_ALIGNMENT);
+
+  // make sure that a block which doesn't fit in the cache is returned to upstream
+  upstream.id_to_deallocate = 3;
+  pool.do_deallocate(a3, 2048, THRUST_MR_DEFAULT_ALIGNMENT);
+  ASSERT_EQUAL(upstream.id_to_deallocate, 0u);
+
+  // while the cached ones are still used
+  tracked_pointer<void> a4 = pool.do_allocate(2048, THRUST_MR_DEFAULT_ALIGNMENT);
+  ASSERT_EQUAL(a4.id == 1u || a4.id == 2u, true);
+
+  pool.do_deallocate(a4, 2048, THRUST_MR_DEFAULT_ALIGNMENT);
+
+  pool.release();
+
+  // make sure that the smallest fitting cached block is used
+  opts.max_cached_oversized_bytes = 0;
+
+  upstream.id_to_allocate = -1u;
+
+  Pool unlimited_pool(&upstream, opts);
+
+  upstream.id_to_allocate  = 4;
+  tracked_pointer<void> a5 = unlimited_pool.do_allocate(8192, THRUST_MR_DEFAULT_ALIGNMENT);
+  upstream.id_to_allocate  = 5;
+  tracked_pointer<void> a6 = unlimited_pool.do_allocate(2560, THRUST_MR_DEFAULT_ALIGNMENT);
+  upstream.id_to_allocate  = 6;
+  tracked_pointer<void> a7 = unlimited_pool.do_allocate(2048, THRUST_MR_DEFAULT_ALIGNMENT);
+  upstream.id_to_allocate  = 7;
+  tracked_pointer<void> a8 = unlimited_pool.do_allocate(3072, THRUST_MR_DEFAULT_ALIGNMENT);
+
+  unlimited_pool.do_deallocate(a5, 8192, THRUST_MR_DEFAULT_ALIGNMENT);
+  unlimited_pool.do_deallocate(a8, 3072, THRUST_MR_DEFAULT_ALIGNMENT);
+  unlimited_pool.do_deallocate(a7, 2048, THRUST_MR_DEFAULT_ALIGNMENT);
+  unlimited_pool.do_deallocate(a6, 2560, THRUST_MR_DEFAULT_ALIGNMENT);
+
+  tracked_pointer<void> a9 = unlimited_pool.do_allocate(2500, THRUST_MR_DEFAULT_ALIGNMENT);
+  ASSERT_EQUAL(a9.id, 5u);
+
+  tracked_pointer<void> a10 = unlimited_pool.do_allocate(2500, THRUST_MR_DEFAULT_ALIGNMENT);
+  ASSERT_EQUAL(a10.id, 7u);
+
+  tracked_pointer<void> a11 = unlimited_pool.do_allocate(2500, THRUST_MR_DEFAULT_ALIGNMENT);
+  ASSERT_EQUAL(a11.id, 4u);
+
+  tracked_pointer<void> a12 = unlimited_pool.do_allocate(1500, THRUST_MR_DEFAULT_ALIGNMENT);
+  ASSERT_EQUAL(a12.id, 6u);
+
+  unlimited_pool.do_deallocate(a9, 2500, THRUST_MR_DEFAULT_ALIGNMENT);
+  unlimited_pool.do_deallocate(a10, 2500, THRUST_MR_DEFAULT_ALIGNMENT);
+  unlimited_pool.do_deallocate(a11, 2500, THRUST_MR_DEFAULT_ALIGNMENT);
+  unlimited_pool.do_deallocate(a12, 1500, THRUST_MR_DEFAULT_ALIGNMENT);
+}
+
+void TestUnsynchronizedPoolCachedOversizedLimit()
+{
+  TestPoolCachedOversizedLimit<thrust::mr::unsynchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestUnsynchronizedPoolCachedOversizedLimit);
+
+void TestSynchronizedPoolCachedOversizedLimit()
+{
+  TestPoolCachedOversizedLimit<thrust::mr::synchronized_pool_resource>();
+}
+DECLARE_UNITTEST(TestSynchronizedPoolCachedOversizedLimit);
+
 template <template <typename> class PoolTemplate>
 void TestGlobalPool()
 {
@@ -372,3 +464,69 @@ void TestSynchronizedGlobalPool()
   TestGlobalPool<thrust::mr::synchronized_pool_resource>();
 }
 DECLARE_UNITTEST(TestSynchronizedGlobalPool);
+
+void TestPoolStatistics()
+{
+  using Pool = thrust::mr::unsynchronized_pool_resource<thrust::mr::new_delete_resource, thrust::mr::pool_statistics>;
+
+  thrust::mr::pool_options options = Pool::get_default_options();
+  options.smallest_block_size      = 16;
+  options.largest_block_size       = 1024;
+
+  thrust::mr::new_delete_resource upstream;
+  Pool pool(&upstream, options);
+
+  thrust::mr::pool_statistics_snapshot stats = pool.statistics();
+  ASSERT_EQUAL(stats.size_classes.size(), 7u);
+  ASSERT_EQUAL(stats.size_classes[0].block_size, 16u);
+  ASSERT_EQUAL(stats.size_classes[6].block_size, 1024u);
+  ASSERT_EQUAL(stats.upstream_allocations, 0u);
+
+  // the list heads of the size classes are allocated on construction, and not counted as upstream traffic
+  const std::size_t bookkeeping_bytes = stats.bookkeeping_bytes;
+  ASSERT_EQUAL(stats.bookkeeping_allocations > 0, true);
+  ASSERT_EQUAL(bookkeeping_bytes > 0, true);
+  ASSERT_EQUAL(stats.bookkeeping_bytes_high_water, bookkeeping_bytes);
+
+  void* a = pool.do_allocate(20);
+  void* b = pool.do_allocate(32);
+  void* c = pool.do_allocate(2048);
+
+  stats = pool.statistics();
+  ASSERT_EQUAL(stats.size_classes[1].misses, 1u);
+  ASSERT_EQUAL(stats.size_classes[1].hits, 1u);
+  ASSERT_EQUAL(stats.oversized_misses, 1u);
+  ASSERT_EQUAL(stats.upstream_allocations, 2u);
+  ASSERT_EQUAL(stats.bytes_in_use, 32u + 32u + 2048u);
+  ASSERT_EQUAL(stats.bytes_cached + stats.bytes_in_use, stats.upstream_bytes_allocated);
+
+  pool.do_deallocate(c, 2048);
+  pool.do_deallocate(b, 32);
+
+  void* d = pool.do_allocate(2000);
+
+  stats = pool.statistics();
+  ASSERT_EQUAL(stats.oversized_hits, 1u);
+  ASSERT_EQUAL(stats.upstream_allocations, 2u);
+  ASSERT_EQUAL(stats.bytes_in_use, 32u + 2000u);
+  ASSERT_EQUAL(stats.bytes_in_use_high_water, 32u + 32u + 2048u);
+
+  pool.do_deallocate(d, 2000);
+  pool.do_deallocate(a, 20);
+  pool.release();
+
+  stats = pool.statistics();
+  ASSERT_EQUAL(stats.upstream_deallocations, 2u);
+  ASSERT_EQUAL(stats.upstream_bytes_deallocated, stats.upstream_bytes_allocated);
+  ASSERT_EQUAL(stats.bytes_held_high_water, stats.upstream_bytes_allocated);
+  ASSERT_EQUAL(stats.bytes_in_use, 0u);
+  ASSERT_EQUAL(stats.bytes_cached, 0u);
+  ASSERT_EQUAL(stats.bookkeeping_bytes, bookkeeping_bytes);
+
+  std::ostringstream json;
+  stats.print_json(json);
+  ASSERT_EQUAL(json.str().find("{\"size_classes\":[{\"block_size\":16,\"hits\":0,\"misses\":0},"), 0u);
+  ASSERT_EQUAL(json.str().find("\"bookkeeping\":{\"allocations\":") != std::string::npos, true);
+  ASSERT_EQUAL(json.str().find("\"oversized\":{\"hits\":1,\"misses\":1}") != std::string::npos, true);
+}
+DECLARE_UNITTEST(TestPoolStatistics);
@@ -0,0 +1,51 @@
+#include <thrust/find.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/logical.h>
+#include <thrust/system/omp/execution_policy.h>
+
+#include <atomic>
+#include <cstddef>
+
+#include <unittest/unittest.h>
+
+// counts how many elements the search looks at
+struct counting_equal_to
+{
+  std::ptrdiff_t value;
+  std::atomic<std::ptrdiff_t>* calls;
+
+  bool operator()(std::ptrdiff_t x) const
+  {
+    calls->fetch_add(1, std::memory_order_relaxed);
+    return x == value;
+  }
+};
+
+void TestOmpFindIfExitsEarly()
+{
+  const std::ptrdiff_t n = std::ptrdiff_t(1) << 24;
+  thrust::counting_iterator<std::ptrdiff_t> first(0);
+
+  // a match near the front stops the search long before the end of the range
+  std::atomic<std::ptrdiff_t> calls(0);
+  auto result = thrust::find_if(thrust::omp::par, first, first + n, counting_equal_to{1000, &calls});
+  ASSERT_EQUAL(result - first, 1000);
+  ASSERT_EQUAL(calls.load() < n / 64, true);
+
+  // so does the generic any_of, implemented in terms of find_if
+  calls = 0;
+  ASSERT_EQUAL(thrust::any_of(thrust::omp::par, first, first + n, counting_equal_to{1000, &calls}), true);
+  ASSERT_EQUAL(calls.load() < n / 64, true);
+
+  // without a match every element is looked at exactly once
+  calls  = 0;
+  result = thrust::find_if(thrust::omp::par, first, first + n, counting_equal_to{-1, &calls});
+  ASSERT_EQUAL(result - first, n);
+  ASSERT_EQUAL(calls.load(), n);
+
+  // a match near the end is found too
+  calls  = 0;
+  result = thrust::find_if(thrust::omp::par, first, first + n, counting_equal_to{n - 3, &calls});
+  ASSERT_EQUAL(result - first, n - 3);
+}
+DECLARE_UNITTEST(TestOmpFindIfExitsEarly);
@@ -0,0 +1,192 @@
+#include <thrust/reduce.h>
+#include <thrust/sequence.h>
+#include <thrust/system/omp/memory.h>
+#include <thrust/system/omp/vector.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <unittest/unittest.h>
+
+#if defined(__linux__)
+#  include <omp.h>
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+
+static std::size_t base_page_size()
+{
+  return static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+}
+
+// whether every page of [p, p + bytes) is resident, i.e. was touched; must be called before anything reads the memory
+static bool all_pages_resident(const char* p, std::size_t bytes)
+{
+  const std::size_t page     = base_page_size();
+  const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(p) / page * page;
+  const std::size_t length   = reinterpret_cast<std::uintptr_t>(p) + bytes - begin;
+
+  std::vector<unsigned char> resident((length + page - 1) / page);
+  if (::mincore(reinterpret_cast<void*>(begin), length, resident.data()) != 0)
+  {
+    return false;
+  }
+
+  for (unsigned char r : resident)
+  {
+    if (!(r & 1))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// the NUMA node of the pages starting at each of the offsets, or an empty vector if the kernel cannot tell
+static std::vector<int> page_nodes(char* p, const std::vector<std::size_t>& offsets)
+{
+  std::vector<void*> pages;
+  for (std::size_t offset : offsets)
+  {
+    pages.push_back(p + offset);
+  }
+
+  std::vector<int> nodes(pages.size(), -1);
+#  if defined(SYS_move_pages)
+  // without target nodes, move_pages reports the node of every page
+  if (::syscall(SYS_move_pages, 0, pages.size(), pages.data(), nullptr, nodes.data(), 0) == 0)
+  {
+    return nodes;
+  }
+#  endif // SYS_move_pages
+  return std::vector<int>();
+}
+#endif // __linux__
+
+void TestOmpFirstTouchMemoryResource()
+{
+  thrust::system::omp::first_touch_memory_resource resource;
+
+  // the memory is zeroed on first touch, and aligned as requested
+  const std::size_t sizes[]      = {1, 100, 4096, 12345, 1 << 20};
+  const std::size_t alignments[] = {1, 64, 4096, 1 << 16};
+  for (std::size_t bytes : sizes)
+  {
+    for (std::size_t alignment : alignments)
+    {
+      thrust::omp::pointer<void> p = resource.allocate(bytes, alignment);
+      char* raw                    = static_cast<char*>(p.get());
+
+      ASSERT_EQUAL(reinterpret_cast<std::uintptr_t>(raw) % alignment, 0u);
+      ASSERT_EQUAL(raw[0], 0);
+      ASSERT_EQUAL(raw[bytes - 1], 0);
+
+      raw[0]         = 1;
+      raw[bytes - 1] = 1;
+      resource.deallocate(p, bytes, alignment);
+    }
+  }
+}
+DECLARE_UNITTEST(TestOmpFirstTouchMemoryResource);
+
+void TestOmpFirstTouchMemoryResourceHugePages()
+{
+  thrust::system::omp::first_touch_huge_page_memory_resource resource;
+
+  const std::size_t bytes      = std::size_t(5) << 20;
+  thrust::omp::pointer<void> p = resource.allocate(bytes);
+  char* raw                    = static_cast<char*>(p.get());
+
+  ASSERT_EQUAL(raw[0], 0);
+  ASSERT_EQUAL(raw[bytes - 1], 0);
+
+  resource.deallocate(p, bytes);
+}
+DECLARE_UNITTEST(TestOmpFirstTouchMemoryResourceHugePages);
+
+void TestOmpFirstTouchVector()
+{
+  thrust::omp::vector<int, thrust::omp::first_touch_allocator<int>> v(1 << 20, thrust::no_init);
+  thrust::sequence(v.begin(), v.end());
+
+  ASSERT_EQUAL(v[12345], 12345);
+  ASSERT_EQUAL(thrust::reduce(v.begin(), v.end(), std::int64_t(0)), (std::int64_t(1 << 20) * ((1 << 20) - 1)) / 2);
+}
+DECLARE_UNITTEST(TestOmpFirstTouchVector);
+
+#if defined(__linux__)
+template <typename Resource>
+void TestOmpFirstTouchTouchesEveryPage()
+{
+  Resource resource;
+
+  // also sizes of a few huge pages, which the kernel may or may not back with huge pages
+  const std::size_t sizes[] = {4096, 100000, std::size_t(5) << 20, (std::size_t(8) << 20) + 12345};
+  for (std::size_t bytes : sizes)
+  {
+    thrust::omp::pointer<void> p = resource.allocate(bytes);
+
+    ASSERT_EQUAL(all_pages_resident(static_cast<char*>(p.get()), bytes), true);
+
+    resource.deallocate(p, bytes);
+  }
+}
+
+void TestOmpFirstTouchMemoryResourceTouchesEveryPage()
+{
+  TestOmpFirstTouchTouchesEveryPage<thrust::system::omp::first_touch_memory_resource>();
+}
+DECLARE_UNITTEST(TestOmpFirstTouchMemoryResourceTouchesEveryPage);
+
+void TestOmpFirstTouchHugePageMemoryResourceTouchesEveryPage()
+{
+  TestOmpFirstTouchTouchesEveryPage<thrust::system::omp::first_touch_huge_page_memory_resource>();
+}
+DECLARE_UNITTEST(TestOmpFirstTouchHugePageMemoryResourceTouchesEveryPage);
+
+void TestOmpFirstTouchPlacement()
+{
+  thrust::system::omp::first_touch_memory_resource resource;
+
+  const std::size_t page  = base_page_size();
+  const std::size_t bytes = page * 4096;
+
+  thrust::omp::pointer<void> p = resource.allocate(bytes, page);
+  char* raw                    = static_cast<char*>(p.get());
+
+  // the first page starting in each interval of the split used by the algorithms, and the last one
+  const auto decomp = thrust::system::omp::detail::default_decomposition(static_cast<std::intptr_t>(bytes));
+
+  std::vector<std::size_t> firsts;
+  std::vector<std::size_t> lasts;
+  for (std::intptr_t i = 0; i < decomp.size(); ++i)
+  {
+    const std::size_t begin = (static_cast<std::size_t>(decomp[i].begin()) + page - 1) / page * page;
+    const std::size_t end   = static_cast<std::size_t>(decomp[i].end());
+    if (begin < end)
+    {
+      firsts.push_back(begin);
+      lasts.push_back((end - 1) / page * page);
+    }
+  }
+
+  const std::vector<int> first_nodes = page_nodes(raw, firsts);
+  const std::vector<int> last_nodes  = page_nodes(raw, lasts);
+
+  // the kernel reports the node of every page, so they were all touched; when the threads are bound to their
+  // processors, each interval lies entirely on the node of the thread which touched it
+  for (std::size_t i = 0; i < first_nodes.size(); ++i)
+  {
+    ASSERT_EQUAL(first_nodes[i] >= 0, true);
+    ASSERT_EQUAL(last_nodes[i] >= 0, true);
+
+    if (omp_get_proc_bind() != omp_proc_bind_false)
+    {
+      ASSERT_EQUAL(first_nodes[i], last_nodes[i]);
+    }
+  }
+
+  resource.deallocate(p, bytes, page);
+}
+DECLARE_UNITTEST(TestOmpFirstTouchPlacement);
+#endif // __linux__
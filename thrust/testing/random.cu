@@ -1,5 +1,7 @@
 #include <thrust/generate.h>
+#include <thrust/iterator/counting_iterator.h>
 #include <thrust/random.h>
+#include <thrust/transform.h>
 
 #include <sstream>
 
@@ -670,6 +672,334 @@ void TestRanlux48Unequal()
 }
 DECLARE_UNITTEST(TestRanlux48Unequal);
 
+void TestPhilox4x32Validation()
+{
+  using Engine = thrust::random::philox4x32;
+
+  TestEngineValidation<Engine, 1955073260u>();
+}
+DECLARE_UNITTEST(TestPhilox4x32Validation);
+
+void TestPhilox4x32Min()
+{
+  using Engine = thrust::random::philox4x32;
+
+  TestEngineMin<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x32Min);
+
+void TestPhilox4x32Max()
+{
+  using Engine = thrust::random::philox4x32;
+
+  TestEngineMax<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x32Max);
+
+void TestPhilox4x32SaveRestore()
+{
+  using Engine = thrust::random::philox4x32;
+
+  TestEngineSaveRestore<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x32SaveRestore);
+
+void TestPhilox4x32Equal()
+{
+  using Engine = thrust::random::philox4x32;
+
+  TestEngineEqual<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x32Equal);
+
+void TestPhilox4x32Unequal()
+{
+  using Engine = thrust::random::philox4x32;
+
+  TestEngineUnequal<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x32Unequal);
+
+void TestPhilox4x64Validation()
+{
+  using Engine = thrust::random::philox4x64;
+
+  TestEngineValidation<Engine, 3409172418970261260ull>();
+}
+DECLARE_UNITTEST(TestPhilox4x64Validation);
+
+void TestPhilox4x64Min()
+{
+  using Engine = thrust::random::philox4x64;
+
+  TestEngineMin<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x64Min);
+
+void TestPhilox4x64Max()
+{
+  using Engine = thrust::random::philox4x64;
+
+  TestEngineMax<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x64Max);
+
+void TestPhilox4x64SaveRestore()
+{
+  using Engine = thrust::random::philox4x64;
+
+  TestEngineSaveRestore<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x64SaveRestore);
+
+void TestPhilox4x64Equal()
+{
+  using Engine = thrust::random::philox4x64;
+
+  TestEngineEqual<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x64Equal);
+
+void TestPhilox4x64Unequal()
+{
+  using Engine = thrust::random::philox4x64;
+
+  TestEngineUnequal<Engine>();
+}
+DECLARE_UNITTEST(TestPhilox4x64Unequal);
+
+void TestThreefry4x32Validation()
+{
+  using Engine = thrust::random::threefry4x32;
+
+  TestEngineValidation<Engine, 112810865u>();
+}
+DECLARE_UNITTEST(TestThreefry4x32Validation);
+
+void TestThreefry4x32Min()
+{
+  using Engine = thrust::random::threefry4x32;
+
+  TestEngineMin<Engine>();
+}
+DECLARE_UNITTEST(TestThreefry4x32Min);
+
+void TestThreefry4x32Max()
+{
+  using Engine = thrust::random::threefry4x32;
+
+  TestEngineMax<Engine>();
+}
+DECLARE_UNITTEST(TestThreefry4x32Max);
+
+void TestThreefry4x32SaveRestore()
+{
+  using Engine = thrust::random::threefry4x32;
+
+  TestEngineSaveRestore<Engine>();
+}
+DECLARE_UNITTEST(TestThreefry4x32SaveRestore);
+
+void TestThreefry4x32Equal()
+{
+  using Engine = thrust::random::threefry4x32;
+
+  TestEngineEqual<Engine>();
+}
+DECLARE_UNITTEST(TestThreefry4x32Equal);
+
+void TestThreefry4x32Unequal()
+{
+  using Engine = thrust::random::threefry4x32;
+
+  TestEngineUnequal<Engine>();
+}
+DECLARE_UNITTEST(TestThreefry4x32Unequal);
+
+void TestThreefry4x64Validation()
+{
+  using Engine = thrust::random::threefry4x64;
+
+  TestEngineValidation<Engine, 9253438642465275567ull>();
+}
+DECLARE_UNITTEST(TestThreefry4x64Validation);
+
+void TestThreefry4x64Min()
+{
+  using Engine = thrust::random::threefry4x64;
+
+  TestEngineMin<Engine>();
+}
+DECLARE_UNITTEST(TestThreefry4x64Min);
+
+void TestThreefry4x64Max()
+{
+  using Engine = thrust::random::threefry4x64;
+
+  TestEngineMax<Engine>();
+}
+DECLARE_UNITTEST(TestThreefry4x64Max);
+
+void TestThreefry4x64SaveRestore()
+{
+  using Engine = thrust::random::threefry4x64;
+
+  TestEngineSaveRestore<Engine>();
+}
+DECLARE_UNITTEST(TestThreefry4x64SaveRestore);
+
+void TestThreefry4x64Equal()
+{
+  using Engine = thrust::random::threefry4x64;
+
+  TestEngineEqual<Engine>();
+}
+DECLARE_UNITTEST(TestThreefry4x64Equal);
+
+void TestThreefry4x64Unequal()
+{
+  using Engine = thrust::random::threefry4x64;
+
+  TestEngineUnequal<Engine>();
+}
+DECLARE_UNITTEST(TestThreefry4x64Unequal);
+
+template <typename Engine>
+struct ValidateCounterBasedEngineDiscard
+{
+  _CCCL_HOST_DEVICE bool operator()(void) const
+  {
+    bool result = true;
+
+    // discarding matches generating, from any position within a block
+    const unsigned long long distances[] = {0, 1, 3, 4, 5, 7, 8, 100, 1001};
+    for (unsigned long long offset = 0; offset < 4; ++offset)
+    {
+      for (unsigned long long z : distances)
+      {
+        Engine e0(13), e1(13);
+        e0.discard(offset);
+        e1.discard(offset);
+
+        e0.discard(z);
+        for (unsigned long long i = 0; i < z; ++i)
+        {
+          e1();
+        }
+        result &= (e0 == e1) && (e0() == e1());
+      }
+    }
+
+    // the counter carries into its next word, and far jumps land on the right block
+    Engine e2, e3;
+    e2.set_counter({0, 0, 0, typename Engine::result_type(Engine::max)});
+    e2.discard(4);
+    e3.set_counter({0, 0, 1, 0});
+    result &= (e2() == e3());
+
+    Engine e4, e5;
+    e4.discard(Engine::word_count << 34);
+    if (Engine::word_size == 32)
+    {
+      e5.set_counter({0, 0, 4, 0});
+    }
+    else
+    {
+      e5.set_counter({0, 0, 0, typename Engine::result_type(1ull << 34)});
+    }
+    result &= (e4() == e5());
+
+    // a block holds the values produced after moving to its counter
+    Engine e6(13);
+    e6.set_counter({0, 0, 0, 7});
+    typename Engine::key_type key{};
+    key[0]                                 = 13;
+    const typename Engine::block_type block = Engine::generate_block({7}, key);
+    for (size_t i = 0; i < Engine::word_count; ++i)
+    {
+      result &= (e6() == block[i]);
+    }
+
+    // distinct keys are distinct streams
+    Engine e7, e8;
+    key[0] = Engine::default_seed;
+    key[1] = 1;
+    e8.set_key(key);
+    result &= (e7 != e8) && (e7() != e8());
+
+    return result;
+  }
+};
+
+template <typename Engine>
+struct CounterBasedEngineElement
+{
+  _CCCL_HOST_DEVICE typename Engine::result_type operator()(unsigned long long i) const
+  {
+    Engine e;
+    e.discard(i);
+    return e();
+  }
+};
+
+template <typename Engine>
+void TestCounterBasedEngineDiscard()
+{
+  // test host
+  thrust::host_vector<bool> h(1);
+  thrust::generate(h.begin(), h.end(), ValidateCounterBasedEngineDiscard<Engine>());
+
+  ASSERT_EQUAL(true, h[0]);
+
+  // test device
+  thrust::device_vector<bool> d(1);
+  thrust::generate(d.begin(), d.end(), ValidateCounterBasedEngineDiscard<Engine>());
+
+  ASSERT_EQUAL(true, d[0]);
+
+  // each element jumps to its own position of the stream, so the values do not depend on how the elements are
+  // distributed among threads
+  const size_t n = 10000;
+  thrust::host_vector<typename Engine::result_type> h_values(n);
+  Engine e;
+  for (size_t i = 0; i < n; ++i)
+  {
+    h_values[i] = e();
+  }
+
+  thrust::device_vector<typename Engine::result_type> d_values(n);
+  thrust::transform(thrust::counting_iterator<unsigned long long>(0),
+                    thrust::counting_iterator<unsigned long long>(n),
+                    d_values.begin(),
+                    CounterBasedEngineElement<Engine>());
+
+  ASSERT_EQUAL(h_values, d_values);
+}
+
+void TestPhilox4x32Discard()
+{
+  TestCounterBasedEngineDiscard<thrust::random::philox4x32>();
+}
+DECLARE_UNITTEST(TestPhilox4x32Discard);
+
+void TestPhilox4x64Discard()
+{
+  TestCounterBasedEngineDiscard<thrust::random::philox4x64>();
+}
+DECLARE_UNITTEST(TestPhilox4x64Discard);
+
+void TestThreefry4x32Discard()
+{
+  TestCounterBasedEngineDiscard<thrust::random::threefry4x32>();
+}
+DECLARE_UNITTEST(TestThreefry4x32Discard);
+
+void TestThreefry4x64Discard()
+{
+  TestCounterBasedEngineDiscard<thrust::random::threefry4x64>();
+}
+DECLARE_UNITTEST(TestThreefry4x64Discard);
+
 _CCCL_DIAG_PUSH
 _CCCL_DIAG_SUPPRESS_MSVC(4305) // truncation warning
 template <typename Distribution, typename Validator>
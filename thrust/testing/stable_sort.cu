@@ -1,7 +1,14 @@
+#include <thrust/execution_policy.h>
 #include <thrust/functional.h>
 #include <thrust/iterator/retag.h>
 #include <thrust/sort.h>
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
 #include <unittest/unittest.h>
 
 template <typename RandomAccessIterator>
@@ -135,3 +142,52 @@ void TestStableSortWithIndirection()
   ASSERT_EQUAL(data, ref);
 }
 DECLARE_INTEGRAL_VECTOR_UNITTEST(TestStableSortWithIndirection);
+
+template <typename T>
+struct TestStableSortPrimitiveKeys
+{
+  void operator()()
+  {
+    // below and above the size from which the parallel host backends sort primitive keys with a radix sort
+    const size_t sizes[] = {1000, 200000};
+
+    for (const size_t n : sizes)
+    {
+      // convert from int, so that signed and floating point keys are negative as well as positive
+      thrust::host_vector<int> h_ints = unittest::random_integers<int>(n);
+      std::vector<T> h_keys(h_ints.begin(), h_ints.end());
+
+      thrust::device_vector<T> d_keys(h_keys.begin(), h_keys.end());
+
+      thrust::host_vector<T> h_ascending(h_keys.begin(), h_keys.end());
+      std::stable_sort(h_ascending.begin(), h_ascending.end(), std::less<T>());
+      thrust::stable_sort(d_keys.begin(), d_keys.end(), thrust::less<T>());
+      ASSERT_EQUAL(h_ascending, d_keys);
+
+      thrust::host_vector<T> h_descending(h_keys.begin(), h_keys.end());
+      std::stable_sort(h_descending.begin(), h_descending.end(), std::greater<T>());
+      thrust::stable_sort(d_keys.begin(), d_keys.end(), thrust::greater<T>());
+      ASSERT_EQUAL(h_descending, d_keys);
+    }
+  }
+};
+SimpleUnitTest<TestStableSortPrimitiveKeys,
+               unittest::type_list<signed char, unsigned short, int, unsigned int, long long, float, double>>
+  TestStableSortPrimitiveKeysInstance;
+
+void TestStableSortSequentialNegativeIntKeys()
+{
+  // the sequential backend sorts primitive keys with a radix sort, whose encoding must order negative keys first
+  thrust::host_vector<int> h_keys = unittest::random_integers<int>(10000);
+  h_keys[0]                       = -1;
+  h_keys[1]                       = std::numeric_limits<int>::min();
+  h_keys[2]                       = std::numeric_limits<int>::max();
+  h_keys[3]                       = 0;
+
+  thrust::host_vector<int> h_ref = h_keys;
+  std::stable_sort(h_ref.begin(), h_ref.end());
+
+  thrust::stable_sort(thrust::seq, h_keys.begin(), h_keys.end());
+  ASSERT_EQUAL(h_ref, h_keys);
+}
+DECLARE_UNITTEST(TestStableSortSequentialNegativeIntKeys);
@@ -2,6 +2,11 @@
 #include <thrust/iterator/retag.h>
 #include <thrust/sort.h>
 
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
 #include <unittest/unittest.h>
 
 template <typename RandomAccessIterator1, typename RandomAccessIterator2>
@@ -120,3 +125,72 @@ struct TestStableSortByKeySemantics
 VariableUnitTest<TestStableSortByKeySemantics,
                  unittest::type_list<unittest::uint8_t, unittest::uint16_t, unittest::uint32_t>>
   TestStableSortByKeySemanticsInstance;
+
+template <typename T>
+struct TestStableSortByKeyPrimitiveKeys
+{
+  void operator()()
+  {
+    // below and above the size from which the parallel host backends sort primitive keys with a radix sort
+    const size_t sizes[] = {1000, 200000};
+
+    for (const size_t n : sizes)
+    {
+      // convert from int, so that signed and floating point keys are negative as well as positive, and fold them
+      // onto few distinct keys, so that the values show whether equal keys keep their order
+      thrust::host_vector<int> h_ints = unittest::random_integers<int>(n);
+      std::vector<std::pair<T, int>> h_pairs(n);
+
+      for (size_t i = 0; i < n; ++i)
+      {
+        h_pairs[i] = {static_cast<T>(h_ints[i] % 1000), static_cast<int>(i)};
+      }
+
+      for (const bool descending : {false, true})
+      {
+        thrust::host_vector<T> h_keys(n);
+        thrust::host_vector<int> h_values(n);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+          h_keys[i]   = h_pairs[i].first;
+          h_values[i] = h_pairs[i].second;
+        }
+
+        thrust::device_vector<T> d_keys     = h_keys;
+        thrust::device_vector<int> d_values = h_values;
+
+        std::vector<std::pair<T, int>> h_sorted = h_pairs;
+
+        if (descending)
+        {
+          std::stable_sort(
+            h_sorted.begin(), h_sorted.end(), [](const std::pair<T, int>& a, const std::pair<T, int>& b) {
+              return a.first > b.first;
+            });
+          thrust::stable_sort_by_key(d_keys.begin(), d_keys.end(), d_values.begin(), thrust::greater<T>());
+        }
+        else
+        {
+          std::stable_sort(
+            h_sorted.begin(), h_sorted.end(), [](const std::pair<T, int>& a, const std::pair<T, int>& b) {
+              return a.first < b.first;
+            });
+          thrust::stable_sort_by_key(d_keys.begin(), d_keys.end(), d_values.begin(), thrust::less<T>());
+        }
+
+        for (size_t i = 0; i < n; ++i)
+        {
+          h_keys[i]   = h_sorted[i].first;
+          h_values[i] = h_sorted[i].second;
+        }
+
+        ASSERT_EQUAL(h_keys, d_keys);
+        ASSERT_EQUAL(h_values, d_values);
+      }
+    }
+  }
+};
+SimpleUnitTest<TestStableSortByKeyPrimitiveKeys,
+               unittest::type_list<short, int, unsigned int, long long, float, double>>
+  TestStableSortByKeyPrimitiveKeysInstance;
@@ -0,0 +1,88 @@
+#include <thrust/reduce.h>
+#include <thrust/sequence.h>
+#include <thrust/system/tbb/memory.h>
+#include <thrust/system/tbb/vector.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <unittest/unittest.h>
+
+#if defined(__linux__)
+#  include <sys/mman.h>
+#  include <unistd.h>
+
+// whether every page of [p, p + bytes) is resident, i.e. was touched; must be called before anything reads the memory
+static bool all_pages_resident(const char* p, std::size_t bytes)
+{
+  const std::size_t page     = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(p) / page * page;
+  const std::size_t length   = reinterpret_cast<std::uintptr_t>(p) + bytes - begin;
+
+  std::vector<unsigned char> resident((length + page - 1) / page);
+  if (::mincore(reinterpret_cast<void*>(begin), length, resident.data()) != 0)
+  {
+    return false;
+  }
+
+  for (unsigned char r : resident)
+  {
+    if (!(r & 1))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+#endif // __linux__
+
+template <typename Resource>
+void TestTbbFirstTouch()
+{
+  Resource resource;
+
+  // also sizes of a few huge pages, which the kernel may or may not back with huge pages
+  const std::size_t sizes[]      = {1, 4096, 100000, std::size_t(5) << 20, (std::size_t(8) << 20) + 12345};
+  const std::size_t alignments[] = {1, 64, 4096};
+  for (std::size_t bytes : sizes)
+  {
+    for (std::size_t alignment : alignments)
+    {
+      thrust::tbb::pointer<void> p = resource.allocate(bytes, alignment);
+      char* raw                    = static_cast<char*>(p.get());
+
+#if defined(__linux__)
+      ASSERT_EQUAL(all_pages_resident(raw, bytes), true);
+#endif // __linux__
+
+      // the memory is zeroed on first touch, and aligned as requested
+      ASSERT_EQUAL(reinterpret_cast<std::uintptr_t>(raw) % alignment, 0u);
+      ASSERT_EQUAL(raw[0], 0);
+      ASSERT_EQUAL(raw[bytes - 1], 0);
+
+      resource.deallocate(p, bytes, alignment);
+    }
+  }
+}
+
+void TestTbbFirstTouchMemoryResource()
+{
+  TestTbbFirstTouch<thrust::system::tbb::first_touch_memory_resource>();
+}
+DECLARE_UNITTEST(TestTbbFirstTouchMemoryResource);
+
+void TestTbbFirstTouchHugePageMemoryResource()
+{
+  TestTbbFirstTouch<thrust::system::tbb::first_touch_huge_page_memory_resource>();
+}
+DECLARE_UNITTEST(TestTbbFirstTouchHugePageMemoryResource);
+
+void TestTbbFirstTouchVector()
+{
+  thrust::tbb::vector<int, thrust::tbb::first_touch_allocator<int>> v(1 << 20, thrust::no_init);
+  thrust::sequence(v.begin(), v.end());
+
+  ASSERT_EQUAL(v[12345], 12345);
+  ASSERT_EQUAL(thrust::reduce(v.begin(), v.end(), std::int64_t(0)), (std::int64_t(1 << 20) * ((1 << 20) - 1)) / 2);
+}
+DECLARE_UNITTEST(TestTbbFirstTouchVector);
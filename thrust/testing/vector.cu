@@ -641,6 +641,92 @@ void TestVectorResizing()
 }
 DECLARE_VECTOR_UNITTEST(TestVectorResizing);
 
+template <class Vector>
+void TestVectorDefaultInitResizing()
+{
+  Vector v(3, thrust::default_init);
+
+  ASSERT_EQUAL(v.size(), 3lu);
+
+  v = {0, 1, 2};
+  v.resize(5, thrust::default_init);
+
+  ASSERT_EQUAL(v.size(), 5lu);
+
+  // the new elements are indeterminate, only the existing ones are preserved
+  ASSERT_EQUAL(v[0], 0);
+  ASSERT_EQUAL(v[1], 1);
+  ASSERT_EQUAL(v[2], 2);
+
+  // grow past the capacity, which has to preserve the existing elements
+  const size_t new_size = v.capacity() + 10;
+  v.resize(new_size, thrust::default_init);
+
+  ASSERT_EQUAL(v.size(), new_size);
+  ASSERT_EQUAL(v[0], 0);
+  ASSERT_EQUAL(v[1], 1);
+  ASSERT_EQUAL(v[2], 2);
+
+  v.resize(2, thrust::default_init);
+
+  Vector ref{0, 1};
+  ASSERT_EQUAL(v, ref);
+
+  Vector w(0, thrust::default_init);
+
+  ASSERT_EQUAL(w.size(), 0lu);
+}
+DECLARE_VECTOR_UNITTEST(TestVectorDefaultInitResizing);
+
+template <class Vector>
+void TestVectorNoInitResizing()
+{
+  Vector v(3, thrust::no_init);
+
+  ASSERT_EQUAL(v.size(), 3lu);
+
+  v = {0, 1, 2};
+
+  const size_t new_size = v.capacity() + 10;
+  v.resize(new_size, thrust::no_init);
+
+  ASSERT_EQUAL(v.size(), new_size);
+
+  v.resize(3, thrust::no_init);
+
+  Vector ref{0, 1, 2};
+  ASSERT_EQUAL(v, ref);
+}
+void TestVectorNoInitResizingInt()
+{
+  TestVectorNoInitResizing<thrust::host_vector<int>>();
+  TestVectorNoInitResizing<thrust::device_vector<int>>();
+}
+DECLARE_UNITTEST(TestVectorNoInitResizingInt);
+
+struct default_init_counted
+{
+  int value = 13;
+};
+
+void TestVectorDefaultInitNonTrivial()
+{
+  // elements whose default constructor does something are still constructed
+  thrust::host_vector<default_init_counted> v(3, thrust::default_init);
+
+  ASSERT_EQUAL(v.size(), 3lu);
+  ASSERT_EQUAL(v[2].value, 13);
+
+  v.resize(10, thrust::default_init);
+
+  ASSERT_EQUAL(v.size(), 10lu);
+  for (size_t i = 0; i < v.size(); ++i)
+  {
+    ASSERT_EQUAL(v[i].value, 13);
+  }
+}
+DECLARE_UNITTEST(TestVectorDefaultInitNonTrivial);
+
 template <class Vector>
 void TestVectorReserving()
 {
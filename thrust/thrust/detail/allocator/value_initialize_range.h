@@ -33,6 +33,11 @@ namespace detail
 template <typename Allocator, typename Pointer, typename Size>
 _CCCL_HOST_DEVICE inline void value_initialize_range(Allocator& a, Pointer p, Size n);
 
+// default-initializes the range, which leaves its elements uninitialized when neither the allocator nor their type
+// have anything to do on default construction
+template <typename Allocator, typename Pointer, typename Size>
+_CCCL_HOST_DEVICE inline void default_initialize_range(Allocator& a, Pointer p, Size n);
+
 } // namespace detail
 THRUST_NAMESPACE_END
 
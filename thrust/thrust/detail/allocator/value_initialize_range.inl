@@ -86,6 +86,21 @@ value_initialize_range(Allocator& a, Pointer p, Size n)
   thrust::uninitialized_fill_n(allocator_system<Allocator>::get(a), p, n, typename pointer_element<Pointer>::type());
 }
 
+template <typename Allocator, typename Pointer, typename Size>
+_CCCL_HOST_DEVICE ::cuda::std::enable_if_t<
+  needs_default_construct_via_allocator<Allocator, typename pointer_element<Pointer>::type>::value>
+default_initialize_range(Allocator& a, Pointer p, Size n)
+{
+  thrust::for_each_n(allocator_system<Allocator>::get(a), p, n, construct1_via_allocator<Allocator>(a));
+}
+
+// default construction of these elements has no effect, so we needn't touch their memory at all
+template <typename Allocator, typename Pointer, typename Size>
+_CCCL_HOST_DEVICE
+typename disable_if<needs_default_construct_via_allocator<Allocator, typename pointer_element<Pointer>::type>::value>::type
+default_initialize_range(Allocator&, Pointer, Size)
+{}
+
 } // namespace allocator_traits_detail
 
 template <typename Allocator, typename Pointer, typename Size>
@@ -94,5 +109,11 @@ _CCCL_HOST_DEVICE void value_initialize_range(Allocator& a, Pointer p, Size n)
   return allocator_traits_detail::value_initialize_range(a, p, n);
 }
 
+template <typename Allocator, typename Pointer, typename Size>
+_CCCL_HOST_DEVICE void default_initialize_range(Allocator& a, Pointer p, Size n)
+{
+  return allocator_traits_detail::default_initialize_range(a, p, n);
+}
+
 } // namespace detail
 THRUST_NAMESPACE_END
@@ -31,6 +31,7 @@
 #  pragma system_header
 #endif // no system header
 
+#include <thrust/detail/allocator/value_initialize_range.h>
 #include <thrust/detail/contiguous_storage.h>
 #include <thrust/detail/type_traits.h>
 #include <thrust/iterator/detail/normal_iterator.h>
@@ -45,6 +46,34 @@
 
 THRUST_NAMESPACE_BEGIN
 
+/*! \p default_init_t is the type of \p default_init, a tag which requests the constructors and \p resize of
+ *  \p host_vector and \p device_vector to default-initialize the new elements instead of value-initializing them.
+ *  Elements of trivially default constructible types are then left uninitialized, which saves a pass over the memory
+ *  of a vector which is overwritten right away. Elements of other types are constructed as they would be otherwise.
+ */
+struct default_init_t
+{
+  explicit default_init_t() = default;
+};
+
+/*! \p no_init_t is the type of \p no_init, a tag which requests the constructors and \p resize of \p host_vector
+ *  and \p device_vector to leave the new elements uninitialized. Unlike \p default_init, it is only accepted when
+ *  default construction of the elements has no effect, i.e. when their type is trivially default constructible and
+ *  the allocator does not construct them itself, so that it always guarantees the memory is not touched.
+ */
+struct no_init_t
+{
+  explicit no_init_t() = default;
+};
+
+/*! Tag requesting default initialization of the new elements of a vector. \see default_init_t
+ */
+_CCCL_GLOBAL_CONSTANT default_init_t default_init{};
+
+/*! Tag requesting the new elements of a vector to be left uninitialized. \see no_init_t
+ */
+_CCCL_GLOBAL_CONSTANT no_init_t no_init{};
+
 namespace detail
 {
 
@@ -91,6 +120,28 @@ public:
    */
   explicit vector_base(size_type n, const Alloc& alloc);
 
+  /*! This constructor creates a vector_base with default-initialized elements.
+   *  \param n The number of elements to create.
+   */
+  vector_base(size_type n, default_init_t);
+
+  /*! This constructor creates a vector_base with default-initialized elements.
+   *  \param n The number of elements to create.
+   *  \param alloc The allocator to use by this vector_base.
+   */
+  vector_base(size_type n, default_init_t, const Alloc& alloc);
+
+  /*! This constructor creates a vector_base with uninitialized elements.
+   *  \param n The number of elements to create.
+   */
+  vector_base(size_type n, no_init_t);
+
+  /*! This constructor creates a vector_base with uninitialized elements.
+   *  \param n The number of elements to create.
+   *  \param alloc The allocator to use by this vector_base.
+   */
+  vector_base(size_type n, no_init_t, const Alloc& alloc);
+
   /*! This constructor creates a vector_base with copies
    *  of an exemplar element.
    *  \param n The number of elements to initially create.
@@ -229,6 +280,28 @@ public:
    */
   void resize(size_type new_size, const value_type& x);
 
+  /*! \brief Resizes this vector_base to the specified number of elements.
+   *  \param new_size Number of elements this vector_base should contain.
+   *  \throw std::length_error If n exceeds max_size().
+   *
+   *  This method will resize this vector_base to the specified number of
+   *  elements. If the number is smaller than this vector_base's current
+   *  size this vector_base is truncated, otherwise this vector_base is
+   *  extended and new elements are default initialized.
+   */
+  void resize(size_type new_size, default_init_t);
+
+  /*! \brief Resizes this vector_base to the specified number of elements.
+   *  \param new_size Number of elements this vector_base should contain.
+   *  \throw std::length_error If n exceeds max_size().
+   *
+   *  This method will resize this vector_base to the specified number of
+   *  elements. If the number is smaller than this vector_base's current
+   *  size this vector_base is truncated, otherwise this vector_base is
+   *  extended and new elements are left uninitialized.
+   */
+  void resize(size_type new_size, no_init_t);
+
   /*! Returns the number of elements in this vector_base.
    */
   _CCCL_HOST_DEVICE size_type size() const;
@@ -501,10 +574,17 @@ private:
   template <typename InputIterator>
   void range_init(InputIterator first, InputIterator last);
 
-  void value_init(size_type n);
+  void value_init(size_type n, bool default_initialize = false);
 
   void fill_init(size_type n, const T& x);
 
+  static constexpr void check_no_init()
+  {
+    static_assert(!allocator_traits_detail::needs_default_construct_via_allocator<Alloc, T>::value,
+                  "thrust::no_init requires trivially default constructible elements and an allocator which does not "
+                  "construct them; use thrust::default_init instead");
+  }
+
   // these methods resolve the ambiguity of the insert() template of form (iterator, InputIterator, InputIterator)
   template <typename InputIteratorOrIntegralType>
   void
@@ -514,8 +594,9 @@ private:
   template <typename InputIteratorOrIntegralType>
   void insert_dispatch(iterator position, InputIteratorOrIntegralType n, InputIteratorOrIntegralType x, true_type);
 
-  // this method appends n value-initialized elements at the end
-  void append(size_type n);
+  // this method appends n value-initialized elements at the end, or default-initialized ones if default_initialize is
+  // true
+  void append(size_type n, bool default_initialize = false);
 
   // this method performs insertion from a fill value
   void fill_insert(iterator position, size_type n, const T& x);
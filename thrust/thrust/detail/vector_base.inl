@@ -79,6 +79,40 @@ vector_base<T, Alloc>::vector_base(size_type n, const Alloc& alloc)
   value_init(n);
 } // end vector_base::vector_base()
 
+template <typename T, typename Alloc>
+vector_base<T, Alloc>::vector_base(size_type n, default_init_t)
+    : m_storage()
+    , m_size(0)
+{
+  value_init(n, true);
+} // end vector_base::vector_base()
+
+template <typename T, typename Alloc>
+vector_base<T, Alloc>::vector_base(size_type n, default_init_t, const Alloc& alloc)
+    : m_storage(alloc)
+    , m_size(0)
+{
+  value_init(n, true);
+} // end vector_base::vector_base()
+
+template <typename T, typename Alloc>
+vector_base<T, Alloc>::vector_base(size_type n, no_init_t)
+    : m_storage()
+    , m_size(0)
+{
+  check_no_init();
+  value_init(n, true);
+} // end vector_base::vector_base()
+
+template <typename T, typename Alloc>
+vector_base<T, Alloc>::vector_base(size_type n, no_init_t, const Alloc& alloc)
+    : m_storage(alloc)
+    , m_size(0)
+{
+  check_no_init();
+  value_init(n, true);
+} // end vector_base::vector_base()
+
 template <typename T, typename Alloc>
 vector_base<T, Alloc>::vector_base(size_type n, const value_type& value)
     : m_storage()
@@ -216,14 +250,21 @@ void vector_base<T, Alloc>::init_dispatch(IteratorOrIntegralType n, IteratorOrIn
 } // end vector_base::init_dispatch()
 
 template <typename T, typename Alloc>
-void vector_base<T, Alloc>::value_init(size_type n)
+void vector_base<T, Alloc>::value_init(size_type n, bool default_initialize)
 {
   if (n > 0)
   {
     m_storage.allocate(n);
     m_size = n;
 
-    m_storage.value_initialize_n(begin(), size());
+    if (default_initialize)
+    {
+      m_storage.default_initialize_n(begin(), size());
+    }
+    else
+    {
+      m_storage.value_initialize_n(begin(), size());
+    }
   } // end if
 } // end vector_base::value_init()
 
@@ -325,6 +366,28 @@ void vector_base<T, Alloc>::resize(size_type new_size, const value_type& x)
   } // end else
 } // end vector_base::resize()
 
+template <typename T, typename Alloc>
+void vector_base<T, Alloc>::resize(size_type new_size, default_init_t)
+{
+  if (new_size < size())
+  {
+    iterator new_end = begin();
+    thrust::advance(new_end, new_size);
+    erase(new_end, end());
+  } // end if
+  else
+  {
+    append(new_size - size(), true);
+  } // end else
+} // end vector_base::resize()
+
+template <typename T, typename Alloc>
+void vector_base<T, Alloc>::resize(size_type new_size, no_init_t)
+{
+  check_no_init();
+  resize(new_size, default_init);
+} // end vector_base::resize()
+
 template <typename T, typename Alloc>
 _CCCL_HOST_DEVICE typename vector_base<T, Alloc>::size_type vector_base<T, Alloc>::size() const
 {
@@ -777,7 +840,7 @@ void vector_base<T, Alloc>::copy_insert(iterator position, ForwardIterator first
 } // end vector_base::copy_insert()
 
 template <typename T, typename Alloc>
-void vector_base<T, Alloc>::append(size_type n)
+void vector_base<T, Alloc>::append(size_type n, bool default_initialize)
 {
   if (n != 0)
   {
@@ -786,7 +849,14 @@ void vector_base<T, Alloc>::append(size_type n)
       // we've got room for all of them
 
       // default construct new elements at the end of the vector
-      m_storage.value_initialize_n(end(), n);
+      if (default_initialize)
+      {
+        m_storage.default_initialize_n(end(), n);
+      }
+      else
+      {
+        m_storage.value_initialize_n(end(), n);
+      }
 
       // extend the size
       m_size += n;
@@ -816,7 +886,14 @@ void vector_base<T, Alloc>::append(size_type n)
         new_end = m_storage.uninitialized_copy(begin(), end(), new_storage.begin());
 
         // construct new elements to insert
-        new_storage.value_initialize_n(new_end, n);
+        if (default_initialize)
+        {
+          new_storage.default_initialize_n(new_end, n);
+        }
+        else
+        {
+          new_storage.value_initialize_n(new_end, n);
+        }
         new_end += n;
       } // end try
       catch (...)
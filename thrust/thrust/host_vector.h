@@ -106,6 +106,44 @@ public:
       : Parent(n, alloc)
   {}
 
+  /*! This constructor creates a \p host_vector with the given size and
+   *  default-initialized elements, which leaves elements of trivially
+   *  default constructible types uninitialized.
+   *  \param n The number of elements to initially create.
+   */
+  _CCCL_HOST host_vector(size_type n, default_init_t)
+      : Parent(n, default_init_t{})
+  {}
+
+  /*! This constructor creates a \p host_vector with the given size and
+   *  default-initialized elements, which leaves elements of trivially
+   *  default constructible types uninitialized.
+   *  \param n The number of elements to initially create.
+   *  \param alloc The allocator to use by this host_vector.
+   */
+  _CCCL_HOST host_vector(size_type n, default_init_t, const Alloc& alloc)
+      : Parent(n, default_init_t{}, alloc)
+  {}
+
+  /*! This constructor creates a \p host_vector with the given size and
+   *  uninitialized elements, which requires \c T to be trivially default
+   *  constructible.
+   *  \param n The number of elements to initially create.
+   */
+  _CCCL_HOST host_vector(size_type n, no_init_t)
+      : Parent(n, no_init_t{})
+  {}
+
+  /*! This constructor creates a \p host_vector with the given size and
+   *  uninitialized elements, which requires \c T to be trivially default
+   *  constructible.
+   *  \param n The number of elements to initially create.
+   *  \param alloc The allocator to use by this host_vector.
+   */
+  _CCCL_HOST host_vector(size_type n, no_init_t, const Alloc& alloc)
+      : Parent(n, no_init_t{}, alloc)
+  {}
+
   /*! This constructor creates a \p host_vector with copies
    *  of an exemplar element.
    *  \param n The number of elements to initially create.
@@ -288,6 +326,30 @@ public:
      */
     void resize(size_type new_size, const value_type &x = value_type());
 
+    /*! \brief Resizes this vector to the specified number of elements.
+     *  \param new_size Number of elements this vector should contain.
+     *  \throw std::length_error If n exceeds max_size().
+     *
+     *  This method will resize this vector to the specified number of
+     *  elements.  If the number is smaller than this vector's current
+     *  size this vector is truncated, otherwise this vector is
+     *  extended and new elements are default initialized, which leaves
+     *  elements of trivially default constructible types uninitialized.
+     */
+    void resize(size_type new_size, default_init_t);
+
+    /*! \brief Resizes this vector to the specified number of elements.
+     *  \param new_size Number of elements this vector should contain.
+     *  \throw std::length_error If n exceeds max_size().
+     *
+     *  This method will resize this vector to the specified number of
+     *  elements.  If the number is smaller than this vector's current
+     *  size this vector is truncated, otherwise this vector is
+     *  extended and new elements are left uninitialized. \c T must be
+     *  trivially default constructible.
+     */
+    void resize(size_type new_size, no_init_t);
+
     /*! Returns the number of elements in this vector.
      */
     size_type size() const;
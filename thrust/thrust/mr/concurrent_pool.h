@@ -0,0 +1,503 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file
+ *  \brief A version of \p unsynchronized_pool_resource safe to use from many threads at once, which caches free blocks
+ *  in per-thread magazines exchanged through a lock-free depot.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/mr/pool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+THRUST_NAMESPACE_BEGIN
+namespace mr
+{
+
+/*! \addtogroup memory_resources Memory Resources
+ *  \ingroup memory_management
+ *  \{
+ */
+
+/*! A version of \p unsynchronized_pool_resource that can be used from many threads at once without serializing them.
+ *
+ *  Every thread caches free blocks of each pooled size in two magazines, i.e. small fixed-capacity stacks of blocks,
+ * and allocates from and deallocates to them without synchronization. When both magazines of a thread are empty on
+ * allocation, or full on deallocation, the thread exchanges one of them with the shared depot, which holds stacks of
+ * full and empty magazines for every pooled size and is lock-free. Only when the depot has no full magazine left are
+ * blocks taken from an \p unsynchronized_pool_resource, guarded by a mutex, which also serves all oversized and
+ * overaligned allocations. Blocks deallocated by a thread other than the one which allocated them thus go back to the
+ * depot and are available to every thread, and the magazines of a thread that exits are returned to the depot.
+ *
+ *  Memory is only returned to the upstream resource by \p release and on destruction, which, like for the other pool
+ * resources, must not happen concurrently with other calls to the resource.
+ *
+ *  \tparam Upstream the type of memory resources that will be used for allocating memory
+ */
+template <typename Upstream>
+struct concurrent_pool_resource : public memory_resource<typename Upstream::pointer>
+{
+  using unsync_pool = unsynchronized_pool_resource<Upstream>;
+  using lock_t      = std::lock_guard<std::mutex>;
+
+  using void_ptr = typename Upstream::pointer;
+
+public:
+  /*! Get the default options for a pool. These are meant to be a sensible set of values for many use cases,
+   *      and as such, may be tuned in the future. This function is exposed so that creating a set of options that are
+   *      just a slight departure from the defaults is easy.
+   */
+  static pool_options get_default_options()
+  {
+    return unsync_pool::get_default_options();
+  }
+
+  /*! Constructor.
+   *
+   *  \param upstream the upstream memory resource for allocations
+   *  \param options pool options to use
+   */
+  concurrent_pool_resource(Upstream* upstream, pool_options options = get_default_options())
+      : m_options(options)
+      , m_smallest_block_log2(detail::log2_ri(m_options.smallest_block_size))
+      , m_state(std::make_shared<shared_state>(detail::log2_ri(m_options.largest_block_size) - m_smallest_block_log2 + 1))
+      , m_upstream_pool(upstream, options)
+  {}
+
+  /*! Constructor. The upstream resource is obtained by calling \p get_global_resource<Upstream>.
+   *
+   *  \param options pool options to use
+   */
+  concurrent_pool_resource(pool_options options = get_default_options())
+      : m_options(options)
+      , m_smallest_block_log2(detail::log2_ri(m_options.smallest_block_size))
+      , m_state(std::make_shared<shared_state>(detail::log2_ri(m_options.largest_block_size) - m_smallest_block_log2 + 1))
+      , m_upstream_pool(get_global_resource<Upstream>(), options)
+  {}
+
+  /*! Destructor. Releases all held memory to upstream.
+   */
+  ~concurrent_pool_resource()
+  {
+    release();
+  }
+
+  /*! Releases all held memory to upstream. Blocks cached in the magazines of all threads and in the depot are
+   * forgotten.
+   */
+  void release()
+  {
+    m_state->clear();
+
+    lock_t lock(m_mutex);
+    m_upstream_pool.release();
+  }
+
+  _CCCL_NODISCARD virtual void_ptr
+  do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+  {
+    bytes = (std::max)(bytes, m_options.smallest_block_size);
+
+    // oversized and/or overaligned allocations are not cached in magazines
+    if (bytes > m_options.largest_block_size || alignment > m_options.alignment)
+    {
+      lock_t lock(m_mutex);
+      return m_upstream_pool.do_allocate(bytes, alignment);
+    }
+
+    std::size_t bytes_log2 = thrust::detail::log2_ri(bytes);
+    std::size_t class_idx  = bytes_log2 - m_smallest_block_log2;
+
+    magazine_pair& mags = local_cache().classes[class_idx];
+
+    if (mags.loaded->count == 0)
+    {
+      if (mags.previous->count != 0)
+      {
+        std::swap(mags.loaded, mags.previous);
+      }
+      else if (magazine* full = m_state->full[class_idx].pop(*m_state))
+      {
+        m_state->empty.push(mags.previous);
+        mags.previous = mags.loaded;
+        mags.loaded   = full;
+      }
+      else
+      {
+        // the depot ran dry, take half a magazine worth of blocks at once to amortize the lock
+        std::size_t block_size = static_cast<std::size_t>(1) << bytes_log2;
+
+        lock_t lock(m_mutex);
+        while (mags.loaded->count < magazine_capacity / 2)
+        {
+          mags.loaded->rounds[mags.loaded->count] = m_upstream_pool.do_allocate(block_size, m_options.alignment);
+          ++mags.loaded->count;
+        }
+      }
+    }
+
+    return mags.loaded->rounds[--mags.loaded->count];
+  }
+
+  virtual void do_deallocate(void_ptr p, std::size_t n, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+  {
+    n = (std::max)(n, m_options.smallest_block_size);
+
+    if (n > m_options.largest_block_size || alignment > m_options.alignment)
+    {
+      lock_t lock(m_mutex);
+      m_upstream_pool.do_deallocate(p, n, alignment);
+      return;
+    }
+
+    std::size_t class_idx = thrust::detail::log2_ri(n) - m_smallest_block_log2;
+
+    magazine_pair& mags = local_cache().classes[class_idx];
+
+    if (mags.loaded->count == magazine_capacity)
+    {
+      if (mags.previous->count != magazine_capacity)
+      {
+        std::swap(mags.loaded, mags.previous);
+      }
+      else
+      {
+        m_state->full[class_idx].push(mags.previous);
+        mags.previous = mags.loaded;
+        mags.loaded   = m_state->empty_magazine();
+      }
+    }
+
+    mags.loaded->rounds[mags.loaded->count++] = p;
+  }
+
+private:
+  static constexpr std::size_t magazine_capacity = 32;
+
+  // A small stack of free blocks of a single size. Magazines are identified by their index in the shared state, which
+  // fits the head of a depot stack together with an ABA tag.
+  struct magazine
+  {
+    void_ptr rounds[magazine_capacity];
+    std::size_t count;
+    std::uint32_t index;
+    // the index of the magazine below this one on a depot stack, plus one
+    std::atomic<std::uint32_t> next;
+  };
+
+  struct magazine_pair
+  {
+    magazine* loaded;
+    magazine* previous;
+  };
+
+  struct thread_cache
+  {
+    std::vector<magazine_pair> classes;
+  };
+
+  struct shared_state;
+
+  // A lock-free stack of magazines. Magazines are only freed together with the shared state, so one popped off the
+  // stack by another thread stays readable; the tag bumped by every change of the head defeats the ABA problem.
+  class magazine_stack
+  {
+  public:
+    magazine_stack()
+        : m_head(0)
+    {}
+
+    void push(magazine* mag)
+    {
+      std::uint64_t head = m_head.load(std::memory_order_relaxed);
+      std::uint64_t desired;
+      do
+      {
+        mag->next.store(static_cast<std::uint32_t>(head), std::memory_order_relaxed);
+        desired = (((head >> 32) + 1) << 32) | (static_cast<std::uint64_t>(mag->index) + 1);
+      } while (!m_head.compare_exchange_weak(head, desired, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    magazine* pop(shared_state& state)
+    {
+      std::uint64_t head = m_head.load(std::memory_order_acquire);
+      std::uint64_t desired;
+      magazine* mag;
+      do
+      {
+        if (static_cast<std::uint32_t>(head) == 0)
+        {
+          return nullptr;
+        }
+
+        mag     = state.magazine_at(static_cast<std::uint32_t>(head) - 1);
+        desired = (((head >> 32) + 1) << 32) | mag->next.load(std::memory_order_relaxed);
+      } while (!m_head.compare_exchange_weak(head, desired, std::memory_order_acquire, std::memory_order_acquire));
+
+      return mag;
+    }
+
+    void clear()
+    {
+      m_head.store(0, std::memory_order_relaxed);
+    }
+
+  private:
+    // the tag in the upper half, the index of the top magazine plus one in the lower half
+    std::atomic<std::uint64_t> m_head;
+  };
+
+  // The depot and the magazines, shared by the resource with the threads using it; a thread that exits returns its
+  // magazines to the depot as long as the resource is alive.
+  struct shared_state
+  {
+    static constexpr std::size_t chunk_size_log2 = 10;
+    static constexpr std::size_t chunk_size      = static_cast<std::size_t>(1) << chunk_size_log2;
+    static constexpr std::size_t max_chunks      = static_cast<std::size_t>(1) << 12;
+
+    explicit shared_state(std::size_t num_classes)
+        : full(num_classes)
+        , magazine_count(0)
+    {
+      for (std::size_t i = 0; i < max_chunks; ++i)
+      {
+        chunks[i].store(nullptr, std::memory_order_relaxed);
+      }
+    }
+
+    ~shared_state()
+    {
+      for (std::size_t i = 0; i < max_chunks; ++i)
+      {
+        delete[] chunks[i].load(std::memory_order_relaxed);
+      }
+    }
+
+    magazine* magazine_at(std::uint32_t idx) const
+    {
+      return chunks[idx >> chunk_size_log2].load(std::memory_order_acquire) + (idx & (chunk_size - 1));
+    }
+
+    // magazines are carved out of chunks that are never freed before the state, so that their indices stay valid
+    magazine* new_magazine()
+    {
+      std::size_t idx   = magazine_count.fetch_add(1, std::memory_order_relaxed);
+      std::size_t chunk = idx >> chunk_size_log2;
+      assert(chunk < max_chunks);
+
+      magazine* storage = chunks[chunk].load(std::memory_order_acquire);
+      if (!storage)
+      {
+        magazine* fresh = new magazine[chunk_size];
+        for (std::size_t i = 0; i < chunk_size; ++i)
+        {
+          fresh[i].count = 0;
+          fresh[i].index = static_cast<std::uint32_t>((chunk << chunk_size_log2) + i);
+        }
+
+        if (chunks[chunk].compare_exchange_strong(storage, fresh, std::memory_order_acq_rel))
+        {
+          storage = fresh;
+        }
+        else
+        {
+          delete[] fresh;
+        }
+      }
+
+      return storage + (idx & (chunk_size - 1));
+    }
+
+    magazine* empty_magazine()
+    {
+      magazine* mag = empty.pop(*this);
+      return mag ? mag : new_magazine();
+    }
+
+    thread_cache* acquire_cache()
+    {
+      lock_t lock(mutex);
+
+      if (!retired.empty())
+      {
+        thread_cache* cache = retired.back();
+        retired.pop_back();
+        return cache;
+      }
+
+      std::unique_ptr<thread_cache> cache(new thread_cache);
+      cache->classes.resize(full.size());
+      for (std::size_t i = 0; i < cache->classes.size(); ++i)
+      {
+        cache->classes[i].loaded   = empty_magazine();
+        cache->classes[i].previous = empty_magazine();
+      }
+
+      caches.push_back(std::move(cache));
+      return caches.back().get();
+    }
+
+    // hands the blocks cached by an exiting thread over to the depot, and its cache over to the next new thread
+    void retire_cache(thread_cache* cache)
+    {
+      for (std::size_t i = 0; i < cache->classes.size(); ++i)
+      {
+        magazine_pair& mags = cache->classes[i];
+        if (mags.loaded->count != 0)
+        {
+          full[i].push(mags.loaded);
+          mags.loaded = empty_magazine();
+        }
+        if (mags.previous->count != 0)
+        {
+          full[i].push(mags.previous);
+          mags.previous = empty_magazine();
+        }
+      }
+
+      lock_t lock(mutex);
+      retired.push_back(cache);
+    }
+
+    // forgets all cached blocks and puts every magazine not held by a thread back on the empty stack
+    void clear()
+    {
+      lock_t lock(mutex);
+
+      for (std::size_t i = 0; i < full.size(); ++i)
+      {
+        full[i].clear();
+      }
+      empty.clear();
+
+      std::size_t count = magazine_count.load(std::memory_order_relaxed);
+      std::vector<bool> held(count, false);
+      for (std::size_t c = 0; c < caches.size(); ++c)
+      {
+        for (std::size_t i = 0; i < caches[c]->classes.size(); ++i)
+        {
+          held[caches[c]->classes[i].loaded->index]   = true;
+          held[caches[c]->classes[i].previous->index] = true;
+        }
+      }
+
+      for (std::size_t idx = 0; idx < count; ++idx)
+      {
+        magazine* mag = magazine_at(static_cast<std::uint32_t>(idx));
+        mag->count    = 0;
+        if (!held[idx])
+        {
+          empty.push(mag);
+        }
+      }
+    }
+
+    // stacks of full or partially full magazines, one per size class
+    std::vector<magazine_stack> full;
+    // empty magazines, which can be loaded with blocks of any size
+    magazine_stack empty;
+
+    std::atomic<magazine*> chunks[max_chunks];
+    std::atomic<std::size_t> magazine_count;
+
+    std::mutex mutex;
+    std::vector<std::unique_ptr<thread_cache>> caches;
+    std::vector<thread_cache*> retired;
+  };
+
+  struct thread_entry
+  {
+    shared_state* state;
+    std::weak_ptr<shared_state> weak_state;
+    thread_cache* cache;
+  };
+
+  // the caches of the calling thread in every resource of this type it used, returned to the depots on thread exit
+  struct thread_registry
+  {
+    std::vector<thread_entry> entries;
+
+    ~thread_registry()
+    {
+      for (std::size_t i = 0; i < entries.size(); ++i)
+      {
+        if (std::shared_ptr<shared_state> state = entries[i].weak_state.lock())
+        {
+          state->retire_cache(entries[i].cache);
+        }
+      }
+    }
+  };
+
+  thread_cache& local_cache()
+  {
+    static thread_local thread_registry registry;
+
+    for (std::size_t i = 0; i < registry.entries.size(); ++i)
+    {
+      thread_entry& entry = registry.entries[i];
+      if (entry.state == m_state.get() && !entry.weak_state.expired())
+      {
+        return *entry.cache;
+      }
+    }
+
+    // forget the caches of destroyed resources, whose state may share an address with this one
+    for (std::size_t i = registry.entries.size(); i > 0; --i)
+    {
+      if (registry.entries[i - 1].weak_state.expired())
+      {
+        registry.entries.erase(registry.entries.begin() + (i - 1));
+      }
+    }
+
+    thread_entry entry = {m_state.get(), m_state, m_state->acquire_cache()};
+    registry.entries.push_back(entry);
+    return *entry.cache;
+  }
+
+  pool_options m_options;
+  std::size_t m_smallest_block_log2;
+
+  std::shared_ptr<shared_state> m_state;
+
+  std::mutex m_mutex;
+  unsync_pool m_upstream_pool;
+};
+
+/*! \} // memory_resources
+ */
+
+} // namespace mr
+THRUST_NAMESPACE_END
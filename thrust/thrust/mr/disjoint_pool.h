@@ -40,6 +40,7 @@
 #include <thrust/mr/allocator.h>
 #include <thrust/mr/memory_resource.h>
 #include <thrust/mr/pool_options.h>
+#include <thrust/mr/pool_statistics.h>
 
 #include <cuda/std/cstdint>
 
@@ -77,8 +78,10 @@ namespace mr
  *
  *  \tparam Upstream the type of memory resources that will be used for allocating memory blocks to be handed off to the
  * user \tparam Bookkeeper the type of memory resources that will be used for allocating bookkeeping memory
+ *  \tparam Statistics the statistics policy, \p no_pool_statistics to record nothing or \p pool_statistics to count hits,
+ *      misses and upstream traffic
  */
-template <typename Upstream, typename Bookkeeper>
+template <typename Upstream, typename Bookkeeper, typename Statistics = no_pool_statistics>
 class disjoint_unsynchronized_pool_resource final
     : public memory_resource<typename Upstream::pointer>
     , private validator2<Upstream, Bookkeeper>
@@ -107,6 +110,8 @@ public:
     ret.cached_size_cutoff_factor      = 16;
     ret.cached_alignment_cutoff_factor = 16;
 
+    ret.max_cached_oversized_bytes = 0;
+
     return ret;
   }
 
@@ -122,16 +127,20 @@ public:
       , m_bookkeeper(bookkeeper)
       , m_options(options)
       , m_smallest_block_log2(detail::log2_ri(m_options.smallest_block_size))
-      , m_pools(m_bookkeeper)
-      , m_allocated(m_bookkeeper)
-      , m_cached_oversized(m_bookkeeper)
-      , m_oversized(m_bookkeeper)
+      , m_statistics()
+      , m_bookkeeping(m_bookkeeper, &m_statistics)
+      , m_pools(m_bookkeeping.get())
+      , m_allocated(m_bookkeeping.get())
+      , m_cached_oversized(m_bookkeeping.get())
+      , m_cached_oversized_bytes(0)
+      , m_oversized(m_bookkeeping.get())
   {
     assert(m_options.validate());
 
-    pointer_vector free(m_bookkeeper);
+    pointer_vector free(m_bookkeeping.get());
     pool p(free);
     m_pools.resize(detail::log2_ri(m_options.largest_block_size) - m_smallest_block_log2 + 1, p);
+    m_statistics.record_size_classes(m_options.smallest_block_size, m_pools.size());
   }
 
   // TODO: C++11: use delegating constructors
@@ -145,16 +154,20 @@ public:
       , m_bookkeeper(get_global_resource<Bookkeeper>())
       , m_options(options)
       , m_smallest_block_log2(detail::log2_ri(m_options.smallest_block_size))
-      , m_pools(m_bookkeeper)
-      , m_allocated(m_bookkeeper)
-      , m_cached_oversized(m_bookkeeper)
-      , m_oversized(m_bookkeeper)
+      , m_statistics()
+      , m_bookkeeping(m_bookkeeper, &m_statistics)
+      , m_pools(m_bookkeeping.get())
+      , m_allocated(m_bookkeeping.get())
+      , m_cached_oversized(m_bookkeeping.get())
+      , m_cached_oversized_bytes(0)
+      , m_oversized(m_bookkeeping.get())
   {
     assert(m_options.validate());
 
-    pointer_vector free(m_bookkeeper);
+    pointer_vector free(m_bookkeeping.get());
     pool p(free);
     m_pools.resize(detail::log2_ri(m_options.largest_block_size) - m_smallest_block_log2 + 1, p);
+    m_statistics.record_size_classes(m_options.smallest_block_size, m_pools.size());
   }
 
   /*! Destructor. Releases all held memory to upstream.
@@ -174,7 +187,10 @@ private:
     void_ptr pointer;
   };
 
-  using chunk_vector = thrust::host_vector<chunk_descriptor, allocator<chunk_descriptor, Bookkeeper>>;
+  using bookkeeping          = thrust::detail::pool_bookkeeping<Bookkeeper, Statistics>;
+  using bookkeeping_resource = typename bookkeeping::resource;
+
+  using chunk_vector = thrust::host_vector<chunk_descriptor, allocator<chunk_descriptor, bookkeeping_resource>>;
 
   struct oversized_block_descriptor
   {
@@ -226,9 +242,9 @@ private:
   };
 
   using oversized_block_vector =
-    thrust::host_vector<oversized_block_descriptor, allocator<oversized_block_descriptor, Bookkeeper>>;
+    thrust::host_vector<oversized_block_descriptor, allocator<oversized_block_descriptor, bookkeeping_resource>>;
 
-  using pointer_vector = thrust::host_vector<void_ptr, allocator<void_ptr, Bookkeeper>>;
+  using pointer_vector = thrust::host_vector<void_ptr, allocator<void_ptr, bookkeeping_resource>>;
 
   struct pool
   {
@@ -251,7 +267,7 @@ private:
     std::size_t previous_allocated_count;
   };
 
-  using pool_vector = thrust::host_vector<pool, allocator<pool, Bookkeeper>>;
+  using pool_vector = thrust::host_vector<pool, allocator<pool, bookkeeping_resource>>;
 
   Upstream* m_upstream;
   Bookkeeper* m_bookkeeper;
@@ -259,16 +275,30 @@ private:
   pool_options m_options;
   std::size_t m_smallest_block_log2;
 
+  // declared before the containers, which record their deallocations in it when destroyed
+  _CCCL_NO_UNIQUE_ADDRESS Statistics m_statistics;
+  bookkeeping m_bookkeeping;
+
   // buckets containing free lists for each pooled size
   pool_vector m_pools;
   // list of all allocations from upstream for the above
   chunk_vector m_allocated;
-  // list of all cached oversized/overaligned blocks that have been returned to the pool to cache
+  // list of all cached oversized/overaligned blocks that have been returned to the pool to cache, sorted by size
   oversized_block_vector m_cached_oversized;
+  // total size of the above
+  std::size_t m_cached_oversized_bytes;
   // list of all oversized/overaligned allocations from upstream
   oversized_block_vector m_oversized;
 
 public:
+  /*! Returns a snapshot of the statistics recorded by the pool resource. Every statistic is zero unless the pool
+   *      resource records them, i.e. unless \p Statistics is \p pool_statistics.
+   */
+  pool_statistics_snapshot statistics() const
+  {
+    return m_statistics.snapshot();
+  }
+
   /*! Releases all held memory to upstream.
    */
   void release()
@@ -284,17 +314,22 @@ public:
     for (std::size_t i = 0; i < m_allocated.size(); ++i)
     {
       m_upstream->do_deallocate(m_allocated[i].pointer, m_allocated[i].size, m_options.alignment);
+      m_statistics.record_upstream_deallocate(m_allocated[i].size);
     }
 
     // deallocate cached oversized/overaligned memory
     for (std::size_t i = 0; i < m_oversized.size(); ++i)
     {
       m_upstream->do_deallocate(m_oversized[i].pointer, m_oversized[i].size, m_oversized[i].alignment);
+      m_statistics.record_upstream_deallocate(m_oversized[i].size);
     }
 
     m_allocated.clear();
     m_oversized.clear();
     m_cached_oversized.clear();
+    m_cached_oversized_bytes = 0;
+
+    m_statistics.record_release();
   }
 
   _CCCL_NODISCARD virtual void_ptr
@@ -347,6 +382,8 @@ public:
         if (it != m_cached_oversized.end())
         {
           oversized.pointer = (*it).pointer;
+          m_cached_oversized_bytes -= (*it).size;
+          m_statistics.record_oversized_allocate((*it).size, true);
           m_cached_oversized.erase(it);
           return oversized.pointer;
         }
@@ -354,8 +391,11 @@ public:
 
       // no fitting cached block found; allocate a new one that's just up to the specs
       oversized.pointer = m_upstream->do_allocate(bytes, alignment);
+      m_statistics.record_upstream_allocate(bytes);
       m_oversized.push_back(oversized);
 
+      m_statistics.record_oversized_allocate(bytes, false);
+
       return oversized.pointer;
     }
 
@@ -365,12 +405,13 @@ public:
     std::size_t bucket_idx = bytes_log2 - m_smallest_block_log2;
     pool& bucket           = m_pools[bucket_idx];
 
+    std::size_t bucket_size = static_cast<std::size_t>(1) << bytes_log2;
+
     // if the free list of the bucket has no elements, allocate a new chunk
     // and split it into blocks pushed to the free list
-    if (bucket.free_blocks.empty())
+    bool hit = !bucket.free_blocks.empty();
+    if (!hit)
     {
-      std::size_t bucket_size = static_cast<std::size_t>(1) << bytes_log2;
-
       std::size_t n = bucket.previous_allocated_count;
       if (n == 0)
       {
@@ -403,6 +444,7 @@ public:
       chunk_descriptor allocated;
       allocated.size    = bytes;
       allocated.pointer = m_upstream->do_allocate(bytes, m_options.alignment);
+      m_statistics.record_upstream_allocate(bytes);
       m_allocated.push_back(allocated);
       bucket.previous_allocated_count = n;
 
@@ -415,6 +457,7 @@ public:
     // allocate a block from the front of the bucket's free list
     void_ptr ret = bucket.free_blocks.back();
     bucket.free_blocks.pop_back();
+    m_statistics.record_pooled_allocate(bucket_idx, bucket_size, hit);
     return ret;
   }
 
@@ -434,17 +477,23 @@ public:
 
       oversized_block_descriptor oversized = *it;
 
-      if (m_options.cache_oversized)
+      m_statistics.record_deallocate(oversized.size);
+
+      if (m_options.cache_oversized
+          && (m_options.max_cached_oversized_bytes == 0
+              || m_cached_oversized_bytes + oversized.size <= m_options.max_cached_oversized_bytes))
       {
         typename oversized_block_vector::iterator position =
           lower_bound(m_cached_oversized.begin(), m_cached_oversized.end(), oversized);
         m_cached_oversized.insert(position, oversized);
+        m_cached_oversized_bytes += oversized.size;
         return;
       }
 
       m_oversized.erase(it);
 
       m_upstream->do_deallocate(p, oversized.size, oversized.alignment);
+      m_statistics.record_upstream_deallocate(oversized.size);
 
       return;
     }
@@ -454,6 +503,8 @@ public:
     std::size_t bucket_idx = n_log2 - m_smallest_block_log2;
     pool& bucket           = m_pools[bucket_idx];
 
+    m_statistics.record_deallocate(static_cast<std::size_t>(1) << n_log2);
+
     bucket.free_blocks.push_back(p);
   }
 };
@@ -0,0 +1,301 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file
+ *  \brief A memory resource which maps anonymous memory directly from the operating system, optionally backed by huge
+ *      pages.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#if !_CCCL_OS(WINDOWS)
+
+#  include <thrust/mr/memory_resource.h>
+#  include <thrust/system/detail/bad_alloc.h>
+
+#  include <cstddef>
+#  include <cstdint>
+#  include <map>
+#  include <mutex>
+#  include <vector>
+
+#  include <sys/mman.h>
+#  include <unistd.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace mr
+{
+
+/*! \addtogroup memory_resources Memory Resources
+ *  \ingroup memory_management
+ *  \{
+ */
+
+/*! The kinds of pages backing the memory of a \p mmap_memory_resource.
+ */
+enum class huge_page_mode
+{
+  /*! Regular pages only.
+   */
+  none,
+  /*! Advise the kernel to back allocations of at least a huge page with transparent huge pages.
+   */
+  transparent,
+  /*! Map allocations of at least a huge page from the reserved huge pages, falling back to transparent huge pages
+   *      when none are available.
+   */
+  explicit_
+};
+
+/*! A memory resource which maps every allocation as anonymous memory directly from the operating system, and unmaps it
+ *      on deallocation. It is meant as the upstream resource of the pool resources when their chunks are large: backing
+ *      the chunks with huge pages cuts the TLB misses of algorithms streaming over them, and the pages of a deallocated
+ *      chunk are returned to the operating system instead of staying in the heap of the process.
+ *
+ *  Allocations of at least \p huge_page_size bytes are backed by huge pages according to the \p huge_page_mode given on
+ *      construction; smaller ones always use regular pages. Every allocation occupies a whole number of pages, so this
+ *      resource is not meant for small blocks.
+ *
+ *  The resource keeps track of its mappings to report how much memory it has mapped and how much of it is resident,
+ *      i.e. counts towards the resident set size of the process.
+ *
+ *  This resource is only available on POSIX systems.
+ */
+class mmap_memory_resource final : public memory_resource<>
+{
+public:
+  /*! The size of the huge pages on the common configurations.
+   */
+  static constexpr std::size_t huge_page_size = std::size_t(1) << 21;
+
+  /*! Constructs the resource.
+   *
+   *  \param mode the kind of pages backing the allocations of at least \p huge_page_size bytes
+   */
+  explicit mmap_memory_resource(huge_page_mode mode = huge_page_mode::none)
+      : m_mode(mode)
+      , m_mapped_bytes(0)
+  {}
+
+  /*! Unmaps all memory which was not deallocated.
+   */
+  ~mmap_memory_resource()
+  {
+    for (const auto& mapping : m_mappings)
+    {
+      ::munmap(mapping.first, mapping.second);
+    }
+  }
+
+  mmap_memory_resource(const mmap_memory_resource&)            = delete;
+  mmap_memory_resource& operator=(const mmap_memory_resource&) = delete;
+
+  _CCCL_NODISCARD void* do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+  {
+    const bool huge          = uses_huge_pages(bytes);
+    const std::size_t length = mapping_length(bytes);
+
+    void* ret = nullptr;
+#  if defined(MAP_HUGETLB)
+    // huge TLB mappings are aligned to the huge page size
+    if (huge && m_mode == huge_page_mode::explicit_ && alignment <= huge_page_size)
+    {
+      void* mapping =
+        ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      if (mapping != MAP_FAILED)
+      {
+        ret = mapping;
+      }
+    }
+#  endif // MAP_HUGETLB
+
+    if (ret == nullptr)
+    {
+      // transparent huge pages only back the parts of a mapping aligned to their size
+      if (huge && alignment < huge_page_size)
+      {
+        alignment = huge_page_size;
+      }
+      ret = map_aligned(length, alignment);
+
+#  if defined(MADV_HUGEPAGE)
+      if (huge)
+      {
+        ::madvise(ret, length, MADV_HUGEPAGE);
+      }
+#  endif // MADV_HUGEPAGE
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    try
+    {
+      m_mappings.emplace(ret, length);
+    }
+    catch (...)
+    {
+      // the mapping is not recorded, so nothing would ever unmap it
+      ::munmap(ret, length);
+      throw;
+    }
+    m_mapped_bytes += length;
+    return ret;
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t) override
+  {
+    const std::size_t length = mapping_length(bytes);
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_mappings.erase(p);
+      m_mapped_bytes -= length;
+    }
+    ::munmap(p, length);
+  }
+
+  /*! Returns the pages lying entirely within <tt>[p, p + bytes)</tt>, a range inside an allocation of this resource,
+   *      to the operating system, while keeping the range allocated. The pages are mapped again, filled with zeros, when
+   *      they are next accessed. This is useful to drop the footprint of memory which stays allocated but is known to
+   *      be unused, such as a free chunk cached by a pool resource.
+   *
+   *  \param p the beginning of the range
+   *  \param bytes the size of the range
+   */
+  void purge(void* p, std::size_t bytes)
+  {
+    const std::uintptr_t page  = page_size();
+    const std::uintptr_t begin = round_up(reinterpret_cast<std::uintptr_t>(p), page);
+    const std::uintptr_t end   = (reinterpret_cast<std::uintptr_t>(p) + bytes) / page * page;
+    if (begin < end)
+    {
+      ::madvise(reinterpret_cast<void*>(begin), end - begin, MADV_DONTNEED);
+    }
+  }
+
+  /*! Returns the number of bytes currently mapped by this resource, which is the sum of the sizes of its live
+   *      allocations rounded up to whole pages.
+   */
+  std::size_t mapped_bytes() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_mapped_bytes;
+  }
+
+  /*! Returns the number of bytes of memory mapped by this resource which are resident, i.e. which have been touched
+   *      and not purged since, and count towards the resident set size of the process.
+   */
+  std::size_t resident_bytes() const
+  {
+    const std::size_t page = page_size();
+    std::size_t ret        = 0;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<resident_vector_element> resident;
+    for (const auto& mapping : m_mappings)
+    {
+      resident.resize(mapping.second / page);
+      if (::mincore(mapping.first, mapping.second, resident.data()) == 0)
+      {
+        for (resident_vector_element r : resident)
+        {
+          ret += (r & 1) ? page : 0;
+        }
+      }
+    }
+    return ret;
+  }
+
+  /*! Returns the size of the regular pages of the system.
+   */
+  static std::size_t page_size()
+  {
+    static const std::size_t size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return size;
+  }
+
+  /*! Returns whether this resource backs an allocation of \p bytes bytes with huge pages, or at least asks the kernel
+   *      to do so.
+   */
+  bool uses_huge_pages(std::size_t bytes) const
+  {
+    return m_mode != huge_page_mode::none && bytes >= huge_page_size;
+  }
+
+private:
+#  if defined(__APPLE__)
+  using resident_vector_element = char;
+#  else
+  using resident_vector_element = unsigned char;
+#  endif
+
+  static std::uintptr_t round_up(std::uintptr_t n, std::uintptr_t multiple)
+  {
+    return (n + multiple - 1) / multiple * multiple;
+  }
+
+  std::size_t mapping_length(std::size_t bytes) const
+  {
+    return round_up(bytes == 0 ? 1 : bytes, uses_huge_pages(bytes) ? huge_page_size : page_size());
+  }
+
+  // maps length bytes at the given alignment, by mapping enough to align the start and unmapping what sticks out
+  static void* map_aligned(std::size_t length, std::size_t alignment)
+  {
+    const std::size_t page  = page_size();
+    const std::size_t slack = alignment > page ? alignment - page : 0;
+
+    void* mapping = ::mmap(nullptr, length + slack, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED)
+    {
+      throw thrust::system::detail::bad_alloc("mmap_memory_resource: mmap failed");
+    }
+
+    char* begin   = static_cast<char*>(mapping);
+    char* aligned = reinterpret_cast<char*>(round_up(reinterpret_cast<std::uintptr_t>(begin), alignment));
+    char* end     = begin + length + slack;
+    if (aligned != begin)
+    {
+      ::munmap(begin, aligned - begin);
+    }
+    if (aligned + length != end)
+    {
+      ::munmap(aligned + length, end - (aligned + length));
+    }
+    return aligned;
+  }
+
+  huge_page_mode m_mode;
+  mutable std::mutex m_mutex;
+  std::map<void*, std::size_t> m_mappings;
+  std::size_t m_mapped_bytes;
+};
+
+/*! \} // memory_resources
+ */
+
+} // namespace mr
+THRUST_NAMESPACE_END
+
+#endif // !_CCCL_OS(WINDOWS)
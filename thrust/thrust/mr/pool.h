@@ -37,7 +37,9 @@
 #include <thrust/mr/allocator.h>
 #include <thrust/mr/memory_resource.h>
 #include <thrust/mr/pool_options.h>
+#include <thrust/mr/pool_statistics.h>
 
+#include <cuda/std/__bit/countr.h>
 #include <cuda/std/cstdint>
 
 #include <cassert>
@@ -72,8 +74,10 @@ namespace mr
  * need to transfer it back and forth between the host and the device whenever an allocation or a deallocation happens.
  *
  *  \tparam Upstream the type of memory resources that will be used for allocating memory blocks
+ *  \tparam Statistics the statistics policy, \p no_pool_statistics to record nothing or \p pool_statistics to count hits,
+ *      misses and upstream traffic
  */
-template <typename Upstream>
+template <typename Upstream, typename Statistics = no_pool_statistics>
 class unsynchronized_pool_resource final
     : public memory_resource<typename Upstream::pointer>
     , private validator<Upstream>
@@ -102,6 +106,8 @@ public:
     ret.cached_size_cutoff_factor      = 16;
     ret.cached_alignment_cutoff_factor = 16;
 
+    ret.max_cached_oversized_bytes = 0;
+
     return ret;
   }
 
@@ -114,15 +120,24 @@ public:
       : m_upstream(upstream)
       , m_options(options)
       , m_smallest_block_log2(detail::log2_ri(m_options.smallest_block_size))
-      , m_pools(upstream)
+      , m_statistics()
+      , m_bookkeeping(m_upstream, &m_statistics)
+      , m_pools(m_bookkeeping.get())
       , m_allocated()
       , m_oversized()
-      , m_cached_oversized()
+      , m_cached_oversized(m_bookkeeping.get())
+      , m_cached_classes()
+      , m_cached_oversized_bytes(0)
   {
     assert(m_options.validate());
 
     pool p = {block_descriptor_ptr(), 0};
     m_pools.resize(detail::log2_ri(m_options.largest_block_size) - m_smallest_block_log2 + 1, p);
+    if (m_options.cache_oversized)
+    {
+      m_cached_oversized.resize(cached_class_count, oversized_block_descriptor_ptr());
+    }
+    m_statistics.record_size_classes(m_options.smallest_block_size, m_pools.size());
   }
 
   // TODO: C++11: use delegating constructors
@@ -135,15 +150,24 @@ public:
       : m_upstream(get_global_resource<Upstream>())
       , m_options(options)
       , m_smallest_block_log2(detail::log2_ri(m_options.smallest_block_size))
-      , m_pools(get_global_resource<Upstream>())
+      , m_statistics()
+      , m_bookkeeping(m_upstream, &m_statistics)
+      , m_pools(m_bookkeeping.get())
       , m_allocated()
       , m_oversized()
-      , m_cached_oversized()
+      , m_cached_oversized(m_bookkeeping.get())
+      , m_cached_classes()
+      , m_cached_oversized_bytes(0)
   {
     assert(m_options.validate());
 
     pool p = {block_descriptor_ptr(), 0};
     m_pools.resize(detail::log2_ri(m_options.largest_block_size) - m_smallest_block_log2 + 1, p);
+    if (m_options.cache_oversized)
+    {
+      m_cached_oversized.resize(cached_class_count, oversized_block_descriptor_ptr());
+    }
+    m_statistics.record_size_classes(m_options.smallest_block_size, m_pools.size());
   }
 
   /*! Destructor. Releases all held memory to upstream.
@@ -180,8 +204,8 @@ private:
 
   // this was originally a forward list, but I made it a doubly linked list
   // because that way deallocation when not caching is faster and doesn't require
-  // traversal of a linked list (it's still a forward list for the cached list,
-  // because allocation from that list already traverses)
+  // traversal of a linked list (it's still a forward list for the lists of cached
+  // blocks of each size class, which are kept sorted and traversed anyway)
   //
   // TODO: investigate whether it's better to have this be a doubly-linked list
   // with fast do_deallocate when !m_options.cache_oversized, or to have this be
@@ -206,19 +230,146 @@ private:
     std::size_t previous_allocated_count;
   };
 
-  using pool_vector = thrust::host_vector<pool, allocator<pool, Upstream>>;
+  using bookkeeping          = thrust::detail::pool_bookkeeping<Upstream, Statistics>;
+  using bookkeeping_resource = typename bookkeeping::resource;
+
+  using pool_vector = thrust::host_vector<pool, allocator<pool, bookkeeping_resource>>;
+
+  using oversized_block_descriptor_ptr_vector =
+    thrust::host_vector<oversized_block_descriptor_ptr,
+                        allocator<oversized_block_descriptor_ptr, bookkeeping_resource>>;
+
+  // cached oversized/overaligned blocks are segregated by size into classes, each covering a quarter of a power of two
+  static constexpr std::size_t cached_class_split_log2 = 2;
+  static constexpr std::size_t cached_class_count      = (8 * sizeof(std::size_t)) << cached_class_split_log2;
 
   Upstream* m_upstream;
 
   pool_options m_options;
   std::size_t m_smallest_block_log2;
 
+  // declared before the containers, which record their deallocations in it when destroyed
+  _CCCL_NO_UNIQUE_ADDRESS Statistics m_statistics;
+  bookkeeping m_bookkeeping;
+
   pool_vector m_pools;
   chunk_descriptor_ptr m_allocated;
   oversized_block_descriptor_ptr m_oversized;
-  oversized_block_descriptor_ptr m_cached_oversized;
+  // heads of the lists of cached oversized/overaligned blocks of each size class, sorted by increasing size
+  oversized_block_descriptor_ptr_vector m_cached_oversized;
+  // bit set of the size classes with cached blocks
+  ::cuda::std::uint64_t m_cached_classes[cached_class_count / 64];
+  std::size_t m_cached_oversized_bytes;
+
+  static std::size_t cached_class(std::size_t size)
+  {
+    std::size_t size_log2 = thrust::detail::log2(size);
+    std::size_t split     = 0;
+
+    if (size_log2 >= cached_class_split_log2)
+    {
+      split = (size >> (size_log2 - cached_class_split_log2))
+            & ((static_cast<std::size_t>(1) << cached_class_split_log2) - 1);
+    }
+
+    return (size_log2 << cached_class_split_log2) | split;
+  }
+
+  // returns the first size class starting at c that holds cached blocks, or cached_class_count if there is none
+  std::size_t next_cached_class(std::size_t c) const
+  {
+    while (c < cached_class_count)
+    {
+      ::cuda::std::uint64_t word = m_cached_classes[c / 64] >> (c % 64);
+      if (word)
+      {
+        return c + ::cuda::std::countr_zero(word);
+      }
+
+      c = (c / 64 + 1) * 64;
+    }
+
+    return c;
+  }
+
+  // Unlinks and returns the smallest cached block fitting the request, or a null pointer if there's none.
+  oversized_block_descriptor_ptr take_cached_oversized(std::size_t bytes, std::size_t alignment)
+  {
+    for (std::size_t c = next_cached_class(cached_class(bytes)); c < cached_class_count; c = next_cached_class(c + 1))
+    {
+      oversized_block_descriptor_ptr* previous = &thrust::raw_reference_cast(m_cached_oversized[c]);
+      oversized_block_descriptor_ptr ptr       = *previous;
+
+      while (oversized_block_ptr_traits::get(ptr))
+      {
+        oversized_block_descriptor desc = *ptr;
+
+        if (desc.size >= bytes)
+        {
+          // if the size is bigger than the requested size by a factor
+          // bigger than or equal to the specified cutoff for size,
+          // allocate a new block; so is every block that follows
+          std::size_t size_factor = desc.size / bytes;
+          if (size_factor >= m_options.cached_size_cutoff_factor)
+          {
+            return oversized_block_descriptor_ptr();
+          }
+
+          // if the alignment is bigger than the requested one by a factor
+          // bigger than or equal to the specified cutoff for alignment,
+          // look for another block
+          std::size_t alignment_factor = desc.alignment / alignment;
+          if (desc.alignment >= alignment && alignment_factor < m_options.cached_alignment_cutoff_factor)
+          {
+            *previous = desc.next_cached;
+
+            if (!oversized_block_ptr_traits::get(thrust::raw_reference_cast(m_cached_oversized[c])))
+            {
+              m_cached_classes[c / 64] &= ~(static_cast<::cuda::std::uint64_t>(1) << (c % 64));
+            }
+
+            m_cached_oversized_bytes -= desc.size;
+
+            return ptr;
+          }
+        }
+
+        previous = &thrust::raw_reference_cast(*ptr).next_cached;
+        ptr      = *previous;
+      }
+    }
+
+    return oversized_block_descriptor_ptr();
+  }
+
+  // Links block, described by desc, into the list of cached blocks of its size class.
+  void cache_oversized(oversized_block_descriptor_ptr block, oversized_block_descriptor desc)
+  {
+    std::size_t c = cached_class(desc.size);
+
+    oversized_block_descriptor_ptr* previous = &thrust::raw_reference_cast(m_cached_oversized[c]);
+    while (oversized_block_ptr_traits::get(*previous) && thrust::raw_reference_cast(**previous).size < desc.size)
+    {
+      previous = &thrust::raw_reference_cast(**previous).next_cached;
+    }
+
+    desc.next_cached = *previous;
+    *block           = desc;
+    *previous        = block;
+
+    m_cached_classes[c / 64] |= static_cast<::cuda::std::uint64_t>(1) << (c % 64);
+    m_cached_oversized_bytes += desc.size;
+  }
 
 public:
+  /*! Returns a snapshot of the statistics recorded by the pool resource. Every statistic is zero unless the pool
+   *      resource records them, i.e. unless \p Statistics is \p pool_statistics.
+   */
+  pool_statistics_snapshot statistics() const
+  {
+    return m_statistics.snapshot();
+  }
+
   /*! Releases all held memory to upstream.
    */
   void release()
@@ -240,6 +391,7 @@ public:
         static_cast<char_ptr>(static_cast<void_ptr>(alloc)) - thrust::raw_reference_cast(*alloc).size);
       m_upstream->do_deallocate(
         p, thrust::raw_reference_cast(*alloc).size + sizeof(chunk_descriptor), m_options.alignment);
+      m_statistics.record_upstream_deallocate(thrust::raw_reference_cast(*alloc).size + sizeof(chunk_descriptor));
     }
 
     // deallocate cached oversized/overaligned memory
@@ -252,9 +404,23 @@ public:
 
       void_ptr p = static_cast<void_ptr>(static_cast<char_ptr>(static_cast<void_ptr>(alloc)) - desc.current_size);
       m_upstream->do_deallocate(p, desc.size + sizeof(oversized_block_descriptor), desc.alignment);
+      m_statistics.record_upstream_deallocate(desc.size + sizeof(oversized_block_descriptor));
+    }
+
+    // reset the cached oversized/overaligned lists
+    for (std::size_t i = 0; i < m_cached_oversized.size(); ++i)
+    {
+      thrust::raw_reference_cast(m_cached_oversized[i]) = oversized_block_descriptor_ptr();
+    }
+
+    for (std::size_t i = 0; i < cached_class_count / 64; ++i)
+    {
+      m_cached_classes[i] = 0;
     }
 
-    m_cached_oversized = oversized_block_descriptor_ptr();
+    m_cached_oversized_bytes = 0;
+
+    m_statistics.record_release();
   }
 
   _CCCL_NODISCARD virtual void_ptr
@@ -268,85 +434,47 @@ public:
     {
       if (m_options.cache_oversized)
       {
-        oversized_block_descriptor_ptr ptr       = m_cached_oversized;
-        oversized_block_descriptor_ptr* previous = &m_cached_oversized;
-        while (oversized_block_ptr_traits::get(ptr))
+        oversized_block_descriptor_ptr ptr = take_cached_oversized(bytes, alignment);
+
+        if (oversized_block_ptr_traits::get(ptr))
         {
           oversized_block_descriptor desc = *ptr;
-          bool is_good                    = desc.size >= bytes && desc.alignment >= alignment;
+          desc.next_cached                = oversized_block_descriptor_ptr();
 
-          // if the size is bigger than the requested size by a factor
-          // bigger than or equal to the specified cutoff for size,
-          // allocate a new block
-          if (is_good)
-          {
-            std::size_t size_factor = desc.size / bytes;
-            if (size_factor >= m_options.cached_size_cutoff_factor)
-            {
-              is_good = false;
-            }
-          }
+          auto ret = static_cast<char_ptr>(static_cast<void_ptr>(ptr)) - desc.size;
 
-          // if the alignment is bigger than the requested one by a factor
-          // bigger than or equal to the specified cutoff for alignment,
-          // allocate a new block
-          if (is_good)
+          if (bytes != desc.size)
           {
-            std::size_t alignment_factor = desc.alignment / alignment;
-            if (alignment_factor >= m_options.cached_alignment_cutoff_factor)
-            {
-              is_good = false;
-            }
-          }
+            desc.current_size = bytes;
 
-          if (is_good)
-          {
-            if (previous != &m_cached_oversized)
+            ptr = static_cast<oversized_block_descriptor_ptr>(static_cast<void_ptr>(ret + bytes));
+
+            if (oversized_block_ptr_traits::get(desc.prev))
             {
-              *previous = desc.next_cached;
+              thrust::raw_reference_cast(*desc.prev).next = ptr;
             }
             else
             {
-              m_cached_oversized = desc.next_cached;
+              m_oversized = ptr;
             }
 
-            desc.next_cached = oversized_block_descriptor_ptr();
-
-            auto ret = static_cast<char_ptr>(static_cast<void_ptr>(ptr)) - desc.size;
-
-            if (bytes != desc.size)
+            if (oversized_block_ptr_traits::get(desc.next))
             {
-              desc.current_size = bytes;
-
-              ptr = static_cast<oversized_block_descriptor_ptr>(static_cast<void_ptr>(ret + bytes));
-
-              if (oversized_block_ptr_traits::get(desc.prev))
-              {
-                thrust::raw_reference_cast(*desc.prev).next = ptr;
-              }
-              else
-              {
-                m_oversized = ptr;
-              }
-
-              if (oversized_block_ptr_traits::get(desc.next))
-              {
-                thrust::raw_reference_cast(*desc.next).prev = ptr;
-              }
+              thrust::raw_reference_cast(*desc.next).prev = ptr;
             }
+          }
 
-            *ptr = desc;
+          *ptr = desc;
 
-            return static_cast<void_ptr>(ret);
-          }
+          m_statistics.record_oversized_allocate(bytes, true);
 
-          previous = &thrust::raw_reference_cast(*ptr).next_cached;
-          ptr      = *previous;
+          return static_cast<void_ptr>(ret);
         }
       }
 
       // no fitting cached block found; allocate a new one that's just up to the specs
       void_ptr allocated = m_upstream->do_allocate(bytes + sizeof(oversized_block_descriptor), alignment);
+      m_statistics.record_upstream_allocate(bytes + sizeof(oversized_block_descriptor));
       oversized_block_descriptor_ptr block =
         static_cast<oversized_block_descriptor_ptr>(static_cast<void_ptr>(static_cast<char_ptr>(allocated) + bytes));
 
@@ -367,6 +495,8 @@ public:
         *desc.next                      = next;
       }
 
+      m_statistics.record_oversized_allocate(bytes, false);
+
       return allocated;
     }
 
@@ -380,7 +510,8 @@ public:
 
     // if the free list of the bucket has no elements, allocate a new chunk
     // and split it into blocks pushed to the free list
-    if (!detail::pointer_traits<block_descriptor_ptr>::get(bucket.free_list))
+    bool hit = detail::pointer_traits<block_descriptor_ptr>::get(bucket.free_list) != nullptr;
+    if (!hit)
     {
       std::size_t n = bucket.previous_allocated_count;
       if (n == 0)
@@ -410,6 +541,7 @@ public:
       std::size_t chunk_size = block_size * n;
 
       void_ptr allocated = m_upstream->do_allocate(chunk_size + sizeof(chunk_descriptor), m_options.alignment);
+      m_statistics.record_upstream_allocate(chunk_size + sizeof(chunk_descriptor));
       chunk_descriptor_ptr chunk =
         static_cast<chunk_descriptor_ptr>(static_cast<void_ptr>(static_cast<char_ptr>(allocated) + chunk_size));
 
@@ -434,6 +566,7 @@ public:
     // allocate a block from the front of the bucket's free list
     block_descriptor_ptr block = bucket.free_list;
     bucket.free_list           = thrust::raw_reference_cast(*block).next;
+    m_statistics.record_pooled_allocate(bucket_idx, bytes, hit);
     return static_cast<void_ptr>(static_cast<char_ptr>(static_cast<void_ptr>(block)) - bytes);
   }
 
@@ -455,10 +588,12 @@ public:
       assert(desc.current_size == n);
       assert(desc.alignment == alignment);
 
-      if (m_options.cache_oversized)
-      {
-        desc.next_cached = m_cached_oversized;
+      m_statistics.record_deallocate(n);
 
+      if (m_options.cache_oversized
+          && (m_options.max_cached_oversized_bytes == 0
+              || m_cached_oversized_bytes + desc.size <= m_options.max_cached_oversized_bytes))
+      {
         if (desc.size != n)
         {
           desc.current_size = desc.size;
@@ -479,8 +614,7 @@ public:
           }
         }
 
-        m_cached_oversized = block;
-        *block             = desc;
+        cache_oversized(block, desc);
 
         return;
       }
@@ -500,6 +634,7 @@ public:
       }
 
       m_upstream->do_deallocate(p, desc.size + sizeof(oversized_block_descriptor), desc.alignment);
+      m_statistics.record_upstream_deallocate(desc.size + sizeof(oversized_block_descriptor));
 
       return;
     }
@@ -511,6 +646,8 @@ public:
 
     n = static_cast<std::size_t>(1) << n_log2;
 
+    m_statistics.record_deallocate(n);
+
     block_descriptor_ptr block = static_cast<block_descriptor_ptr>(static_cast<void_ptr>(static_cast<char_ptr>(p) + n));
 
     block_descriptor desc;
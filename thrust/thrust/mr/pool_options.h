@@ -98,6 +98,12 @@ struct pool_options
    */
   std::size_t cached_alignment_cutoff_factor;
 
+  /*! The maximal total size of the oversized and overaligned blocks cached for later use. A block returned to the pool
+   *      resource when caching it would exceed this limit is immediately returned to the upstream resource instead. A
+   *      value of zero means that there is no limit, which is also the default.
+   */
+  std::size_t max_cached_oversized_bytes = 0;
+
   /*! Checks if the options are self-consistent.
    *
    *  /returns true if the options are self-consistent, false otherwise.
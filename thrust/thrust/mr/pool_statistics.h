@@ -0,0 +1,370 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file
+ *  \brief Statistics policies used by the pooling resource adaptors to record their hit rates and upstream traffic.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <thrust/mr/memory_resource.h>
+
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+THRUST_NAMESPACE_BEGIN
+namespace mr
+{
+
+/*! \addtogroup memory_resources Memory Resources
+ *  \ingroup memory_management
+ *  \{
+ */
+
+/*! The number of allocations served by a single size class of a pool resource.
+ */
+struct pool_size_class_statistics
+{
+  /*! The size of the blocks of the size class.
+   */
+  std::size_t block_size;
+  /*! The number of allocations served from blocks already cached by the pool resource.
+   */
+  std::size_t hits;
+  /*! The number of allocations that required allocating memory from the upstream resource.
+   */
+  std::size_t misses;
+};
+
+/*! A snapshot of the statistics recorded by a pool resource, as returned by its \p statistics member function.
+ */
+struct pool_statistics_snapshot
+{
+  /*! The statistics of the pooled size classes, in order of increasing block size.
+   */
+  std::vector<pool_size_class_statistics> size_classes;
+  /*! The number of oversized and overaligned allocations served from cached blocks.
+   */
+  std::size_t oversized_hits;
+  /*! The number of oversized and overaligned allocations that required allocating memory from the upstream resource.
+   */
+  std::size_t oversized_misses;
+
+  /*! The number of allocations from the upstream resource.
+   */
+  std::size_t upstream_allocations;
+  /*! The number of deallocations to the upstream resource.
+   */
+  std::size_t upstream_deallocations;
+  /*! The total number of bytes allocated from the upstream resource.
+   */
+  std::size_t upstream_bytes_allocated;
+  /*! The total number of bytes deallocated to the upstream resource.
+   */
+  std::size_t upstream_bytes_deallocated;
+
+  /*! The number of allocations made for the internal containers of the pool resource. They come from the upstream
+   *      resource of \p unsynchronized_pool_resource and from the bookkeeper of
+   *      \p disjoint_unsynchronized_pool_resource, and are not counted in the \p upstream statistics.
+   */
+  std::size_t bookkeeping_allocations;
+  /*! The number of bytes currently allocated for the internal containers of the pool resource.
+   */
+  std::size_t bookkeeping_bytes;
+  /*! The highest value of \p bookkeeping_bytes so far.
+   */
+  std::size_t bookkeeping_bytes_high_water;
+
+  /*! The number of bytes in blocks currently handed out to the user. Pooled blocks count with the size of their size
+   *      class.
+   */
+  std::size_t bytes_in_use;
+  /*! The number of bytes currently held from the upstream resource but not handed out to the user, which includes the
+   *      space used by the bookkeeping of the pool resource.
+   */
+  std::size_t bytes_cached;
+  /*! The highest value of \p bytes_in_use so far.
+   */
+  std::size_t bytes_in_use_high_water;
+  /*! The highest number of bytes held from the upstream resource at once so far.
+   */
+  std::size_t bytes_held_high_water;
+
+  /*! Writes the snapshot to a stream as a JSON object.
+   *
+   *  \param os the stream to write to
+   */
+  void print_json(std::ostream& os) const
+  {
+    os << "{\"size_classes\":[";
+    for (std::size_t i = 0; i < size_classes.size(); ++i)
+    {
+      os << (i == 0 ? "" : ",") << "{\"block_size\":" << size_classes[i].block_size
+         << ",\"hits\":" << size_classes[i].hits << ",\"misses\":" << size_classes[i].misses << "}";
+    }
+    os << "],\"oversized\":{\"hits\":" << oversized_hits << ",\"misses\":" << oversized_misses << "}";
+    os << ",\"upstream\":{\"allocations\":" << upstream_allocations << ",\"deallocations\":" << upstream_deallocations
+       << ",\"bytes_allocated\":" << upstream_bytes_allocated
+       << ",\"bytes_deallocated\":" << upstream_bytes_deallocated << "}";
+    os << ",\"bookkeeping\":{\"allocations\":" << bookkeeping_allocations << ",\"bytes\":" << bookkeeping_bytes
+       << ",\"bytes_high_water\":" << bookkeeping_bytes_high_water << "}";
+    os << ",\"bytes_in_use\":" << bytes_in_use << ",\"bytes_cached\":" << bytes_cached
+       << ",\"bytes_in_use_high_water\":" << bytes_in_use_high_water
+       << ",\"bytes_held_high_water\":" << bytes_held_high_water << "}";
+  }
+};
+
+/*! The default statistics policy of the pool resources, which records nothing. All of its member functions are empty,
+ *      so that a pool resource using it pays nothing for the statistics hooks.
+ */
+struct no_pool_statistics
+{
+  void record_size_classes(std::size_t, std::size_t) {}
+  void record_pooled_allocate(std::size_t, std::size_t, bool) {}
+  void record_oversized_allocate(std::size_t, bool) {}
+  void record_deallocate(std::size_t) {}
+  void record_upstream_allocate(std::size_t) {}
+  void record_upstream_deallocate(std::size_t) {}
+  void record_bookkeeping_allocate(std::size_t) {}
+  void record_bookkeeping_deallocate(std::size_t) {}
+  void record_release() {}
+
+  /*! Returns a snapshot where every statistic is zero.
+   */
+  pool_statistics_snapshot snapshot() const
+  {
+    return pool_statistics_snapshot();
+  }
+};
+
+/*! A statistics policy for the pool resources which counts hits and misses per size class, the traffic to the upstream
+ *      resource, and the bytes held by the pool resource. Pass it as the \p Statistics template argument of
+ *      \p unsynchronized_pool_resource or \p disjoint_unsynchronized_pool_resource, and call their
+ *      \p statistics member function to obtain a snapshot.
+ */
+class pool_statistics
+{
+public:
+  pool_statistics()
+      : m_snapshot()
+  {}
+
+  /*! Called on construction of the pool resource, with the size of its smallest size class and the number of size
+   *      classes, each of which is twice the size of the previous one.
+   */
+  void record_size_classes(std::size_t smallest_block_size, std::size_t count)
+  {
+    m_snapshot.size_classes.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      m_snapshot.size_classes[i].block_size = smallest_block_size << i;
+    }
+  }
+
+  /*! Called when a block of the size class \p size_class, of \p bytes bytes, is handed out; \p hit tells whether it
+   *      was already cached.
+   */
+  void record_pooled_allocate(std::size_t size_class, std::size_t bytes, bool hit)
+  {
+    ++(hit ? m_snapshot.size_classes[size_class].hits : m_snapshot.size_classes[size_class].misses);
+    record_allocate(bytes);
+  }
+
+  /*! Called when an oversized or overaligned block of \p bytes bytes is handed out; \p hit tells whether it was
+   *      already cached.
+   */
+  void record_oversized_allocate(std::size_t bytes, bool hit)
+  {
+    ++(hit ? m_snapshot.oversized_hits : m_snapshot.oversized_misses);
+    record_allocate(bytes);
+  }
+
+  /*! Called when a block of \p bytes bytes, previously handed out, is returned to the pool resource.
+   */
+  void record_deallocate(std::size_t bytes)
+  {
+    m_snapshot.bytes_in_use -= bytes;
+  }
+
+  /*! Called after \p bytes bytes were allocated from the upstream resource.
+   */
+  void record_upstream_allocate(std::size_t bytes)
+  {
+    ++m_snapshot.upstream_allocations;
+    m_snapshot.upstream_bytes_allocated += bytes;
+
+    std::size_t held = bytes_held();
+    if (held > m_snapshot.bytes_held_high_water)
+    {
+      m_snapshot.bytes_held_high_water = held;
+    }
+  }
+
+  /*! Called after \p bytes bytes were deallocated to the upstream resource.
+   */
+  void record_upstream_deallocate(std::size_t bytes)
+  {
+    ++m_snapshot.upstream_deallocations;
+    m_snapshot.upstream_bytes_deallocated += bytes;
+  }
+
+  /*! Called after \p bytes bytes were allocated for the internal containers of the pool resource.
+   */
+  void record_bookkeeping_allocate(std::size_t bytes)
+  {
+    ++m_snapshot.bookkeeping_allocations;
+    m_snapshot.bookkeeping_bytes += bytes;
+    if (m_snapshot.bookkeeping_bytes > m_snapshot.bookkeeping_bytes_high_water)
+    {
+      m_snapshot.bookkeeping_bytes_high_water = m_snapshot.bookkeeping_bytes;
+    }
+  }
+
+  /*! Called after \p bytes bytes of the internal containers of the pool resource were deallocated.
+   */
+  void record_bookkeeping_deallocate(std::size_t bytes)
+  {
+    m_snapshot.bookkeeping_bytes -= bytes;
+  }
+
+  /*! Called when the pool resource releases all its memory, which also invalidates the blocks handed out.
+   */
+  void record_release()
+  {
+    m_snapshot.bytes_in_use = 0;
+  }
+
+  /*! Returns the statistics recorded so far.
+   */
+  pool_statistics_snapshot snapshot() const
+  {
+    pool_statistics_snapshot ret = m_snapshot;
+    ret.bytes_cached             = bytes_held() - m_snapshot.bytes_in_use;
+    return ret;
+  }
+
+private:
+  void record_allocate(std::size_t bytes)
+  {
+    m_snapshot.bytes_in_use += bytes;
+    if (m_snapshot.bytes_in_use > m_snapshot.bytes_in_use_high_water)
+    {
+      m_snapshot.bytes_in_use_high_water = m_snapshot.bytes_in_use;
+    }
+  }
+
+  std::size_t bytes_held() const
+  {
+    return m_snapshot.upstream_bytes_allocated - m_snapshot.upstream_bytes_deallocated;
+  }
+
+  pool_statistics_snapshot m_snapshot;
+};
+
+/*! \} // memory_resources
+ */
+
+} // namespace mr
+
+namespace detail
+{
+
+// The resource the internal containers of a pool resource allocate from. Forwards to the resource providing their
+// memory and records the allocations in the statistics of the pool resource.
+template <typename Upstream, typename Statistics>
+class pool_bookkeeping_resource final : public mr::memory_resource<typename Upstream::pointer>
+{
+public:
+  using pointer = typename Upstream::pointer;
+
+  pool_bookkeeping_resource(Upstream* upstream, Statistics* statistics)
+      : m_upstream(upstream)
+      , m_statistics(statistics)
+  {}
+
+  _CCCL_NODISCARD pointer do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    pointer ret = m_upstream->do_allocate(bytes, alignment);
+    m_statistics->record_bookkeeping_allocate(bytes);
+    return ret;
+  }
+
+  void do_deallocate(pointer p, std::size_t bytes, std::size_t alignment) override
+  {
+    m_upstream->do_deallocate(p, bytes, alignment);
+    m_statistics->record_bookkeeping_deallocate(bytes);
+  }
+
+private:
+  Upstream* m_upstream;
+  Statistics* m_statistics;
+};
+
+// Selects the resource the internal containers of a pool resource allocate from: the wrapper above when statistics are
+// recorded, and the resource providing their memory otherwise, so that without statistics the containers keep their
+// allocator type and allocate without an additional virtual call.
+template <typename Upstream, typename Statistics>
+class pool_bookkeeping
+{
+public:
+  using resource = pool_bookkeeping_resource<Upstream, Statistics>;
+
+  pool_bookkeeping(Upstream* upstream, Statistics* statistics)
+      : m_resource(upstream, statistics)
+  {}
+
+  resource* get()
+  {
+    return &m_resource;
+  }
+
+private:
+  resource m_resource;
+};
+
+template <typename Upstream>
+class pool_bookkeeping<Upstream, mr::no_pool_statistics>
+{
+public:
+  using resource = Upstream;
+
+  pool_bookkeeping(Upstream* upstream, mr::no_pool_statistics*)
+      : m_upstream(upstream)
+  {}
+
+  resource* get() const
+  {
+    return m_upstream;
+  }
+
+private:
+  Upstream* m_upstream;
+};
+
+} // namespace detail
+
+THRUST_NAMESPACE_END
@@ -0,0 +1,238 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/random/detail/random_core_access.h>
+
+#include <cuda/std/array>
+#include <cuda/std/cstdint>
+
+#include <cstddef> // for size_t
+#include <iostream>
+
+THRUST_NAMESPACE_BEGIN
+
+namespace random
+{
+
+namespace detail
+{
+
+// The state and the generation algorithm shared by the counter-based engines. The state is an n-word counter X,
+// whose first word is the least significant, a key K of k words, the block Y = Derived::generate_block(X - 1, K) of n
+// words and the index i of the last word of Y which was returned. Each word has w bits. Every n values the counter is
+// incremented and a new block is generated, so the value at any position of the sequence is computed without
+// computing the ones preceding it, and discard takes constant time.
+template <typename Derived, typename UIntType, size_t w, size_t n, size_t k>
+class counter_based_engine
+{
+  static_assert(w > 0 && w <= 64 && w <= sizeof(UIntType) * 8, "the word size must fit the result type");
+
+public:
+  using result_type  = UIntType;
+  using counter_type = ::cuda::std::array<UIntType, n>;
+  using key_type     = ::cuda::std::array<UIntType, k>;
+  using block_type   = ::cuda::std::array<UIntType, n>;
+
+  static const size_t word_size = w;
+
+  static const size_t word_count = n;
+
+  static const size_t key_word_count = k;
+
+  static const result_type min = 0;
+
+  static const result_type max = ~result_type(0) >> (sizeof(result_type) * 8 - w);
+
+  static const result_type default_seed = 20111115u;
+
+  _CCCL_HOST_DEVICE explicit counter_based_engine(result_type value = default_seed)
+  {
+    seed(value);
+  }
+
+  _CCCL_HOST_DEVICE void seed(result_type value = default_seed)
+  {
+    key_type key{};
+    key[0] = value;
+    set_key(key);
+  }
+
+  _CCCL_HOST_DEVICE void set_key(const key_type& key)
+  {
+    for (size_t j = 0; j < k; ++j)
+    {
+      m_key[j] = key[j] & max;
+    }
+    set_counter(counter_type{});
+  }
+
+  _CCCL_HOST_DEVICE void set_counter(const counter_type& counter)
+  {
+    // the counter is given with its most significant word first
+    for (size_t j = 0; j < n; ++j)
+    {
+      m_counter[j] = counter[n - 1 - j] & max;
+      m_block[j]   = 0;
+    }
+    m_index = n - 1;
+  }
+
+  _CCCL_HOST_DEVICE result_type operator()(void)
+  {
+    if (++m_index == n)
+    {
+      m_block = Derived::generate_block(m_counter, m_key);
+      increment_counter(1);
+      m_index = 0;
+    }
+    return m_block[m_index];
+  }
+
+  _CCCL_HOST_DEVICE void discard(unsigned long long z)
+  {
+    const unsigned long long left = n - 1 - m_index;
+    if (z <= left)
+    {
+      m_index += static_cast<size_t>(z);
+      return;
+    }
+
+    // skip the blocks which are discarded entirely, and generate the block of the last discarded value
+    z -= left;
+    increment_counter((z - 1) / n);
+    m_block = Derived::generate_block(m_counter, m_key);
+    increment_counter(1);
+    m_index = static_cast<size_t>((z - 1) % n);
+  }
+
+private:
+  counter_type m_counter;
+  key_type m_key;
+  block_type m_block;
+  size_t m_index;
+
+  friend struct thrust::random::detail::random_core_access;
+
+  _CCCL_HOST_DEVICE void increment_counter(unsigned long long z)
+  {
+    for (size_t j = 0; j < n && z != 0; ++j)
+    {
+      if constexpr (w == 64)
+      {
+        const result_type sum = static_cast<result_type>(m_counter[j] + z);
+        z                     = sum < m_counter[j] ? 1 : 0;
+        m_counter[j]          = sum;
+      }
+      else
+      {
+        const ::cuda::std::uint64_t sum = m_counter[j] + (z & max);
+        m_counter[j]                    = static_cast<result_type>(sum & max);
+        z                               = (z >> w) + (sum >> w);
+      }
+    }
+  }
+
+  _CCCL_HOST_DEVICE bool equal(const counter_based_engine& rhs) const
+  {
+    // the rest of the block is a function of the counter and the key
+    return m_counter == rhs.m_counter && m_key == rhs.m_key && m_index == rhs.m_index;
+  }
+
+  template <typename CharT, typename Traits>
+  std::basic_ostream<CharT, Traits>& stream_out(std::basic_ostream<CharT, Traits>& os) const
+  {
+    using ostream_type = std::basic_ostream<CharT, Traits>;
+    using ios_base     = typename ostream_type::ios_base;
+
+    // save old flags & fill character
+    const typename ios_base::fmtflags flags = os.flags();
+    const CharT fill                        = os.fill();
+
+    const CharT space = os.widen(' ');
+    os.flags(ios_base::dec | ios_base::fixed | ios_base::left);
+    os.fill(space);
+
+    // output the counter, the key, the block and the index
+    for (size_t j = 0; j < n; ++j)
+    {
+      os << m_counter[j] << space;
+    }
+    for (size_t j = 0; j < k; ++j)
+    {
+      os << m_key[j] << space;
+    }
+    for (size_t j = 0; j < n; ++j)
+    {
+      os << m_block[j] << space;
+    }
+    os << m_index;
+
+    // restore flags & fill character
+    os.flags(flags);
+    os.fill(fill);
+
+    return os;
+  }
+
+  template <typename CharT, typename Traits>
+  std::basic_istream<CharT, Traits>& stream_in(std::basic_istream<CharT, Traits>& is)
+  {
+    using istream_type = std::basic_istream<CharT, Traits>;
+    using ios_base     = typename istream_type::ios_base;
+
+    // save old flags
+    const typename ios_base::fmtflags flags = is.flags();
+
+    is.flags(ios_base::dec | ios_base::skipws);
+
+    // input the counter, the key, the block and the index
+    for (size_t j = 0; j < n; ++j)
+    {
+      is >> m_counter[j];
+    }
+    for (size_t j = 0; j < k; ++j)
+    {
+      is >> m_key[j];
+    }
+    for (size_t j = 0; j < n; ++j)
+    {
+      is >> m_block[j];
+    }
+    is >> m_index;
+
+    // restore flags
+    is.flags(flags);
+
+    return is;
+  }
+}; // end counter_based_engine
+
+} // namespace detail
+
+} // namespace random
+
+THRUST_NAMESPACE_END
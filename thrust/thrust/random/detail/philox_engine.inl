@@ -0,0 +1,154 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <thrust/random/philox_engine.h>
+
+#include <nv/target>
+
+THRUST_NAMESPACE_BEGIN
+
+namespace random
+{
+
+namespace detail
+{
+
+inline std::uint64_t host_mul64hi(std::uint64_t a, std::uint64_t b)
+{
+#if _CCCL_HAS_INT128()
+  return static_cast<std::uint64_t>((static_cast<__uint128_t>(a) * b) >> 64);
+#else // ^^^ _CCCL_HAS_INT128() ^^^ / vvv !_CCCL_HAS_INT128() vvv
+  // schoolbook multiplication of the 32-bit halves
+  const std::uint64_t a_lo = a & 0xFFFFFFFF, a_hi = a >> 32;
+  const std::uint64_t b_lo = b & 0xFFFFFFFF, b_hi = b >> 32;
+  const std::uint64_t cross = (a_lo * b_lo >> 32) + (a_hi * b_lo & 0xFFFFFFFF) + a_lo * b_hi;
+  return a_hi * b_hi + (a_hi * b_lo >> 32) + (cross >> 32);
+#endif // !_CCCL_HAS_INT128()
+}
+
+} // namespace detail
+
+template <typename UIntType, size_t w, size_t n, size_t r, UIntType... consts>
+_CCCL_HOST_DEVICE void philox_engine<UIntType, w, n, r, consts...>::mulhilo(
+  result_type a, result_type b, result_type& hi, result_type& lo)
+{
+  if constexpr (w <= 32)
+  {
+    const std::uint64_t product = std::uint64_t(a) * std::uint64_t(b);
+    hi                          = static_cast<result_type>(product >> w);
+    lo                          = static_cast<result_type>(product & super_t::max);
+  }
+  else
+  {
+    const std::uint64_t a64 = a;
+    const std::uint64_t b64 = b;
+    lo                      = static_cast<result_type>(a64 * b64);
+
+    NV_IF_TARGET(NV_IS_DEVICE,
+                 (hi = static_cast<result_type>(__umul64hi(a64, b64));),
+                 (hi = static_cast<result_type>(detail::host_mul64hi(a64, b64));))
+  }
+} // end philox_engine::mulhilo()
+
+template <typename UIntType, size_t w, size_t n, size_t r, UIntType... consts>
+_CCCL_HOST_DEVICE typename philox_engine<UIntType, w, n, r, consts...>::block_type
+philox_engine<UIntType, w, n, r, consts...>::generate_block(const counter_type& counter, const key_type& key)
+{
+  block_type x;
+  key_type k;
+  for (size_t j = 0; j < n; ++j)
+  {
+    x[j] = counter[j] & super_t::max;
+  }
+  for (size_t j = 0; j < n / 2; ++j)
+  {
+    k[j] = key[j] & super_t::max;
+  }
+
+  for (size_t round = 0; round < r; ++round)
+  {
+    if (round > 0)
+    {
+      // bump the key
+      for (size_t j = 0; j < n / 2; ++j)
+      {
+        k[j] = (k[j] + constant_at(2 * j + 1)) & super_t::max;
+      }
+    }
+
+    // each pair of words multiplies the first word of another pair; with four words, the first words are swapped
+    block_type v = x;
+    if constexpr (n == 4)
+    {
+      v[0] = x[2];
+      v[2] = x[0];
+    }
+
+    for (size_t j = 0; j < n / 2; ++j)
+    {
+      result_type hi, lo;
+      mulhilo(constant_at(2 * j), v[2 * j], hi, lo);
+      x[2 * j]     = hi ^ k[j] ^ v[2 * j + 1];
+      x[2 * j + 1] = lo;
+    }
+  }
+
+  return x;
+} // end philox_engine::generate_block()
+
+template <typename UIntType, size_t w, size_t n, size_t r, UIntType... consts>
+_CCCL_HOST_DEVICE bool operator==(const philox_engine<UIntType, w, n, r, consts...>& lhs,
+                                  const philox_engine<UIntType, w, n, r, consts...>& rhs)
+{
+  return thrust::random::detail::random_core_access::equal(lhs, rhs);
+}
+
+template <typename UIntType, size_t w, size_t n, size_t r, UIntType... consts>
+_CCCL_HOST_DEVICE bool operator!=(const philox_engine<UIntType, w, n, r, consts...>& lhs,
+                                  const philox_engine<UIntType, w, n, r, consts...>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+template <typename UIntType_, size_t w_, size_t n_, size_t r_, UIntType_... consts_, typename CharT, typename Traits>
+std::basic_ostream<CharT, Traits>&
+operator<<(std::basic_ostream<CharT, Traits>& os, const philox_engine<UIntType_, w_, n_, r_, consts_...>& e)
+{
+  return thrust::random::detail::random_core_access::stream_out(os, e);
+}
+
+template <typename UIntType_, size_t w_, size_t n_, size_t r_, UIntType_... consts_, typename CharT, typename Traits>
+std::basic_istream<CharT, Traits>&
+operator>>(std::basic_istream<CharT, Traits>& is, philox_engine<UIntType_, w_, n_, r_, consts_...>& e)
+{
+  return thrust::random::detail::random_core_access::stream_in(is, e);
+}
+
+} // namespace random
+
+THRUST_NAMESPACE_END
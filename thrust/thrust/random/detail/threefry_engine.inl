@@ -0,0 +1,153 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <thrust/random/threefry_engine.h>
+
+THRUST_NAMESPACE_BEGIN
+
+namespace random
+{
+
+namespace detail
+{
+
+// The rotation amounts of the rounds of Threefry, which repeat every eight rounds, for each pair of words.
+template <size_t w>
+struct threefry_rotations;
+
+template <>
+struct threefry_rotations<32>
+{
+  _CCCL_HOST_DEVICE static unsigned int get(size_t round, size_t pair)
+  {
+    constexpr unsigned char values[8][2] = {{10, 26}, {11, 21}, {13, 27}, {23, 5}, {6, 20}, {17, 11}, {25, 10}, {18, 20}};
+    return values[round % 8][pair];
+  }
+
+  static const std::uint32_t parity = 0x1BD11BDA;
+};
+
+template <>
+struct threefry_rotations<64>
+{
+  _CCCL_HOST_DEVICE static unsigned int get(size_t round, size_t pair)
+  {
+    constexpr unsigned char values[8][2] = {{14, 16}, {52, 57}, {23, 40}, {5, 37}, {25, 33}, {46, 12}, {58, 22}, {32, 32}};
+    return values[round % 8][pair];
+  }
+
+  static const std::uint64_t parity = 0x1BD11BDAA9FC1A22;
+};
+
+} // namespace detail
+
+template <typename UIntType, size_t w, size_t n, size_t r>
+_CCCL_HOST_DEVICE typename threefry_engine<UIntType, w, n, r>::result_type
+threefry_engine<UIntType, w, n, r>::rotl(result_type x, unsigned int s)
+{
+  return static_cast<result_type>(((x << s) | (x >> (w - s))) & super_t::max);
+} // end threefry_engine::rotl()
+
+template <typename UIntType, size_t w, size_t n, size_t r>
+_CCCL_HOST_DEVICE typename threefry_engine<UIntType, w, n, r>::block_type
+threefry_engine<UIntType, w, n, r>::generate_block(const counter_type& counter, const key_type& key)
+{
+  using rotations = detail::threefry_rotations<w>;
+
+  // the key schedule is the key followed by the exclusive or of its words with a parity constant
+  result_type ks[n + 1];
+  ks[n] = static_cast<result_type>(rotations::parity);
+  for (size_t j = 0; j < n; ++j)
+  {
+    ks[j] = key[j] & super_t::max;
+    ks[n] ^= ks[j];
+  }
+
+  block_type x;
+  for (size_t j = 0; j < n; ++j)
+  {
+    x[j] = static_cast<result_type>((counter[j] + ks[j]) & super_t::max);
+  }
+
+  for (size_t round = 0; round < r; ++round)
+  {
+    // mix the words in pairs, which alternate between (0, 1), (2, 3) and (0, 3), (2, 1)
+    const size_t b0 = round % 2 == 0 ? 1 : 3;
+    const size_t b1 = round % 2 == 0 ? 3 : 1;
+
+    x[0]  = static_cast<result_type>((x[0] + x[b0]) & super_t::max);
+    x[b0] = rotl(x[b0], rotations::get(round, 0)) ^ x[0];
+    x[2]  = static_cast<result_type>((x[2] + x[b1]) & super_t::max);
+    x[b1] = rotl(x[b1], rotations::get(round, 1)) ^ x[2];
+
+    // inject the key every four rounds
+    if (round % 4 == 3)
+    {
+      const size_t s = round / 4 + 1;
+      for (size_t j = 0; j < n; ++j)
+      {
+        x[j] = static_cast<result_type>((x[j] + ks[(s + j) % (n + 1)]) & super_t::max);
+      }
+      x[n - 1] = static_cast<result_type>((x[n - 1] + s) & super_t::max);
+    }
+  }
+
+  return x;
+} // end threefry_engine::generate_block()
+
+template <typename UIntType, size_t w, size_t n, size_t r>
+_CCCL_HOST_DEVICE bool
+operator==(const threefry_engine<UIntType, w, n, r>& lhs, const threefry_engine<UIntType, w, n, r>& rhs)
+{
+  return thrust::random::detail::random_core_access::equal(lhs, rhs);
+}
+
+template <typename UIntType, size_t w, size_t n, size_t r>
+_CCCL_HOST_DEVICE bool
+operator!=(const threefry_engine<UIntType, w, n, r>& lhs, const threefry_engine<UIntType, w, n, r>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+template <typename UIntType_, size_t w_, size_t n_, size_t r_, typename CharT, typename Traits>
+std::basic_ostream<CharT, Traits>&
+operator<<(std::basic_ostream<CharT, Traits>& os, const threefry_engine<UIntType_, w_, n_, r_>& e)
+{
+  return thrust::random::detail::random_core_access::stream_out(os, e);
+}
+
+template <typename UIntType_, size_t w_, size_t n_, size_t r_, typename CharT, typename Traits>
+std::basic_istream<CharT, Traits>&
+operator>>(std::basic_istream<CharT, Traits>& is, threefry_engine<UIntType_, w_, n_, r_>& e)
+{
+  return thrust::random::detail::random_core_access::stream_in(is, e);
+}
+
+} // namespace random
+
+THRUST_NAMESPACE_END
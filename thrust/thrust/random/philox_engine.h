@@ -0,0 +1,274 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file philox_engine.h
+ *  \brief A counter-based Philox pseudorandom number generator.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/random/detail/counter_based_engine.h>
+
+#include <cstddef> // for size_t
+#include <cstdint>
+#include <iostream>
+
+THRUST_NAMESPACE_BEGIN
+
+namespace random
+{
+
+/*! \addtogroup random_number_engine_templates
+ *  \{
+ */
+
+/*! \class philox_engine
+ *  \brief A \p philox_engine random number engine produces unsigned integer random values using the counter-based
+ *         Philox algorithm of Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3", SC 2011.
+ *
+ *  The engine applies a bijection, keyed by its seed, to consecutive values of an <tt>n</tt>-word counter, and returns
+ *  the \c n words of each result in turn. The value at any position of the sequence is therefore computed in constant
+ *  time: \p discard does not depend on the number of values discarded, and \p set_counter moves the engine to any
+ *  position. Engines with different keys produce independent streams, which makes it possible to generate the same
+ *  values in parallel regardless of the number of threads, for instance by seeding one engine per stream and
+ *  discarding up to the position of each element. \p generate_block computes a whole block of \c n values from a
+ *  counter and a key without any engine state.
+ *
+ *  This engine follows the \c std::philox_engine of C++26.
+ *
+ *  \tparam UIntType The type of unsigned integer to produce.
+ *  \tparam w The word size of the produced values, either at most 32 or 64.
+ *  \tparam n The number of words of the counter, either 2 or 4.
+ *  \tparam r The number of rounds of the bijection.
+ *  \tparam consts The multiplier and the round constant of each of the <tt>n / 2</tt> pairs of words, alternately.
+ *
+ *  The following code snippet shows examples of use of a \p philox_engine instance:
+ *
+ *  \code
+ *  #include <thrust/random/philox_engine.h>
+ *  #include <iostream>
+ *
+ *  int main()
+ *  {
+ *    // create a philox4x32 object, which is an instance of philox_engine
+ *    thrust::philox4x32 rng1;
+ *
+ *    // output some random values to cout
+ *    std::cout << rng1() << std::endl;
+ *
+ *    // jump to the millionth value of the stream, in constant time
+ *    thrust::philox4x32 rng2;
+ *    rng2.discard(999999);
+ *
+ *    // produce the four values of the block at counter 7 of the stream with key 13
+ *    thrust::philox4x32::block_type block = thrust::philox4x32::generate_block({7}, {13});
+ *
+ *    return 0;
+ *  }
+ *  \endcode
+ */
+template <typename UIntType, size_t w, size_t n, size_t r, UIntType... consts>
+class philox_engine
+    : public thrust::random::detail::counter_based_engine<philox_engine<UIntType, w, n, r, consts...>, UIntType, w, n, n / 2>
+{
+  static_assert(n == 2 || n == 4, "philox_engine supports 2 or 4 words");
+  static_assert(w <= 32 || w == 64, "philox_engine supports words of at most 32 bits or of 64 bits");
+  static_assert(sizeof...(consts) == n, "philox_engine needs a multiplier and a round constant per pair of words");
+
+  using super_t =
+    thrust::random::detail::counter_based_engine<philox_engine<UIntType, w, n, r, consts...>, UIntType, w, n, n / 2>;
+
+public:
+  // types
+
+  /*! \typedef result_type
+   *  \brief The type of the unsigned integer produced by this \p philox_engine.
+   */
+  using result_type = typename super_t::result_type;
+
+  /*! \typedef counter_type
+   *  \brief The type of the counter of this \p philox_engine, \c n words.
+   */
+  using counter_type = typename super_t::counter_type;
+
+  /*! \typedef key_type
+   *  \brief The type of the key of this \p philox_engine, <tt>n / 2</tt> words.
+   */
+  using key_type = typename super_t::key_type;
+
+  /*! \typedef block_type
+   *  \brief The type of the \c n values produced for each value of the counter.
+   */
+  using block_type = typename super_t::block_type;
+
+  // engine characteristics
+
+  /*! The number of rounds of the bijection.
+   */
+  static const size_t round_count = r;
+
+  // constructors and seeding functions
+
+  /*! This constructor, which optionally accepts a seed, initializes a new \p philox_engine. The seed is the first word
+   *  of the key, and the counter starts at zero.
+   *
+   *  \param value The seed used to initialize this \p philox_engine's state.
+   */
+  _CCCL_HOST_DEVICE explicit philox_engine(result_type value = super_t::default_seed)
+      : super_t(value)
+  {}
+
+  /*! This method sets the key of this \p philox_engine to <tt>{value, 0, ...}</tt> and its counter to zero.
+   *
+   *  \param value The seed used to initialize this \p philox_engine's state.
+   */
+  using super_t::seed;
+
+  /*! This method sets the key of this \p philox_engine, which selects one of its independent streams, and sets its
+   *  counter to zero.
+   */
+  using super_t::set_key;
+
+  /*! This method moves this \p philox_engine to the first value of the block of a given counter, whose most
+   *  significant word comes first.
+   */
+  using super_t::set_counter;
+
+  /*! This member function produces a new random value and updates this \p philox_engine's state.
+   */
+  using super_t::operator();
+
+  /*! This member function advances this \p philox_engine's state a given number of times and discards the results,
+   *  in constant time.
+   */
+  using super_t::discard;
+
+  /*! This function computes the \c n values of the block at a given counter of the stream with a given key, which
+   *  are the values a \p philox_engine with this key produces after <tt>set_counter</tt> with this counter. Unlike
+   *  \p set_counter, it takes the counter with its least significant word first, so that a single-word initializer
+   *  such as <tt>{i}</tt> denotes the counter \c i.
+   *
+   *  \param counter The counter, least significant word first.
+   *  \param key The key.
+   *  \return The block of values.
+   */
+  _CCCL_HOST_DEVICE static block_type generate_block(const counter_type& counter, const key_type& key);
+
+  /*! \cond
+   */
+
+private:
+  _CCCL_HOST_DEVICE static constexpr result_type constant_at(size_t i)
+  {
+    constexpr result_type values[] = {consts...};
+    return values[i];
+  }
+
+  _CCCL_HOST_DEVICE static void mulhilo(result_type a, result_type b, result_type& hi, result_type& lo);
+
+  /*! \endcond
+   */
+}; // end philox_engine
+
+/*! This function checks two \p philox_engines for equality.
+ *  \param lhs The first \p philox_engine to test.
+ *  \param rhs The second \p philox_engine to test.
+ *  \return \c true if \p lhs is equal to \p rhs; \c false, otherwise.
+ */
+template <typename UIntType_, size_t w_, size_t n_, size_t r_, UIntType_... consts_>
+_CCCL_HOST_DEVICE bool operator==(const philox_engine<UIntType_, w_, n_, r_, consts_...>& lhs,
+                                  const philox_engine<UIntType_, w_, n_, r_, consts_...>& rhs);
+
+/*! This function checks two \p philox_engines for inequality.
+ *  \param lhs The first \p philox_engine to test.
+ *  \param rhs The second \p philox_engine to test.
+ *  \return \c true if \p lhs is not equal to \p rhs; \c false, otherwise.
+ */
+template <typename UIntType_, size_t w_, size_t n_, size_t r_, UIntType_... consts_>
+_CCCL_HOST_DEVICE bool operator!=(const philox_engine<UIntType_, w_, n_, r_, consts_...>& lhs,
+                                  const philox_engine<UIntType_, w_, n_, r_, consts_...>& rhs);
+
+/*! This function streams a philox_engine to a \p std::basic_ostream.
+ *  \param os The \p basic_ostream to stream out to.
+ *  \param e The \p philox_engine to stream out.
+ *  \return \p os
+ */
+template <typename UIntType_, size_t w_, size_t n_, size_t r_, UIntType_... consts_, typename CharT, typename Traits>
+std::basic_ostream<CharT, Traits>&
+operator<<(std::basic_ostream<CharT, Traits>& os, const philox_engine<UIntType_, w_, n_, r_, consts_...>& e);
+
+/*! This function streams a philox_engine in from a std::basic_istream.
+ *  \param is The \p basic_istream to stream from.
+ *  \param e The \p philox_engine to stream in.
+ *  \return \p is
+ */
+template <typename UIntType_, size_t w_, size_t n_, size_t r_, UIntType_... consts_, typename CharT, typename Traits>
+std::basic_istream<CharT, Traits>&
+operator>>(std::basic_istream<CharT, Traits>& is, philox_engine<UIntType_, w_, n_, r_, consts_...>& e);
+
+/*! \} // end random_number_engine_templates
+ */
+
+/*! \addtogroup predefined_random
+ *  \{
+ */
+
+/*! \typedef philox4x32
+ *  \brief A random number engine with predefined parameters which implements the Philox4x32-10 algorithm, which
+ *         produces four 32-bit values per counter.
+ *  \note The 10000th consecutive invocation of a default-constructed object of type \p philox4x32
+ *        shall produce the value \c 1955073260 .
+ */
+using philox4x32 = philox_engine<std::uint32_t, 32, 4, 10, 0xCD9E8D57, 0x9E3779B9, 0xD2511F53, 0xBB67AE85>;
+
+/*! \typedef philox4x64
+ *  \brief A random number engine with predefined parameters which implements the Philox4x64-10 algorithm, which
+ *         produces four 64-bit values per counter.
+ *  \note The 10000th consecutive invocation of a default-constructed object of type \p philox4x64
+ *        shall produce the value \c 3409172418970261260 .
+ */
+using philox4x64 =
+  philox_engine<std::uint64_t,
+                64,
+                4,
+                10,
+                0xCA5A826395121157,
+                0x9E3779B97F4A7C15,
+                0xD2E7470EE14C6C93,
+                0xBB67AE8584CAA73B>;
+
+/*! \} // predefined_random
+ */
+
+} // namespace random
+
+// import names into thrust::
+using random::philox4x32;
+using random::philox4x64;
+using random::philox_engine;
+
+THRUST_NAMESPACE_END
+
+#include <thrust/random/detail/philox_engine.inl>
@@ -0,0 +1,252 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file threefry_engine.h
+ *  \brief A counter-based Threefry pseudorandom number generator.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/random/detail/counter_based_engine.h>
+
+#include <cstddef> // for size_t
+#include <cstdint>
+#include <iostream>
+
+THRUST_NAMESPACE_BEGIN
+
+namespace random
+{
+
+/*! \addtogroup random_number_engine_templates
+ *  \{
+ */
+
+/*! \class threefry_engine
+ *  \brief A \p threefry_engine random number engine produces unsigned integer random values using the counter-based
+ *         Threefry algorithm of Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3", SC 2011, a reduced
+ *         version of the Threefish block cipher.
+ *
+ *  Like \p philox_engine, the engine applies a bijection, keyed by its seed, to consecutive values of a counter of four
+ *  words, and returns the four words of each result in turn, so that \p discard and \p set_counter take constant time
+ *  and engines with different keys produce independent streams. Threefry only uses additions, rotations and
+ *  exclusive ors, which makes it faster than Philox on processors with slow wide multiplications. Its key has four
+ *  words.
+ *
+ *  \tparam UIntType The type of unsigned integer to produce.
+ *  \tparam w The word size of the produced values, either 32 or 64.
+ *  \tparam n The number of words of the counter, which must be 4.
+ *  \tparam r The number of rounds of the bijection, a multiple of 4 of at most 72.
+ *
+ *  The following code snippet shows examples of use of a \p threefry_engine instance:
+ *
+ *  \code
+ *  #include <thrust/random/threefry_engine.h>
+ *  #include <iostream>
+ *
+ *  int main()
+ *  {
+ *    // create a threefry4x64 object, which is an instance of threefry_engine
+ *    thrust::threefry4x64 rng;
+ *
+ *    // select the stream with key {1, 2, 3, 4}, and jump to its millionth value
+ *    rng.set_key({1, 2, 3, 4});
+ *    rng.discard(999999);
+ *
+ *    // output some random values to cout
+ *    std::cout << rng() << std::endl;
+ *
+ *    return 0;
+ *  }
+ *  \endcode
+ */
+template <typename UIntType, size_t w, size_t n, size_t r>
+class threefry_engine
+    : public thrust::random::detail::counter_based_engine<threefry_engine<UIntType, w, n, r>, UIntType, w, n, n>
+{
+  static_assert(n == 4, "threefry_engine supports 4 words");
+  static_assert(w == 32 || w == 64, "threefry_engine supports words of 32 or 64 bits");
+  static_assert(r % 4 == 0 && r <= 72, "threefry_engine supports a multiple of 4 rounds, at most 72");
+
+  using super_t = thrust::random::detail::counter_based_engine<threefry_engine<UIntType, w, n, r>, UIntType, w, n, n>;
+
+public:
+  // types
+
+  /*! \typedef result_type
+   *  \brief The type of the unsigned integer produced by this \p threefry_engine.
+   */
+  using result_type = typename super_t::result_type;
+
+  /*! \typedef counter_type
+   *  \brief The type of the counter of this \p threefry_engine, \c n words.
+   */
+  using counter_type = typename super_t::counter_type;
+
+  /*! \typedef key_type
+   *  \brief The type of the key of this \p threefry_engine, \c n words.
+   */
+  using key_type = typename super_t::key_type;
+
+  /*! \typedef block_type
+   *  \brief The type of the \c n values produced for each value of the counter.
+   */
+  using block_type = typename super_t::block_type;
+
+  // engine characteristics
+
+  /*! The number of rounds of the bijection.
+   */
+  static const size_t round_count = r;
+
+  // constructors and seeding functions
+
+  /*! This constructor, which optionally accepts a seed, initializes a new \p threefry_engine. The seed is the first
+   *  word of the key, and the counter starts at zero.
+   *
+   *  \param value The seed used to initialize this \p threefry_engine's state.
+   */
+  _CCCL_HOST_DEVICE explicit threefry_engine(result_type value = super_t::default_seed)
+      : super_t(value)
+  {}
+
+  /*! This method sets the key of this \p threefry_engine to <tt>{value, 0, ...}</tt> and its counter to zero.
+   *
+   *  \param value The seed used to initialize this \p threefry_engine's state.
+   */
+  using super_t::seed;
+
+  /*! This method sets the key of this \p threefry_engine, which selects one of its independent streams, and sets its
+   *  counter to zero.
+   */
+  using super_t::set_key;
+
+  /*! This method moves this \p threefry_engine to the first value of the block of a given counter, whose most
+   *  significant word comes first.
+   */
+  using super_t::set_counter;
+
+  /*! This member function produces a new random value and updates this \p threefry_engine's state.
+   */
+  using super_t::operator();
+
+  /*! This member function advances this \p threefry_engine's state a given number of times and discards the
+   *  results, in constant time.
+   */
+  using super_t::discard;
+
+  /*! This function computes the \c n values of the block at a given counter of the stream with a given key, which
+   *  are the values a \p threefry_engine with this key produces after <tt>set_counter</tt> with this counter. Unlike
+   *  \p set_counter, it takes the counter with its least significant word first, so that a single-word initializer
+   *  such as <tt>{i}</tt> denotes the counter \c i.
+   *
+   *  \param counter The counter, least significant word first.
+   *  \param key The key.
+   *  \return The block of values.
+   */
+  _CCCL_HOST_DEVICE static block_type generate_block(const counter_type& counter, const key_type& key);
+
+  /*! \cond
+   */
+
+private:
+  _CCCL_HOST_DEVICE static result_type rotl(result_type x, unsigned int s);
+
+  /*! \endcond
+   */
+}; // end threefry_engine
+
+/*! This function checks two \p threefry_engines for equality.
+ *  \param lhs The first \p threefry_engine to test.
+ *  \param rhs The second \p threefry_engine to test.
+ *  \return \c true if \p lhs is equal to \p rhs; \c false, otherwise.
+ */
+template <typename UIntType_, size_t w_, size_t n_, size_t r_>
+_CCCL_HOST_DEVICE bool operator==(const threefry_engine<UIntType_, w_, n_, r_>& lhs,
+                                  const threefry_engine<UIntType_, w_, n_, r_>& rhs);
+
+/*! This function checks two \p threefry_engines for inequality.
+ *  \param lhs The first \p threefry_engine to test.
+ *  \param rhs The second \p threefry_engine to test.
+ *  \return \c true if \p lhs is not equal to \p rhs; \c false, otherwise.
+ */
+template <typename UIntType_, size_t w_, size_t n_, size_t r_>
+_CCCL_HOST_DEVICE bool operator!=(const threefry_engine<UIntType_, w_, n_, r_>& lhs,
+                                  const threefry_engine<UIntType_, w_, n_, r_>& rhs);
+
+/*! This function streams a threefry_engine to a \p std::basic_ostream.
+ *  \param os The \p basic_ostream to stream out to.
+ *  \param e The \p threefry_engine to stream out.
+ *  \return \p os
+ */
+template <typename UIntType_, size_t w_, size_t n_, size_t r_, typename CharT, typename Traits>
+std::basic_ostream<CharT, Traits>&
+operator<<(std::basic_ostream<CharT, Traits>& os, const threefry_engine<UIntType_, w_, n_, r_>& e);
+
+/*! This function streams a threefry_engine in from a std::basic_istream.
+ *  \param is The \p basic_istream to stream from.
+ *  \param e The \p threefry_engine to stream in.
+ *  \return \p is
+ */
+template <typename UIntType_, size_t w_, size_t n_, size_t r_, typename CharT, typename Traits>
+std::basic_istream<CharT, Traits>&
+operator>>(std::basic_istream<CharT, Traits>& is, threefry_engine<UIntType_, w_, n_, r_>& e);
+
+/*! \} // end random_number_engine_templates
+ */
+
+/*! \addtogroup predefined_random
+ *  \{
+ */
+
+/*! \typedef threefry4x32
+ *  \brief A random number engine with predefined parameters which implements the Threefry4x32-20 algorithm, which
+ *         produces four 32-bit values per counter.
+ *  \note The 10000th consecutive invocation of a default-constructed object of type \p threefry4x32
+ *        shall produce the value \c 112810865 .
+ */
+using threefry4x32 = threefry_engine<std::uint32_t, 32, 4, 20>;
+
+/*! \typedef threefry4x64
+ *  \brief A random number engine with predefined parameters which implements the Threefry4x64-20 algorithm, which
+ *         produces four 64-bit values per counter.
+ *  \note The 10000th consecutive invocation of a default-constructed object of type \p threefry4x64
+ *        shall produce the value \c 9253438642465275567 .
+ */
+using threefry4x64 = threefry_engine<std::uint64_t, 64, 4, 20>;
+
+/*! \} // predefined_random
+ */
+
+} // namespace random
+
+// import names into thrust::
+using random::threefry4x32;
+using random::threefry4x64;
+using random::threefry_engine;
+
+THRUST_NAMESPACE_END
+
+#include <thrust/random/detail/threefry_engine.inl>
@@ -0,0 +1,117 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file find_if.h
+ *  \brief A search for the first element satisfying a predicate shared by the workers of the host parallel backends.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/function.h>
+#include <thrust/iterator/iterator_traits.h>
+
+#include <cuda/std/__algorithm/max.h>
+#include <cuda/std/__algorithm/min.h>
+
+#include <atomic>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+// Finds the first element of [first, first + n) satisfying pred, cooperatively among any number of workers which all
+// call operator(). The workers claim blocks of the range in increasing order from a shared counter and lower the shared
+// position of the best match they find; blocks past that position are never claimed, so the search ends shortly after
+// the first match has been found instead of scanning the whole range.
+template <typename RandomAccessIterator, typename Predicate>
+class cooperative_find_if
+{
+public:
+  using difference_type = thrust::detail::it_difference_t<RandomAccessIterator>;
+
+  // a block is about 16 KiB of input, large enough to make claiming it cheap, small enough to exit early
+  static constexpr difference_type block_size = ::cuda::std::max<difference_type>(
+    256, (1 << 14) / sizeof(thrust::detail::it_value_t<RandomAccessIterator>));
+
+  cooperative_find_if(RandomAccessIterator first, difference_type n, Predicate pred)
+      : m_first(first)
+      , m_n(n)
+      , m_pred{pred}
+      , m_next_block(0)
+      , m_found(n)
+  {}
+
+  difference_type num_blocks() const
+  {
+    return (m_n + block_size - 1) / block_size;
+  }
+
+  void operator()()
+  {
+    for (;;)
+    {
+      const difference_type begin = m_next_block.fetch_add(block_size, std::memory_order_relaxed);
+      if (begin >= m_n || begin >= m_found.load(std::memory_order_relaxed))
+      {
+        return;
+      }
+
+      const difference_type end = ::cuda::std::min(begin + block_size, m_n);
+      for (difference_type i = begin; i < end; ++i)
+      {
+        if (m_pred(m_first[i]))
+        {
+          // every block claimed from now on starts past i
+          difference_type found = m_found.load(std::memory_order_relaxed);
+          while (i < found && !m_found.compare_exchange_weak(found, i, std::memory_order_relaxed))
+            ;
+          return;
+        }
+      }
+    }
+  }
+
+  // the position of the first element satisfying pred, or n if there is none; valid once all workers have returned
+  difference_type result() const
+  {
+    return m_found.load(std::memory_order_relaxed);
+  }
+
+private:
+  RandomAccessIterator m_first;
+  difference_type m_n;
+  thrust::detail::wrapped_function<Predicate, bool> m_pred;
+  std::atomic<difference_type> m_next_block;
+  std::atomic<difference_type> m_found;
+};
+
+} // namespace internal
+} // namespace detail
+} // namespace system
+THRUST_NAMESPACE_END
@@ -0,0 +1,97 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file first_touch_resource.h
+ *  \brief A memory resource whose pages are first touched by the workers of a host parallel backend.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/mr/memory_resource.h>
+#include <thrust/mr/mmap.h>
+
+#include <cstddef>
+#include <new>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+// Allocates memory that no thread has touched yet, and has its pages touched by the workers of a parallel backend
+// before handing it out. Operating systems place a page on the NUMA node of the thread which touches it first, so the
+// pages end up on the nodes of the workers which later process them, instead of all on the node of the allocating
+// thread. PageToucher::touch(p, bytes, page_size) writes to every page of [p, p + bytes), splitting the range among
+// the workers the same way the algorithms of the backend split their input.
+//
+// On POSIX systems the memory comes from an mmap_memory_resource, which also advises the kernel to back large
+// allocations with transparent huge pages when TransparentHugePages is true. Elsewhere it comes from operator new,
+// whose large allocations are not touched either.
+template <typename PageToucher, bool TransparentHugePages = false>
+class first_touch_resource final : public thrust::mr::memory_resource<>
+{
+public:
+  first_touch_resource()
+#if !_CCCL_OS(WINDOWS)
+      : m_upstream(TransparentHugePages ? thrust::mr::huge_page_mode::transparent : thrust::mr::huge_page_mode::none)
+#endif // !_CCCL_OS(WINDOWS)
+  {}
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+  {
+#if !_CCCL_OS(WINDOWS)
+    void* p = m_upstream.do_allocate(bytes, alignment);
+    // The kernel may back a mapping advised for huge pages with regular pages, in part or entirely, so every regular
+    // page is touched. The touches past the first one of a huge page which is granted cost no page fault.
+    PageToucher::touch(static_cast<char*>(p), bytes, thrust::mr::mmap_memory_resource::page_size());
+#else // ^^^ !_CCCL_OS(WINDOWS) ^^^ / vvv _CCCL_OS(WINDOWS) vvv
+    void* p = ::operator new(bytes, std::align_val_t(alignment));
+    PageToucher::touch(static_cast<char*>(p), bytes, std::size_t(4096));
+#endif // _CCCL_OS(WINDOWS)
+    return p;
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+  {
+#if !_CCCL_OS(WINDOWS)
+    m_upstream.do_deallocate(p, bytes, alignment);
+#else // ^^^ !_CCCL_OS(WINDOWS) ^^^ / vvv _CCCL_OS(WINDOWS) vvv
+    ::operator delete(p, std::align_val_t(alignment));
+#endif // _CCCL_OS(WINDOWS)
+  }
+
+private:
+#if !_CCCL_OS(WINDOWS)
+  thrust::mr::mmap_memory_resource m_upstream;
+#endif // !_CCCL_OS(WINDOWS)
+};
+
+} // namespace internal
+} // namespace detail
+} // namespace system
+THRUST_NAMESPACE_END
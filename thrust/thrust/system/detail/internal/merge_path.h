@@ -0,0 +1,124 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file merge_path.h
+ *  \brief Partitioning of merges and set operations on two sorted ranges into independent pieces.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/binary_search.h>
+#include <thrust/detail/seq.h>
+#include <thrust/pair.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+// Returns the number of elements of [first1, first1 + n1) which appear among the first diag elements of
+// the stable merge of [first1, first1 + n1) with [first2, first2 + n2). The remaining diag - result elements
+// come from [first2, first2 + n2). Merging the pieces between consecutive diagonals independently reproduces
+// the full merge, so a merge may be split into equally sized pieces for parallel execution.
+template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename Size, typename Compare>
+Size merge_path(RandomAccessIterator1 first1, Size n1, RandomAccessIterator2 first2, Size n2, Size diag, Compare comp)
+{
+  Size lo = diag > n2 ? diag - n2 : Size(0);
+  Size hi = diag < n1 ? diag : n1;
+
+  // find the first element of [first1, first1 + n1) which follows the element of
+  // [first2, first2 + n2) on the same diagonal; ties are taken from the first range
+  while (lo < hi)
+  {
+    const Size mid = lo + (hi - lo) / 2;
+
+    if (comp(first2[diag - 1 - mid], first1[mid]))
+    {
+      hi = mid;
+    }
+    else
+    {
+      lo = mid + 1;
+    }
+  }
+
+  return lo;
+}
+
+// Returns the positions (i, j) in [first1, first1 + n1) and [first2, first2 + n2) at which a set operation on
+// the two ranges may be split near diagonal diag: the prefixes ending at i and j and the remaining suffixes can be
+// processed independently. The merge path position is adjusted so that the k-th copy of an equivalent element in
+// the first range always lands on the same side as the k-th copy in the second range, which is the element it is
+// matched with by the sequential set operations. i + j is either diag or diag - 1.
+template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename Size, typename Compare>
+thrust::pair<Size, Size>
+balanced_path(RandomAccessIterator1 first1, Size n1, RandomAccessIterator2 first2, Size n2, Size diag, Compare comp)
+{
+  const Size i = merge_path(first1, n1, first2, n2, diag, comp);
+  const Size j = diag - i;
+
+  if (i == n1 && j == n2)
+  {
+    return thrust::make_pair(i, j);
+  }
+
+  // only the run of elements equivalent to the next element of the merge may straddle the diagonal
+  auto split_run = [&](const auto& x) {
+    const Size start1 = thrust::lower_bound(thrust::seq, first1, first1 + i, x, comp) - first1;
+    const Size start2 = thrust::lower_bound(thrust::seq, first2, first2 + j, x, comp) - first2;
+    const Size count1 = thrust::upper_bound(thrust::seq, first1 + i, first1 + n1, x, comp) - first1 - start1;
+    const Size count2 = thrust::upper_bound(thrust::seq, first2 + j, first2 + n2, x, comp) - first2 - start2;
+
+    // the number of elements of the run preceding the diagonal and the number of matched pairs in the run
+    const Size taken   = (i - start1) + (j - start2);
+    const Size matched = count1 < count2 ? count1 : count2;
+
+    if (taken <= 2 * matched)
+    {
+      return thrust::make_pair(start1 + taken / 2, start2 + taken / 2);
+    }
+    else if (count1 > count2)
+    {
+      return thrust::make_pair(start1 + taken - matched, start2 + matched);
+    }
+
+    return thrust::make_pair(start1 + matched, start2 + taken - matched);
+  };
+
+  if (j < n2 && (i == n1 || comp(first2[j], first1[i])))
+  {
+    return split_run(first2[j]);
+  }
+
+  return split_run(first1[i]);
+}
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
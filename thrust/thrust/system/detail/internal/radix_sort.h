@@ -0,0 +1,232 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file radix_sort.h
+ *  \brief Building blocks of a tiled, stable LSD radix sort for the parallel host backends.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/functional.h>
+#include <thrust/tuple.h>
+
+#include <cuda/std/__bit/bit_cast.h>
+#include <cuda/std/__type_traits/conjunction.h>
+#include <cuda/std/__type_traits/disjunction.h>
+#include <cuda/std/__type_traits/is_integral.h>
+#include <cuda/std/__type_traits/is_same.h>
+#include <cuda/std/__type_traits/is_signed.h>
+#include <cuda/std/__type_traits/make_unsigned.h>
+
+#include <cstddef>
+#include <cstdint>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+namespace radix_sort_detail
+{
+
+// maps a key to an unsigned integer of the same size which orders the same way
+template <typename KeyType>
+struct radix_bits
+{
+  using type = ::cuda::std::make_unsigned_t<KeyType>;
+
+  static type encode(KeyType key)
+  {
+    const type x = static_cast<type>(key);
+
+    // flip the sign bit so that negative keys precede positive keys
+    return ::cuda::std::is_signed<KeyType>::value ? static_cast<type>(x ^ (type(1) << (8 * sizeof(type) - 1))) : x;
+  }
+};
+
+template <>
+struct radix_bits<bool>
+{
+  using type = unsigned char;
+
+  static type encode(bool key)
+  {
+    return static_cast<type>(key);
+  }
+};
+
+template <>
+struct radix_bits<float>
+{
+  using type = std::uint32_t;
+
+  static type encode(float key)
+  {
+    // -0.0 and +0.0 compare equal and must not be reordered
+    const type x = ::cuda::std::bit_cast<type>(key == float(0) ? float(0) : key);
+
+    // flip every bit of negative keys and only the sign bit of positive keys
+    const type mask = (x >> 31) ? ~type(0) : (type(1) << 31);
+    return x ^ mask;
+  }
+};
+
+template <>
+struct radix_bits<double>
+{
+  using type = std::uint64_t;
+
+  static type encode(double key)
+  {
+    // -0.0 and +0.0 compare equal and must not be reordered
+    const type x = ::cuda::std::bit_cast<type>(key == double(0) ? double(0) : key);
+
+    // flip every bit of negative keys and only the sign bit of positive keys
+    const type mask = (x >> 63) ? ~type(0) : (type(1) << 63);
+    return x ^ mask;
+  }
+};
+
+} // namespace radix_sort_detail
+
+// every pass of the radix sort distributes the keys among 2^8 buckets
+constexpr unsigned int radix_digit_bits  = 8;
+constexpr unsigned int radix_num_buckets = 1u << radix_digit_bits;
+
+// Inputs shorter than this are not worth the passes of the radix sort over the elements and their buffer, and keep
+// using the comparison sort of the backend.
+// XXX this value is a tuning opportunity
+constexpr std::ptrdiff_t radix_sort_threshold = 128 * 1024;
+
+// the radix sort is used in place of a comparison sort for keys of primitive type ordered by less or greater
+template <typename KeyType, typename Compare>
+struct use_radix_sort
+    : ::cuda::std::_And<::cuda::std::disjunction<::cuda::std::is_integral<KeyType>,
+                                                 ::cuda::std::is_same<KeyType, float>,
+                                                 ::cuda::std::is_same<KeyType, double>>,
+                        ::cuda::std::disjunction<::cuda::std::is_same<Compare, thrust::less<KeyType>>,
+                                                 ::cuda::std::is_same<Compare, thrust::greater<KeyType>>>>
+{};
+
+// Extracts the digit of a key examined by a pass of the radix sort, starting from the least significant one.
+// Descending orders are obtained by complementing the encoded keys, which keeps the sort stable.
+template <typename KeyType, bool Descending>
+struct radix_digit
+{
+  using bits_type = typename radix_sort_detail::radix_bits<KeyType>::type;
+
+  static constexpr unsigned int num_passes = (8 * sizeof(bits_type)) / radix_digit_bits;
+
+  unsigned int operator()(KeyType key, unsigned int pass) const
+  {
+    bits_type x = radix_sort_detail::radix_bits<KeyType>::encode(key);
+
+    if (Descending)
+    {
+      x = static_cast<bits_type>(~x);
+    }
+
+    return static_cast<unsigned int>((x >> (radix_digit_bits * pass)) & (radix_num_buckets - 1));
+  }
+};
+
+// extracts the digit of the key of a (key, value) tuple, for sorting keys and values together through a zip_iterator
+template <typename Digit>
+struct radix_digit_of_key
+{
+  static constexpr unsigned int num_passes = Digit::num_passes;
+
+  Digit digit;
+
+  template <typename Tuple>
+  unsigned int operator()(const Tuple& key_value, unsigned int pass) const
+  {
+    return digit(thrust::get<0>(key_value), pass);
+  }
+};
+
+// counts the elements of [first, first + n) falling into each bucket during the given pass
+template <typename Digit, typename RandomAccessIterator, typename Size>
+void radix_histogram(Digit digit, RandomAccessIterator first, Size n, unsigned int pass, std::size_t* counts)
+{
+  for (unsigned int bucket = 0; bucket < radix_num_buckets; ++bucket)
+  {
+    counts[bucket] = 0;
+  }
+
+  for (Size i = 0; i < n; ++i)
+  {
+    ++counts[digit(first[i], pass)];
+  }
+}
+
+// Replaces the bucket counts of every tile (radix_num_buckets consecutive counts per tile) with the position at
+// which the tile writes the first of its elements falling into each bucket. Tiles write their elements of a bucket
+// one after the other, which keeps the sort stable. Returns false when all n elements fall into the same bucket: the
+// pass would not move any of them and may be skipped.
+template <typename Size>
+bool radix_offsets(std::size_t* counts, Size num_tiles, std::size_t n)
+{
+  std::size_t sum = 0;
+
+  for (unsigned int bucket = 0; bucket < radix_num_buckets; ++bucket)
+  {
+    const std::size_t bucket_begin = sum;
+
+    for (Size tile = 0; tile < num_tiles; ++tile)
+    {
+      const std::size_t count = counts[tile * radix_num_buckets + bucket];
+
+      counts[tile * radix_num_buckets + bucket] = sum;
+
+      sum += count;
+    }
+
+    if (sum - bucket_begin == n)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// moves the elements of [first, first + n) to their place in result during the given pass, in order
+template <typename Digit, typename RandomAccessIterator1, typename Size, typename RandomAccessIterator2>
+void radix_scatter(
+  Digit digit, RandomAccessIterator1 first, Size n, unsigned int pass, std::size_t* offsets, RandomAccessIterator2 result)
+{
+  for (Size i = 0; i < n; ++i)
+  {
+    result[offsets[digit(first[i], pass)]++] = first[i];
+  }
+}
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
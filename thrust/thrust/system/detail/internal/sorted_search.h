@@ -0,0 +1,173 @@
+/*
+ *  Copyright 2024 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file sorted_search.h
+ *  \brief Vectorized binary searches of sorted values, co-iterating over the searched range and the values.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/function.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/detail/generic/binary_search.h>
+
+#include <cuda/std/__functional/invoke.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+// How each vectorized search function of generic::detail locates a value: the position it looks for is the first
+// one whose element is not before the value, and its result is computed from that position.
+template <typename BinarySearchFunction>
+struct sorted_search_traits;
+
+template <>
+struct sorted_search_traits<thrust::system::detail::generic::detail::lbf>
+{
+  template <typename Compare, typename T1, typename T2>
+  static bool before(Compare& comp, const T1& element, const T2& value)
+  {
+    return comp(element, value);
+  }
+
+  template <typename RandomAccessIterator, typename Size, typename T, typename Compare>
+  static Size result(RandomAccessIterator, Size, Size position, const T&, Compare&)
+  {
+    return position;
+  }
+};
+
+template <>
+struct sorted_search_traits<thrust::system::detail::generic::detail::ubf>
+{
+  template <typename Compare, typename T1, typename T2>
+  static bool before(Compare& comp, const T1& element, const T2& value)
+  {
+    return !comp(value, element);
+  }
+
+  template <typename RandomAccessIterator, typename Size, typename T, typename Compare>
+  static Size result(RandomAccessIterator, Size, Size position, const T&, Compare&)
+  {
+    return position;
+  }
+};
+
+template <>
+struct sorted_search_traits<thrust::system::detail::generic::detail::bsf>
+{
+  template <typename Compare, typename T1, typename T2>
+  static bool before(Compare& comp, const T1& element, const T2& value)
+  {
+    return comp(element, value);
+  }
+
+  template <typename RandomAccessIterator, typename Size, typename T, typename Compare>
+  static bool result(RandomAccessIterator first, Size n, Size position, const T& value, Compare& comp)
+  {
+    return position != n && !comp(value, first[position]);
+  }
+};
+
+// Whether the values searched with comp may be checked for sortedness, which requires comparing them to each other.
+template <typename InputIterator, typename StrictWeakOrdering>
+inline constexpr bool can_check_sorted_search_values =
+  ::cuda::std::is_invocable_v<StrictWeakOrdering&,
+                              const thrust::detail::it_value_t<InputIterator>&,
+                              const thrust::detail::it_value_t<InputIterator>&>;
+
+// Searches the sorted range [first, first + n) for each of the values in [values_first + begin, values_first + end),
+// which must be sorted as well, writing the results to the same positions of output. The positions found for
+// consecutive values only move forward, so each search gallops from the previous position: the step doubles until an
+// element which is not before the value is crossed, and a binary search over the last step finishes the search. The
+// searches are sequential scans of the range when the values are dense in it, and cost O(log(n / m)) comparisons each
+// when m values are spread over it, against O(log(n)) for independent binary searches.
+template <typename RandomAccessIterator1,
+          typename RandomAccessIterator2,
+          typename RandomAccessIterator3,
+          typename Size,
+          typename StrictWeakOrdering,
+          typename BinarySearchFunction>
+void sorted_search(
+  RandomAccessIterator1 first,
+  Size n,
+  RandomAccessIterator2 values_first,
+  Size begin,
+  Size end,
+  RandomAccessIterator3 output,
+  StrictWeakOrdering comp,
+  BinarySearchFunction)
+{
+  using traits = sorted_search_traits<BinarySearchFunction>;
+
+  thrust::detail::wrapped_function<StrictWeakOrdering, bool> wrapped_comp{comp};
+
+  Size position = 0;
+  for (Size i = begin; i < end; ++i)
+  {
+    const thrust::detail::it_value_t<RandomAccessIterator2> value = values_first[i];
+
+    if (position != n && traits::before(wrapped_comp, first[position], value))
+    {
+      // the element at lo is before the value, and so are all elements preceding it
+      Size lo   = position;
+      Size step = 1;
+      while (step < n - lo && traits::before(wrapped_comp, first[lo + step], value))
+      {
+        lo += step;
+        step *= 2;
+      }
+
+      Size hi = step < n - lo ? lo + step : n;
+      ++lo;
+      while (lo < hi)
+      {
+        const Size mid = lo + (hi - lo) / 2;
+        if (traits::before(wrapped_comp, first[mid], value))
+        {
+          lo = mid + 1;
+        }
+        else
+        {
+          hi = mid;
+        }
+      }
+      position = lo;
+    }
+
+    output[i] = traits::result(first, n, position, value, wrapped_comp);
+  }
+}
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
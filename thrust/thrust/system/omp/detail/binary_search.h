@@ -25,8 +25,18 @@
 #elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
 #  pragma system_header
 #endif // no system header
+#include <thrust/detail/static_assert.h> // for depend_on_instantiation
+#include <thrust/detail/type_traits/minimum_type.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/sort.h>
 #include <thrust/system/detail/generic/binary_search.h>
+#include <thrust/system/detail/internal/sorted_search.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
 #include <thrust/system/omp/detail/execution_policy.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+
+#include <cstdint>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -71,6 +81,125 @@ bool binary_search(execution_policy<DerivedPolicy>& exec,
   return thrust::system::detail::generic::binary_search(exec, begin, end, value, comp);
 }
 
+// Searches are independent binary searches unless the values are sorted, in which case the positions they find only
+// move forward: each worker then co-iterates over the searched range and a contiguous piece of the values.
+template <typename DerivedPolicy,
+          typename ForwardIterator,
+          typename InputIterator,
+          typename OutputIterator,
+          typename StrictWeakOrdering,
+          typename BinarySearchFunction>
+OutputIterator vectorized_search(
+  execution_policy<DerivedPolicy>& exec,
+  ForwardIterator begin,
+  ForwardIterator end,
+  InputIterator values_begin,
+  InputIterator values_end,
+  OutputIterator output,
+  StrictWeakOrdering comp,
+  BinarySearchFunction func)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  static_assert(
+    thrust::detail::depend_on_instantiation<InputIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value,
+    "OpenMP compiler support is not enabled");
+
+  using traversal = typename thrust::detail::minimum_type<typename iterator_traversal<ForwardIterator>::type,
+                                                          typename iterator_traversal<InputIterator>::type,
+                                                          typename iterator_traversal<OutputIterator>::type>::type;
+
+  if constexpr (::cuda::std::is_convertible_v<traversal, random_access_traversal_tag>
+                && thrust::system::detail::internal::can_check_sorted_search_values<InputIterator, StrictWeakOrdering>)
+  {
+    if (thrust::is_sorted(exec, values_begin, values_end, comp))
+    {
+      using difference_type = thrust::detail::it_difference_t<InputIterator>;
+
+      const difference_type n = thrust::distance(begin, end);
+      const difference_type m = thrust::distance(values_begin, values_end);
+
+      thrust::system::detail::internal::uniform_decomposition<difference_type> decomp =
+        thrust::system::omp::detail::default_decomposition(m);
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+      using index_type = std::intptr_t;
+
+      const index_type num_tiles = static_cast<index_type>(decomp.size());
+
+      THRUST_PRAGMA_OMP(parallel for)
+      for (index_type tile = 0; tile < num_tiles; ++tile)
+      {
+        thrust::system::detail::internal::sorted_search(
+          begin, n, values_begin, decomp[tile].begin(), decomp[tile].end(), output, comp, func);
+      }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+
+      return output + m;
+    }
+  }
+
+  return thrust::system::detail::generic::detail::binary_search(
+    exec, begin, end, values_begin, values_end, output, comp, func);
+}
+
+template <typename DerivedPolicy,
+          typename ForwardIterator,
+          typename InputIterator,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator lower_bound(
+  execution_policy<DerivedPolicy>& exec,
+  ForwardIterator begin,
+  ForwardIterator end,
+  InputIterator values_begin,
+  InputIterator values_end,
+  OutputIterator output,
+  StrictWeakOrdering comp)
+{
+  return omp::detail::vectorized_search(
+    exec, begin, end, values_begin, values_end, output, comp, thrust::system::detail::generic::detail::lbf());
+}
+
+template <typename DerivedPolicy,
+          typename ForwardIterator,
+          typename InputIterator,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator upper_bound(
+  execution_policy<DerivedPolicy>& exec,
+  ForwardIterator begin,
+  ForwardIterator end,
+  InputIterator values_begin,
+  InputIterator values_end,
+  OutputIterator output,
+  StrictWeakOrdering comp)
+{
+  return omp::detail::vectorized_search(
+    exec, begin, end, values_begin, values_end, output, comp, thrust::system::detail::generic::detail::ubf());
+}
+
+template <typename DerivedPolicy,
+          typename ForwardIterator,
+          typename InputIterator,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator binary_search(
+  execution_policy<DerivedPolicy>& exec,
+  ForwardIterator begin,
+  ForwardIterator end,
+  InputIterator values_begin,
+  InputIterator values_end,
+  OutputIterator output,
+  StrictWeakOrdering comp)
+{
+  return omp::detail::vectorized_search(
+    exec, begin, end, values_begin, values_end, output, comp, thrust::system::detail::generic::detail::bsf());
+}
+
 } // namespace detail
 } // namespace omp
 } // namespace system
@@ -25,6 +25,7 @@
 #elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
 #  pragma system_header
 #endif // no system header
+#include <thrust/detail/static_assert.h> // for depend_on_instantiation
 #include <thrust/system/omp/detail/default_decomposition.h>
 
 // don't attempt to #include this file without omp support
@@ -29,8 +29,13 @@
 #elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
 #  pragma system_header
 #endif // no system header
-#include <thrust/system/detail/generic/find.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/static_assert.h> // for depend_on_instantiation
+#include <thrust/distance.h>
+#include <thrust/find.h>
+#include <thrust/system/detail/internal/find_if.h>
 #include <thrust/system/omp/detail/execution_policy.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -43,8 +48,33 @@ namespace detail
 template <typename DerivedPolicy, typename InputIterator, typename Predicate>
 InputIterator find_if(execution_policy<DerivedPolicy>& exec, InputIterator first, InputIterator last, Predicate pred)
 {
-  // omp prefers generic::find_if to cpp::find_if
-  return thrust::system::detail::generic::find_if(exec, first, last, pred);
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  static_assert(thrust::detail::depend_on_instantiation<InputIterator,
+                                                        (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value,
+                "OpenMP compiler support is not enabled");
+
+  (void) exec;
+
+  // the threads claim blocks in order and stop claiming them past the first match found, which also makes mismatch,
+  // equal and the logical algorithms, all implemented in terms of find_if, exit early
+  thrust::system::detail::internal::cooperative_find_if<InputIterator, Predicate> search(
+    first, thrust::distance(first, last), pred);
+
+  if (search.num_blocks() <= 1)
+  {
+    return thrust::find_if(thrust::seq, first, last, pred);
+  }
+
+  THRUST_PRAGMA_OMP(parallel)
+  {
+    search();
+  }
+
+  return first + search.result();
 }
 
 } // end namespace detail
@@ -0,0 +1,212 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/function.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/static_assert.h> // for depend_on_instantiation
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/merge.h>
+#include <thrust/pair.h>
+#include <thrust/system/detail/internal/merge_path.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/merge.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+
+#include <cstdint>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator
+merge(execution_policy<DerivedPolicy>&,
+      InputIterator1 first1,
+      InputIterator1 last1,
+      InputIterator2 first2,
+      InputIterator2 last2,
+      OutputIterator result,
+      StrictWeakOrdering comp)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  static_assert(thrust::detail::depend_on_instantiation<InputIterator1,
+                                                        (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value,
+                "OpenMP compiler support is not enabled");
+
+  using difference_type = thrust::detail::it_difference_t<InputIterator1>;
+
+  const difference_type n1 = thrust::distance(first1, last1);
+  const difference_type n2 = thrust::distance(first2, last2);
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp =
+    thrust::system::omp::detail::default_decomposition(n1 + n2);
+
+  if (decomp.size() <= 1)
+  {
+    return thrust::merge(thrust::seq, first1, last1, first2, last2, result, comp);
+  }
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  using index_type = std::intptr_t;
+
+  const index_type num_tiles = static_cast<index_type>(decomp.size());
+
+  // wrap comp
+  thrust::detail::wrapped_function<StrictWeakOrdering, bool> wrapped_comp{comp};
+
+  // every tile of the output is produced by an independent sequential merge
+  // of the input ranges bounded by the merge path at the tile's ends
+  THRUST_PRAGMA_OMP(parallel for)
+  for (index_type tile = 0; tile < num_tiles; ++tile)
+  {
+    const difference_type begin = decomp[tile].begin();
+    const difference_type end   = decomp[tile].end();
+
+    const difference_type begin1 =
+      thrust::system::detail::internal::merge_path(first1, n1, first2, n2, begin, wrapped_comp);
+    const difference_type end1 =
+      thrust::system::detail::internal::merge_path(first1, n1, first2, n2, end, wrapped_comp);
+
+    thrust::merge(
+      thrust::seq,
+      first1 + begin1,
+      first1 + end1,
+      first2 + (begin - begin1),
+      first2 + (end - end1),
+      result + begin,
+      comp);
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+
+  return result + (n1 + n2);
+} // end merge()
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename InputIterator3,
+          typename InputIterator4,
+          typename OutputIterator1,
+          typename OutputIterator2,
+          typename StrictWeakOrdering>
+thrust::pair<OutputIterator1, OutputIterator2> merge_by_key(
+  execution_policy<DerivedPolicy>&,
+  InputIterator1 keys_first1,
+  InputIterator1 keys_last1,
+  InputIterator2 keys_first2,
+  InputIterator2 keys_last2,
+  InputIterator3 values_first3,
+  InputIterator4 values_first4,
+  OutputIterator1 keys_result,
+  OutputIterator2 values_result,
+  StrictWeakOrdering comp)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  static_assert(thrust::detail::depend_on_instantiation<InputIterator1,
+                                                        (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value,
+                "OpenMP compiler support is not enabled");
+
+  using difference_type = thrust::detail::it_difference_t<InputIterator1>;
+
+  const difference_type n1 = thrust::distance(keys_first1, keys_last1);
+  const difference_type n2 = thrust::distance(keys_first2, keys_last2);
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp =
+    thrust::system::omp::detail::default_decomposition(n1 + n2);
+
+  if (decomp.size() <= 1)
+  {
+    return thrust::merge_by_key(
+      thrust::seq,
+      keys_first1,
+      keys_last1,
+      keys_first2,
+      keys_last2,
+      values_first3,
+      values_first4,
+      keys_result,
+      values_result,
+      comp);
+  }
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  using index_type = std::intptr_t;
+
+  const index_type num_tiles = static_cast<index_type>(decomp.size());
+
+  // wrap comp
+  thrust::detail::wrapped_function<StrictWeakOrdering, bool> wrapped_comp{comp};
+
+  THRUST_PRAGMA_OMP(parallel for)
+  for (index_type tile = 0; tile < num_tiles; ++tile)
+  {
+    const difference_type begin = decomp[tile].begin();
+    const difference_type end   = decomp[tile].end();
+
+    const difference_type begin1 =
+      thrust::system::detail::internal::merge_path(keys_first1, n1, keys_first2, n2, begin, wrapped_comp);
+    const difference_type end1 =
+      thrust::system::detail::internal::merge_path(keys_first1, n1, keys_first2, n2, end, wrapped_comp);
+
+    thrust::merge_by_key(
+      thrust::seq,
+      keys_first1 + begin1,
+      keys_first1 + end1,
+      keys_first2 + (begin - begin1),
+      keys_first2 + (end - end1),
+      values_first3 + begin1,
+      values_first4 + (begin - begin1),
+      keys_result + begin,
+      values_result + begin,
+      comp);
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+
+  return thrust::make_pair(keys_result + (n1 + n2), values_result + (n1 + n2));
+} // end merge_by_key()
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
@@ -0,0 +1,253 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/function.h>
+#include <thrust/detail/static_assert.h> // for depend_on_instantiation
+#include <thrust/detail/temporary_array.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/omp/detail/reduce_intervals.h>
+#include <thrust/system/omp/detail/scan.h>
+
+#include <cuda/std/__functional/invoke.h>
+
+#include <cstdint>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace scan_detail
+{
+
+// scans [first, last) serially, combining every element with the running carry
+template <bool Inclusive, typename InputIterator, typename OutputIterator, typename ValueType, typename BinaryFunction>
+void scan_tile(
+  InputIterator first, InputIterator last, OutputIterator result, ValueType carry, BinaryFunction binary_op)
+{
+  for (; first != last; ++first, (void) ++result)
+  {
+    if constexpr (Inclusive)
+    {
+      *result = carry = binary_op(carry, *first);
+    }
+    else
+    {
+      ValueType tmp = *first; // temporary value allows in-situ scan
+      *result       = carry;
+      carry         = binary_op(carry, tmp);
+    }
+  }
+}
+
+// placeholder initial value for scans without one
+struct no_init
+{};
+
+// Two-pass scan over the default decomposition:
+//   1. reduce every tile in parallel,
+//   2. scan the (few) tile sums serially to obtain the carry into each tile,
+//   3. scan every tile in parallel, seeded with its carry.
+// When HasInit is false, the first tile has no carry and starts from its first element.
+template <bool Inclusive,
+          bool HasInit,
+          typename ValueType,
+          typename DerivedPolicy,
+          typename InputIterator,
+          typename OutputIterator,
+          typename InitialValueType,
+          typename BinaryFunction>
+OutputIterator scan(execution_policy<DerivedPolicy>& exec,
+                    InputIterator first,
+                    InputIterator last,
+                    OutputIterator result,
+                    InitialValueType init,
+                    BinaryFunction binary_op)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  static_assert(
+    thrust::detail::depend_on_instantiation<InputIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value,
+    "OpenMP compiler support is not enabled");
+
+  using difference_type = thrust::detail::it_difference_t<InputIterator>;
+
+  const difference_type n = thrust::distance(first, last);
+
+  if (n == 0)
+  {
+    return result;
+  }
+
+  // wrap binary_op
+  thrust::detail::wrapped_function<BinaryFunction, ValueType> wrapped_binary_op{binary_op};
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp =
+    thrust::system::omp::detail::default_decomposition(n);
+
+  if (decomp.size() == 1)
+  {
+    if constexpr (HasInit)
+    {
+      scan_detail::scan_tile<Inclusive>(first, last, result, ValueType(init), wrapped_binary_op);
+    }
+    else
+    {
+      ValueType carry = *first;
+      *result         = carry;
+      scan_detail::scan_tile<Inclusive>(first + 1, last, result + 1, carry, wrapped_binary_op);
+    }
+
+    return result + n;
+  }
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  using index_type = std::intptr_t;
+
+  const index_type num_tiles = static_cast<index_type>(decomp.size());
+
+  // sums[0] holds the initial value and sums[i + 1] the sum of tile i;
+  // after the serial scan below, sums[i] is the carry into tile i
+  thrust::detail::temporary_array<ValueType, DerivedPolicy> sums(exec, num_tiles + 1);
+
+  // first pass: reduce each tile
+  thrust::system::omp::detail::reduce_intervals(exec, first, sums.begin() + 1, binary_op, decomp);
+
+  // second pass: scan the tile sums
+  index_type i = 1;
+
+  if constexpr (HasInit)
+  {
+    sums[0] = init;
+  }
+  else
+  {
+    // the first tile has no carry, so the scan of the sums starts at sums[1]
+    ++i;
+  }
+
+  ValueType carry = sums[i - 1];
+
+  for (; i < num_tiles; ++i)
+  {
+    carry   = wrapped_binary_op(carry, static_cast<ValueType>(sums[i]));
+    sums[i] = carry;
+  }
+
+  // third pass: scan each tile starting from its carry
+  THRUST_PRAGMA_OMP(parallel for)
+  for (index_type tile = 0; tile < num_tiles; ++tile)
+  {
+    InputIterator tile_first   = first + decomp[tile].begin();
+    InputIterator tile_last    = first + decomp[tile].end();
+    OutputIterator tile_result = result + decomp[tile].begin();
+
+    if (!HasInit && tile == 0)
+    {
+      ValueType tile_carry = *tile_first;
+      *tile_result         = tile_carry;
+      scan_detail::scan_tile<Inclusive>(tile_first + 1, tile_last, tile_result + 1, tile_carry, wrapped_binary_op);
+    }
+    else
+    {
+      scan_detail::scan_tile<Inclusive>(
+        tile_first, tile_last, tile_result, static_cast<ValueType>(sums[tile]), wrapped_binary_op);
+    }
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+
+  return result + n;
+}
+
+} // namespace scan_detail
+
+template <typename DerivedPolicy, typename InputIterator, typename OutputIterator, typename BinaryFunction>
+OutputIterator inclusive_scan(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator first,
+  InputIterator last,
+  OutputIterator result,
+  BinaryFunction binary_op)
+{
+  // Use the input iterator's value type per https://wg21.link/P0571
+  using ValueType = thrust::detail::it_value_t<InputIterator>;
+
+  return scan_detail::scan<true, false, ValueType>(exec, first, last, result, scan_detail::no_init{}, binary_op);
+}
+
+template <typename DerivedPolicy,
+          typename InputIterator,
+          typename OutputIterator,
+          typename InitialValueType,
+          typename BinaryFunction>
+OutputIterator inclusive_scan(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator first,
+  InputIterator last,
+  OutputIterator result,
+  InitialValueType init,
+  BinaryFunction binary_op)
+{
+  // Use the input iterator's value type and the initial value type per wg21.link/p2322
+  using ValueType =
+    typename ::cuda::std::__accumulator_t<BinaryFunction, thrust::detail::it_value_t<InputIterator>, InitialValueType>;
+
+  return scan_detail::scan<true, true, ValueType>(exec, first, last, result, init, binary_op);
+}
+
+template <typename DerivedPolicy,
+          typename InputIterator,
+          typename OutputIterator,
+          typename InitialValueType,
+          typename BinaryFunction>
+OutputIterator exclusive_scan(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator first,
+  InputIterator last,
+  OutputIterator result,
+  InitialValueType init,
+  BinaryFunction binary_op)
+{
+  // Use the initial value type per https://wg21.link/P0571
+  using ValueType = InitialValueType;
+
+  return scan_detail::scan<false, true, ValueType>(exec, first, last, result, init, binary_op);
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
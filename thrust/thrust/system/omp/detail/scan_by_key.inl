@@ -0,0 +1,378 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/function.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/static_assert.h> // for depend_on_instantiation
+#include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/transform_iterator.h>
+#include <thrust/scan.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/omp/detail/reduce_intervals.h>
+#include <thrust/system/omp/detail/scan_by_key.h>
+#include <thrust/tuple.h>
+
+#include <cstdint>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace scan_by_key_detail
+{
+
+// placeholder initial value for inclusive scans
+struct no_init
+{};
+
+// maps index i to (whether element i begins a segment, the value element i contributes to the running sum);
+// the first element of a segment restarts the running sum, from init when HasInit is true
+template <bool HasInit,
+          typename ValueType,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename InitialValueType,
+          typename BinaryPredicate,
+          typename BinaryFunction>
+struct segment_head
+{
+  InputIterator1 keys;
+  InputIterator2 values;
+  InitialValueType init;
+  thrust::detail::wrapped_function<BinaryPredicate, bool> binary_pred;
+  thrust::detail::wrapped_function<BinaryFunction, ValueType> binary_op;
+
+  template <typename Size>
+  thrust::tuple<bool, ValueType> operator()(Size i) const
+  {
+    const bool is_head = (i == 0) || !binary_pred(keys[i - 1], keys[i]);
+    ValueType value    = values[i];
+
+    if constexpr (HasInit)
+    {
+      if (is_head)
+      {
+        value = binary_op(init, value);
+      }
+    }
+
+    return thrust::tuple<bool, ValueType>(is_head, value);
+  }
+};
+
+// combines the summaries of two adjacent ranges: the running sum restarts at a segment head in the right range
+template <typename ValueType, typename BinaryFunction>
+struct segmented_binary_op
+{
+  thrust::detail::wrapped_function<BinaryFunction, ValueType> binary_op;
+
+  thrust::tuple<bool, ValueType>
+  operator()(const thrust::tuple<bool, ValueType>& lhs, const thrust::tuple<bool, ValueType>& rhs) const
+  {
+    if (thrust::get<0>(rhs))
+    {
+      return rhs;
+    }
+
+    return thrust::tuple<bool, ValueType>(thrust::get<0>(lhs), binary_op(thrust::get<1>(lhs), thrust::get<1>(rhs)));
+  }
+};
+
+template <typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename ValueType,
+          typename BinaryPredicate,
+          typename BinaryFunction>
+void inclusive_scan_by_key_tile(
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  OutputIterator result,
+  bool is_head,
+  ValueType carry,
+  BinaryPredicate binary_pred,
+  BinaryFunction binary_op)
+{
+  using KeyType = thrust::detail::it_value_t<InputIterator1>;
+
+  KeyType prev_key = *first1;
+  ValueType prev_value = is_head ? static_cast<ValueType>(*first2) : binary_op(carry, *first2);
+
+  *result = prev_value;
+
+  for (++first1, ++first2, ++result; first1 != last1; ++first1, (void) ++first2, (void) ++result)
+  {
+    KeyType key = *first1;
+
+    if (binary_pred(prev_key, key))
+    {
+      *result = prev_value = binary_op(prev_value, *first2);
+    }
+    else
+    {
+      *result = prev_value = *first2;
+    }
+
+    prev_key = key;
+  }
+}
+
+template <typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename ValueType,
+          typename BinaryPredicate,
+          typename BinaryFunction>
+void exclusive_scan_by_key_tile(
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  OutputIterator result,
+  bool is_head,
+  ValueType carry,
+  ValueType init,
+  BinaryPredicate binary_pred,
+  BinaryFunction binary_op)
+{
+  using KeyType = thrust::detail::it_value_t<InputIterator1>;
+
+  KeyType temp_key     = *first1;
+  ValueType temp_value = *first2;
+
+  ValueType next = is_head ? init : carry;
+
+  *result = next;
+
+  next = binary_op(next, temp_value);
+
+  for (++first1, ++first2, ++result; first1 != last1; ++first1, (void) ++first2, (void) ++result)
+  {
+    KeyType key = *first1;
+
+    // use temp to permit in-place scans
+    temp_value = *first2;
+
+    if (!binary_pred(temp_key, key))
+    {
+      next = init; // reset sum
+    }
+
+    *result = next;
+    next    = binary_op(next, temp_value);
+
+    temp_key = key;
+  }
+}
+
+// Segmented version of the two-pass tile scan in scan.inl. Each tile is summarized by
+// (whether it contains a segment head, the running sum at its end) using reduce_intervals,
+// the summaries are scanned serially to find each tile's carry, then every tile is scanned in parallel.
+template <bool Exclusive,
+          typename ValueType,
+          typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename T,
+          typename BinaryPredicate,
+          typename BinaryFunction>
+OutputIterator scan_by_key(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  OutputIterator result,
+  T init,
+  BinaryPredicate binary_pred,
+  BinaryFunction binary_op)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  static_assert(thrust::detail::depend_on_instantiation<InputIterator1,
+                                                        (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value,
+                "OpenMP compiler support is not enabled");
+
+  using difference_type = thrust::detail::it_difference_t<InputIterator1>;
+
+  const difference_type n = thrust::distance(first1, last1);
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp =
+    thrust::system::omp::detail::default_decomposition(n);
+
+  if (decomp.size() <= 1)
+  {
+    if constexpr (Exclusive)
+    {
+      return thrust::exclusive_scan_by_key(thrust::seq, first1, last1, first2, result, init, binary_pred, binary_op);
+    }
+    else
+    {
+      return thrust::inclusive_scan_by_key(thrust::seq, first1, last1, first2, result, binary_pred, binary_op);
+    }
+  }
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  using index_type   = std::intptr_t;
+  using summary_type = thrust::tuple<bool, ValueType>;
+
+  const index_type num_tiles = static_cast<index_type>(decomp.size());
+
+  thrust::detail::wrapped_function<BinaryPredicate, bool> wrapped_binary_pred{binary_pred};
+  thrust::detail::wrapped_function<BinaryFunction, ValueType> wrapped_binary_op{binary_op};
+
+  using segment_head_type =
+    segment_head<Exclusive, ValueType, InputIterator1, InputIterator2, T, BinaryPredicate, BinaryFunction>;
+
+  segment_head_type head_flags{first1, first2, init, wrapped_binary_pred, wrapped_binary_op};
+
+  segmented_binary_op<ValueType, BinaryFunction> segmented_op{wrapped_binary_op};
+
+  // first pass: summarize each tile
+  thrust::detail::temporary_array<summary_type, DerivedPolicy> summaries(exec, num_tiles);
+
+  thrust::system::omp::detail::reduce_intervals(
+    exec,
+    thrust::make_transform_iterator(thrust::counting_iterator<difference_type>(0), head_flags),
+    summaries.begin(),
+    segmented_op,
+    decomp);
+
+  // second pass: replace each summary with (whether the tile begins a segment, the carry into the tile);
+  // the keys straddling tile boundaries are compared before any output is written to permit in-place scans
+  summary_type carry = summaries[0];
+
+  for (index_type i = 1; i < num_tiles; ++i)
+  {
+    const summary_type tile_summary  = summaries[i];
+    const difference_type tile_begin = decomp[i].begin();
+
+    const bool is_head = !wrapped_binary_pred(first1[tile_begin - 1], first1[tile_begin]);
+
+    summaries[i] = summary_type(is_head, thrust::get<1>(carry));
+    carry        = segmented_op(carry, tile_summary);
+  }
+
+  // third pass: scan each tile starting from its carry
+  THRUST_PRAGMA_OMP(parallel for)
+  for (index_type tile = 0; tile < num_tiles; ++tile)
+  {
+    const difference_type tile_begin = decomp[tile].begin();
+    const difference_type tile_end   = decomp[tile].end();
+    const summary_type tile_carry    = summaries[tile];
+
+    if constexpr (Exclusive)
+    {
+      exclusive_scan_by_key_tile(
+        first1 + tile_begin,
+        first1 + tile_end,
+        first2 + tile_begin,
+        result + tile_begin,
+        thrust::get<0>(tile_carry),
+        thrust::get<1>(tile_carry),
+        ValueType(init),
+        wrapped_binary_pred,
+        wrapped_binary_op);
+    }
+    else
+    {
+      inclusive_scan_by_key_tile(
+        first1 + tile_begin,
+        first1 + tile_end,
+        first2 + tile_begin,
+        result + tile_begin,
+        thrust::get<0>(tile_carry),
+        thrust::get<1>(tile_carry),
+        wrapped_binary_pred,
+        wrapped_binary_op);
+    }
+  }
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+
+  return result + n;
+}
+
+} // namespace scan_by_key_detail
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename BinaryPredicate,
+          typename BinaryFunction>
+OutputIterator inclusive_scan_by_key(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  OutputIterator result,
+  BinaryPredicate binary_pred,
+  BinaryFunction binary_op)
+{
+  using ValueType = thrust::detail::it_value_t<InputIterator2>;
+
+  return scan_by_key_detail::scan_by_key<false, ValueType>(
+    exec, first1, last1, first2, result, scan_by_key_detail::no_init{}, binary_pred, binary_op);
+}
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename T,
+          typename BinaryPredicate,
+          typename BinaryFunction>
+OutputIterator exclusive_scan_by_key(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  OutputIterator result,
+  T init,
+  BinaryPredicate binary_pred,
+  BinaryFunction binary_op)
+{
+  using ValueType = T;
+
+  return scan_by_key_detail::scan_by_key<true, ValueType>(
+    exec, first1, last1, first2, result, init, binary_pred, binary_op);
+}
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
@@ -0,0 +1,310 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/function.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/static_assert.h> // for depend_on_instantiation
+#include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/discard_iterator.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/pair.h>
+#include <thrust/set_operations.h>
+#include <thrust/system/detail/internal/merge_path.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/omp/detail/set_operations.h>
+
+#include <cstdint>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace set_operations_detail
+{
+
+struct difference_op
+{
+  template <typename InputIterator1,
+            typename InputIterator2,
+            typename OutputIterator,
+            typename StrictWeakOrdering>
+  OutputIterator operator()(
+    InputIterator1 first1,
+    InputIterator1 last1,
+    InputIterator2 first2,
+    InputIterator2 last2,
+    OutputIterator result,
+    StrictWeakOrdering comp) const
+  {
+    return thrust::set_difference(thrust::seq, first1, last1, first2, last2, result, comp);
+  }
+};
+
+struct intersection_op
+{
+  template <typename InputIterator1,
+            typename InputIterator2,
+            typename OutputIterator,
+            typename StrictWeakOrdering>
+  OutputIterator operator()(
+    InputIterator1 first1,
+    InputIterator1 last1,
+    InputIterator2 first2,
+    InputIterator2 last2,
+    OutputIterator result,
+    StrictWeakOrdering comp) const
+  {
+    return thrust::set_intersection(thrust::seq, first1, last1, first2, last2, result, comp);
+  }
+};
+
+struct symmetric_difference_op
+{
+  template <typename InputIterator1,
+            typename InputIterator2,
+            typename OutputIterator,
+            typename StrictWeakOrdering>
+  OutputIterator operator()(
+    InputIterator1 first1,
+    InputIterator1 last1,
+    InputIterator2 first2,
+    InputIterator2 last2,
+    OutputIterator result,
+    StrictWeakOrdering comp) const
+  {
+    return thrust::set_symmetric_difference(thrust::seq, first1, last1, first2, last2, result, comp);
+  }
+};
+
+struct union_op
+{
+  template <typename InputIterator1,
+            typename InputIterator2,
+            typename OutputIterator,
+            typename StrictWeakOrdering>
+  OutputIterator operator()(
+    InputIterator1 first1,
+    InputIterator1 last1,
+    InputIterator2 first2,
+    InputIterator2 last2,
+    OutputIterator result,
+    StrictWeakOrdering comp) const
+  {
+    return thrust::set_union(thrust::seq, first1, last1, first2, last2, result, comp);
+  }
+};
+
+// Every set operation is split into independent pieces along the balanced path of the two
+// input ranges. The pieces are processed twice: once to count the size of their output,
+// and once more to write it at the offsets given by the exclusive sum of these counts.
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename StrictWeakOrdering,
+          typename SetOperation>
+OutputIterator set_operation(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  InputIterator2 last2,
+  OutputIterator result,
+  StrictWeakOrdering comp,
+  SetOperation set_op)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  static_assert(thrust::detail::depend_on_instantiation<InputIterator1,
+                                                        (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value,
+                "OpenMP compiler support is not enabled");
+
+  using difference_type = thrust::detail::it_difference_t<InputIterator1>;
+  using bounds_type     = thrust::pair<difference_type, difference_type>;
+
+  const difference_type n1 = thrust::distance(first1, last1);
+  const difference_type n2 = thrust::distance(first2, last2);
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp =
+    thrust::system::omp::detail::default_decomposition(n1 + n2);
+
+  if (decomp.size() <= 1)
+  {
+    return set_op(first1, last1, first2, last2, result, comp);
+  }
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  using index_type = std::intptr_t;
+
+  const index_type num_tiles = static_cast<index_type>(decomp.size());
+
+  // wrap comp
+  thrust::detail::wrapped_function<StrictWeakOrdering, bool> wrapped_comp{comp};
+
+  // bounds[tile] is where tile begins in each of the input ranges
+  thrust::detail::temporary_array<bounds_type, DerivedPolicy> bounds(exec, num_tiles + 1);
+
+  THRUST_PRAGMA_OMP(parallel for)
+  for (index_type tile = 0; tile <= num_tiles; ++tile)
+  {
+    const difference_type diag = tile < num_tiles ? decomp[tile].begin() : n1 + n2;
+
+    bounds[tile] = thrust::system::detail::internal::balanced_path(first1, n1, first2, n2, diag, wrapped_comp);
+  }
+
+  // offsets[tile + 1] is the size of the output of tile, until it is scanned below
+  thrust::detail::temporary_array<difference_type, DerivedPolicy> offsets(exec, num_tiles + 1);
+
+  THRUST_PRAGMA_OMP(parallel for)
+  for (index_type tile = 0; tile < num_tiles; ++tile)
+  {
+    const bounds_type begin = bounds[tile];
+    const bounds_type end   = bounds[tile + 1];
+
+    offsets[tile + 1] =
+      set_op(first1 + begin.first,
+             first1 + end.first,
+             first2 + begin.second,
+             first2 + end.second,
+             thrust::make_discard_iterator(),
+             comp)
+      - thrust::make_discard_iterator();
+  }
+
+  offsets[0] = 0;
+
+  for (index_type tile = 0; tile < num_tiles; ++tile)
+  {
+    offsets[tile + 1] = static_cast<difference_type>(offsets[tile]) + static_cast<difference_type>(offsets[tile + 1]);
+  }
+
+  THRUST_PRAGMA_OMP(parallel for)
+  for (index_type tile = 0; tile < num_tiles; ++tile)
+  {
+    const bounds_type begin = bounds[tile];
+    const bounds_type end   = bounds[tile + 1];
+
+    set_op(first1 + begin.first,
+           first1 + end.first,
+           first2 + begin.second,
+           first2 + end.second,
+           result + static_cast<difference_type>(offsets[tile]),
+           comp);
+  }
+
+  return result + static_cast<difference_type>(offsets[num_tiles]);
+#else
+  return result;
+#endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
+} // end set_operation()
+
+} // end namespace set_operations_detail
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator set_difference(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  InputIterator2 last2,
+  OutputIterator result,
+  StrictWeakOrdering comp)
+{
+  return set_operations_detail::set_operation(
+    exec, first1, last1, first2, last2, result, comp, set_operations_detail::difference_op{});
+} // end set_difference()
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator set_intersection(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  InputIterator2 last2,
+  OutputIterator result,
+  StrictWeakOrdering comp)
+{
+  return set_operations_detail::set_operation(
+    exec, first1, last1, first2, last2, result, comp, set_operations_detail::intersection_op{});
+} // end set_intersection()
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator set_symmetric_difference(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  InputIterator2 last2,
+  OutputIterator result,
+  StrictWeakOrdering comp)
+{
+  return set_operations_detail::set_operation(
+    exec, first1, last1, first2, last2, result, comp, set_operations_detail::symmetric_difference_op{});
+} // end set_symmetric_difference()
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator set_union(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  InputIterator2 last2,
+  OutputIterator result,
+  StrictWeakOrdering comp)
+{
+  return set_operations_detail::set_operation(
+    exec, first1, last1, first2, last2, result, comp, set_operations_detail::union_op{});
+} // end set_union()
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
@@ -31,13 +31,25 @@
 #  include <omp.h>
 #endif // omp support
 
+#include <thrust/copy.h>
+#include <thrust/detail/raw_pointer_cast.h>
 #include <thrust/detail/seq.h>
 #include <thrust/detail/temporary_array.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/functional.h>
 #include <thrust/iterator/iterator_traits.h>
-#include <thrust/merge.h>
+#include <thrust/iterator/zip_iterator.h>
 #include <thrust/sort.h>
 #include <thrust/system/detail/generic/select_system.h>
-#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/detail/internal/radix_sort.h>
+#include <thrust/system/omp/detail/merge.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+
+#include <cuda/std/__algorithm/min.h>
+
+#include <cstddef>
+#include <cstdint>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -49,46 +61,350 @@ namespace detail
 namespace sort_detail
 {
 
-template <typename DerivedPolicy, typename RandomAccessIterator, typename StrictWeakOrdering>
-void inplace_merge(execution_policy<DerivedPolicy>& exec,
-                   RandomAccessIterator first,
-                   RandomAccessIterator middle,
-                   RandomAccessIterator last,
-                   StrictWeakOrdering comp)
+// Merges the sorted runs [decomp[a].begin(), decomp[a + width - 1].end()) pairwise, doubling width
+// until a single run remains. Each merge is a parallel merge, so the last levels of the merge tree
+// keep every thread busy even though they consist of only a few merges. The runs ping-pong between
+// [first, last) and a temporary buffer.
+template <typename DerivedPolicy, typename RandomAccessIterator, typename Decomposition, typename StrictWeakOrdering>
+void merge_tiles(execution_policy<DerivedPolicy>& exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 Decomposition decomp,
+                 StrictWeakOrdering comp)
 {
   using value_type = thrust::detail::it_value_t<RandomAccessIterator>;
+  using index_type = std::intptr_t;
+
+  const index_type num_tiles = static_cast<index_type>(decomp.size());
+
+  thrust::detail::temporary_array<value_type, DerivedPolicy> buffer(exec, first, last);
+
+  bool sorted_in_buffer = false;
+
+  for (index_type width = 1; width < num_tiles; width *= 2)
+  {
+    for (index_type a = 0; a < num_tiles; a += 2 * width)
+    {
+      const index_type b = ::cuda::std::min(a + width, num_tiles);
+      const index_type c = ::cuda::std::min(a + 2 * width, num_tiles);
+
+      const auto begin  = decomp[a].begin();
+      const auto middle = decomp[b - 1].end();
+      const auto end    = decomp[c - 1].end();
+
+      if (sorted_in_buffer)
+      {
+        thrust::system::omp::detail::merge(
+          exec,
+          buffer.begin() + begin,
+          buffer.begin() + middle,
+          buffer.begin() + middle,
+          buffer.begin() + end,
+          first + begin,
+          comp);
+      }
+      else
+      {
+        thrust::system::omp::detail::merge(
+          exec, first + begin, first + middle, first + middle, first + end, buffer.begin() + begin, comp);
+      }
+    }
 
-  thrust::detail::temporary_array<value_type, DerivedPolicy> a(exec, first, middle);
-  thrust::detail::temporary_array<value_type, DerivedPolicy> b(exec, middle, last);
+    sorted_in_buffer = !sorted_in_buffer;
+  }
 
-  thrust::merge(thrust::seq, a.begin(), a.end(), b.begin(), b.end(), first, comp);
+  if (sorted_in_buffer)
+  {
+    thrust::copy(exec, buffer.begin(), buffer.end(), first);
+  }
 }
 
 template <typename DerivedPolicy,
           typename RandomAccessIterator1,
           typename RandomAccessIterator2,
+          typename Decomposition,
           typename StrictWeakOrdering>
-void inplace_merge_by_key(
+void merge_tiles_by_key(
   execution_policy<DerivedPolicy>& exec,
-  RandomAccessIterator1 first1,
-  RandomAccessIterator1 middle1,
-  RandomAccessIterator1 last1,
-  RandomAccessIterator2 first2,
+  RandomAccessIterator1 keys_first,
+  RandomAccessIterator1 keys_last,
+  RandomAccessIterator2 values_first,
+  Decomposition decomp,
   StrictWeakOrdering comp)
 {
   using value_type1 = thrust::detail::it_value_t<RandomAccessIterator1>;
   using value_type2 = thrust::detail::it_value_t<RandomAccessIterator2>;
+  using index_type  = std::intptr_t;
+
+  const index_type num_tiles = static_cast<index_type>(decomp.size());
+
+  RandomAccessIterator2 values_last = values_first + (keys_last - keys_first);
+
+  thrust::detail::temporary_array<value_type1, DerivedPolicy> keys_buffer(exec, keys_first, keys_last);
+  thrust::detail::temporary_array<value_type2, DerivedPolicy> values_buffer(exec, values_first, values_last);
+
+  bool sorted_in_buffer = false;
+
+  for (index_type width = 1; width < num_tiles; width *= 2)
+  {
+    for (index_type a = 0; a < num_tiles; a += 2 * width)
+    {
+      const index_type b = ::cuda::std::min(a + width, num_tiles);
+      const index_type c = ::cuda::std::min(a + 2 * width, num_tiles);
+
+      const auto begin  = decomp[a].begin();
+      const auto middle = decomp[b - 1].end();
+      const auto end    = decomp[c - 1].end();
+
+      if (sorted_in_buffer)
+      {
+        thrust::system::omp::detail::merge_by_key(
+          exec,
+          keys_buffer.begin() + begin,
+          keys_buffer.begin() + middle,
+          keys_buffer.begin() + middle,
+          keys_buffer.begin() + end,
+          values_buffer.begin() + begin,
+          values_buffer.begin() + middle,
+          keys_first + begin,
+          values_first + begin,
+          comp);
+      }
+      else
+      {
+        thrust::system::omp::detail::merge_by_key(
+          exec,
+          keys_first + begin,
+          keys_first + middle,
+          keys_first + middle,
+          keys_first + end,
+          values_first + begin,
+          values_first + middle,
+          keys_buffer.begin() + begin,
+          values_buffer.begin() + begin,
+          comp);
+      }
+    }
+
+    sorted_in_buffer = !sorted_in_buffer;
+  }
+
+  if (sorted_in_buffer)
+  {
+    thrust::copy(exec, keys_buffer.begin(), keys_buffer.end(), keys_first);
+    thrust::copy(exec, values_buffer.begin(), values_buffer.end(), values_first);
+  }
+}
+
+// Performs one pass of the radix sort of the tiles of [first, first + n) into result. Returns false, without moving
+// any element, when the pass may be skipped because every element falls into the same bucket.
+template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename Decomposition, typename Digit>
+bool radix_sort_pass(RandomAccessIterator1 first,
+                     RandomAccessIterator2 result,
+                     Decomposition decomp,
+                     Digit digit,
+                     unsigned int pass,
+                     std::size_t* counts)
+{
+  using index_type = std::intptr_t;
+
+  const index_type num_tiles = static_cast<index_type>(decomp.size());
+  const std::size_t n        = static_cast<std::size_t>(decomp[num_tiles - 1].end());
+
+  // every thread counts the digits of its own tile
+  THRUST_PRAGMA_OMP(parallel for)
+  for (index_type i = 0; i < num_tiles; ++i)
+  {
+    thrust::system::detail::internal::radix_histogram(
+      digit,
+      first + decomp[i].begin(),
+      decomp[i].size(),
+      pass,
+      counts + i * thrust::system::detail::internal::radix_num_buckets);
+  }
+
+  if (!thrust::system::detail::internal::radix_offsets(counts, num_tiles, n))
+  {
+    return false;
+  }
+
+  // every thread scatters its own tile
+  THRUST_PRAGMA_OMP(parallel for)
+  for (index_type i = 0; i < num_tiles; ++i)
+  {
+    thrust::system::detail::internal::radix_scatter(
+      digit,
+      first + decomp[i].begin(),
+      decomp[i].size(),
+      pass,
+      counts + i * thrust::system::detail::internal::radix_num_buckets,
+      result);
+  }
+
+  return true;
+}
+
+// Sorts the tiles of [first, first + n) with an LSD radix sort, one digit per pass. The elements ping-pong between
+// [first, first + n) and a buffer of the same size.
+template <typename DerivedPolicy,
+          typename RandomAccessIterator1,
+          typename RandomAccessIterator2,
+          typename Decomposition,
+          typename Digit>
+void radix_sort(execution_policy<DerivedPolicy>& exec,
+                RandomAccessIterator1 first,
+                RandomAccessIterator2 buffer,
+                Decomposition decomp,
+                Digit digit)
+{
+  const auto num_tiles = decomp.size();
+  const auto n         = decomp[num_tiles - 1].end();
+
+  thrust::detail::temporary_array<std::size_t, DerivedPolicy> counts(
+    exec, num_tiles * thrust::system::detail::internal::radix_num_buckets);
+
+  bool sorted_in_buffer = false;
+
+  for (unsigned int pass = 0; pass < Digit::num_passes; ++pass)
+  {
+    if (sorted_in_buffer)
+    {
+      sorted_in_buffer = !radix_sort_pass(buffer, first, decomp, digit, pass, thrust::raw_pointer_cast(counts.data()));
+    }
+    else
+    {
+      sorted_in_buffer = radix_sort_pass(first, buffer, decomp, digit, pass, thrust::raw_pointer_cast(counts.data()));
+    }
+  }
+
+  if (sorted_in_buffer)
+  {
+    thrust::copy(exec, buffer, buffer + n, first);
+  }
+}
+
+// sorts every other kind of keys with a merge sort
+template <typename DerivedPolicy, typename RandomAccessIterator, typename Decomposition, typename StrictWeakOrdering>
+void stable_sort(execution_policy<DerivedPolicy>& exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 Decomposition decomp,
+                 StrictWeakOrdering comp,
+                 thrust::detail::false_type)
+{
+  using index_type = std::intptr_t;
+
+  const index_type num_tiles = static_cast<index_type>(decomp.size());
+
+  // every thread sorts its own tile
+  THRUST_PRAGMA_OMP(parallel for)
+  for (index_type i = 0; i < num_tiles; ++i)
+  {
+    thrust::stable_sort(thrust::seq, first + decomp[i].begin(), first + decomp[i].end(), comp);
+  }
+
+  if (num_tiles > 1)
+  {
+    merge_tiles(exec, first, last, decomp, comp);
+  }
+}
+
+// sorts primitive keys ordered by less or greater with a radix sort
+template <typename DerivedPolicy, typename RandomAccessIterator, typename Decomposition, typename StrictWeakOrdering>
+void stable_sort(execution_policy<DerivedPolicy>& exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 Decomposition decomp,
+                 StrictWeakOrdering comp,
+                 thrust::detail::true_type)
+{
+  using KeyType = thrust::detail::it_value_t<RandomAccessIterator>;
+
+  if (last - first < thrust::system::detail::internal::radix_sort_threshold)
+  {
+    stable_sort(exec, first, last, decomp, comp, thrust::detail::false_type());
+    return;
+  }
+
+  thrust::detail::temporary_array<KeyType, DerivedPolicy> keys_buffer(exec, last - first);
+
+  using digit_type = thrust::system::detail::internal::
+    radix_digit<KeyType, ::cuda::std::is_same<StrictWeakOrdering, thrust::greater<KeyType>>::value>;
+
+  radix_sort(exec, first, keys_buffer.begin(), decomp, digit_type{});
+}
+
+template <typename DerivedPolicy,
+          typename RandomAccessIterator1,
+          typename RandomAccessIterator2,
+          typename Decomposition,
+          typename StrictWeakOrdering>
+void stable_sort_by_key(
+  execution_policy<DerivedPolicy>& exec,
+  RandomAccessIterator1 keys_first,
+  RandomAccessIterator1 keys_last,
+  RandomAccessIterator2 values_first,
+  Decomposition decomp,
+  StrictWeakOrdering comp,
+  thrust::detail::false_type)
+{
+  using index_type = std::intptr_t;
 
-  RandomAccessIterator2 middle2 = first2 + (middle1 - first1);
-  RandomAccessIterator2 last2   = first2 + (last1 - first1);
+  const index_type num_tiles = static_cast<index_type>(decomp.size());
 
-  thrust::detail::temporary_array<value_type1, DerivedPolicy> lhs1(exec, first1, middle1);
-  thrust::detail::temporary_array<value_type1, DerivedPolicy> rhs1(exec, middle1, last1);
-  thrust::detail::temporary_array<value_type2, DerivedPolicy> lhs2(exec, first2, middle2);
-  thrust::detail::temporary_array<value_type2, DerivedPolicy> rhs2(exec, middle2, last2);
+  // every thread sorts its own tile
+  THRUST_PRAGMA_OMP(parallel for)
+  for (index_type i = 0; i < num_tiles; ++i)
+  {
+    thrust::stable_sort_by_key(
+      thrust::seq,
+      keys_first + decomp[i].begin(),
+      keys_first + decomp[i].end(),
+      values_first + decomp[i].begin(),
+      comp);
+  }
 
-  thrust::merge_by_key(
-    thrust::seq, lhs1.begin(), lhs1.end(), rhs1.begin(), rhs1.end(), lhs2.begin(), rhs2.begin(), first1, first2, comp);
+  if (num_tiles > 1)
+  {
+    merge_tiles_by_key(exec, keys_first, keys_last, values_first, decomp, comp);
+  }
+}
+
+template <typename DerivedPolicy,
+          typename RandomAccessIterator1,
+          typename RandomAccessIterator2,
+          typename Decomposition,
+          typename StrictWeakOrdering>
+void stable_sort_by_key(
+  execution_policy<DerivedPolicy>& exec,
+  RandomAccessIterator1 keys_first,
+  RandomAccessIterator1 keys_last,
+  RandomAccessIterator2 values_first,
+  Decomposition decomp,
+  StrictWeakOrdering comp,
+  thrust::detail::true_type)
+{
+  using KeyType   = thrust::detail::it_value_t<RandomAccessIterator1>;
+  using ValueType = thrust::detail::it_value_t<RandomAccessIterator2>;
+
+  if (keys_last - keys_first < thrust::system::detail::internal::radix_sort_threshold)
+  {
+    stable_sort_by_key(exec, keys_first, keys_last, values_first, decomp, comp, thrust::detail::false_type());
+    return;
+  }
+
+  thrust::detail::temporary_array<KeyType, DerivedPolicy> keys_buffer(exec, keys_last - keys_first);
+  thrust::detail::temporary_array<ValueType, DerivedPolicy> values_buffer(exec, keys_last - keys_first);
+
+  using digit_type = thrust::system::detail::internal::
+    radix_digit<KeyType, ::cuda::std::is_same<StrictWeakOrdering, thrust::greater<KeyType>>::value>;
+
+  // keys and values are moved together
+  radix_sort(exec,
+             thrust::make_zip_iterator(keys_first, values_first),
+             thrust::make_zip_iterator(keys_buffer.begin(), values_buffer.begin()),
+             decomp,
+             thrust::system::detail::internal::radix_digit_of_key<digit_type>{});
 }
 
 } // namespace sort_detail
@@ -106,8 +422,9 @@ void stable_sort(
                                                         (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value,
                 "OpenMP compiler support is not enabled");
 
-  // Avoid issues on compilers that don't provide `omp_get_num_threads()`.
+  // Avoid issues on compilers that don't provide `omp_get_max_threads()`.
 #if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  using KeyType   = thrust::detail::it_value_t<RandomAccessIterator>;
   using IndexType = thrust::detail::it_difference_t<RandomAccessIterator>;
 
   if (first == last)
@@ -115,52 +432,11 @@ void stable_sort(
     return;
   }
 
-  THRUST_PRAGMA_OMP(parallel)
-  {
-    thrust::system::detail::internal::uniform_decomposition<IndexType> decomp(last - first, 1, omp_get_num_threads());
-
-    // process id
-    IndexType p_i = omp_get_thread_num();
-
-    // every thread sorts its own tile
-    if (p_i < decomp.size())
-    {
-      thrust::stable_sort(thrust::seq, first + decomp[p_i].begin(), first + decomp[p_i].end(), comp);
-    }
-
-    THRUST_PRAGMA_OMP(barrier)
-
-    // XXX For some reason, MSVC 2015 yields an error unless we include this meaningless semicolon here
-    ;
-
-    IndexType nseg = decomp.size();
-    IndexType h    = 2;
+  thrust::system::detail::internal::uniform_decomposition<IndexType> decomp(last - first, 1, omp_get_max_threads());
 
-    // keep track of which sub-range we're processing
-    IndexType a = p_i, b = p_i, c = p_i + 1;
+  thrust::system::detail::internal::use_radix_sort<KeyType, StrictWeakOrdering> use_radix_sort;
 
-    while (nseg > 1)
-    {
-      if (c >= decomp.size())
-      {
-        c = decomp.size() - 1;
-      }
-
-      if ((p_i % h) == 0 && c > b)
-      {
-        sort_detail::inplace_merge(
-          exec, first + decomp[a].begin(), first + decomp[b].end(), first + decomp[c].end(), comp);
-
-        b = c;
-        c += h;
-      }
-
-      nseg = (nseg + 1) / 2;
-      h *= 2;
-
-      THRUST_PRAGMA_OMP(barrier)
-    }
-  }
+  sort_detail::stable_sort(exec, first, last, decomp, comp, use_radix_sort);
 #endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
 }
 
@@ -184,8 +460,9 @@ void stable_sort_by_key(
                                                         (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)>::value,
                 "OpenMP compiler support is not enabled");
 
-  // Avoid issues on compilers that don't provide `omp_get_num_threads()`.
+  // Avoid issues on compilers that don't provide `omp_get_max_threads()`.
 #if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  using KeyType   = thrust::detail::it_value_t<RandomAccessIterator1>;
   using IndexType = thrust::detail::it_difference_t<RandomAccessIterator1>;
 
   if (keys_first == keys_last)
@@ -193,63 +470,12 @@ void stable_sort_by_key(
     return;
   }
 
-  THRUST_PRAGMA_OMP(parallel)
-  {
-    thrust::system::detail::internal::uniform_decomposition<IndexType> decomp(
-      keys_last - keys_first, 1, omp_get_num_threads());
-
-    // process id
-    IndexType p_i = omp_get_thread_num();
-
-    // every thread sorts its own tile
-    if (p_i < decomp.size())
-    {
-      thrust::stable_sort_by_key(
-        thrust::seq,
-        keys_first + decomp[p_i].begin(),
-        keys_first + decomp[p_i].end(),
-        values_first + decomp[p_i].begin(),
-        comp);
-    }
-
-    THRUST_PRAGMA_OMP(barrier)
+  thrust::system::detail::internal::uniform_decomposition<IndexType> decomp(
+    keys_last - keys_first, 1, omp_get_max_threads());
 
-    // XXX For some reason, MSVC 2015 yields an error unless we include this meaningless semicolon here
-    ;
+  thrust::system::detail::internal::use_radix_sort<KeyType, StrictWeakOrdering> use_radix_sort;
 
-    IndexType nseg = decomp.size();
-    IndexType h    = 2;
-
-    // keep track of which sub-range we're processing
-    IndexType a = p_i, b = p_i, c = p_i + 1;
-
-    while (nseg > 1)
-    {
-      if (c >= decomp.size())
-      {
-        c = decomp.size() - 1;
-      }
-
-      if ((p_i % h) == 0 && c > b)
-      {
-        sort_detail::inplace_merge_by_key(
-          exec,
-          keys_first + decomp[a].begin(),
-          keys_first + decomp[b].end(),
-          keys_first + decomp[c].end(),
-          values_first + decomp[a].begin(),
-          comp);
-
-        b = c;
-        c += h;
-      }
-
-      nseg = (nseg + 1) / 2;
-      h *= 2;
-
-      THRUST_PRAGMA_OMP(barrier)
-    }
-  }
+  sort_detail::stable_sort_by_key(exec, keys_first, keys_last, values_first, decomp, comp, use_radix_sort);
 #endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
 }
 
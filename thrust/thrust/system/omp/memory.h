@@ -83,6 +83,12 @@ inline void free(pointer<void> ptr);
 template <typename T>
 using allocator = thrust::mr::stateless_resource_allocator<T, thrust::system::omp::memory_resource>;
 
+/*! \p omp::first_touch_allocator allocates memory from \p omp::first_touch_memory_resource, which is placed on the
+ *  NUMA nodes of the threads of the \p omp system that process it.
+ */
+template <typename T>
+using first_touch_allocator = thrust::mr::stateless_resource_allocator<T, thrust::system::omp::first_touch_memory_resource>;
+
 //! \p omp::universal_allocator allocates memory that can be used by the \p omp system and host systems.
 template <typename T>
 using universal_allocator = thrust::mr::stateless_resource_allocator<T, thrust::system::omp::universal_memory_resource>;
@@ -100,6 +106,7 @@ using universal_host_pinned_allocator =
 namespace omp
 {
 using thrust::system::omp::allocator;
+using thrust::system::omp::first_touch_allocator;
 using thrust::system::omp::free;
 using thrust::system::omp::malloc;
 using thrust::system::omp::universal_allocator;
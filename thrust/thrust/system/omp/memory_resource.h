@@ -31,6 +31,9 @@
 #endif // no system header
 #include <thrust/mr/fancy_pointer_resource.h>
 #include <thrust/mr/new.h>
+#include <thrust/system/detail/internal/first_touch_resource.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
 #include <thrust/system/omp/pointer.h>
 
 THRUST_NAMESPACE_BEGIN
@@ -46,6 +49,42 @@ using native_resource = thrust::mr::fancy_pointer_resource<thrust::mr::new_delet
 
 using universal_native_resource =
   thrust::mr::fancy_pointer_resource<thrust::mr::new_delete_resource, thrust::omp::universal_pointer<void>>;
+
+// touches the pages of each interval of default_decomposition from the thread which the static schedule of the
+// algorithms assigns to that interval
+struct page_toucher
+{
+  template <typename Size>
+  static void touch(char* p, Size bytes, Size page_size)
+  {
+    using index_type = std::intptr_t;
+
+    const thrust::system::detail::internal::uniform_decomposition<index_type> decomp =
+      thrust::system::omp::detail::default_decomposition(static_cast<index_type>(bytes));
+    const index_type n = decomp.size();
+
+    THRUST_PRAGMA_OMP(parallel for)
+    for (index_type i = 0; i < n; ++i)
+    {
+      // the first page starting in the interval; a page straddling two intervals goes to the first one
+      const index_type page  = static_cast<index_type>(page_size);
+      const index_type begin = (decomp[i].begin() + page - 1) / page * page;
+      for (index_type offset = begin; offset < decomp[i].end(); offset += page)
+      {
+        p[offset] = 0;
+      }
+    }
+  }
+};
+
+using first_touch_resource = thrust::system::detail::internal::first_touch_resource<page_toucher>;
+
+using first_touch_huge_page_resource = thrust::system::detail::internal::first_touch_resource<page_toucher, true>;
+
+using first_touch_native_resource = thrust::mr::fancy_pointer_resource<first_touch_resource, thrust::omp::pointer<void>>;
+
+using first_touch_huge_page_native_resource =
+  thrust::mr::fancy_pointer_resource<first_touch_huge_page_resource, thrust::omp::pointer<void>>;
 } // namespace detail
 //! \endcond
 
@@ -66,6 +105,19 @@ using universal_memory_resource = detail::universal_native_resource;
 /*! An alias for \p omp::universal_memory_resource. */
 using universal_host_pinned_memory_resource = universal_memory_resource;
 
+/*! A memory resource for the OpenMP system which places memory on the NUMA nodes of the threads that process it.
+ *  It maps untouched memory and writes to each of its pages from the thread to which the algorithms of the OpenMP
+ *  system assign the part of a range containing that page, so that the operating system allocates the page on the
+ *  node of that thread. Memory from \p omp::memory_resource is instead placed entirely on the node of the thread
+ *  which first initializes it.
+ */
+using first_touch_memory_resource = detail::first_touch_native_resource;
+
+/*! Like \p omp::first_touch_memory_resource, but advises the operating system to back allocations of at least a
+ *  huge page with transparent huge pages, which reduces the TLB misses of algorithms streaming over large ranges.
+ */
+using first_touch_huge_page_memory_resource = detail::first_touch_huge_page_native_resource;
+
 /*! \}
  */
 
@@ -26,5 +26,130 @@
 #  pragma system_header
 #endif // no system header
 
-// this system inherits binary_search
+#include <thrust/detail/type_traits/minimum_type.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/sort.h>
+#include <thrust/system/detail/generic/binary_search.h>
+#include <thrust/system/detail/internal/sorted_search.h>
+#include <thrust/system/tbb/detail/execution_policy.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+// this system inherits the scalar binary_search
 #include <thrust/system/cpp/detail/binary_search.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+// Searches are independent binary searches unless the values are sorted, in which case the positions they find only
+// move forward: each task then co-iterates over the searched range and a contiguous piece of the values.
+template <typename DerivedPolicy,
+          typename ForwardIterator,
+          typename InputIterator,
+          typename OutputIterator,
+          typename StrictWeakOrdering,
+          typename BinarySearchFunction>
+OutputIterator vectorized_search(
+  execution_policy<DerivedPolicy>& exec,
+  ForwardIterator begin,
+  ForwardIterator end,
+  InputIterator values_begin,
+  InputIterator values_end,
+  OutputIterator output,
+  StrictWeakOrdering comp,
+  BinarySearchFunction func)
+{
+  using traversal = typename thrust::detail::minimum_type<typename iterator_traversal<ForwardIterator>::type,
+                                                          typename iterator_traversal<InputIterator>::type,
+                                                          typename iterator_traversal<OutputIterator>::type>::type;
+
+  if constexpr (::cuda::std::is_convertible_v<traversal, random_access_traversal_tag>
+                && thrust::system::detail::internal::can_check_sorted_search_values<InputIterator, StrictWeakOrdering>)
+  {
+    if (thrust::is_sorted(exec, values_begin, values_end, comp))
+    {
+      using difference_type = thrust::detail::it_difference_t<InputIterator>;
+
+      const difference_type n = thrust::distance(begin, end);
+      const difference_type m = thrust::distance(values_begin, values_end);
+
+      // each piece starts with a search over the whole range, which large pieces amortize
+      ::tbb::parallel_for(::tbb::blocked_range<difference_type>(0, m, 1024),
+                          [=](const ::tbb::blocked_range<difference_type>& r) {
+                            thrust::system::detail::internal::sorted_search(
+                              begin, n, values_begin, r.begin(), r.end(), output, comp, func);
+                          });
+
+      return output + m;
+    }
+  }
+
+  return thrust::system::detail::generic::detail::binary_search(
+    exec, begin, end, values_begin, values_end, output, comp, func);
+}
+
+template <typename DerivedPolicy,
+          typename ForwardIterator,
+          typename InputIterator,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator lower_bound(
+  execution_policy<DerivedPolicy>& exec,
+  ForwardIterator begin,
+  ForwardIterator end,
+  InputIterator values_begin,
+  InputIterator values_end,
+  OutputIterator output,
+  StrictWeakOrdering comp)
+{
+  return tbb::detail::vectorized_search(
+    exec, begin, end, values_begin, values_end, output, comp, thrust::system::detail::generic::detail::lbf());
+}
+
+template <typename DerivedPolicy,
+          typename ForwardIterator,
+          typename InputIterator,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator upper_bound(
+  execution_policy<DerivedPolicy>& exec,
+  ForwardIterator begin,
+  ForwardIterator end,
+  InputIterator values_begin,
+  InputIterator values_end,
+  OutputIterator output,
+  StrictWeakOrdering comp)
+{
+  return tbb::detail::vectorized_search(
+    exec, begin, end, values_begin, values_end, output, comp, thrust::system::detail::generic::detail::ubf());
+}
+
+template <typename DerivedPolicy,
+          typename ForwardIterator,
+          typename InputIterator,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator binary_search(
+  execution_policy<DerivedPolicy>& exec,
+  ForwardIterator begin,
+  ForwardIterator end,
+  InputIterator values_begin,
+  InputIterator values_end,
+  OutputIterator output,
+  StrictWeakOrdering comp)
+{
+  return tbb::detail::vectorized_search(
+    exec, begin, end, values_begin, values_end, output, comp, thrust::system::detail::generic::detail::bsf());
+}
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
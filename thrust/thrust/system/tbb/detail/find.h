@@ -25,9 +25,17 @@
 #elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
 #  pragma system_header
 #endif // no system header
-#include <thrust/system/detail/generic/find.h>
+#include <thrust/detail/seq.h>
+#include <thrust/distance.h>
+#include <thrust/find.h>
+#include <thrust/system/detail/internal/find_if.h>
 #include <thrust/system/tbb/detail/execution_policy.h>
 
+#include <cuda/std/__algorithm/min.h>
+
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
 THRUST_NAMESPACE_BEGIN
 namespace system
 {
@@ -39,8 +47,32 @@ namespace detail
 template <typename DerivedPolicy, typename InputIterator, typename Predicate>
 InputIterator find_if(execution_policy<DerivedPolicy>& exec, InputIterator first, InputIterator last, Predicate pred)
 {
-  // tbb prefers generic::find_if to cpp::find_if
-  return thrust::system::detail::generic::find_if(exec, first, last, pred);
+  (void) exec;
+
+  // the workers claim blocks in order and stop claiming them past the first match found, which also makes mismatch,
+  // equal and the logical algorithms, all implemented in terms of find_if, exit early
+  thrust::system::detail::internal::cooperative_find_if<InputIterator, Predicate> search(
+    first, thrust::distance(first, last), pred);
+
+  if (search.num_blocks() <= 1)
+  {
+    return thrust::find_if(thrust::seq, first, last, pred);
+  }
+
+  // one task per worker of the arena; the blocks are handed out by the search itself
+  const int num_workers = static_cast<int>(
+    (::cuda::std::min)(static_cast<decltype(search.num_blocks())>(::tbb::this_task_arena::max_concurrency()),
+                       search.num_blocks()));
+
+  ::tbb::parallel_for(
+    0,
+    num_workers,
+    [&search](int) {
+      search();
+    },
+    ::tbb::simple_partitioner());
+
+  return first + search.result();
 }
 
 } // end namespace detail
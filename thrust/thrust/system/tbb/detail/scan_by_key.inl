@@ -0,0 +1,377 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/advance.h>
+#include <thrust/detail/function.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/tbb/detail/scan_by_key.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_scan.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace scan_by_key_detail
+{
+
+// placeholder initial value for inclusive scans
+struct no_init
+{};
+
+// The body's summary of the elements it has consumed is
+//   (first key, last key, whether a segment begins after the first element, running sum).
+// Keeping the boundary keys in the summary means a range never reads the keys of its
+// neighbours, which may be concurrently overwritten by an in-place scan.
+// When Exclusive is true, the running sum restarts from init at each segment head.
+template <bool Exclusive,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename ValueType,
+          typename InitialValueType,
+          typename BinaryPredicate,
+          typename BinaryFunction>
+struct scan_by_key_body
+{
+  using KeyType = thrust::detail::it_value_t<InputIterator1>;
+
+  InputIterator1 keys;
+  InputIterator2 values;
+  OutputIterator output;
+  InitialValueType init;
+  thrust::detail::wrapped_function<BinaryPredicate, bool> binary_pred;
+  thrust::detail::wrapped_function<BinaryFunction, ValueType> binary_op;
+  KeyType first_key;
+  KeyType last_key;
+  bool has_head;
+  ValueType sum;
+  bool first_call;
+
+  scan_by_key_body(InputIterator1 keys,
+                   InputIterator2 values,
+                   OutputIterator output,
+                   InitialValueType init,
+                   BinaryPredicate binary_pred,
+                   BinaryFunction binary_op)
+      : keys(keys)
+      , values(values)
+      , output(output)
+      , init(init)
+      , binary_pred{binary_pred}
+      , binary_op{binary_op}
+      , first_key(*keys)
+      , last_key(*keys)
+      , has_head(false)
+      , sum(*values)
+      , first_call(true)
+  {}
+
+  scan_by_key_body(scan_by_key_body& b, ::tbb::split)
+      : keys(b.keys)
+      , values(b.values)
+      , output(b.output)
+      , init(b.init)
+      , binary_pred{b.binary_pred}
+      , binary_op{b.binary_op}
+      , first_key(b.first_key)
+      , last_key(b.last_key)
+      , has_head(false)
+      , sum(b.sum)
+      , first_call(true)
+  {}
+
+  // the running sum of a segment whose head is the first element summarized by partial_sum
+  ValueType restart(const ValueType& partial_sum)
+  {
+    if constexpr (Exclusive)
+    {
+      return binary_op(init, partial_sum);
+    }
+    else
+    {
+      return partial_sum;
+    }
+  }
+
+  // fold the summary of the elements following those already summarized into this body
+  void accumulate(
+    const KeyType& rhs_first_key, const KeyType& rhs_last_key, bool rhs_has_head, const ValueType& rhs_sum)
+  {
+    if (first_call)
+    {
+      first_key = rhs_first_key;
+      has_head  = rhs_has_head;
+      sum       = rhs_sum;
+    }
+    else
+    {
+      const bool boundary_is_head = !binary_pred(last_key, rhs_first_key);
+
+      if (rhs_has_head)
+      {
+        sum = rhs_sum;
+      }
+      else if (boundary_is_head)
+      {
+        sum = restart(rhs_sum);
+      }
+      else
+      {
+        sum = binary_op(sum, rhs_sum);
+      }
+
+      has_head = has_head || rhs_has_head || boundary_is_head;
+    }
+
+    last_key   = rhs_last_key;
+    first_call = false;
+  }
+
+  template <typename Size>
+  void operator()(const ::tbb::blocked_range<Size>& r, ::tbb::pre_scan_tag)
+  {
+    InputIterator1 iter1 = keys + r.begin();
+    InputIterator2 iter2 = values + r.begin();
+
+    const KeyType range_first_key = *iter1;
+    KeyType prev_key              = range_first_key;
+
+    // the first element of the whole input is always a segment head
+    bool range_has_head = (r.begin() == 0);
+    ValueType temp      = *iter2;
+
+    if (range_has_head)
+    {
+      temp = restart(temp);
+    }
+
+    ++iter1;
+    ++iter2;
+
+    for (Size i = r.begin() + 1; i != r.end(); ++i, ++iter1, ++iter2)
+    {
+      KeyType key = *iter1;
+
+      if (binary_pred(prev_key, key))
+      {
+        temp = binary_op(temp, *iter2);
+      }
+      else
+      {
+        temp           = restart(*iter2);
+        range_has_head = true;
+      }
+
+      prev_key = key;
+    }
+
+    accumulate(range_first_key, prev_key, range_has_head, temp);
+  }
+
+  template <typename Size>
+  void operator()(const ::tbb::blocked_range<Size>& r, ::tbb::final_scan_tag)
+  {
+    InputIterator1 iter1 = keys + r.begin();
+    InputIterator2 iter2 = values + r.begin();
+    OutputIterator iter3 = output + r.begin();
+
+    if (first_call)
+    {
+      first_key = *iter1;
+    }
+
+    KeyType prev_key = last_key;
+
+    for (Size i = r.begin(); i != r.end(); ++i, ++iter1, ++iter2, ++iter3)
+    {
+      KeyType key = *iter1;
+
+      // read the value before writing the output to permit in-place scans
+      ValueType value = *iter2;
+
+      const bool is_head = (first_call && i == r.begin()) || !binary_pred(prev_key, key);
+
+      if constexpr (Exclusive)
+      {
+        if (is_head)
+        {
+          sum = init;
+        }
+
+        *iter3 = sum;
+        sum    = binary_op(sum, value);
+      }
+      else
+      {
+        if (is_head)
+        {
+          sum = value;
+        }
+        else
+        {
+          sum = binary_op(sum, value);
+        }
+
+        *iter3 = sum;
+      }
+
+      prev_key = key;
+    }
+
+    last_key   = prev_key;
+    has_head   = true;
+    first_call = false;
+  }
+
+  void reverse_join(scan_by_key_body& b)
+  {
+    if (b.first_call)
+    {
+      return;
+    }
+
+    // b summarizes the elements preceding those summarized by this body
+    if (first_call)
+    {
+      assign(b);
+    }
+    else
+    {
+      const KeyType rhs_first_key = first_key;
+      const KeyType rhs_last_key  = last_key;
+      const bool rhs_has_head     = has_head;
+      const ValueType rhs_sum     = sum;
+
+      assign(b);
+      accumulate(rhs_first_key, rhs_last_key, rhs_has_head, rhs_sum);
+    }
+  }
+
+  void assign(scan_by_key_body& b)
+  {
+    first_key  = b.first_key;
+    last_key   = b.last_key;
+    has_head   = b.has_head;
+    sum        = b.sum;
+    first_call = b.first_call;
+  }
+};
+
+template <bool Exclusive,
+          typename ValueType,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename InitialValueType,
+          typename BinaryPredicate,
+          typename BinaryFunction>
+OutputIterator scan_by_key(
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  OutputIterator result,
+  InitialValueType init,
+  BinaryPredicate binary_pred,
+  BinaryFunction binary_op)
+{
+  using Size = thrust::detail::it_difference_t<InputIterator1>;
+  Size n     = thrust::distance(first1, last1);
+
+  if (n != 0)
+  {
+    using Body = scan_by_key_body<Exclusive,
+                                  InputIterator1,
+                                  InputIterator2,
+                                  OutputIterator,
+                                  ValueType,
+                                  InitialValueType,
+                                  BinaryPredicate,
+                                  BinaryFunction>;
+    Body scan_body(first1, first2, result, init, binary_pred, binary_op);
+    ::tbb::parallel_scan(::tbb::blocked_range<Size>(0, n), scan_body);
+  }
+
+  thrust::advance(result, n);
+
+  return result;
+}
+
+} // namespace scan_by_key_detail
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename BinaryPredicate,
+          typename BinaryFunction>
+OutputIterator inclusive_scan_by_key(
+  execution_policy<DerivedPolicy>&,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  OutputIterator result,
+  BinaryPredicate binary_pred,
+  BinaryFunction binary_op)
+{
+  using ValueType = thrust::detail::it_value_t<InputIterator2>;
+
+  return scan_by_key_detail::scan_by_key<false, ValueType>(
+    first1, last1, first2, result, scan_by_key_detail::no_init{}, binary_pred, binary_op);
+}
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename T,
+          typename BinaryPredicate,
+          typename BinaryFunction>
+OutputIterator exclusive_scan_by_key(
+  execution_policy<DerivedPolicy>&,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  OutputIterator result,
+  T init,
+  BinaryPredicate binary_pred,
+  BinaryFunction binary_op)
+{
+  using ValueType = T;
+
+  return scan_by_key_detail::scan_by_key<true, ValueType>(first1, last1, first2, result, init, binary_pred, binary_op);
+}
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
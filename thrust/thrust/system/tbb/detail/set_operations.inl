@@ -0,0 +1,369 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/function.h>
+#include <thrust/detail/seq.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/discard_iterator.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/pair.h>
+#include <thrust/scan.h>
+#include <thrust/set_operations.h>
+#include <thrust/system/detail/internal/merge_path.h>
+#include <thrust/system/tbb/detail/execution_policy.h>
+#include <thrust/system/tbb/detail/set_operations.h>
+
+#include <cuda/std/__algorithm/max.h>
+#include <cuda/std/__algorithm/min.h>
+
+#include <cassert>
+#include <thread>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace set_operations_detail
+{
+
+struct difference_op
+{
+  template <typename InputIterator1,
+            typename InputIterator2,
+            typename OutputIterator,
+            typename StrictWeakOrdering>
+  OutputIterator operator()(
+    InputIterator1 first1,
+    InputIterator1 last1,
+    InputIterator2 first2,
+    InputIterator2 last2,
+    OutputIterator result,
+    StrictWeakOrdering comp) const
+  {
+    return thrust::set_difference(thrust::seq, first1, last1, first2, last2, result, comp);
+  }
+};
+
+struct intersection_op
+{
+  template <typename InputIterator1,
+            typename InputIterator2,
+            typename OutputIterator,
+            typename StrictWeakOrdering>
+  OutputIterator operator()(
+    InputIterator1 first1,
+    InputIterator1 last1,
+    InputIterator2 first2,
+    InputIterator2 last2,
+    OutputIterator result,
+    StrictWeakOrdering comp) const
+  {
+    return thrust::set_intersection(thrust::seq, first1, last1, first2, last2, result, comp);
+  }
+};
+
+struct symmetric_difference_op
+{
+  template <typename InputIterator1,
+            typename InputIterator2,
+            typename OutputIterator,
+            typename StrictWeakOrdering>
+  OutputIterator operator()(
+    InputIterator1 first1,
+    InputIterator1 last1,
+    InputIterator2 first2,
+    InputIterator2 last2,
+    OutputIterator result,
+    StrictWeakOrdering comp) const
+  {
+    return thrust::set_symmetric_difference(thrust::seq, first1, last1, first2, last2, result, comp);
+  }
+};
+
+struct union_op
+{
+  template <typename InputIterator1,
+            typename InputIterator2,
+            typename OutputIterator,
+            typename StrictWeakOrdering>
+  OutputIterator operator()(
+    InputIterator1 first1,
+    InputIterator1 last1,
+    InputIterator2 first2,
+    InputIterator2 last2,
+    OutputIterator result,
+    StrictWeakOrdering comp) const
+  {
+    return thrust::set_union(thrust::seq, first1, last1, first2, last2, result, comp);
+  }
+};
+
+// computes where each partition of the output begins in each of the input ranges
+template <typename InputIterator1, typename InputIterator2, typename BoundsIterator, typename Size, typename Compare>
+struct balanced_path_body
+{
+  InputIterator1 first1;
+  InputIterator2 first2;
+  BoundsIterator bounds;
+  Size n1, n2;
+  Size partition_size;
+  Compare comp;
+
+  void operator()(const ::tbb::blocked_range<Size>& r) const
+  {
+    for (Size i = r.begin(); i != r.end(); ++i)
+    {
+      const Size diag = ::cuda::std::min(n1 + n2, i * partition_size);
+
+      bounds[i] = thrust::system::detail::internal::balanced_path(first1, n1, first2, n2, diag, comp);
+    }
+  }
+};
+
+// applies the set operation to a single partition, writing its output at the given offset,
+// or only counting the size of its output when no offsets are given
+template <typename InputIterator1,
+          typename InputIterator2,
+          typename BoundsIterator,
+          typename OffsetIterator,
+          typename OutputIterator,
+          typename Size,
+          typename StrictWeakOrdering,
+          typename SetOperation>
+struct set_operation_body
+{
+  InputIterator1 first1;
+  InputIterator2 first2;
+  BoundsIterator bounds;
+  OffsetIterator offsets;
+  OutputIterator result;
+  bool count_only;
+  StrictWeakOrdering comp;
+  SetOperation set_op;
+
+  void operator()(const ::tbb::blocked_range<Size>& r) const
+  {
+    assert(r.size() == 1);
+
+    const Size i = r.begin();
+
+    const thrust::pair<Size, Size> begin = bounds[i];
+    const thrust::pair<Size, Size> end   = bounds[i + 1];
+
+    if (count_only)
+    {
+      offsets[i + 1] =
+        set_op(first1 + begin.first,
+               first1 + end.first,
+               first2 + begin.second,
+               first2 + end.second,
+               thrust::make_discard_iterator(),
+               comp)
+        - thrust::make_discard_iterator();
+    }
+    else
+    {
+      set_op(first1 + begin.first,
+             first1 + end.first,
+             first2 + begin.second,
+             first2 + end.second,
+             result + static_cast<Size>(offsets[i]),
+             comp);
+    }
+  }
+};
+
+// Every set operation is split into independent pieces along the balanced path of the two
+// input ranges. The pieces are processed twice: once to count the size of their output,
+// and once more to write it at the offsets given by the exclusive sum of these counts.
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename StrictWeakOrdering,
+          typename SetOperation>
+OutputIterator set_operation(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  InputIterator2 last2,
+  OutputIterator result,
+  StrictWeakOrdering comp,
+  SetOperation set_op)
+{
+  using difference_type = thrust::detail::it_difference_t<InputIterator1>;
+  using bounds_type     = thrust::pair<difference_type, difference_type>;
+
+  const difference_type n1 = thrust::distance(first1, last1);
+  const difference_type n2 = thrust::distance(first2, last2);
+
+  // XXX this value is a tuning opportunity
+  const difference_type parallelism_threshold = 10000;
+
+  if (n1 + n2 < parallelism_threshold)
+  {
+    // don't bother parallelizing for small n
+    return set_op(first1, last1, first2, last2, result, comp);
+  }
+
+  // count the number of processors
+  const unsigned int p = ::cuda::std::max<unsigned int>(1u, std::thread::hardware_concurrency());
+
+  // generate O(P) partitions of sequential work, no smaller than the threshold
+  const difference_type partition_size =
+    ::cuda::std::max<difference_type>(parallelism_threshold, (n1 + n2 + p - 1) / p);
+  const difference_type num_partitions = (n1 + n2 + partition_size - 1) / partition_size;
+
+  // wrap comp
+  using wrapped_comp_type = thrust::detail::wrapped_function<StrictWeakOrdering, bool>;
+  wrapped_comp_type wrapped_comp{comp};
+
+  thrust::detail::temporary_array<bounds_type, DerivedPolicy> bounds(0, exec, num_partitions + 1);
+
+  using bounds_iterator = typename thrust::detail::temporary_array<bounds_type, DerivedPolicy>::iterator;
+
+  ::tbb::parallel_for(
+    ::tbb::blocked_range<difference_type>(0, num_partitions + 1),
+    balanced_path_body<InputIterator1, InputIterator2, bounds_iterator, difference_type, wrapped_comp_type>{
+      first1, first2, bounds.begin(), n1, n2, partition_size, wrapped_comp});
+
+  // offsets[i + 1] is the size of the output of partition i, until it is scanned below
+  thrust::detail::temporary_array<difference_type, DerivedPolicy> offsets(0, exec, num_partitions + 1);
+
+  using offsets_iterator = typename thrust::detail::temporary_array<difference_type, DerivedPolicy>::iterator;
+  using body_type =
+    set_operation_body<InputIterator1,
+                       InputIterator2,
+                       bounds_iterator,
+                       offsets_iterator,
+                       OutputIterator,
+                       difference_type,
+                       StrictWeakOrdering,
+                       SetOperation>;
+
+  // force grainsize == 1 with simple_partioner()
+  ::tbb::parallel_for(::tbb::blocked_range<difference_type>(0, num_partitions, 1),
+                      body_type{first1, first2, bounds.begin(), offsets.begin(), result, true, comp, set_op},
+                      ::tbb::simple_partitioner());
+
+  // scan the counts to get each partition's output offset
+  offsets[0] = 0;
+  thrust::inclusive_scan(thrust::seq, offsets.begin() + 1, offsets.end(), offsets.begin() + 1);
+
+  ::tbb::parallel_for(::tbb::blocked_range<difference_type>(0, num_partitions, 1),
+                      body_type{first1, first2, bounds.begin(), offsets.begin(), result, false, comp, set_op},
+                      ::tbb::simple_partitioner());
+
+  return result + static_cast<difference_type>(offsets[num_partitions]);
+} // end set_operation()
+
+} // end namespace set_operations_detail
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator set_difference(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  InputIterator2 last2,
+  OutputIterator result,
+  StrictWeakOrdering comp)
+{
+  return set_operations_detail::set_operation(
+    exec, first1, last1, first2, last2, result, comp, set_operations_detail::difference_op{});
+} // end set_difference()
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator set_intersection(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  InputIterator2 last2,
+  OutputIterator result,
+  StrictWeakOrdering comp)
+{
+  return set_operations_detail::set_operation(
+    exec, first1, last1, first2, last2, result, comp, set_operations_detail::intersection_op{});
+} // end set_intersection()
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator set_symmetric_difference(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  InputIterator2 last2,
+  OutputIterator result,
+  StrictWeakOrdering comp)
+{
+  return set_operations_detail::set_operation(
+    exec, first1, last1, first2, last2, result, comp, set_operations_detail::symmetric_difference_op{});
+} // end set_symmetric_difference()
+
+template <typename DerivedPolicy,
+          typename InputIterator1,
+          typename InputIterator2,
+          typename OutputIterator,
+          typename StrictWeakOrdering>
+OutputIterator set_union(
+  execution_policy<DerivedPolicy>& exec,
+  InputIterator1 first1,
+  InputIterator1 last1,
+  InputIterator2 first2,
+  InputIterator2 last2,
+  OutputIterator result,
+  StrictWeakOrdering comp)
+{
+  return set_operations_detail::set_operation(
+    exec, first1, last1, first2, last2, result, comp, set_operations_detail::union_op{});
+} // end set_union()
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
@@ -26,13 +26,26 @@
 #  pragma system_header
 #endif // no system header
 #include <thrust/detail/copy.h>
+#include <thrust/detail/raw_pointer_cast.h>
 #include <thrust/detail/seq.h>
 #include <thrust/detail/temporary_array.h>
+#include <thrust/detail/type_traits.h>
 #include <thrust/distance.h>
+#include <thrust/functional.h>
 #include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/zip_iterator.h>
 #include <thrust/merge.h>
 #include <thrust/sort.h>
+#include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/detail/internal/radix_sort.h>
 
+#include <cuda/std/__algorithm/max.h>
+
+#include <cstddef>
+#include <thread>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 #include <tbb/parallel_invoke.h>
 
 THRUST_NAMESPACE_BEGIN
@@ -42,6 +55,138 @@ namespace tbb
 {
 namespace detail
 {
+namespace radix_sort_detail
+{
+
+template <typename RandomAccessIterator, typename Decomposition, typename Digit>
+struct histogram_body
+{
+  using index_type = typename Decomposition::index_type;
+
+  RandomAccessIterator first;
+  Decomposition decomp;
+  Digit digit;
+  unsigned int pass;
+  std::size_t* counts;
+
+  void operator()(const ::tbb::blocked_range<index_type>& r) const
+  {
+    for (index_type i = r.begin(); i != r.end(); ++i)
+    {
+      thrust::system::detail::internal::radix_histogram(
+        digit,
+        first + decomp[i].begin(),
+        decomp[i].size(),
+        pass,
+        counts + i * thrust::system::detail::internal::radix_num_buckets);
+    }
+  }
+};
+
+template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename Decomposition, typename Digit>
+struct scatter_body
+{
+  using index_type = typename Decomposition::index_type;
+
+  RandomAccessIterator1 first;
+  RandomAccessIterator2 result;
+  Decomposition decomp;
+  Digit digit;
+  unsigned int pass;
+  std::size_t* offsets;
+
+  void operator()(const ::tbb::blocked_range<index_type>& r) const
+  {
+    for (index_type i = r.begin(); i != r.end(); ++i)
+    {
+      thrust::system::detail::internal::radix_scatter(
+        digit,
+        first + decomp[i].begin(),
+        decomp[i].size(),
+        pass,
+        offsets + i * thrust::system::detail::internal::radix_num_buckets,
+        result);
+    }
+  }
+};
+
+// Performs one pass of the radix sort of the tiles of [first, first + n) into result. Returns false, without moving
+// any element, when the pass may be skipped because every element falls into the same bucket.
+template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename Decomposition, typename Digit>
+bool radix_sort_pass(RandomAccessIterator1 first,
+                     RandomAccessIterator2 result,
+                     Decomposition decomp,
+                     Digit digit,
+                     unsigned int pass,
+                     std::size_t* counts)
+{
+  using index_type = typename Decomposition::index_type;
+
+  const index_type num_tiles = decomp.size();
+  const std::size_t n        = static_cast<std::size_t>(decomp[num_tiles - 1].end());
+
+  // force grainsize == 1 with simple_partioner()
+  ::tbb::parallel_for(::tbb::blocked_range<index_type>(0, num_tiles, 1),
+                      histogram_body<RandomAccessIterator1, Decomposition, Digit>{first, decomp, digit, pass, counts},
+                      ::tbb::simple_partitioner());
+
+  if (!thrust::system::detail::internal::radix_offsets(counts, num_tiles, n))
+  {
+    return false;
+  }
+
+  ::tbb::parallel_for(
+    ::tbb::blocked_range<index_type>(0, num_tiles, 1),
+    scatter_body<RandomAccessIterator1, RandomAccessIterator2, Decomposition, Digit>{
+      first, result, decomp, digit, pass, counts},
+    ::tbb::simple_partitioner());
+
+  return true;
+}
+
+// Sorts [first, first + n) with an LSD radix sort, one digit per pass. Every pass counts the digits of O(P) tiles in
+// parallel and scatters the tiles in parallel. The elements ping-pong between [first, first + n) and a buffer of the
+// same size.
+template <typename DerivedPolicy, typename RandomAccessIterator1, typename RandomAccessIterator2, typename Digit>
+void radix_sort(execution_policy<DerivedPolicy>& exec,
+                RandomAccessIterator1 first,
+                RandomAccessIterator2 buffer,
+                thrust::detail::it_difference_t<RandomAccessIterator1> n,
+                Digit digit)
+{
+  using difference_type = thrust::detail::it_difference_t<RandomAccessIterator1>;
+
+  // count the number of processors
+  const unsigned int p = ::cuda::std::max<unsigned int>(1u, std::thread::hardware_concurrency());
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp(
+    n, thrust::system::detail::internal::radix_sort_threshold / 4, p);
+
+  thrust::detail::temporary_array<std::size_t, DerivedPolicy> counts(
+    exec, decomp.size() * thrust::system::detail::internal::radix_num_buckets);
+
+  bool sorted_in_buffer = false;
+
+  for (unsigned int pass = 0; pass < Digit::num_passes; ++pass)
+  {
+    if (sorted_in_buffer)
+    {
+      sorted_in_buffer = !radix_sort_pass(buffer, first, decomp, digit, pass, thrust::raw_pointer_cast(counts.data()));
+    }
+    else
+    {
+      sorted_in_buffer = radix_sort_pass(first, buffer, decomp, digit, pass, thrust::raw_pointer_cast(counts.data()));
+    }
+  }
+
+  if (sorted_in_buffer)
+  {
+    thrust::copy(exec, buffer, buffer + n, first);
+  }
+}
+
+} // namespace radix_sort_detail
+
 namespace sort_detail
 {
 
@@ -256,17 +401,55 @@ void merge_sort_by_key(
 
 } // namespace sort_by_key_detail
 
+namespace sort_detail
+{
+
+// sorts primitive keys ordered by less or greater with a radix sort
 template <typename DerivedPolicy, typename RandomAccessIterator, typename StrictWeakOrdering>
-void stable_sort(
-  execution_policy<DerivedPolicy>& exec, RandomAccessIterator first, RandomAccessIterator last, StrictWeakOrdering comp)
+void stable_sort(execution_policy<DerivedPolicy>& exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp,
+                 thrust::detail::true_type)
+{
+  using key_type = thrust::detail::it_value_t<RandomAccessIterator>;
+
+  const auto n = thrust::distance(first, last);
+
+  if (n < thrust::system::detail::internal::radix_sort_threshold)
+  {
+    thrust::stable_sort(thrust::seq, first, last, comp);
+    return;
+  }
+
+  thrust::detail::temporary_array<key_type, DerivedPolicy> temp(exec, n);
+
+  using digit_type = thrust::system::detail::internal::
+    radix_digit<key_type, ::cuda::std::is_same<StrictWeakOrdering, thrust::greater<key_type>>::value>;
+
+  radix_sort_detail::radix_sort(exec, first, temp.begin(), n, digit_type{});
+}
+
+// sorts every other kind of keys with a merge sort
+template <typename DerivedPolicy, typename RandomAccessIterator, typename StrictWeakOrdering>
+void stable_sort(execution_policy<DerivedPolicy>& exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp,
+                 thrust::detail::false_type)
 {
   using key_type = thrust::detail::it_value_t<RandomAccessIterator>;
 
   thrust::detail::temporary_array<key_type, DerivedPolicy> temp(exec, first, last);
 
-  sort_detail::merge_sort(exec, first, last, temp.begin(), comp, true);
+  merge_sort(exec, first, last, temp.begin(), comp, true);
 }
 
+} // namespace sort_detail
+
+namespace sort_by_key_detail
+{
+
 template <typename DerivedPolicy,
           typename RandomAccessIterator1,
           typename RandomAccessIterator2,
@@ -276,7 +459,46 @@ void stable_sort_by_key(
   RandomAccessIterator1 first1,
   RandomAccessIterator1 last1,
   RandomAccessIterator2 first2,
-  StrictWeakOrdering comp)
+  StrictWeakOrdering comp,
+  thrust::detail::true_type)
+{
+  using key_type = thrust::detail::it_value_t<RandomAccessIterator1>;
+  using val_type = thrust::detail::it_value_t<RandomAccessIterator2>;
+
+  const auto n = thrust::distance(first1, last1);
+
+  if (n < thrust::system::detail::internal::radix_sort_threshold)
+  {
+    thrust::stable_sort_by_key(thrust::seq, first1, last1, first2, comp);
+    return;
+  }
+
+  thrust::detail::temporary_array<key_type, DerivedPolicy> temp1(exec, n);
+  thrust::detail::temporary_array<val_type, DerivedPolicy> temp2(exec, n);
+
+  using digit_type = thrust::system::detail::internal::
+    radix_digit<key_type, ::cuda::std::is_same<StrictWeakOrdering, thrust::greater<key_type>>::value>;
+
+  // keys and values are moved together
+  radix_sort_detail::radix_sort(
+    exec,
+    thrust::make_zip_iterator(first1, first2),
+    thrust::make_zip_iterator(temp1.begin(), temp2.begin()),
+    n,
+    thrust::system::detail::internal::radix_digit_of_key<digit_type>{});
+}
+
+template <typename DerivedPolicy,
+          typename RandomAccessIterator1,
+          typename RandomAccessIterator2,
+          typename StrictWeakOrdering>
+void stable_sort_by_key(
+  execution_policy<DerivedPolicy>& exec,
+  RandomAccessIterator1 first1,
+  RandomAccessIterator1 last1,
+  RandomAccessIterator2 first2,
+  StrictWeakOrdering comp,
+  thrust::detail::false_type)
 {
   using key_type = thrust::detail::it_value_t<RandomAccessIterator1>;
   using val_type = thrust::detail::it_value_t<RandomAccessIterator2>;
@@ -286,7 +508,38 @@ void stable_sort_by_key(
   thrust::detail::temporary_array<key_type, DerivedPolicy> temp1(exec, first1, last1);
   thrust::detail::temporary_array<val_type, DerivedPolicy> temp2(exec, first2, last2);
 
-  sort_by_key_detail::merge_sort_by_key(exec, first1, last1, first2, temp1.begin(), temp2.begin(), comp, true);
+  merge_sort_by_key(exec, first1, last1, first2, temp1.begin(), temp2.begin(), comp, true);
+}
+
+} // namespace sort_by_key_detail
+
+template <typename DerivedPolicy, typename RandomAccessIterator, typename StrictWeakOrdering>
+void stable_sort(
+  execution_policy<DerivedPolicy>& exec, RandomAccessIterator first, RandomAccessIterator last, StrictWeakOrdering comp)
+{
+  using key_type = thrust::detail::it_value_t<RandomAccessIterator>;
+
+  thrust::system::detail::internal::use_radix_sort<key_type, StrictWeakOrdering> use_radix_sort;
+
+  sort_detail::stable_sort(exec, first, last, comp, use_radix_sort);
+}
+
+template <typename DerivedPolicy,
+          typename RandomAccessIterator1,
+          typename RandomAccessIterator2,
+          typename StrictWeakOrdering>
+void stable_sort_by_key(
+  execution_policy<DerivedPolicy>& exec,
+  RandomAccessIterator1 first1,
+  RandomAccessIterator1 last1,
+  RandomAccessIterator2 first2,
+  StrictWeakOrdering comp)
+{
+  using key_type = thrust::detail::it_value_t<RandomAccessIterator1>;
+
+  thrust::system::detail::internal::use_radix_sort<key_type, StrictWeakOrdering> use_radix_sort;
+
+  sort_by_key_detail::stable_sort_by_key(exec, first1, last1, first2, comp, use_radix_sort);
 }
 
 } // end namespace detail
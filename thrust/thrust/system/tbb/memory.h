@@ -83,6 +83,12 @@ inline void free(pointer<void> ptr);
 template <typename T>
 using allocator = thrust::mr::stateless_resource_allocator<T, thrust::system::tbb::memory_resource>;
 
+/*! \p tbb::first_touch_allocator allocates memory from \p tbb::first_touch_memory_resource, which is spread over
+ *  the NUMA nodes of the worker threads of the \p tbb system.
+ */
+template <typename T>
+using first_touch_allocator = thrust::mr::stateless_resource_allocator<T, thrust::system::tbb::first_touch_memory_resource>;
+
 //! \p tbb::universal_allocator allocates memory that can be used by the \p tbb system and host systems.
 template <typename T>
 using universal_allocator = thrust::mr::stateless_resource_allocator<T, thrust::system::tbb::universal_memory_resource>;
@@ -100,6 +106,7 @@ using universal_host_pinned_allocator =
 namespace tbb
 {
 using thrust::system::tbb::allocator;
+using thrust::system::tbb::first_touch_allocator;
 using thrust::system::tbb::free;
 using thrust::system::tbb::malloc;
 using thrust::system::tbb::universal_allocator;
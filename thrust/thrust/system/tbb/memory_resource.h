@@ -31,8 +31,12 @@
 #endif // no system header
 #include <thrust/mr/fancy_pointer_resource.h>
 #include <thrust/mr/new.h>
+#include <thrust/system/detail/internal/first_touch_resource.h>
 #include <thrust/system/tbb/pointer.h>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 THRUST_NAMESPACE_BEGIN
 namespace system
 {
@@ -46,6 +50,35 @@ using native_resource = thrust::mr::fancy_pointer_resource<thrust::mr::new_delet
 
 using universal_native_resource =
   thrust::mr::fancy_pointer_resource<thrust::mr::new_delete_resource, thrust::tbb::universal_pointer<void>>;
+
+// the algorithms of the TBB system do not assign parts of a range to threads deterministically, so the pages are
+// touched under a static_partitioner, which splits them evenly over the worker threads
+struct page_toucher
+{
+  template <typename Size>
+  static void touch(char* p, Size bytes, Size page_size)
+  {
+    const Size num_pages = (bytes + page_size - 1) / page_size;
+    ::tbb::parallel_for(
+      ::tbb::blocked_range<Size>(0, num_pages),
+      [=](const ::tbb::blocked_range<Size>& r) {
+        for (Size page = r.begin(); page != r.end(); ++page)
+        {
+          p[page * page_size] = 0;
+        }
+      },
+      ::tbb::static_partitioner());
+  }
+};
+
+using first_touch_resource = thrust::system::detail::internal::first_touch_resource<page_toucher>;
+
+using first_touch_huge_page_resource = thrust::system::detail::internal::first_touch_resource<page_toucher, true>;
+
+using first_touch_native_resource = thrust::mr::fancy_pointer_resource<first_touch_resource, thrust::tbb::pointer<void>>;
+
+using first_touch_huge_page_native_resource =
+  thrust::mr::fancy_pointer_resource<first_touch_huge_page_resource, thrust::tbb::pointer<void>>;
 } // namespace detail
 //! \endcond
 
@@ -66,6 +99,18 @@ using universal_memory_resource = detail::universal_native_resource;
 /*! An alias for \p tbb::universal_memory_resource. */
 using universal_host_pinned_memory_resource = universal_memory_resource;
 
+/*! A memory resource for the TBB system which spreads memory over the NUMA nodes of the worker threads. It maps
+ *  untouched memory and writes to its pages from the worker threads, splitting them evenly, so that the operating
+ *  system allocates each page on the node of the thread which touched it. Memory from \p tbb::memory_resource is
+ *  instead placed entirely on the node of the thread which first initializes it.
+ */
+using first_touch_memory_resource = detail::first_touch_native_resource;
+
+/*! Like \p tbb::first_touch_memory_resource, but advises the operating system to back allocations of at least a
+ *  huge page with transparent huge pages, which reduces the TLB misses of algorithms streaming over large ranges.
+ */
+using first_touch_huge_page_memory_resource = detail::first_touch_huge_page_native_resource;
+
 /*! \} // memory_resources
  */
 